@@ -0,0 +1,129 @@
+// Compares tool call latency in process and through an isolated plugin host.
+//
+//   bench_plugin_host [--calls N] [--payload BYTES]
+//
+// The out-of-process case re-executes this program as the host, serving
+// the same echo tool over the shared-memory ring.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "openclaw/agent/tool_registry.hpp"
+#include "openclaw/plugins/plugin_host.hpp"
+
+namespace net = boost::asio;
+using namespace openclaw;
+using json = nlohmann::json;
+
+namespace {
+
+class EchoTool : public agent::Tool {
+public:
+    [[nodiscard]] auto definition() const -> agent::ToolDefinition override {
+        return {.name = "echo", .description = "Returns its input"};
+    }
+    auto execute(json params) -> net::awaitable<Result<json>> override {
+        co_return params;
+    }
+};
+
+auto arg_value(int argc, char** argv, std::string_view name, long fallback) -> long {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (argv[i] == name) {
+            return std::strtol(argv[i + 1], nullptr, 10);
+        }
+    }
+    return fallback;
+}
+
+void report(const char* label, std::vector<double>& micros) {
+    std::sort(micros.begin(), micros.end());
+    auto at = [&](double q) { return micros[static_cast<size_t>(q * (micros.size() - 1))]; };
+    double sum = 0;
+    for (auto m : micros) sum += m;
+    std::printf("%-16s calls=%zu  min=%.2fus  p50=%.2fus  p99=%.2fus  mean=%.2fus\n",
+                label, micros.size(), micros.front(), at(0.5), at(0.99),
+                sum / static_cast<double>(micros.size()));
+}
+
+template <typename Call>
+auto measure(long calls, const json& params, Call call) -> net::awaitable<std::vector<double>> {
+    std::vector<double> micros;
+    micros.reserve(static_cast<size_t>(calls));
+    for (long i = 0; i < calls; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        auto result = co_await call(params);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (!result) {
+            std::fprintf(stderr, "call failed: %s\n", result.error().what().c_str());
+            std::exit(1);
+        }
+        micros.push_back(std::chrono::duration<double, std::micro>(elapsed).count());
+    }
+    co_return micros;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::string_view(argv[1]) == "serve") {
+        plugins::PluginHostEndpoint endpoint{
+            .memfd = static_cast<int>(arg_value(argc, argv, "--memfd", -1)),
+            .request_fd = static_cast<int>(arg_value(argc, argv, "--request-fd", -1)),
+            .response_fd = static_cast<int>(arg_value(argc, argv, "--response-fd", -1)),
+            .ring_bytes = static_cast<size_t>(arg_value(argc, argv, "--ring-bytes", 0)),
+        };
+        return plugins::serve_plugin_host(endpoint, "echo", "1.0",
+                                          {std::make_shared<EchoTool>()});
+    }
+
+    auto calls = arg_value(argc, argv, "--calls", 20000);
+    auto payload = arg_value(argc, argv, "--payload", 64);
+    json params{{"data", std::string(static_cast<size_t>(payload), 'x')}};
+
+    net::io_context ioc;
+    agent::ToolRegistry in_process;
+    in_process.register_tool(std::make_shared<EchoTool>());
+
+    auto host = std::make_shared<plugins::PluginHost>(ioc, plugins::PluginHostOptions{
+        .library = "echo",
+        .command = {"/proc/self/exe", "serve"},
+    });
+    bool is_ready = false;
+    net::steady_timer ready(ioc, net::steady_timer::time_point::max());
+    host->on_tools([&](auto) {
+        is_ready = true;
+        ready.cancel();
+    });
+    if (auto started = host->start(); !started) {
+        std::fprintf(stderr, "host failed to start: %s\n", started.error().what().c_str());
+        return 1;
+    }
+
+    std::printf("payload=%ld bytes\n", payload);
+    net::co_spawn(ioc, [&]() -> net::awaitable<void> {
+        auto local = co_await measure(calls, params, [&](const json& p) {
+            return in_process.execute("echo", p);
+        });
+        report("in-process", local);
+
+        if (!is_ready) {
+            boost::system::error_code ec;
+            co_await ready.async_wait(net::redirect_error(net::use_awaitable, ec));
+        }
+        auto remote = co_await measure(calls, params, [&](const json& p) {
+            return host->call("echo", p);
+        });
+        report("out-of-process", remote);
+        host->stop();
+    }, net::detached);
+    ioc.run();
+    return 0;
+}
@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""Runs mylobster_bench and checks the results against budgets.json.
+
+    compare_bench.py --bench build/bench/mylobster_bench [--out results.json]
+    compare_bench.py --xml catch2-output.xml
+    compare_bench.py --results results.json
+
+The benchmark binary is run with Catch2's XML reporter, whose benchmark
+output is stable across Catch2 versions; the mean of every benchmark is
+written to --out as JSON. Arguments after "--" go to the binary, e.g.
+"-- [gateway] --benchmark-samples 50".
+
+Exits 1 when a benchmark's mean exceeds its budget, or when a budgeted
+benchmark did not run. --update rewrites the budgets from the results
+(mean x --headroom, at least --floor) instead of checking them.
+"""
+
+import argparse
+import json
+import pathlib
+import subprocess
+import sys
+import tempfile
+import xml.etree.ElementTree as ET
+
+DEFAULT_BUDGETS = pathlib.Path(__file__).resolve().parent / "budgets.json"
+
+
+def parse_catch_xml(text):
+    """Returns {name: {mean_ns, low_ns, high_ns, stddev_ns, samples}}."""
+    results = {}
+    for bench in ET.fromstring(text).iter("BenchmarkResults"):
+        mean = bench.find("mean")
+        stddev = bench.find("standardDeviation")
+        if mean is None:
+            continue
+        results[bench.get("name")] = {
+            "mean_ns": float(mean.get("value")),
+            "low_ns": float(mean.get("lowerBound")),
+            "high_ns": float(mean.get("upperBound")),
+            "stddev_ns": float(stddev.get("value")) if stddev is not None else 0.0,
+            "samples": int(bench.get("samples", "0")),
+        }
+    return results
+
+
+def run_bench(binary, extra_args):
+    # The report goes to a file: the library logs to stdout
+    with tempfile.TemporaryDirectory() as tmp:
+        report = pathlib.Path(tmp) / "report.xml"
+        proc = subprocess.run([binary, "--reporter", "xml", "--out", str(report), *extra_args],
+                              capture_output=True, text=True)
+        if proc.returncode != 0:
+            sys.stderr.write(proc.stdout + proc.stderr)
+            sys.exit(f"{binary} exited with {proc.returncode}")
+        return parse_catch_xml(report.read_text())
+
+
+def format_ns(ns):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= scale:
+            return f"{ns / scale:.2f} {unit}"
+    return f"{ns:.0f} ns"
+
+
+def check(results, budgets, allow_missing):
+    failures = 0
+    width = max((len(name) for name in budgets | results), default=0)
+    for name in sorted(budgets | results):
+        budget = budgets.get(name)
+        result = results.get(name)
+        if result is None:
+            if not allow_missing:
+                print(f"MISSING  {name:<{width}}  budget {format_ns(budget)}")
+                failures += 1
+            continue
+        mean = result["mean_ns"]
+        if budget is None:
+            print(f"NEW      {name:<{width}}  {format_ns(mean):>10}  (no budget)")
+            continue
+        ratio = mean / budget
+        status = "OK" if mean <= budget else "OVER"
+        failures += status == "OVER"
+        print(f"{status:<8} {name:<{width}}  {format_ns(mean):>10} / "
+              f"{format_ns(budget):>10}  ({ratio:.0%} of budget)")
+    return failures
+
+
+def main():
+    argv = sys.argv[1:]
+    extra = []
+    if "--" in argv:
+        split = argv.index("--")
+        argv, extra = argv[:split], argv[split + 1:]
+
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--bench", help="mylobster_bench binary to run")
+    source.add_argument("--xml", help="saved Catch2 XML reporter output")
+    source.add_argument("--results", help="results JSON from an earlier --out")
+    parser.add_argument("--out", help="write the results here as JSON")
+    parser.add_argument("--budgets", default=str(DEFAULT_BUDGETS))
+    parser.add_argument("--allow-missing", action="store_true",
+                        help="don't fail on budgeted benchmarks that did not run "
+                             "(when filtering with a Catch2 test spec)")
+    parser.add_argument("--update", action="store_true",
+                        help="rewrite the budgets from these results")
+    parser.add_argument("--headroom", type=float, default=3.0,
+                        help="budget = mean x headroom when updating (default 3)")
+    parser.add_argument("--floor", type=float, default=1000.0,
+                        help="smallest budget written when updating, in ns (default "
+                             "1000); sub-microsecond means are mostly timer noise")
+    args = parser.parse_args(argv)
+
+    if args.bench:
+        results = run_bench(args.bench, extra)
+    elif args.xml:
+        results = parse_catch_xml(pathlib.Path(args.xml).read_text())
+    else:
+        results = json.loads(pathlib.Path(args.results).read_text())["benchmarks"]
+
+    if args.out:
+        pathlib.Path(args.out).write_text(
+            json.dumps({"benchmarks": results}, indent=2, sort_keys=True) + "\n")
+
+    budgets_path = pathlib.Path(args.budgets)
+    config = json.loads(budgets_path.read_text()) if budgets_path.exists() else {}
+    budgets = config.get("budgets_ns", {})
+
+    if args.update:
+        for name, result in results.items():
+            budgets[name] = round(max(result["mean_ns"] * args.headroom, args.floor))
+        config["budgets_ns"] = dict(sorted(budgets.items()))
+        budgets_path.write_text(json.dumps(config, indent=2) + "\n")
+        print(f"Updated {len(results)} budgets in {budgets_path}")
+        return 0
+
+    failures = check(results, budgets, args.allow_missing)
+    if failures:
+        print(f"\n{failures} benchmark(s) over budget or missing")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,373 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "openclaw/browser/dom_snapshot.hpp"
+
+using namespace openclaw::browser;
+using json = nlohmann::json;
+
+namespace {
+
+/// Builds a DOMSnapshot.captureSnapshot response in CDP's columnar layout.
+class SnapshotBuilder {
+public:
+    SnapshotBuilder() { add(-1, 9, "#document", {}, {}, true); }
+
+    auto element(int parent, const std::string& name,
+                 std::vector<std::pair<std::string, std::string>> attrs = {},
+                 bool rendered = true) -> int {
+        return add(parent, 1, name, {}, std::move(attrs), rendered);
+    }
+
+    auto text(int parent, const std::string& value, bool rendered = true) -> int {
+        return add(parent, 3, "#text", value, {}, rendered);
+    }
+
+    auto build() const -> json {
+        return {
+            {"strings", strings_},
+            {"documents", json::array({{
+                {"nodes", {
+                    {"parentIndex", parent_},
+                    {"nodeType", type_},
+                    {"nodeName", name_},
+                    {"nodeValue", value_},
+                    {"attributes", attributes_},
+                }},
+                {"layout", {
+                    {"nodeIndex", layout_index_},
+                    {"bounds", bounds_},
+                }},
+            }})},
+        };
+    }
+
+private:
+    auto add(int parent, int type, const std::string& name, const std::string& value,
+             std::vector<std::pair<std::string, std::string>> attrs, bool rendered) -> int {
+        int index = static_cast<int>(parent_.size());
+        parent_.push_back(parent);
+        type_.push_back(type);
+        name_.push_back(intern(name));
+        value_.push_back(value.empty() ? -1 : intern(value));
+        json flat = json::array();
+        for (const auto& [k, v] : attrs) {
+            flat.push_back(intern(k));
+            flat.push_back(intern(v));
+        }
+        attributes_.push_back(std::move(flat));
+        if (type != 9 && rendered) {
+            layout_index_.push_back(index);
+            bounds_.push_back({index, index * 2, 100, 20});
+        }
+        return index;
+    }
+
+    auto intern(const std::string& s) -> int {
+        auto [it, inserted] = index_.try_emplace(s, static_cast<int>(strings_.size()));
+        if (inserted) strings_.push_back(s);
+        return it->second;
+    }
+
+    json strings_ = json::array();
+    std::unordered_map<std::string, int> index_;
+    std::vector<int> parent_, type_, name_, value_, layout_index_;
+    json attributes_ = json::array();
+    json bounds_ = json::array();
+};
+
+/// A news listing page of about 5,000 nodes: wrapper divs, headline links,
+/// summaries and tag lists per card.
+auto listing_page(int cards) -> json {
+    SnapshotBuilder b;
+    int html = b.element(0, "HTML", {{"lang", "en"}});
+    int body = b.element(html, "BODY", {{"class", "page home"}});
+    int main = b.element(body, "MAIN", {{"id", "content"}});
+    for (int i = 0; i < cards; ++i) {
+        auto id = std::to_string(i);
+        int wrap = main;
+        for (int d = 0; d < 3; ++d) {
+            wrap = b.element(wrap, "DIV", {{"class", "wrap-" + std::to_string(d)}});
+        }
+        int h2 = b.element(wrap, "H2", {{"class", "headline"}});
+        b.text(b.element(h2, "A", {{"href", "https://example.com/a/" + id}}),
+               "Headline number " + id);
+        for (int p = 0; p < 2; ++p) {
+            b.text(b.element(wrap, "P", {{"class", "summary"}}),
+                   "Paragraph " + std::to_string(p) + " of story " + id + ".");
+        }
+        int ul = b.element(wrap, "UL", {{"class", "tags"}});
+        for (int t = 0; t < 3; ++t) {
+            b.text(b.element(ul, "LI"), "tag-" + std::to_string(t));
+        }
+    }
+    return b.build();
+}
+
+/// A long article index of about 52,000 nodes: deeper wrappers, more
+/// attributes and an unrendered script per card.
+auto heavy_page(int cards) -> json {
+    SnapshotBuilder b;
+    int html = b.element(0, "HTML");
+    int body = b.element(html, "BODY", {{"class", "page home"}});
+    int main = b.element(body, "MAIN", {{"id", "content"}});
+    for (int i = 0; i < cards; ++i) {
+        auto id = std::to_string(i);
+        int wrap = main;
+        for (int d = 0; d < 4; ++d) {
+            wrap = b.element(wrap, "DIV", {{"class", "wrap-" + std::to_string(d)},
+                                           {"data-testid", "card-" + id}});
+        }
+        int h2 = b.element(wrap, "H2", {{"class", "headline"}});
+        b.text(b.element(h2, "A", {{"href", "https://example.com/a/" + id},
+                                   {"class", "link"}}),
+               "Headline number " + id);
+        for (int p = 0; p < 3; ++p) {
+            b.text(b.element(wrap, "P", {{"class", "summary"}}),
+                   "Paragraph " + std::to_string(p) + " of story " + id +
+                   " with some   ordinary body text.");
+        }
+        int ul = b.element(wrap, "UL", {{"class", "tags"}});
+        for (int t = 0; t < 5; ++t) {
+            b.text(b.element(ul, "LI"), "tag-" + std::to_string(t));
+        }
+        b.text(b.element(wrap, "SCRIPT", {}, false), "track(" + id + ");", false);
+    }
+    return b.build();
+}
+
+/// Snapshot::build_dom_tree as it was before FlatDomSnapshot: a recursive
+/// walk over the response JSON that scans every parentIndex entry for each
+/// node's children, so quadratic in the node count. Not shipped; kept as
+/// the baseline the flat decoder is measured against.
+auto legacy_build_dom_tree(const json& nodes, const json& strings, int index,
+                           int depth, const SnapshotOptions& options) -> DomNode {
+    DomNode node;
+
+    if (options.max_depth >= 0 && depth > options.max_depth) {
+        return node;
+    }
+
+    // DOMSnapshot format uses index-based arrays
+    if (!nodes.contains("nodeName") ||
+        index < 0 || index >= static_cast<int>(nodes["nodeName"].size())) {
+        return node;
+    }
+
+    // Node name from string table
+    int name_idx = nodes["nodeName"][index].get<int>();
+    if (name_idx >= 0 && name_idx < static_cast<int>(strings.size())) {
+        node.tag_name = strings[name_idx].get<std::string>();
+    }
+
+    // Node type
+    int node_type = nodes["nodeType"][index].get<int>();
+    switch (node_type) {
+        case 1: node.node_type = "element"; break;
+        case 3: node.node_type = "text"; break;
+        case 9: node.node_type = "document"; break;
+        case 10: node.node_type = "doctype"; break;
+        case 11: node.node_type = "fragment"; break;
+        default: node.node_type = "other"; break;
+    }
+
+    node.node_id = index;
+
+    // Text value from string table
+    if (nodes.contains("nodeValue")) {
+        int val_idx = nodes["nodeValue"][index].get<int>();
+        if (val_idx >= 0 && val_idx < static_cast<int>(strings.size())) {
+            node.text_content = strings[val_idx].get<std::string>();
+        }
+    }
+
+    // Skip whitespace-only text nodes if configured
+    if (!options.include_whitespace && node.node_type == "text") {
+        bool all_whitespace = true;
+        for (char c : node.text_content) {
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                all_whitespace = false;
+                break;
+            }
+        }
+        if (all_whitespace && !node.text_content.empty()) {
+            node.text_content.clear();
+        }
+    }
+
+    // Attributes
+    if (nodes.contains("attributes") && index < static_cast<int>(nodes["attributes"].size())) {
+        auto& attrs = nodes["attributes"][index];
+        if (attrs.is_array()) {
+            for (size_t i = 0; i + 1 < attrs.size(); i += 2) {
+                int key_idx = attrs[i].get<int>();
+                int val_idx = attrs[i + 1].get<int>();
+                std::string key, val;
+                if (key_idx >= 0 && key_idx < static_cast<int>(strings.size())) {
+                    key = strings[key_idx].get<std::string>();
+                }
+                if (val_idx >= 0 && val_idx < static_cast<int>(strings.size())) {
+                    val = strings[val_idx].get<std::string>();
+                }
+                if (!key.empty()) {
+                    node.attributes[key] = val;
+                }
+            }
+        }
+    }
+
+    // Layout / bounding box
+    if (nodes.contains("layout")) {
+        auto& layout = nodes["layout"];
+        if (layout.contains("bounds") && index < static_cast<int>(layout["bounds"].size())) {
+            auto& bounds = layout["bounds"][index];
+            if (bounds.is_array() && bounds.size() >= 4) {
+                node.bounding_box = {
+                    {"x", bounds[0]},
+                    {"y", bounds[1]},
+                    {"width", bounds[2]},
+                    {"height", bounds[3]},
+                };
+            }
+        }
+    }
+
+    // Children
+    if (nodes.contains("parentIndex")) {
+        auto& parent_indices = nodes["parentIndex"];
+        for (int i = 0; i < static_cast<int>(parent_indices.size()); ++i) {
+            if (parent_indices[i].get<int>() == index && i != index) {
+                auto child = legacy_build_dom_tree(nodes, strings, i, depth + 1, options);
+                if (!child.tag_name.empty() || !child.text_content.empty() ||
+                    !child.children.empty()) {
+                    node.children.push_back(std::move(child));
+                }
+            }
+        }
+    }
+
+    return node;
+}
+
+/// The legacy capture_dom() path from a captureSnapshot response.
+auto legacy_dom_tree(const json& result) -> DomNode {
+    return legacy_build_dom_tree(result["documents"][0]["nodes"], result["strings"],
+                                 0, 0, {});
+}
+
+/// The flat path from the same response, decode included.
+void flat_dom_tree(Catch::Benchmark::Chronometer& meter, const json& page) {
+    // Copies are made up front so only decoding is timed
+    std::vector<json> inputs(static_cast<size_t>(meter.runs()), page);
+    meter.measure([&](int i) {
+        return FlatDomSnapshot::decode(std::move(inputs[i]))->to_dom_node();
+    });
+}
+
+/// DOMSnapshot.captureSnapshot responses saved by record_dom_snapshot,
+/// keyed by file stem.
+auto recorded_pages() -> std::vector<std::pair<std::string, json>> {
+    std::vector<std::pair<std::string, json>> pages;
+    std::error_code ec;
+    for (const auto& entry :
+         std::filesystem::directory_iterator(MYLOBSTER_BENCH_FIXTURES, ec)) {
+        if (entry.path().extension() != ".json") continue;
+        std::ifstream file(entry.path());
+        pages.emplace_back(entry.path().stem().string(), json::parse(file));
+    }
+    std::ranges::sort(pages, {}, &std::pair<std::string, json>::first);
+    return pages;
+}
+
+} // anonymous namespace
+
+TEST_CASE("DOM snapshot tree build", "[benchmark][browser]") {
+    auto page = listing_page(300);
+
+    BENCHMARK_ADVANCED("FlatDomSnapshot::decode")(Catch::Benchmark::Chronometer meter) {
+        // Copies are made up front so only decoding is timed
+        std::vector<json> inputs(static_cast<size_t>(meter.runs()), page);
+        meter.measure([&](int i) {
+            return FlatDomSnapshot::decode(std::move(inputs[i]));
+        });
+    };
+
+    auto flat = FlatDomSnapshot::decode(page);
+    REQUIRE(flat.has_value());
+
+    BENCHMARK("FlatDomSnapshot::to_dom_node") {
+        return flat->to_dom_node();
+    };
+
+    BENCHMARK("FlatDomSnapshot::to_text") {
+        return flat->to_text();
+    };
+
+    // The whole response-to-DomNode path, old and new side by side
+    BENCHMARK("Snapshot::build_dom_tree legacy") {
+        return legacy_dom_tree(page);
+    };
+
+    BENCHMARK_ADVANCED("FlatDomSnapshot decode + to_dom_node")(Catch::Benchmark::Chronometer meter) {
+        flat_dom_tree(meter, page);
+    };
+}
+
+TEST_CASE("DOM snapshot tree build, heavy page", "[benchmark][browser]") {
+    auto page = heavy_page(2000);
+
+    BENCHMARK_ADVANCED("FlatDomSnapshot::decode heavy")(Catch::Benchmark::Chronometer meter) {
+        std::vector<json> inputs(static_cast<size_t>(meter.runs()), page);
+        meter.measure([&](int i) {
+            return FlatDomSnapshot::decode(std::move(inputs[i]));
+        });
+    };
+
+    auto flat = FlatDomSnapshot::decode(page);
+    REQUIRE(flat.has_value());
+
+    BENCHMARK("FlatDomSnapshot::to_dom_node heavy") {
+        return flat->to_dom_node();
+    };
+
+    BENCHMARK("FlatDomSnapshot::to_text heavy") {
+        return flat->to_text();
+    };
+}
+
+// Real pages recorded with record_dom_snapshot into bench/fixtures/dom_snapshot.
+// Hidden from the default run: the legacy path is quadratic and takes
+// seconds per sample on large pages, so run it on its own, e.g.
+// `mylobster_bench [recorded] --benchmark-samples 10`.
+TEST_CASE("DOM snapshot tree build, recorded pages", "[.][recorded][benchmark][browser]") {
+    auto pages = recorded_pages();
+    if (pages.empty()) {
+        WARN("No recorded snapshots in " MYLOBSTER_BENCH_FIXTURES);
+        return;
+    }
+
+    for (const auto& [name, page] : pages) {
+        REQUIRE(FlatDomSnapshot::decode(page).has_value());
+
+        BENCHMARK("Snapshot::build_dom_tree legacy " + name) {
+            return legacy_dom_tree(page);
+        };
+
+        BENCHMARK_ADVANCED("FlatDomSnapshot decode + to_dom_node " + name)(Catch::Benchmark::Chronometer meter) {
+            flat_dom_tree(meter, page);
+        };
+
+        auto flat = FlatDomSnapshot::decode(page);
+        BENCHMARK("FlatDomSnapshot::to_text " + name) {
+            return flat->to_text();
+        };
+    }
+}
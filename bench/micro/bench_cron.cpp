@@ -0,0 +1,36 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+
+#include "openclaw/cron/parser.hpp"
+
+using namespace openclaw::cron;
+
+TEST_CASE("Cron next occurrence", "[benchmark][cron]") {
+    // A fixed start so results do not depend on the wall clock
+    auto from = openclaw::Timestamp(std::chrono::seconds(1767225600));  // 2026-01-01 00:00 UTC
+
+    auto every_five = parse_cron("*/5 * * * *");
+    auto weekdays = parse_cron("30 9 * * 1-5");
+    auto monthly = parse_cron("0 3 15 * *");  // Two weeks out
+    REQUIRE(every_five.has_value());
+    REQUIRE(weekdays.has_value());
+    REQUIRE(monthly.has_value());
+
+    BENCHMARK("parse_cron") {
+        return parse_cron("0,15,30,45 8-18/2 * jan-jun mon-fri");
+    };
+
+    BENCHMARK("next_occurrence every 5 min") {
+        return next_occurrence(*every_five, from);
+    };
+
+    BENCHMARK("next_occurrence weekdays 09:30") {
+        return next_occurrence(*weekdays, from);
+    };
+
+    BENCHMARK("next_occurrence monthly") {
+        return next_occurrence(*monthly, from);
+    };
+}
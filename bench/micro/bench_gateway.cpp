@@ -0,0 +1,126 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+#include "openclaw/gateway/frame.hpp"
+#include "openclaw/gateway/server.hpp"
+#include "openclaw/gateway/tool_policy.hpp"
+
+using namespace openclaw::gateway;
+
+namespace {
+
+/// A chat.send request as the Control UI sends it.
+auto chat_request() -> std::string {
+    return serialize_frame(Frame{RequestFrame{
+        .id = "req-7f3a9c21d4e84b6a",
+        .method = "chat.send",
+        .params = {
+            {"sessionKey", "agent:main:webchat:user-42"},
+            {"message", "Summarize the last three messages in #general and draft a reply "
+                        "that thanks everyone for the release notes."},
+            {"idempotencyKey", "b7c1e2f0-5d4a-4f8e-9a61-0c3d2e1f4a5b"},
+            {"attachments", json::array()},
+        },
+    }});
+}
+
+/// A streamed assistant delta, the most frequent outbound frame.
+auto chat_delta_event() -> Frame {
+    return Frame{EventFrame{
+        .event = "chat",
+        .data = {
+            {"runId", "run-2c9d41"},
+            {"sessionKey", "agent:main:webchat:user-42"},
+            {"seq", 118},
+            {"state", "delta"},
+            {"message", {
+                {"role", "assistant"},
+                {"content", json::array({{{"type", "text"},
+                    {"text", "Thanks for pulling the release notes together - the "
+                             "migration section in particular will save people time."}}})},
+            }},
+        },
+    }};
+}
+
+/// Assistant output with a little markup, as relayed to a browser client.
+auto outbound_text() -> std::string {
+    std::string text;
+    for (int i = 0; i < 8; ++i) {
+        text += "Here is paragraph " + std::to_string(i) +
+                " of the answer, with <b>bold</b> text, a "
+                "<a href=\"https://example.com/docs\">link</a> and some `code`. ";
+    }
+    return serialize_frame(Frame{EventFrame{.event = "chat", .data = {{"text", text}}}});
+}
+
+} // anonymous namespace
+
+TEST_CASE("Gateway frame codec", "[benchmark][gateway]") {
+    auto request = chat_request();
+    auto event = chat_delta_event();
+    auto event_text = serialize_frame(event);
+
+    REQUIRE(parse_frame(request).has_value());
+
+    BENCHMARK("parse_frame request") {
+        return parse_frame(request);
+    };
+
+    BENCHMARK("parse_frame event") {
+        return parse_frame(event_text);
+    };
+
+    BENCHMARK("serialize_frame event") {
+        return serialize_frame(event);
+    };
+}
+
+TEST_CASE("Connection outbound sanitizer", "[benchmark][gateway]") {
+    auto text = outbound_text();
+
+    BENCHMARK_ADVANCED("sanitize_outbound_text")(Catch::Benchmark::Chronometer meter) {
+        std::vector<std::string> inputs(static_cast<size_t>(meter.runs()), text);
+        meter.measure([&](int i) { sanitize_outbound_text(inputs[i]); });
+    };
+}
+
+TEST_CASE("ToolPolicy checks", "[benchmark][gateway]") {
+    ToolPolicy policy;
+    policy.configure({
+        {"tools.profile", "coding"},
+        {"tools.allow", {"group:browser", "group:memory"}},
+        {"tools.deny", {"shell"}},
+    });
+    policy.set_owner("owner-1");
+
+    const std::vector<std::string> calls = {
+        "file_read", "file_write", "code_edit", "shell", "git", "browser_open",
+        "memory_search", "cron", "gateway", "unknown_tool",
+    };
+    REQUIRE(policy.is_allowed("file_read", "user-42"));
+
+    BENCHMARK("ToolPolicy::is_allowed by name") {
+        int allowed = 0;
+        for (const auto& name : calls) {
+            allowed += policy.is_allowed(name, "user-42") ? 1 : 0;
+        }
+        return allowed;
+    };
+
+    std::vector<ToolPolicy::ToolId> ids;
+    for (const auto& name : calls) {
+        if (auto id = policy.tool_id(name)) ids.push_back(*id);
+    }
+
+    BENCHMARK("ToolPolicy::is_allowed by id") {
+        int allowed = 0;
+        for (auto id : ids) {
+            allowed += policy.is_allowed(id, "user-42") ? 1 : 0;
+        }
+        return allowed;
+    };
+}
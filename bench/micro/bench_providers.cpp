@@ -0,0 +1,53 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <string>
+
+#include "openclaw/providers/sse_line_parser.hpp"
+
+using namespace openclaw::providers;
+
+namespace {
+
+/// An Anthropic Messages stream of about 64 KiB: a few hundred text deltas
+/// between the usual start and stop events, with CRLF line endings.
+auto anthropic_stream() -> std::string {
+    std::string stream =
+        "event: message_start\r\n"
+        "data: {\"type\":\"message_start\",\"message\":{\"id\":\"msg_01XFDUDYJgAACzvnptvVoYEL\","
+        "\"type\":\"message\",\"role\":\"assistant\",\"content\":[],\"model\":\"claude-sonnet-4-20250514\","
+        "\"usage\":{\"input_tokens\":1204,\"output_tokens\":1}}}\r\n\r\n"
+        "event: content_block_start\r\n"
+        "data: {\"type\":\"content_block_start\",\"index\":0,\"content_block\":{\"type\":\"text\",\"text\":\"\"}}\r\n\r\n";
+    for (int i = 0; stream.size() < 64 * 1024; ++i) {
+        stream += "event: content_block_delta\r\n"
+                  "data: {\"type\":\"content_block_delta\",\"index\":0,\"delta\":{\"type\":\"text_delta\","
+                  "\"text\":\"token " + std::to_string(i) + " of a reasonably long answer \"}}\r\n\r\n";
+        if (i % 50 == 0) {
+            stream += "event: ping\r\ndata: {\"type\": \"ping\"}\r\n\r\n";
+        }
+    }
+    stream +=
+        "event: content_block_stop\r\ndata: {\"type\":\"content_block_stop\",\"index\":0}\r\n\r\n"
+        "event: message_delta\r\n"
+        "data: {\"type\":\"message_delta\",\"delta\":{\"stop_reason\":\"end_turn\"},\"usage\":{\"output_tokens\":512}}\r\n\r\n"
+        "event: message_stop\r\ndata: {\"type\":\"message_stop\"}\r\n\r\n";
+    return stream;
+}
+
+} // anonymous namespace
+
+TEST_CASE("SSE line parser", "[benchmark][providers]") {
+    auto stream = anthropic_stream();
+    constexpr size_t kChunk = 1400;  // One TLS record's worth of payload
+
+    BENCHMARK("SseLineParser::feed 64KiB") {
+        size_t lines = 0;
+        SseLineParser parser([&lines](std::string_view) { ++lines; });
+        for (size_t i = 0; i < stream.size(); i += kChunk) {
+            parser.feed(stream.data() + i, std::min(kChunk, stream.size() - i));
+        }
+        return lines;
+    };
+}
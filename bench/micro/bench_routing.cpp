@@ -0,0 +1,61 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <string>
+
+#include <boost/asio.hpp>
+
+#include "openclaw/routing/router.hpp"
+#include "openclaw/routing/rules.hpp"
+
+using namespace openclaw::routing;
+
+namespace {
+
+auto noop_handler() -> Router::Handler {
+    return [](const IncomingMessage&) -> boost::asio::awaitable<void> { co_return; };
+}
+
+} // anonymous namespace
+
+TEST_CASE("Router dispatch", "[benchmark][routing]") {
+    // A typical deployment: a handful of commands, per-channel routes and
+    // a catch-all, checked in priority order.
+    Router router;
+    for (const auto* command : {"/help", "/status", "/reset", "/model", "/think"}) {
+        router.add_route(std::make_unique<PrefixRule>(command, 100), noop_handler());
+    }
+    router.add_route(std::make_unique<RegexRule>(R"(^remind me (to|about) .+)", 50),
+                     noop_handler());
+    for (const auto* channel : {"telegram", "discord", "slack", "whatsapp"}) {
+        router.add_route(std::make_unique<ChannelRule>(channel, 10), noop_handler());
+    }
+    router.add_route(std::make_unique<ChannelRule>("webchat", 0), noop_handler());
+
+    IncomingMessage msg{
+        .channel = "webchat",
+        .sender_id = "user-42",
+        .text = "Can you look at the failing build on the release branch?",
+        .metadata = json::object(),
+    };
+
+    // Each iteration runs one route() to completion on its own io_context
+    boost::asio::io_context ioc;
+    auto route_once = [&] {
+        bool routed = false;
+        boost::asio::co_spawn(ioc,
+            [&]() -> boost::asio::awaitable<void> {
+                routed = (co_await router.route(msg)).has_value();
+            },
+            boost::asio::detached);
+        ioc.run();
+        ioc.restart();
+        return routed;
+    };
+    REQUIRE(route_once());
+
+    BENCHMARK("Router::route fallthrough") {
+        return route_once();
+    };
+}
@@ -0,0 +1,111 @@
+// Records pages' DOMSnapshot.captureSnapshot responses as fixtures for the
+// [recorded] DOM snapshot benchmarks in mylobster_bench.
+//
+//   record_dom_snapshot [--chrome PATH] [--out DIR] NAME=URL ...
+//
+// Each URL is loaded in a pooled Chrome session until the network is idle,
+// then captured with the parameters Snapshot uses and written to
+// DIR/NAME.json (default bench/fixtures/dom_snapshot).
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "openclaw/browser/browser_action.hpp"
+#include "openclaw/browser/browser_pool.hpp"
+#include "openclaw/browser/dom_snapshot.hpp"
+
+namespace net = boost::asio;
+using namespace openclaw;
+using namespace openclaw::browser;
+
+namespace {
+
+struct Page {
+    std::string name;
+    std::string url;
+};
+
+auto record(BrowserPool& pool, const Page& page, const std::filesystem::path& out)
+    -> net::awaitable<bool> {
+    auto session = co_await pool.acquire();
+    if (!session) {
+        std::fprintf(stderr, "%s: %s\n", page.name.c_str(), session.error().what().c_str());
+        co_return false;
+    }
+
+    BrowserAction action(*(*session)->cdp);
+    auto loaded = co_await action.navigate(page.url, {.timeout_ms = 60000,
+                                                      .wait_until = "networkidle0"});
+    auto snapshot = loaded
+        ? co_await (*session)->cdp->send_command("DOMSnapshot.captureSnapshot",
+                                                 FlatDomSnapshot::capture_params())
+        : Result<json>(std::unexpected(loaded.error()));
+    pool.release(*session);
+    if (!snapshot) {
+        std::fprintf(stderr, "%s: %s\n", page.name.c_str(), snapshot.error().what().c_str());
+        co_return false;
+    }
+
+    auto flat = FlatDomSnapshot::decode(*snapshot);
+    auto path = out / (page.name + ".json");
+    std::ofstream(path) << snapshot->dump();
+    std::printf("%-24s %7zu nodes  %s\n", page.name.c_str(),
+                flat ? flat->size() : size_t{0}, path.c_str());
+    co_return true;
+}
+
+auto record_all(BrowserPool& pool, std::vector<Page> pages, std::filesystem::path out)
+    -> net::awaitable<int> {
+    int failed = 0;
+    for (const auto& page : pages) {
+        failed += !co_await record(pool, page, out);
+    }
+    co_await pool.close_all();
+    co_return failed;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    BrowserConfig config;
+    config.pool_size = 1;
+    std::filesystem::path out = MYLOBSTER_BENCH_FIXTURES;
+    std::vector<Page> pages;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--chrome" && i + 1 < argc) {
+            config.chrome_path = argv[++i];
+        } else if (arg == "--out" && i + 1 < argc) {
+            out = argv[++i];
+        } else if (auto eq = arg.find('='); eq != std::string_view::npos && eq > 0) {
+            pages.push_back({std::string(arg.substr(0, eq)), std::string(arg.substr(eq + 1))});
+        } else {
+            std::fprintf(stderr, "usage: %s [--chrome PATH] [--out DIR] NAME=URL ...\n", argv[0]);
+            return 2;
+        }
+    }
+    if (pages.empty()) {
+        std::fprintf(stderr, "usage: %s [--chrome PATH] [--out DIR] NAME=URL ...\n", argv[0]);
+        return 2;
+    }
+    std::filesystem::create_directories(out);
+
+    net::io_context ioc;
+    BrowserPool pool(ioc, config);
+    int failed = 0;
+    net::co_spawn(ioc, record_all(pool, std::move(pages), out),
+        [&failed](std::exception_ptr e, int result) {
+            if (e) std::rethrow_exception(e);
+            failed = result;
+        });
+    ioc.run();
+    return failed == 0 ? 0 : 1;
+}
@@ -88,8 +88,8 @@ FetchContent_Declare(
 set(UUID_BUILD_TESTS OFF CACHE BOOL "" FORCE)
 FetchContent_MakeAvailable(stduuid)
 
-# Catch2 (test framework, only if building tests)
-if(MYLOBSTER_BUILD_TESTS)
+# Catch2 (test framework; also drives the microbenchmarks)
+if(MYLOBSTER_BUILD_TESTS OR MYLOBSTER_BUILD_BENCHMARKS)
     FetchContent_Declare(
         Catch2
         GIT_REPOSITORY https://github.com/catchorg/Catch2.git
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -16,27 +18,50 @@ namespace openclaw::agent {
 /// Registry that holds all available tools for the agent.
 ///
 /// Tools are registered by name and can be looked up, listed, or
-/// executed by name. The registry owns all registered tool instances.
+/// executed by name. The registry shares ownership of every tool.
+///
+/// The name map is immutable once published: writers copy it, apply their
+/// change and swap the new map in atomically, while readers take a
+/// snapshot without locking. A call in flight keeps its tool alive even if
+/// the tool is replaced or removed meanwhile, which is what lets plugins
+/// be reloaded under load.
 class ToolRegistry {
 public:
-    ToolRegistry() = default;
+    using ToolMap = std::unordered_map<std::string, std::shared_ptr<Tool>>;
+
+    ToolRegistry();
     ~ToolRegistry() = default;
 
     ToolRegistry(const ToolRegistry&) = delete;
     ToolRegistry& operator=(const ToolRegistry&) = delete;
-    ToolRegistry(ToolRegistry&&) = default;
-    ToolRegistry& operator=(ToolRegistry&&) = default;
-
-    /// Register a tool. The registry takes ownership. If a tool with the
-    /// same name already exists, it will be replaced.
-    void register_tool(std::unique_ptr<Tool> tool);
-
-    /// Look up a tool by name. Returns nullptr if not found.
+    ToolRegistry(ToolRegistry&&) = delete;
+    ToolRegistry& operator=(ToolRegistry&&) = delete;
+
+    /// Register a tool. If a tool with the same name already exists, it
+    /// will be replaced. Accepts a unique_ptr, or a shared_ptr whose owner
+    /// must stay alive while the tool is reachable (e.g. a plugin library).
+    void register_tool(std::shared_ptr<Tool> tool);
+
+    /// Remove the tools named in `remove` and add `add` in a single
+    /// publication, so no reader sees a partial set.
+    void replace(const std::vector<std::string>& remove,
+                 std::vector<std::shared_ptr<Tool>> add);
+
+    /// Look up a tool by name. Returns nullptr if not found. The pointer
+    /// stays valid until the tool is replaced or removed; use find() to
+    /// hold on to a tool across a suspension point.
     [[nodiscard]] auto get(std::string_view name) -> Tool*;
 
     /// Look up a tool by name (const). Returns nullptr if not found.
     [[nodiscard]] auto get(std::string_view name) const -> const Tool*;
 
+    /// Look up a tool by name and keep it alive for as long as the
+    /// returned pointer is held. Returns nullptr if not found.
+    [[nodiscard]] auto find(std::string_view name) const -> std::shared_ptr<Tool>;
+
+    /// The currently published name map.
+    [[nodiscard]] auto snapshot() const -> std::shared_ptr<const ToolMap>;
+
     /// Return definitions for all registered tools.
     [[nodiscard]] auto list() const -> std::vector<ToolDefinition>;
 
@@ -67,7 +92,13 @@ public:
     void clear();
 
 private:
-    std::unordered_map<std::string, std::unique_ptr<Tool>> tools_;
+    /// Copies the published map, lets `change` edit the copy and publishes
+    /// it. Writers are serialized; readers never wait.
+    template <typename Change>
+    void update(Change&& change);
+
+    std::atomic<std::shared_ptr<const ToolMap>> tools_;
+    std::mutex write_mutex_;
 };
 
 } // namespace openclaw::agent
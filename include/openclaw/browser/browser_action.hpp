@@ -1,6 +1,9 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -11,6 +14,7 @@
 #include <nlohmann/json.hpp>
 
 #include "openclaw/browser/cdp_client.hpp"
+#include "openclaw/browser/screenshot.hpp"
 #include "openclaw/core/error.hpp"
 
 namespace openclaw::browser {
@@ -26,10 +30,23 @@ struct NavigateOptions {
 
 /// Options for screenshot capture.
 struct ScreenshotOptions {
-    std::string format = "png";  // "png" or "jpeg"
-    int quality = 80;            // JPEG quality (ignored for PNG)
+    std::string format = "png";  // "png", "jpeg", "webp" or "auto" (WebP)
+    int quality = 80;            // JPEG/WebP quality (ignored for PNG)
     bool full_page = false;
     std::optional<json> clip;    // { x, y, width, height } region
+    /// Render at most this size and re-encode until under its byte limit.
+    /// Without a budget the region is captured at full resolution.
+    std::optional<ImageBudget> budget;
+};
+
+/// A captured screenshot.
+struct Screenshot {
+    std::string data;  // base64-encoded image, as returned by CDP
+    std::string format;
+    int width = 0;     // Output pixels
+    int height = 0;
+    size_t bytes = 0;  // Decoded size of `data`
+    int attempts = 1;  // Captures needed to meet the budget
 };
 
 /// Options for element interaction.
@@ -48,7 +65,6 @@ struct TypeOptions {
 /// Options for waiting.
 struct WaitOptions {
     int timeout_ms = 30000;
-    int polling_ms = 100;
 };
 
 /// Result of evaluating JavaScript in the browser context.
@@ -68,10 +84,19 @@ struct ElementInfo {
 
 /// High-level browser automation actions.
 /// Wraps CDP commands into ergonomic methods for navigation, interaction, and extraction.
+///
+/// Waits are event-driven rather than polled: navigation tracks the main
+/// frame's `Page.lifecycleEvent`s (and `Page.frameStoppedLoading`), and
+/// wait_for() installs a MutationObserver that reports back through a
+/// `Runtime.addBinding` binding, so a wait resumes as soon as its
+/// condition holds.
 class BrowserAction {
 public:
     explicit BrowserAction(CdpClient& cdp);
-    ~BrowserAction() = default;
+    ~BrowserAction();
+
+    BrowserAction(const BrowserAction&) = delete;
+    BrowserAction& operator=(const BrowserAction&) = delete;
 
     // -- Navigation --
 
@@ -128,9 +153,11 @@ public:
 
     // -- Extraction --
 
-    /// Take a screenshot of the page.
+    /// Take a screenshot of the page. With a budget, Chrome renders the
+    /// clip directly at the target size and lossy formats are re-captured
+    /// at lower quality (then smaller) until the image fits `max_bytes`.
     auto screenshot(const ScreenshotOptions& options = {})
-        -> awaitable<Result<std::string>>;  // base64-encoded image data
+        -> awaitable<Result<Screenshot>>;
 
     /// Get the text content of an element.
     auto get_text(std::string_view selector) -> awaitable<Result<std::string>>;
@@ -165,14 +192,27 @@ public:
     auto wait_for(std::string_view selector, const WaitOptions& options = {})
         -> awaitable<Result<void>>;
 
-    /// Wait for navigation to complete.
-    auto wait_for_navigation(int timeout_ms = 30000)
+    /// Wait until the current main-frame document reaches `wait_until`
+    /// ("load", "domcontentloaded", "networkidle0" or "networkidle2").
+    auto wait_for_navigation(int timeout_ms = 30000,
+                             std::string_view wait_until = "load")
         -> awaitable<Result<void>>;
 
     /// Wait for a fixed duration in milliseconds.
     auto wait(int ms) -> awaitable<void>;
 
 private:
+    struct WaitState;
+    using Deadline = std::chrono::steady_clock::time_point;
+
+    /// Enables lifecycle events and the wait binding on first use.
+    auto enable_waits() -> awaitable<Result<void>>;
+
+    /// Suspends until `ready()` holds, re-checking after every lifecycle
+    /// or binding event. Returns false at the deadline.
+    auto wait_until(std::function<bool()> ready, Deadline deadline)
+        -> awaitable<bool>;
+
     auto resolve_selector(std::string_view selector) -> awaitable<Result<int>>;
     auto get_box_model(int node_id) -> awaitable<Result<json>>;
     auto dispatch_mouse_event(std::string_view type, double x, double y,
@@ -180,6 +220,8 @@ private:
         -> awaitable<Result<void>>;
 
     CdpClient& cdp_;
+    std::shared_ptr<WaitState> waits_;
+    std::vector<ListenerId> listeners_;
 };
 
 } // namespace openclaw::browser
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
@@ -13,8 +14,12 @@
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/use_awaitable.hpp>
+#include <nlohmann/json.hpp>
 
 #include "openclaw/browser/cdp_client.hpp"
+#include "openclaw/browser/page_cache.hpp"
+#include "openclaw/browser/request_interceptor.hpp"
+#include "openclaw/browser/snapshot_diff.hpp"
 #include "openclaw/core/config.hpp"
 #include "openclaw/core/error.hpp"
 
@@ -22,7 +27,8 @@ namespace openclaw::browser {
 
 using boost::asio::awaitable;
 
-/// Represents a single managed browser instance.
+/// Represents a single managed Chrome process.
+/// `cdp` is the browser-level DevTools connection used to manage contexts.
 struct BrowserInstance {
     std::string id;
     std::unique_ptr<CdpClient> cdp;
@@ -33,12 +39,71 @@ struct BrowserInstance {
 #else
     pid_t pid = 0;
 #endif
-    bool in_use = false;
+    std::filesystem::path user_data_dir;  // Removed once the process is gone
+    size_t leased = 0;      // Context slots handed out (or being set up)
+    bool healthy = true;    // Cleared when a health check fails
     int64_t last_used = 0;
 };
 
-/// Pool manager for Chrome browser instances.
-/// Handles launching, reusing, and closing Chrome processes with CDP.
+/// An isolated browsing session: one browser context (separate cookies,
+/// storage and cache) with a single page target inside a shared Chrome
+/// process. `cdp` is a flat session on the process's browser connection,
+/// attached to the page target.
+///
+/// The pool hands sessions out as shared pointers. A closed or released
+/// session is disposed once the last caller still holding it lets go, so a
+/// request in flight keeps its session alive across `co_await`.
+struct BrowserSession {
+    std::string id;
+    std::string owner;               // Connection that opened it; empty for internal use
+    std::string instance_id;         // Owning Chrome process
+    std::string browser_context_id;
+    std::string target_id;
+    std::unique_ptr<CdpClient> cdp;
+    std::unique_ptr<SnapshotTracker> snapshots;  // Created on first use
+    std::unique_ptr<RequestInterceptor> network;  // Enforces the network profile
+    int64_t created_at = 0;
+    int64_t last_used = 0;
+};
+
+/// Point-in-time counters for pool health and latency.
+struct BrowserPoolStats {
+    size_t processes = 0;       // Running Chrome processes
+    size_t idle_processes = 0;  // Processes with no leased contexts
+    size_t launching = 0;       // Launches in flight
+    size_t sessions = 0;        // Sessions handed out to callers
+    size_t capacity = 0;        // pool_size * contexts_per_browser
+    size_t waiters = 0;         // Callers queued in acquire()
+    uint64_t acquires = 0;          // Successful acquisitions
+    uint64_t acquire_waits = 0;     // Acquisitions that had to queue
+    uint64_t acquire_timeouts = 0;  // Queued acquisitions that timed out
+    int64_t acquire_wait_total_ms = 0;
+    int64_t acquire_wait_max_ms = 0;
+    uint64_t launches = 0;          // Successful Chrome launches
+    uint64_t launch_failures = 0;
+    int64_t launch_total_ms = 0;
+    int64_t launch_max_ms = 0;
+    uint64_t contexts_created = 0;
+    uint64_t contexts_disposed = 0;
+    uint64_t health_check_failures = 0;
+    uint64_t restarts = 0;          // Unhealthy processes replaced
+};
+
+void to_json(nlohmann::json& j, const BrowserPoolStats& s);
+
+/// Pool manager for Chrome browser processes and the sessions inside them.
+///
+/// Each caller gets its own browser context (`Target.createBrowserContext`)
+/// with a page target, so up to `contexts_per_browser` isolated sessions
+/// share one Chrome process. Contexts are disposed on release, which wipes
+/// their cookies and storage and returns the slot to the process.
+///
+/// Launches never block the event loop: Chrome is spawned and its DevTools
+/// endpoint discovered with asynchronous reads and timers. When every slot
+/// is taken, acquire() queues the caller in FIFO order until a slot frees
+/// or `acquire_timeout_ms` elapses. Up to `prewarm_count` idle processes are
+/// kept launched ahead of demand, and processes failing a periodic health
+/// check are killed and replaced.
 class BrowserPool {
 public:
     BrowserPool(boost::asio::io_context& ioc, const BrowserConfig& config);
@@ -49,32 +114,80 @@ public:
     BrowserPool(BrowserPool&&) noexcept;
     BrowserPool& operator=(BrowserPool&&) noexcept;
 
-    /// Acquire a browser instance from the pool.
-    /// Launches a new Chrome process if the pool is empty and below max capacity.
-    auto acquire() -> awaitable<Result<BrowserInstance*>>;
-
-    /// Release a browser instance back to the pool.
-    void release(BrowserInstance* instance);
-
-    /// Close a specific browser instance and remove it from the pool.
-    auto close(std::string_view instance_id) -> awaitable<Result<void>>;
-
-    /// Close all browser instances in the pool.
+    /// Acquire an isolated session.
+    /// Uses a free context slot immediately if one exists; otherwise queues
+    /// the caller (launching a new Chrome process if below max capacity)
+    /// and fails with ErrorCode::Timeout after `acquire_timeout_ms`.
+    /// `owner` names the connection the session belongs to.
+    auto acquire(std::string owner = {})
+        -> awaitable<Result<std::shared_ptr<BrowserSession>>>;
+
+    /// Release a session. Once no caller holds it, its browser context is
+    /// disposed in the background and the slot handed to the oldest queued
+    /// waiter, if any.
+    void release(const std::shared_ptr<BrowserSession>& session);
+
+    /// Look up a session handed out by acquire() to `owner`; nullptr if
+    /// there is none or it belongs to someone else.
+    [[nodiscard]] auto find(std::string_view session_id, std::string_view owner = {})
+        -> std::shared_ptr<BrowserSession>;
+
+    /// Start launching idle processes up to `prewarm_count` and begin
+    /// periodic health checks.
+    void prewarm();
+
+    /// Release `owner`'s session by id, disposing its browser context once
+    /// requests still using it finish.
+    auto close(std::string_view session_id, std::string_view owner = {})
+        -> awaitable<Result<void>>;
+
+    /// Close all sessions and browser processes in the pool.
     auto close_all() -> awaitable<void>;
 
-    /// Returns the number of active (in-use) instances.
+    /// Returns the number of sessions currently handed out.
     [[nodiscard]] auto active_count() const -> size_t;
 
-    /// Returns the total number of instances (active + idle).
+    /// Returns the number of running Chrome processes.
     [[nodiscard]] auto total_count() const -> size_t;
 
-    /// Returns the maximum pool size.
+    /// Extracted-page cache shared by all sessions; nullptr unless
+    /// `page_cache_bytes` is set.
+    [[nodiscard]] auto page_cache() -> PageCache*;
+
+    /// FetchGuard for `ssrf_policy`, as enforced on every session.
+    [[nodiscard]] auto fetch_guard() const -> infra::FetchGuard;
+
+    /// The io_context sessions and their CDP connections run on.
+    [[nodiscard]] auto io_context() const -> boost::asio::io_context&;
+
+    /// Returns the maximum number of concurrent sessions.
     [[nodiscard]] auto max_size() const -> size_t;
 
+    /// Returns occupancy, acquire-wait, launch-time and health counters.
+    [[nodiscard]] auto stats() const -> BrowserPoolStats;
+
+    /// Builds the named network profile ("" for `network_profile`) with the
+    /// configured size cap and blocked domains; nullopt for unknown names.
+    [[nodiscard]] auto network_profile(std::string_view name = {}) const
+        -> std::optional<NetworkProfile>;
+
 private:
-    auto launch_browser() -> Result<std::unique_ptr<BrowserInstance>>;
+    auto launch_browser() -> awaitable<Result<std::shared_ptr<BrowserInstance>>>;
+    auto launch_and_admit() -> awaitable<void>;
+    auto open_session(std::shared_ptr<BrowserInstance> instance)
+        -> awaitable<Result<std::unique_ptr<BrowserSession>>>;
+    auto dispose_session(std::unique_ptr<BrowserSession> session)
+        -> awaitable<void>;
+    auto share_session(std::unique_ptr<BrowserSession> session)
+        -> std::shared_ptr<BrowserSession>;
+    auto health_check_loop() -> awaitable<void>;
+    auto check_instance(std::shared_ptr<BrowserInstance> instance)
+        -> awaitable<bool>;
+    void return_slot_locked(const std::string& instance_id);
+    void replenish_locked();
     auto find_chrome() const -> std::string;
-    auto get_ws_endpoint(int debug_port) -> Result<std::string>;
+    auto get_ws_endpoint(int debug_port, BrowserInstance& process)
+        -> awaitable<Result<std::string>>;
     auto allocate_debug_port() -> int;
 
     struct Impl;
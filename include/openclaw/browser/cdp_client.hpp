@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/io_context.hpp>
@@ -22,8 +23,24 @@ using json = nlohmann::json;
 /// Callback type for CDP event subscriptions.
 using EventHandler = std::function<void(json)>;
 
+/// Identifies a handler registered with CdpClient::listen().
+using ListenerId = uint64_t;
+
+/// A CDP command for pipelined submission via CdpClient::send_many().
+struct CdpCommand {
+    std::string method;
+    json params = json::object();
+};
+
 /// Chrome DevTools Protocol WebSocket client.
 /// Communicates with a Chrome/Chromium instance over the CDP WebSocket interface.
+///
+/// A client created by connect() owns the WebSocket. attach() returns
+/// flat-mode session clients (`Target.attachToTarget {flatten: true}`) that
+/// share that WebSocket: their commands carry a `sessionId` and they only
+/// receive events for their session, so many targets need one connection.
+/// Commands are written in submission order and their responses matched by
+/// id, so independent commands can be pipelined with send_many().
 class CdpClient {
 public:
     explicit CdpClient(boost::asio::io_context& ioc);
@@ -37,19 +54,42 @@ public:
     /// Connect to the Chrome DevTools WebSocket endpoint.
     auto connect(std::string_view ws_url) -> awaitable<Result<void>>;
 
+    /// Attach to a target in flat mode over this client's connection.
+    /// The returned client routes commands and events through `sessionId`;
+    /// disconnecting it detaches from the target.
+    auto attach(std::string_view target_id)
+        -> awaitable<Result<std::unique_ptr<CdpClient>>>;
+
     /// Send a CDP command and await its result.
     /// method: CDP method name (e.g. "Page.navigate", "Runtime.evaluate").
     /// params: optional JSON parameters for the command.
     auto send_command(std::string_view method, json params = {})
         -> awaitable<Result<json>>;
 
+    /// Send independent commands back-to-back, then await all responses.
+    /// Costs one round trip instead of one per command; past 256 commands
+    /// each new one waits for the oldest response, so any number can be
+    /// sent. Results are in the order of `commands`; one command failing
+    /// does not affect the others.
+    auto send_many(std::vector<CdpCommand> commands)
+        -> awaitable<std::vector<Result<json>>>;
+
     /// Subscribe to a CDP event. The handler is called each time the event fires.
     void subscribe(std::string_view event, EventHandler handler);
 
     /// Unsubscribe from a CDP event.
     void unsubscribe(std::string_view event);
 
-    /// Disconnect from the Chrome DevTools endpoint.
+    /// Add a handler for a CDP event alongside any others. Unlike
+    /// subscribe(), listeners never replace each other, so components that
+    /// watch the same event (e.g. Page.lifecycleEvent) can coexist.
+    auto listen(std::string_view event, EventHandler handler) -> ListenerId;
+
+    /// Remove a handler added with listen().
+    void unlisten(ListenerId id);
+
+    /// Disconnect from the Chrome DevTools endpoint
+    /// (or detach from the target, for a session client).
     auto disconnect() -> awaitable<void>;
 
     /// Returns true if the client is currently connected.
@@ -58,7 +98,13 @@ public:
     /// Get the WebSocket URL this client is connected to.
     [[nodiscard]] auto ws_url() const -> std::string_view;
 
+    /// Flat-mode session id; empty for the client that owns the WebSocket.
+    [[nodiscard]] auto session_id() const -> std::string_view;
+
 private:
+    struct Transport;
+    CdpClient(std::shared_ptr<Transport> transport, std::string session_id);
+
     struct Impl;
     std::unique_ptr<Impl> impl_;
 };
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "openclaw/browser/snapshot.hpp"
+#include "openclaw/core/error.hpp"
+
+namespace openclaw::browser {
+
+using json = nlohmann::json;
+
+/// Layout rectangle of a rendered node, in CSS pixels.
+struct DomRect {
+    double x = 0;
+    double y = 0;
+    double width = 0;
+    double height = 0;
+};
+
+/// A name/value attribute pair viewing the snapshot's string table.
+struct DomAttribute {
+    std::string_view name;
+    std::string_view value;
+};
+
+/// One node of a decoded DOMSnapshot document.
+/// Strings are views into the snapshot's string table; tree links are
+/// indices into FlatDomSnapshot::nodes() (-1 when absent).
+struct FlatDomNode {
+    std::string_view name;   // nodeName: "DIV", "#text", "#document", ...
+    std::string_view value;  // nodeValue: the text of text/comment nodes
+    int32_t parent = -1;
+    int32_t first_child = -1;
+    int32_t next_sibling = -1;
+    int32_t depth = 0;
+    int32_t layout = -1;     // Index into the bounds table; -1 if not rendered
+    int32_t backend_id = 0;  // backendNodeId: stable across snapshots of a page
+    uint32_t attr_begin = 0;
+    uint32_t attr_count = 0;
+    uint8_t type = 0;        // DOM nodeType: 1 element, 3 text, 9 document, ...
+};
+
+/// Flat, read-only view of a `DOMSnapshot.captureSnapshot` result.
+///
+/// The column arrays of the CDP response are resolved once and decoded in
+/// a single pass into contiguous node, attribute and bounds arrays, with
+/// no per-node map lookups and no string copies. The snapshot owns the CDP
+/// response, so its string views stay valid for the snapshot's lifetime
+/// (including across moves).
+class FlatDomSnapshot {
+public:
+    /// Parameters for the `DOMSnapshot.captureSnapshot` command to decode.
+    static auto capture_params() -> json;
+
+    /// Decodes the first document of a DOMSnapshot.captureSnapshot result.
+    static auto decode(json result) -> Result<FlatDomSnapshot>;
+
+    /// All nodes in document order; index 0 is the document node.
+    [[nodiscard]] auto nodes() const -> std::span<const FlatDomNode> {
+        return nodes_;
+    }
+
+    [[nodiscard]] auto size() const -> size_t { return nodes_.size(); }
+
+    [[nodiscard]] auto attributes(const FlatDomNode& node) const
+        -> std::span<const DomAttribute>;
+
+    /// Value of the named attribute, or empty if the node doesn't have it.
+    [[nodiscard]] auto attribute(const FlatDomNode& node,
+                                 std::string_view name) const
+        -> std::string_view;
+
+    [[nodiscard]] auto has_attribute(const FlatDomNode& node,
+                                     std::string_view name) const -> bool;
+
+    /// Layout box of the node, if it was rendered.
+    [[nodiscard]] auto bounds(const FlatDomNode& node) const
+        -> std::optional<DomRect>;
+
+    /// Builds the nested DomNode tree rooted at the document node.
+    [[nodiscard]] auto to_dom_node(const SnapshotOptions& options = {}) const
+        -> DomNode;
+
+    /// Whether the node (and so its subtree) is page content under
+    /// `options`: not a script/style/head element, not whitespace-only
+    /// text, not past `max_depth`, and unless `include_hidden`, neither
+    /// hidden (`hidden`, `aria-hidden`) nor unrendered text.
+    [[nodiscard]] auto is_content(const FlatDomNode& node,
+                                  const SnapshotOptions& options) const -> bool;
+
+    /// Renders the page (or the subtree at `root`) as readable text: one
+    /// line per block element, headings and list items marked, non-content
+    /// subtrees skipped.
+    [[nodiscard]] auto to_text(const SnapshotOptions& options = {},
+                               int32_t root = 0) const -> std::string;
+
+private:
+    json source_;  // Owns the strings the views point into
+    std::vector<FlatDomNode> nodes_;
+    std::vector<DomAttribute> attributes_;
+    std::vector<DomRect> bounds_;
+};
+
+} // namespace openclaw::browser
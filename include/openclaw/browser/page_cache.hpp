@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+
+namespace openclaw::browser {
+
+using json = nlohmann::json;
+
+/// The Cache-Control directives PageCache acts on.
+struct CacheControl {
+    bool no_store = false;
+    bool no_cache = false;            // Revalidate before every reuse
+    bool is_private = false;          // Not for a cache shared across sessions
+    std::optional<int64_t> max_age;   // Seconds; s-maxage wins over max-age
+};
+
+/// Parses a Cache-Control header value (directives are case-insensitive).
+[[nodiscard]] auto parse_cache_control(std::string_view header) -> CacheControl;
+
+/// Canonical form of a URL for cache keys: lower-cased scheme and host,
+/// default port and fragment dropped, "/" for an empty path, and
+/// click-tracking query parameters (utm_*, gclid, fbclid) removed.
+[[nodiscard]] auto normalize_url(std::string_view url) -> std::string;
+
+/// Extracted content of one page, as served to read-only tools.
+struct CachedPage {
+    std::string final_url;
+    std::string title;
+    std::string content;        // Text or sanitized HTML
+    std::string etag;           // Validators of the main document response
+    std::string last_modified;
+    int64_t stored_at_ms = 0;
+    int64_t expires_at_ms = 0;  // Fresh until then
+    bool revalidate = false;    // no-cache: always revalidate first
+
+    [[nodiscard]] auto has_validators() const -> bool {
+        return !etag.empty() || !last_modified.empty();
+    }
+    [[nodiscard]] auto bytes() const -> size_t;
+};
+
+/// Cumulative cache counters.
+struct PageCacheStats {
+    size_t entries = 0;
+    size_t bytes = 0;
+    size_t max_bytes = 0;
+    uint64_t hits = 0;         // Served fresh
+    uint64_t revalidated = 0;  // Served after a 304
+    uint64_t misses = 0;
+    uint64_t stores = 0;
+    uint64_t evictions = 0;
+};
+
+void to_json(json& j, const PageCacheStats& s);
+
+/// LRU cache of extracted pages under one byte budget, shared by every
+/// session of a BrowserPool. Freshness follows the main document's
+/// Cache-Control (s-maxage, then max-age, else `default_ttl_ms`); stale
+/// entries with an ETag or Last-Modified can be revalidated with a
+/// conditional request instead of a browser load.
+class PageCache {
+public:
+    PageCache(size_t max_bytes, int64_t default_ttl_ms);
+
+    /// Result of lookup(): a copy of the entry and whether it is fresh.
+    struct Lookup {
+        CachedPage page;
+        bool fresh = false;
+    };
+
+    /// Finds `key` and marks it most recently used. Stale entries without
+    /// validators are dropped and reported as misses.
+    [[nodiscard]] auto lookup(const std::string& key, int64_t now_ms)
+        -> std::optional<Lookup>;
+
+    /// Stores a page unless `control` forbids it (no-store, private) or it
+    /// alone exceeds the budget, evicting least recently used entries.
+    /// Returns true if stored.
+    auto store(const std::string& key, CachedPage page,
+               const CacheControl& control, int64_t now_ms) -> bool;
+
+    /// Renews a stale entry after the origin answered 304 Not Modified.
+    void refresh(const std::string& key, const CacheControl& control,
+                 int64_t now_ms);
+
+    /// Counts a lookup that could not be served from the cache.
+    void record_miss();
+
+    void erase(const std::string& key);
+
+    [[nodiscard]] auto stats() const -> PageCacheStats;
+
+    /// Key for `url` extracted as `format` ("text", "html").
+    [[nodiscard]] static auto key(std::string_view url, std::string_view format)
+        -> std::string;
+
+private:
+    struct Entry {
+        std::string key;
+        CachedPage page;
+    };
+
+    auto expiry(const CacheControl& control, int64_t now_ms) const -> int64_t;
+    void erase_locked(std::list<Entry>::iterator it);
+
+    mutable std::mutex mutex_;
+    size_t max_bytes_;
+    int64_t default_ttl_ms_;
+    std::list<Entry> lru_;  // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    PageCacheStats stats_;
+};
+
+} // namespace openclaw::browser
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <nlohmann/json.hpp>
+
+#include "openclaw/browser/browser_pool.hpp"
+#include "openclaw/infra/fetch_guard.hpp"
+
+namespace openclaw::browser {
+
+using boost::asio::awaitable;
+using json = nlohmann::json;
+
+/// Options for PageFetcher::fetch_many().
+struct FetchManyOptions {
+    size_t concurrency = 4;            // Pages loading at once (capped by the pool)
+    int timeout_ms = 15000;            // Per URL: navigation plus extraction
+    std::string wait_until = "domcontentloaded";
+    std::string profile;               // Network profile; empty = pool default
+    std::string format = "text";       // "text" or "html" (sanitized)
+    size_t max_chars = 0;              // Per-page content cap; 0 = unlimited
+    bool use_cache = true;             // Consult the pool's page cache, if any
+};
+
+/// Outcome of fetching one URL.
+struct PageFetchResult {
+    size_t index = 0;       // Position in the requested URL list
+    std::string url;        // As requested
+    std::string final_url;  // After redirects
+    std::string title;
+    std::string content;    // Text or sanitized HTML, per FetchManyOptions::format
+    bool truncated = false;
+    bool cached = false;    // Served from the page cache, without a browser
+    std::string error;      // Empty on success
+    int64_t elapsed_ms = 0;
+
+    [[nodiscard]] auto ok() const -> bool { return error.empty(); }
+};
+
+void to_json(json& j, const PageFetchResult& r);
+
+/// Loads many URLs in parallel across pooled browser contexts.
+///
+/// Each URL is checked by the pool's FetchGuard, loaded in its own session
+/// (with the requested network profile) and extracted with
+/// Snapshot::to_text_representation(), or as HTML passed through
+/// FetchGuard::sanitize_html_content(). At most `concurrency` sessions are
+/// held at once; every session is released as soon as its page is read.
+///
+/// With a PageCache on the pool, fresh pages are answered from it without
+/// acquiring a session, and stale ones are first revalidated with a
+/// conditional GET (If-None-Match / If-Modified-Since).
+///
+/// acquire_session() and load_and_extract() are virtual so that tests can
+/// stand in for Chrome.
+class PageFetcher {
+public:
+    /// Called as each URL completes, in completion order.
+    using ResultCallback = std::function<void(const PageFetchResult&)>;
+
+    /// Uses the pool's io_context and SSRF policy.
+    explicit PageFetcher(BrowserPool& pool);
+    virtual ~PageFetcher() = default;
+
+    PageFetcher(const PageFetcher&) = delete;
+    PageFetcher& operator=(const PageFetcher&) = delete;
+
+    /// Fetch `urls`; results are returned in request order.
+    auto fetch_many(std::vector<std::string> urls, FetchManyOptions options,
+                    ResultCallback on_result = {})
+        -> awaitable<std::vector<PageFetchResult>>;
+
+    /// Fetch a single URL in a session of its own.
+    auto fetch_one(std::string url, const FetchManyOptions& options)
+        -> awaitable<PageFetchResult>;
+
+protected:
+    /// Status and headers of the main document response.
+    struct DocumentResponse {
+        int status = 0;
+        json headers = json::object();
+    };
+
+    /// A session of its own for one URL, from the pool.
+    virtual auto acquire_session()
+        -> awaitable<Result<std::shared_ptr<BrowserSession>>>;
+
+    /// Navigates `session` to `url` and fills in `result` and `document`.
+    virtual auto load_and_extract(BrowserSession& session, const std::string& url,
+                                  const FetchManyOptions& options, PageFetchResult& result,
+                                  DocumentResponse& document)
+        -> awaitable<Result<void>>;
+
+private:
+    struct Wave;
+
+    /// Fetches the wave's URLs one after another until none are left.
+    auto run_worker(std::shared_ptr<Wave> wave) -> awaitable<void>;
+
+    /// Serves `url` from the cache if it is fresh or still valid upstream.
+    auto from_cache(const std::string& key, PageFetchResult& result)
+        -> awaitable<bool>;
+
+    boost::asio::io_context& ioc_;
+    BrowserPool& pool_;
+    infra::FetchGuard guard_;
+};
+
+} // namespace openclaw::browser
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <nlohmann/json.hpp>
+
+#include "openclaw/browser/cdp_client.hpp"
+#include "openclaw/core/error.hpp"
+#include "openclaw/infra/fetch_guard.hpp"
+
+namespace openclaw::browser {
+
+using boost::asio::awaitable;
+using json = nlohmann::json;
+
+/// Which subresources a session loads.
+struct NetworkProfile {
+    std::string name = "full";
+    bool block_images = false;
+    bool block_media = false;
+    bool block_fonts = false;
+    bool block_trackers = false;
+    size_t max_response_bytes = 0;            // 0 = unlimited
+    std::vector<std::string> blocked_domains;  // In addition to built-in trackers
+
+    /// Built-in profiles: "full" loads everything; "text" skips images,
+    /// media, fonts and trackers (stylesheets still load, since hidden-
+    /// content detection depends on them).
+    [[nodiscard]] static auto named(std::string_view name)
+        -> std::optional<NetworkProfile>;
+
+    /// True if nothing is blocked or capped.
+    [[nodiscard]] auto is_passthrough() const -> bool;
+};
+
+/// Why a request was refused.
+enum class BlockReason { None, ResourceType, Tracker };
+
+/// Decides whether a request is blocked by the profile alone (no I/O).
+/// `resource_type` is a CDP Network.ResourceType ("Image", "Font", ...).
+[[nodiscard]] auto classify_request(const NetworkProfile& profile,
+                                    std::string_view resource_type,
+                                    std::string_view url) -> BlockReason;
+
+/// True if `host` is, or is a subdomain of, a built-in tracker/ad domain
+/// or one of `extra`.
+[[nodiscard]] auto is_tracker_host(std::string_view host,
+                                   const std::vector<std::string>& extra = {})
+    -> bool;
+
+/// Lower-cased host of an absolute URL, without userinfo or port;
+/// empty for URLs without an authority (data:, blob:, about:).
+[[nodiscard]] auto url_host(std::string_view url) -> std::string;
+
+/// True for data: and blob: URLs, which never reach the network. Every
+/// other request must have a host for the SSRF check to pass.
+[[nodiscard]] auto is_local_scheme(std::string_view url) -> bool;
+
+/// Per-session network counters.
+struct NetworkStats {
+    uint64_t requests = 0;         // Requests paused by the interceptor
+    uint64_t blocked_type = 0;     // Images, media, fonts
+    uint64_t blocked_tracker = 0;
+    uint64_t blocked_ssrf = 0;     // Refused by FetchGuard, or without a host
+    uint64_t blocked_size = 0;     // Responses over max_response_bytes
+    uint64_t bytes_received = 0;   // Encoded bytes loaded (Network.loadingFinished)
+    uint64_t bytes_saved = 0;      // Declared sizes of responses cut by the cap
+    uint64_t page_loads = 0;
+    int64_t last_load_ms = 0;
+    int64_t total_load_ms = 0;
+};
+
+void to_json(json& j, const NetworkStats& s);
+
+/// Enforces a NetworkProfile on one page through CDP `Fetch` interception.
+///
+/// Requests are paused at the request stage and failed with
+/// `BlockedByClient` when their type or host is blocked, or when FetchGuard
+/// refuses the host (SSRF checks on every subresource, cached per host).
+/// With `max_response_bytes` set, responses are also paused at the
+/// response stage and cut when their Content-Length exceeds the cap.
+/// Interception is disabled entirely when the profile blocks nothing and
+/// the guard allows private networks.
+class RequestInterceptor {
+public:
+    RequestInterceptor(boost::asio::io_context& ioc, CdpClient& cdp,
+                       infra::FetchGuard guard);
+    ~RequestInterceptor();
+
+    RequestInterceptor(const RequestInterceptor&) = delete;
+    RequestInterceptor& operator=(const RequestInterceptor&) = delete;
+
+    /// Switch to `profile`, enabling or disabling interception as needed.
+    auto apply(NetworkProfile profile) -> awaitable<Result<void>>;
+
+    [[nodiscard]] auto profile() const -> const NetworkProfile&;
+    [[nodiscard]] auto stats() const -> NetworkStats;
+
+private:
+    struct State;
+
+    /// Resolves one paused request: fail it, or let it continue.
+    static auto handle_paused(std::shared_ptr<State> state, json params)
+        -> awaitable<void>;
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace openclaw::browser
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+
+#include "openclaw/core/config.hpp"
+
+namespace openclaw::browser {
+
+using json = nlohmann::json;
+
+/// Size limits for images handed to models (from ImageConfig).
+struct ImageBudget {
+    int max_dimension_px = 1200;          // Longest side of the output image
+    size_t max_bytes = 5 * 1024 * 1024;   // Encoded size
+
+    [[nodiscard]] static auto from_config(const ImageConfig& config) -> ImageBudget;
+};
+
+/// A page region in CSS pixels (document coordinates).
+struct CaptureRegion {
+    double x = 0;
+    double y = 0;
+    double width = 0;
+    double height = 0;
+};
+
+/// Parameters of one Page.captureScreenshot attempt.
+/// Chrome renders the clip at `scale`, so the output is
+/// region * scale * device_scale pixels without a separate resize pass.
+struct CapturePlan {
+    CaptureRegion region;
+    double scale = 1.0;
+    double device_scale = 1.0;  // Device pixels per CSS pixel
+    std::string format = "webp";  // "png", "jpeg" or "webp"
+    int quality = 80;             // Ignored for PNG
+
+    [[nodiscard]] auto output_width() const -> int;
+    [[nodiscard]] auto output_height() const -> int;
+    [[nodiscard]] auto to_params() const -> json;
+};
+
+/// Lowest quality refine_capture() goes to before it starts downscaling.
+inline constexpr int kMinScreenshotQuality = 30;
+
+/// Output side below which refine_capture() gives up.
+inline constexpr int kMinScreenshotDimension = 256;
+
+/// Chooses the clip scale that fits `region` into the budget's longest
+/// side. `format` "auto" (or empty) picks WebP.
+[[nodiscard]] auto plan_capture(CaptureRegion region, double device_scale,
+                                std::string_view format, int quality,
+                                const ImageBudget& budget) -> CapturePlan;
+
+/// Next attempt after `plan` encoded to `bytes` bytes, over the budget.
+/// Lossy formats first lower their quality in proportion to the overshoot,
+/// then shrink; PNG can only shrink. Returns nullopt when the image cannot
+/// get smaller without dropping below kMinScreenshotDimension.
+[[nodiscard]] auto refine_capture(const CapturePlan& plan, size_t bytes,
+                                  const ImageBudget& budget)
+    -> std::optional<CapturePlan>;
+
+/// Decoded length of a padded base64 string, without decoding it.
+[[nodiscard]] auto base64_decoded_size(std::string_view data) -> size_t;
+
+} // namespace openclaw::browser
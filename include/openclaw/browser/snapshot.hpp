@@ -73,6 +73,11 @@ public:
     auto extract_text(std::string_view selector)
         -> awaitable<Result<std::string>>;
 
+    /// Render the page text (headings, list items, one line per block)
+    /// straight from a DOM snapshot, without building a DomNode tree.
+    auto capture_dom_text(const SnapshotOptions& options = {})
+        -> awaitable<Result<std::string>>;
+
     /// Get a simplified, LLM-friendly text representation of the page.
     /// Combines accessibility tree roles, names, and text into a readable format.
     auto to_text_representation(const SnapshotOptions& options = {})
@@ -91,9 +96,14 @@ public:
         -> awaitable<Result<json>>;
 
 private:
-    auto build_dom_tree(const json& nodes, const json& strings, int index,
-                        int depth, const SnapshotOptions& options)
-        -> DomNode;
+    auto capture_document(const SnapshotOptions& options)
+        -> awaitable<Result<DomNode>>;
+    auto parse_dom_snapshot(json result, const SnapshotOptions& options)
+        -> Result<DomNode>;
+    auto parse_accessibility_tree(const json& result)
+        -> Result<AccessibilityNode>;
+    auto parse_links(const json& result)
+        -> std::vector<std::pair<std::string, std::string>>;
     auto build_accessibility_tree(const json& node) -> AccessibilityNode;
     auto flatten_text(const DomNode& node) -> std::string;
     auto render_accessibility_node(const AccessibilityNode& node, int indent)
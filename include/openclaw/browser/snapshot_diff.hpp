@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+#include <nlohmann/json.hpp>
+
+#include "openclaw/browser/cdp_client.hpp"
+#include "openclaw/browser/dom_snapshot.hpp"
+#include "openclaw/browser/snapshot.hpp"
+#include "openclaw/core/error.hpp"
+
+namespace openclaw::browser {
+
+using boost::asio::awaitable;
+using json = nlohmann::json;
+
+/// One content node of a page as remembered between snapshots.
+struct DigestNode {
+    int64_t id = 0;        // Stable id (backendNodeId); positional if absent
+    int64_t parent = 0;    // Stable id of the parent, 0 at the root
+    int32_t depth = 0;
+    std::string label;     // "H1", "#text", "[button] \"Submit\""
+    std::string text;      // The node's own text
+    std::string attrs;     // Semantic attributes, "href=/a; alt=Logo"
+};
+
+/// Document-ordered content nodes of a page, keyed by stable id.
+/// Small enough to keep per page and compare against the next capture.
+class PageDigest {
+public:
+    /// Content nodes of a DOM snapshot (see FlatDomSnapshot::is_content).
+    static auto from_dom(const FlatDomSnapshot& snapshot,
+                         const SnapshotOptions& options = {}) -> PageDigest;
+
+    /// Non-ignored nodes of an `Accessibility.getFullAXTree` result.
+    static auto from_accessibility(const json& result) -> PageDigest;
+
+    [[nodiscard]] auto nodes() const -> const std::vector<DigestNode>& {
+        return nodes_;
+    }
+    [[nodiscard]] auto size() const -> size_t { return nodes_.size(); }
+    [[nodiscard]] auto find(int64_t id) const -> const DigestNode*;
+
+    /// Text of the node at `id` and its descendants, space-separated.
+    [[nodiscard]] auto subtree_text(int64_t id) const -> std::string;
+
+    /// Indented outline, one node per line (used for accessibility pages).
+    [[nodiscard]] auto render() const -> std::string;
+
+private:
+    void add(DigestNode node);
+
+    std::vector<DigestNode> nodes_;
+    std::unordered_map<int64_t, size_t> index_;
+};
+
+/// Changes between two digests of the same page.
+/// Added and removed entries are reported at the topmost changed node only,
+/// carrying the text of the whole subtree.
+struct SnapshotDiff {
+    std::vector<json> added;
+    std::vector<json> removed;
+    std::vector<json> changed;
+    size_t touched = 0;  // Nodes involved, including inside added/removed subtrees
+
+    [[nodiscard]] auto empty() const -> bool { return touched == 0; }
+};
+
+void to_json(json& j, const SnapshotDiff& d);
+
+/// Compares two digests of a page.
+auto diff_digests(const PageDigest& before, const PageDigest& after)
+    -> SnapshotDiff;
+
+/// Which tree a SnapshotTracker diffs.
+enum class SnapshotSource { Dom, Accessibility };
+
+/// Options for SnapshotTracker::capture().
+struct SnapshotDiffOptions {
+    SnapshotSource source = SnapshotSource::Dom;
+    SnapshotOptions snapshot;
+    bool diff = true;             // false forces a full snapshot
+    double full_threshold = 0.5;  // Send full when this fraction of nodes changed
+    size_t max_mutations = 5000;  // Send full without diffing past this many events
+};
+
+/// Keeps the last snapshot of a page and returns compact diffs against it.
+///
+/// DOM mutation events (`DOM.childNodeInserted`, `attributeModified`, ...)
+/// are counted between captures. After `documentUpdated` (navigation) or
+/// more than `max_mutations` events capture() sends a full snapshot;
+/// otherwise it captures, diffs by stable node id and falls back to full
+/// when more than `full_threshold` of the page changed. With no events at
+/// all it answers "unchanged" without a round trip, as long as the DOM
+/// agent has reported every node: content inserted since the last full
+/// capture is not watched, so it is always re-captured until then.
+///
+/// Results are JSON objects with `mode` "full" (plus `text`), "diff" (plus
+/// `added`/`removed`/`changed`) or "unchanged".
+class SnapshotTracker {
+public:
+    explicit SnapshotTracker(CdpClient& cdp);
+    ~SnapshotTracker();
+
+    SnapshotTracker(const SnapshotTracker&) = delete;
+    SnapshotTracker& operator=(const SnapshotTracker&) = delete;
+
+    auto capture(const SnapshotDiffOptions& options = {})
+        -> awaitable<Result<json>>;
+
+    /// Forget the baseline; the next capture is full.
+    void reset();
+
+private:
+    auto watch_document() -> awaitable<Result<void>>;
+
+    struct MutationState {
+        std::atomic<uint64_t> mutations{0};
+        std::atomic<bool> document_changed{true};
+        std::atomic<bool> unwatched_nodes{true};  // Inserted since watch_document()
+    };
+
+    CdpClient& cdp_;
+    std::shared_ptr<MutationState> state_;
+    std::optional<PageDigest> baseline_;
+    SnapshotSource baseline_source_ = SnapshotSource::Dom;
+    std::vector<ListenerId> listeners_;  // Empty until the first capture
+};
+
+} // namespace openclaw::browser
@@ -22,4 +22,8 @@ void register_version_command(CLI::App& app);
 /// Connects to a running gateway and prints its status.
 void register_status_command(CLI::App& app, Config& config);
 
+/// Register the hidden `plugin-host` subcommand.
+/// Runs one isolated plugin in a child process spawned by the gateway.
+void register_plugin_host_command(CLI::App& app, Config& config);
+
 } // namespace openclaw::cli
@@ -17,11 +17,12 @@
 namespace openclaw {
 
 struct AuthConfig {
-    std::string method = "none";  // "none", "token", "tailscale"
+    std::string method = "none";  // "none", "token", "tailscale", "jwt"
     std::optional<std::string> token;
     std::optional<std::string> tailscale_authkey;
+    std::vector<std::string> jwt_secrets;  // HS256 keys, newest first; empty = use token
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(AuthConfig, method, token, tailscale_authkey)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(AuthConfig, method, token, tailscale_authkey, jwt_secrets)
 
 struct TlsConfig {
     std::string cert_file;
@@ -30,6 +31,15 @@ struct TlsConfig {
 };
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(TlsConfig, cert_file, key_file, ca_file)
 
+/// Flow control for streamed chat output.
+struct StreamConfig {
+    size_t run_buffer_bytes = 256 * 1024;          // Per run, between the provider and the gateway
+    size_t connection_buffer_bytes = 1024 * 1024;  // Per connection, queued for the socket
+    std::string policy = "coalesce";               // "pause", "coalesce" or "drop"
+    std::map<std::string, std::string> client_policies;  // connect clientMode -> policy
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(StreamConfig, run_buffer_bytes, connection_buffer_bytes, policy, client_policies)
+
 struct GatewayConfig {
     uint16_t port = 18789;
     BindMode bind = BindMode::Loopback;
@@ -37,8 +47,9 @@ struct GatewayConfig {
     std::optional<TlsConfig> tls;
     size_t max_connections = 100;
     std::string http_security_hsts;  // v2026.2.24: HSTS header value (empty = disabled)
+    StreamConfig stream;
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(GatewayConfig, port, bind, max_connections, http_security_hsts)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(GatewayConfig, port, bind, max_connections, http_security_hsts, stream)
 
 struct ProviderConfig {
     std::string name;
@@ -95,12 +106,22 @@ inline auto resolve_ssrf_allow_private(const SsrfPolicyConfig& policy) -> bool {
 
 struct BrowserConfig {
     bool enabled = false;
-    size_t pool_size = 2;
+    size_t pool_size = 2;               // Max Chrome processes
     std::optional<std::string> chrome_path;
     int timeout_ms = 30000;
     SsrfPolicyConfig ssrf_policy;
+    size_t prewarm_count = 0;           // Idle processes kept launched ahead of demand
+    int acquire_timeout_ms = 30000;     // Max time acquire() waits in the FIFO queue
+    int launch_timeout_ms = 15000;      // Max time to wait for the DevTools endpoint
+    size_t contexts_per_browser = 8;    // Isolated sessions sharing one process
+    int health_check_interval_ms = 30000;  // 0 disables process health checks
+    std::string network_profile = "full";  // "full" or "text" (no images/media/fonts/trackers)
+    size_t max_response_bytes = 0;      // Cut responses declaring more; 0 = unlimited
+    std::vector<std::string> blocked_domains;  // Always blocked, with subdomains
+    size_t page_cache_bytes = 0;        // Shared extracted-page cache; 0 = disabled
+    int page_cache_ttl_seconds = 600;   // Freshness when Cache-Control gives none
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(BrowserConfig, enabled, pool_size, chrome_path, timeout_ms, ssrf_policy)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(BrowserConfig, enabled, pool_size, chrome_path, timeout_ms, ssrf_policy, prewarm_count, acquire_timeout_ms, launch_timeout_ms, contexts_per_browser, health_check_interval_ms, network_profile, max_response_bytes, blocked_domains, page_cache_bytes, page_cache_ttl_seconds)
 
 struct SessionConfig {
     std::string store = "sqlite";
@@ -111,13 +132,43 @@ struct SessionConfig {
 };
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(SessionConfig, store, db_path, ttl_seconds, compaction_floor_tokens, thread_binding)
 
+/// Price of a model in USD per million tokens. `model` matches exactly or as
+/// a prefix ("claude-sonnet-4" covers its dated snapshots); the longest wins.
+struct ModelPriceConfig {
+    std::string model;
+    double input_per_mtok = 0.0;
+    double output_per_mtok = 0.0;
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ModelPriceConfig, model, input_per_mtok, output_per_mtok)
+
+/// Spending limit for one tenant: the runs whose `dimension` equals `key`.
+struct UsageBudgetConfig {
+    std::string dimension = "agent";  // "provider", "model", "session", "agent", "channel" or "caller"
+    std::string key;
+    double soft_usd = 0.0;            // Logged once per period (0 = none)
+    double hard_usd = 0.0;            // New runs are refused (0 = none)
+    std::string period = "day";       // "day" or "month", UTC
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(UsageBudgetConfig, dimension, key, soft_usd, hard_usd, period)
+
+struct UsageConfig {
+    bool enabled = true;
+    std::optional<std::string> db_path;  // Default: <data_dir>/usage.db
+    int bucket_seconds = 3600;           // Rollup granularity
+    int flush_interval_seconds = 30;
+    std::vector<ModelPriceConfig> prices;
+    std::vector<UsageBudgetConfig> budgets;
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(UsageConfig, enabled, db_path, bucket_seconds, flush_interval_seconds, prices, budgets)
+
 struct PluginConfig {
     std::string name;
     std::string path;
     bool enabled = true;
+    bool isolated = false;  // Run in a restartable child process (tools only)
     json settings;
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(PluginConfig, name, path, enabled, settings)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(PluginConfig, name, path, enabled, isolated, settings)
 
 struct CronConfig {
     bool enabled = false;
@@ -139,11 +190,38 @@ struct SandboxDockerSettings {
 };
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(SandboxDockerSettings, dangerously_allow_container_namespace_join, network_mode, bind_mounts)
 
+struct CodeRuntimeConfig {
+    std::string name;                       // Language of tool calls: "python", "node", "shell"
+    std::vector<std::string> command;       // Interpreter argv; empty uses the runner's default
+    std::optional<std::string> runner;      // Job loop: "python", "node" or "shell"; defaults to name
+    int workers = 2;
+    std::optional<int> memory_mb;           // Overrides CodeSandboxConfig::memory_mb
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(CodeRuntimeConfig, name, command, runner, workers, memory_mb)
+
+struct CodeSandboxConfig {
+    bool enabled = false;
+    std::optional<std::string> work_dir;        // Default: <data_dir>/sandbox
+    std::vector<CodeRuntimeConfig> runtimes;    // Empty: python, node and shell
+    int timeout_seconds = 10;
+    int max_jobs_per_worker = 50;               // Recycle after this many; 1 = fresh process per job
+    size_t max_output_bytes = 64 * 1024;
+    int memory_mb = 512;                        // RLIMIT_AS and cgroup memory.max
+    int cpu_seconds = 60;                       // RLIMIT_CPU over a worker's lifetime
+    int max_file_mb = 16;                       // RLIMIT_FSIZE
+    int max_open_files = 256;                   // RLIMIT_NOFILE
+    int max_processes = 0;                      // cgroup pids.max and RLIMIT_NPROC (per uid); 0 = unlimited
+    std::string network_mode = "none";
+    std::optional<std::string> cgroup_parent;   // Delegated cgroup v2 directory
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(CodeSandboxConfig, enabled, work_dir, runtimes, timeout_seconds, max_jobs_per_worker, max_output_bytes, memory_mb, cpu_seconds, max_file_mb, max_open_files, max_processes, network_mode, cgroup_parent)
+
 struct SandboxConfig {
     bool enabled = false;
     SandboxDockerSettings docker;
+    CodeSandboxConfig code;  // Pre-forked workers behind the code_run tool
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(SandboxConfig, enabled, docker)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(SandboxConfig, enabled, docker, code)
 
 struct HttpSecurityHeaders {
     std::optional<std::string> strict_transport_security;
@@ -162,6 +240,17 @@ struct ImageConfig {
 };
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ImageConfig, max_dimension_px, max_bytes)
 
+struct LoggingConfig {
+    size_t ring_size = 4096;            // Records buffered for the sink thread and gateway.logs
+    std::string overflow = "drop";      // "drop", "block" or "overwrite" when the sink falls behind
+    bool console = true;                // Colored lines on stdout
+    std::optional<std::string> file;    // Also append plain lines here
+    std::optional<std::string> json_file;  // Also append JSON lines here
+    std::map<std::string, std::string> levels;  // Per category (module), e.g. {"browser": "warn"}
+    int sample_per_second = 0;          // Per call site, below warn; 0 = unlimited
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(LoggingConfig, ring_size, overflow, console, file, json_file, levels, sample_per_second)
+
 struct Config {
     GatewayConfig gateway;
     std::vector<ProviderConfig> providers;
@@ -169,9 +258,11 @@ struct Config {
     MemoryConfig memory;
     BrowserConfig browser;
     SessionConfig sessions;
+    UsageConfig usage;
     std::vector<PluginConfig> plugins;
     CronConfig cron;
     std::string log_level = "info";
+    LoggingConfig logging;
     std::optional<std::string> data_dir;
     std::optional<SubagentConfig> subagents;
     std::optional<ImageConfig> image;
@@ -181,7 +272,7 @@ struct Config {
     HttpSecurityHeaders http_security;
     std::optional<SecretsConfig> secrets;  // v2026.2.26: external secrets management
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(Config, gateway, providers, channels, memory, browser, sessions, plugins, cron, log_level, data_dir, subagents, image, model_by_channel, heartbeat, sandbox, http_security, secrets)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(Config, gateway, providers, channels, memory, browser, sessions, usage, plugins, cron, log_level, logging, data_dir, subagents, image, model_by_channel, heartbeat, sandbox, http_security, secrets)
 
 /// v2026.2.26: Resolve thread binding policy with cascade:
 /// session config > channel config > global default.
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace openclaw {
+
+/// One log line, already formatted by the producer. Fixed size so it can
+/// be written into a ring slot without allocating.
+struct LogRecord {
+    static constexpr size_t kMessageBytes = 928;
+
+    int64_t time_ns = 0;       // system_clock, since the epoch
+    uint64_t thread_id = 0;
+    int32_t line = 0;
+    uint16_t length = 0;       // Bytes used in `message`
+    uint8_t level = 0;         // spdlog::level::level_enum
+    bool truncated = false;
+    char category[24] = {};    // NUL-terminated, see log_category()
+    char file[40] = {};        // Tail of the source path, NUL-terminated
+    char message[kMessageBytes];
+
+    [[nodiscard]] auto text() const -> std::string_view { return {message, length}; }
+};
+
+/// What a producer does when the sink thread has fallen a full ring behind.
+enum class LogOverflow {
+    Drop,       // Discard the new record (counted in dropped())
+    Block,      // Spin until the sink frees a slot
+    Overwrite,  // Reuse the oldest slot; the sink skips what it missed
+};
+
+/// Bounded multi-producer, single-consumer ring of LogRecords.
+///
+/// Producers claim a position with a CAS on `head` and publish the slot
+/// through its stamp (odd while being written, even once complete), so the
+/// logging path takes no locks. The single sink thread drains in order with
+/// pop(). Consumed slots keep their contents until a later lap reuses them,
+/// which lets any thread read the recent history (read()) through the same
+/// stamps without disturbing the sink.
+class LogRing {
+public:
+    enum class ReadStatus { Ok, NotReady, Lost };
+
+    struct Slot {
+        std::atomic<uint64_t> stamp{0};
+        LogRecord record;
+    };
+
+    /// `capacity` is rounded up to a power of two, at least 16.
+    explicit LogRing(size_t capacity, LogOverflow overflow = LogOverflow::Drop);
+
+    LogRing(const LogRing&) = delete;
+    LogRing& operator=(const LogRing&) = delete;
+
+    /// Claims a slot, lets `fill` write the record in place and publishes
+    /// it. Returns false if the record was dropped.
+    template <typename Fill>
+    auto push(Fill&& fill) -> bool {
+        auto pos = claim();
+        if (!pos) {
+            return false;
+        }
+        auto& slot = slots_[*pos & mask_];
+        fill(slot.record);
+        publish(slot, *pos);
+        return true;
+    }
+
+    /// Sink side: takes the next record in order. Returns false when the
+    /// ring is drained or the next record is still being written.
+    auto pop(LogRecord& out) -> bool;
+
+    /// Copies up to `limit` published records starting at position `since`
+    /// (clamped to what the ring still holds). Returns the position after
+    /// the last record copied, to pass as `since` next time.
+    auto read(uint64_t since, size_t limit, std::vector<LogRecord>& out) const -> uint64_t;
+
+    /// Blocks the sink until something is published after `seen`, the
+    /// value of published() observed before the last drain.
+    void wait(uint32_t seen) const { published_.wait(seen, std::memory_order_acquire); }
+    void wake();
+
+    [[nodiscard]] auto published() const -> uint32_t { return published_.load(std::memory_order_acquire); }
+    [[nodiscard]] auto head() const -> uint64_t { return head_.load(std::memory_order_acquire); }
+    [[nodiscard]] auto tail() const -> uint64_t { return tail_.load(std::memory_order_acquire); }
+    [[nodiscard]] auto capacity() const -> size_t { return mask_ + 1; }
+    [[nodiscard]] auto overflow() const -> LogOverflow { return overflow_; }
+    [[nodiscard]] auto dropped() const -> uint64_t { return dropped_.load(std::memory_order_relaxed); }
+    [[nodiscard]] auto lost() const -> uint64_t { return lost_.load(std::memory_order_relaxed); }
+
+    /// Block-mode producers only wait while a sink is draining the ring;
+    /// otherwise they drop.
+    void set_sink_running(bool running) { sink_running_.store(running, std::memory_order_release); }
+
+private:
+    // Claims a position and marks its slot as being written. Nullopt if
+    // the record is dropped.
+    auto claim() -> std::optional<uint64_t>;
+    void publish(Slot& slot, uint64_t pos);
+    auto read_slot(uint64_t pos, LogRecord& out) const -> ReadStatus;
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+    LogOverflow overflow_;
+    alignas(64) std::atomic<uint64_t> head_{0};
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    alignas(64) mutable std::atomic<uint32_t> published_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> lost_{0};
+    std::atomic<bool> sink_running_{false};
+};
+
+/// {"timestamp" (ms), "level", "category", "file", "line", "thread",
+/// "message"}, plus "truncated" when the message was cut.
+void to_json(nlohmann::json& j, const LogRecord& record);
+
+/// Category of a log call site: the module directory of its source file
+/// ("src/browser/pool.cpp" -> "browser", "include/openclaw/core/x.hpp" ->
+/// "core"), or empty if the path has none.
+[[nodiscard]] auto log_category(std::string_view file) -> std::string_view;
+
+} // namespace openclaw
@@ -1,20 +1,62 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <spdlog/spdlog.h>
 
+#include "openclaw/core/log_ring.hpp"
+
 namespace openclaw {
 
+struct LoggingConfig;
+
+/// Counters of the logging pipeline since the last init()/configure().
+struct LogStats {
+    uint64_t written = 0;     // Records accepted into the ring
+    uint64_t dropped = 0;     // Rejected because the ring was full
+    uint64_t lost = 0;        // Overwritten before the sink wrote them
+    uint64_t suppressed = 0;  // Held back by per-call-site sampling
+    size_t capacity = 0;
+};
+
+/// Process-wide logger.
+///
+/// LOG_* calls format on the calling thread into a fixed-size record in a
+/// lock-free ring (LogRing); a background thread writes the records to the
+/// configured outputs (stdout, a text file, JSON lines). gateway.logs reads
+/// its history from the same ring.
 class Logger {
 public:
     static void init(std::string_view name = "openclaw", std::string_view level = "info");
+
+    /// Rebuilds the pipeline with the given outputs, ring size, overflow
+    /// policy, per-category levels and sampling. Records still in the old
+    /// ring are written out first.
+    static void configure(const LoggingConfig& config);
+
     static auto get() -> std::shared_ptr<spdlog::logger>&;
 
     static void set_level(std::string_view level);
+
+    /// Blocks until every record logged so far has reached the outputs.
     static void flush();
+
+    /// Drains the ring and stops the sink thread. Later records are kept
+    /// in the ring (for gateway.logs) but not written.
+    static void shutdown();
+
+    /// Copies up to `limit` records logged at or after position `since`
+    /// into `out`. Returns the position to continue from.
+    static auto read(uint64_t since, size_t limit, std::vector<LogRecord>& out) -> uint64_t;
+
+    /// Position of the next record to be logged.
+    [[nodiscard]] static auto position() -> uint64_t;
+
+    [[nodiscard]] static auto stats() -> LogStats;
 };
 
 } // namespace openclaw
@@ -1,8 +1,15 @@
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include <nlohmann/json.hpp>
@@ -39,8 +46,9 @@ struct SecretRef {
     std::string source;    // "env", "file", "exec"
     std::string provider;  // provider identifier
     std::string id;        // key/path/command identifier
+    int ttl_ms = 0;        // cache lifetime; 0 uses SecretsConfig::cache_ttl_ms
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(SecretRef, source, provider, id)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(SecretRef, source, provider, id, ttl_ms)
 
 /// Sub-providers for the secrets management subsystem.
 struct SecretsEnvProvider {
@@ -72,28 +80,106 @@ struct SecretsConfig {
     std::optional<EnvProvider> env;
     std::optional<FileProvider> file;
     std::optional<ExecProvider> exec;
+    int cache_ttl_ms = 300000;  // default lifetime of file and exec secrets
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(SecretsConfig, env, file, exec)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(SecretsConfig, env, file, exec, cache_ttl_ms)
+
+/// Counters of the SecretResolver cache.
+struct SecretCacheStats {
+    uint64_t hits = 0;              // Served from a fresh entry
+    uint64_t misses = 0;            // Resolved on the calling thread
+    uint64_t coalesced = 0;         // Waited for a resolution already running
+    uint64_t stale_served = 0;      // Served an expired value while it refreshed
+    uint64_t refreshes = 0;         // Background fetches that succeeded
+    uint64_t refresh_failures = 0;  // Background fetches that failed
+    size_t entries = 0;
+};
+
+/// Splits an exec secret's command line into argv words, the way a shell
+/// would but without evaluating anything: words are separated by blanks,
+/// single quotes keep their contents verbatim, double quotes allow \"
+/// and \\ escapes, and a backslash outside quotes escapes the next
+/// character. `$`, globs, `;` and the like are ordinary characters.
+/// Fails on an unterminated quote or a trailing backslash.
+[[nodiscard]] auto split_command_line(std::string_view line)
+    -> Result<std::vector<std::string>>;
 
 /// Resolves secrets from various providers (env vars, files, exec).
+///
+/// File and exec secrets are cached for their TTL. A background thread
+/// refreshes entries that are in use shortly before they expire, so hot
+/// secrets never block a caller after the first resolution. An expired
+/// entry is still served while its refresh runs, and a failed refresh
+/// keeps serving the last good value. Concurrent resolutions of the same
+/// reference share one fetch. Environment variables are not cached.
 class SecretResolver {
 public:
     explicit SecretResolver(SecretsConfig config = {});
+    ~SecretResolver();
 
-    /// Resolve a secret reference to its string value.
+    SecretResolver(const SecretResolver&) = delete;
+    auto operator=(const SecretResolver&) -> SecretResolver& = delete;
+
+    /// Resolve a secret reference to its string value, from the cache when
+    /// possible.
     auto resolve(const SecretRef& ref) -> Result<std::string>;
 
+    /// Starts fetching `refs` in the background so that later resolve()
+    /// calls (e.g. during provider setup) find them cached.
+    void prefetch(const std::vector<SecretRef>& refs);
+
+    /// Drops a cached secret; the next resolve() fetches it again.
+    void invalidate(const SecretRef& ref);
+
+    /// Drops every cached secret, e.g. after the secrets config changed.
+    void clear();
+
+    [[nodiscard]] auto stats() const -> SecretCacheStats;
+
     /// Resolve from environment variable.
     auto resolve_env(std::string_view key) -> Result<std::string>;
 
     /// Resolve from a file (checks ownership and permissions <= 0644).
     auto resolve_file(std::string_view path) -> Result<std::string>;
 
-    /// Resolve by executing a command (with timeout).
+    /// Resolve by executing a command directly, without a shell (with
+    /// timeout). Uncached.
     auto resolve_exec(std::string_view cmd, const std::vector<std::string>& args) -> Result<std::string>;
 
 private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        SecretRef ref;
+        std::optional<std::string> value;  // Last good value
+        Clock::time_point fetched_at;
+        Clock::time_point refresh_at;      // When the worker refreshes it
+        bool used = false;                 // Resolved since the last fetch
+        bool refresh_requested = false;    // Refresh as soon as possible
+        int failures = 0;                  // Consecutive failed fetches
+        std::shared_future<Result<std::string>> inflight;  // Valid while fetching
+    };
+
+    [[nodiscard]] static auto cache_key(const SecretRef& ref) -> std::string;
+    [[nodiscard]] auto ttl(const SecretRef& ref) const -> std::chrono::milliseconds;
+
+    /// Uncached resolution of a file or exec reference.
+    auto fetch(const SecretRef& ref) -> Result<std::string>;
+
+    /// Records the outcome of a fetch of `key`. Called with mutex_ held.
+    void store(const std::string& key, const Result<std::string>& result, bool background);
+
+    void ensure_worker();  // Called with mutex_ held
+    void refresh_loop();
+
     SecretsConfig config_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unordered_map<std::string, Entry> entries_;
+    SecretCacheStats stats_;
+    bool stopping_ = false;
+    std::thread worker_;
 };
 
 } // namespace openclaw
@@ -5,6 +5,7 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <boost/asio/awaitable.hpp>
 #include <boost/beast/http/message.hpp>
@@ -13,6 +14,7 @@
 
 #include "openclaw/core/config.hpp"
 #include "openclaw/core/error.hpp"
+#include "openclaw/infra/jwt.hpp"
 
 namespace openclaw::gateway {
 
@@ -24,6 +26,7 @@ enum class AuthMethod {
     None,       // No authentication required
     Token,      // Shared secret / bearer token
     Tailscale,  // Tailscale identity (whois-based)
+    Jwt,        // HS256 bearer JWT
 };
 
 /// Information extracted after successful authentication.
@@ -95,6 +98,27 @@ private:
     std::string socket_path_;
 };
 
+/// JWT bearer authentication.  Validated tokens are cached until they
+/// expire, so a client reconnecting with the same token skips the HMAC.
+/// The identity is the `sub` claim; all claims become metadata.
+class JwtAuthVerifier final : public AuthVerifier {
+public:
+    explicit JwtAuthVerifier(std::vector<std::string> secrets);
+
+    auto verify(std::string_view credential)
+        -> awaitable<Result<AuthInfo>> override;
+
+    [[nodiscard]] auto method() const noexcept -> AuthMethod override {
+        return AuthMethod::Jwt;
+    }
+
+    /// For key rotation, revocation and stats.
+    [[nodiscard]] auto verifier() noexcept -> infra::JwtVerifier& { return verifier_; }
+
+private:
+    infra::JwtVerifier verifier_;
+};
+
 /// The Authenticator orchestrates authentication for the gateway.
 /// It is configured from AuthConfig and delegates to the appropriate
 /// verifier.
@@ -126,9 +150,18 @@ public:
     /// Return the active authentication method.
     [[nodiscard]] auto active_method() const noexcept -> AuthMethod;
 
+    /// The JWT verifier when method == Jwt, nullptr otherwise.
+    [[nodiscard]] auto jwt_verifier() noexcept -> infra::JwtVerifier*;
+
+    /// Replaces the JWT keys, e.g. after `auth.jwt_secrets` changed at
+    /// runtime. Invalid keys are refused and the current ones stay; an
+    /// unchanged set keeps the token cache.
+    auto set_jwt_secrets(std::vector<std::string> secrets) -> Result<void>;
+
 private:
     AuthMethod method_ = AuthMethod::None;
     std::unique_ptr<AuthVerifier> verifier_;
+    std::vector<std::string> jwt_secrets_;  // Keys in use when method_ == Jwt
 };
 
 /// v2026.2.25: Browser WebSocket authentication policy.
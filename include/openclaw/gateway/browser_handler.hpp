@@ -1,15 +1,22 @@
 #pragma once
 
 #include "openclaw/browser/browser_pool.hpp"
+#include "openclaw/core/config.hpp"
 #include "openclaw/gateway/protocol.hpp"
+#include "openclaw/gateway/server.hpp"
 
 namespace openclaw::gateway {
 
 /// Registers browser.open, browser.close, browser.navigate,
 /// browser.screenshot, browser.content, browser.click, browser.type,
 /// browser.evaluate, browser.wait, browser.scroll, browser.pdf,
-/// browser.cookies.get, browser.cookies.set handlers.
+/// browser.cookies.get, browser.cookies.set, browser.pool.stats,
+/// browser.network.stats, browser.fetch_many handlers.
+/// browser.screenshot sizes and encodes images to fit `image`;
+/// browser.fetch_many can stream per-page events through `server`.
 void register_browser_handlers(Protocol& protocol,
-                               browser::BrowserPool& pool);
+                               GatewayServer& server,
+                               browser::BrowserPool& pool,
+                               const ImageConfig& image = {});
 
 } // namespace openclaw::gateway
@@ -5,6 +5,7 @@
 #include "openclaw/agent/runtime.hpp"
 #include "openclaw/gateway/protocol.hpp"
 #include "openclaw/gateway/server.hpp"
+#include "openclaw/providers/usage_ledger.hpp"
 #include "openclaw/sessions/manager.hpp"
 
 namespace openclaw::gateway {
@@ -12,9 +13,12 @@ namespace openclaw::gateway {
 /// Registers chat.send (and agent.chat alias) handlers on the protocol.
 /// These are the bridge-critical methods: the Rust bridge calls chat.send
 /// for every user message and expects streaming delta/final events back.
+/// Runs are metered into `usage` when given and refused once a hard budget
+/// is reached.
 void register_chat_handlers(Protocol& protocol,
                             GatewayServer& server,
                             sessions::SessionManager& sessions,
-                            agent::AgentRuntime& runtime);
+                            agent::AgentRuntime& runtime,
+                            providers::UsageLedger* usage = nullptr);
 
 } // namespace openclaw::gateway
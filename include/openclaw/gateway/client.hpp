@@ -1,8 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -33,8 +36,14 @@ using StateCallback = std::function<void(bool connected)>;
 /// A client for connecting to a GatewayServer over WebSocket.
 /// Supports sending requests, receiving responses and events, and
 /// an optional auto-reconnect mechanism.
+///
+/// Calls are pipelined: any number may be outstanding on the one
+/// connection, writes go out in order through a single writer, and each
+/// caller is woken directly when the read loop sees its response id.
 class GatewayClient {
 public:
+    using Deadline = std::chrono::steady_clock::time_point;
+
     explicit GatewayClient(net::io_context& ioc);
     ~GatewayClient();
 
@@ -52,7 +61,8 @@ public:
                  std::string_view path = "/")
         -> awaitable<Result<void>>;
 
-    /// Disconnect from the server.
+    /// Disconnect from the server. Writes already queued go out first;
+    /// calls still waiting for a response fail with ConnectionClosed.
     auto disconnect() -> awaitable<void>;
 
     /// Send a Frame to the server.
@@ -66,6 +76,17 @@ public:
               uint32_t timeout_ms = 30000)
         -> awaitable<Result<json>>;
 
+    /// Same as above with an absolute deadline, so a chain of calls made
+    /// on behalf of one request can share that request's budget.
+    /// Fails with ErrorCode::Timeout once the deadline passes. The call
+    /// also honours asio cancellation (e.g. when raced with `||`): the
+    /// pending entry is dropped and operation_aborted is rethrown.
+    auto call(std::string_view method, json params, Deadline deadline)
+        -> awaitable<Result<json>>;
+
+    /// Number of calls still waiting for a response.
+    [[nodiscard]] auto pending_calls() const -> size_t;
+
     /// Register a callback for all incoming frames.
     void on_frame(FrameCallback cb);
 
@@ -85,6 +106,20 @@ public:
 private:
     using WsStream = websocket::stream<beast::tcp_stream>;
 
+    // Completion of one call or send; defined in client.cpp.
+    struct PendingCall;
+
+    struct Outgoing {
+        std::string text;
+        std::string call_id;                   // Request id, failed if the write fails
+        std::shared_ptr<PendingCall> written;  // send(): completed once written
+        bool close = false;                    // disconnect(): close after the writes ahead
+    };
+
+    void enqueue_write(Outgoing outgoing);
+    auto write_loop() -> awaitable<void>;
+    void resolve(const std::string& id, Result<json> result);
+    void fail_pending(const Error& error);
     auto read_loop() -> awaitable<void>;
     auto try_reconnect() -> awaitable<void>;
     void notify_frame(const Frame& frame);
@@ -101,11 +136,12 @@ private:
     std::vector<FrameCallback> frame_callbacks_;
     std::vector<StateCallback> state_callbacks_;
 
+    // Guards pending_calls_, write_queue_ and writing_.
+    mutable std::mutex mutex_;
     // Pending RPC calls awaiting a response, keyed by request id.
-    struct PendingCall {
-        std::function<void(Result<json>)> resolver;
-    };
-    std::unordered_map<std::string, PendingCall> pending_calls_;
+    std::unordered_map<std::string, std::shared_ptr<PendingCall>> pending_calls_;
+    std::deque<Outgoing> write_queue_;
+    bool writing_ = false;
 
     std::atomic<bool> connected_{false};
     bool auto_reconnect_ = false;
@@ -1,9 +1,21 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <nlohmann/json.hpp>
 
 #include "openclaw/core/config.hpp"
@@ -11,48 +23,136 @@
 
 namespace openclaw::gateway {
 
-/// Manages runtime configuration as a mutable JSON document.
+/// One immutable version of the runtime configuration. Shared by every
+/// reader that loaded it; never modified after publication.
+struct ConfigSnapshot {
+    json document;
+    uint64_t version = 0;
+    std::string hash;  // SHA-256 of document.dump(), computed once
+
+    /// Value at dot-separated path, or nullptr if not found.
+    [[nodiscard]] auto find(std::string_view path) const -> const json*;
+};
+
+/// Manages runtime configuration as a versioned JSON document.
 /// Supports dot-path navigation, atomic patches, and persistence.
+///
+/// The current version is an immutable ConfigSnapshot published through an
+/// atomic shared_ptr: readers load it without locking or copying. Writers
+/// serialize on a mutex, build the next document off to the side and
+/// publish it with its hash. Persistence runs on a background thread that
+/// coalesces changes for a short debounce window and writes the latest
+/// version with an atomic write-rename.
 class RuntimeConfig {
 public:
+    /// Called with each newly published version, on the writer's thread
+    /// and with writes held off until it returns.
+    using ChangeHandler = std::function<void(const ConfigSnapshot& snapshot)>;
+
     explicit RuntimeConfig(const Config& initial_config);
 
-    /// Get value at dot-separated path. Returns null if not found.
-    [[nodiscard]] auto get(std::string_view path) const -> json;
+    /// Writes any pending change before returning.
+    ~RuntimeConfig();
+
+    RuntimeConfig(const RuntimeConfig&) = delete;
+    RuntimeConfig& operator=(const RuntimeConfig&) = delete;
+
+    /// The current version.
+    [[nodiscard]] auto snapshot() const -> std::shared_ptr<const ConfigSnapshot>;
+
+    /// Value at dot-separated path in the current version, sharing its
+    /// snapshot. Returns nullptr if not found.
+    [[nodiscard]] auto get(std::string_view path) const -> std::shared_ptr<const json>;
 
     /// Set value at dot-separated path.
     void set(std::string_view path, const json& value);
 
-    /// Apply a batch of patches with optimistic concurrency.
+    /// Apply a batch of patches as one version with optimistic concurrency.
     /// Returns false if baseHash doesn't match current hash.
     auto patch(const std::vector<std::pair<std::string, json>>& patches,
                const std::string& base_hash) -> bool;
 
-    /// Get SHA256 hash of the current config.
+    /// SHA256 hash of the current version.
     [[nodiscard]] auto hash() const -> std::string;
 
-    /// Get the full config as JSON.
-    [[nodiscard]] auto to_json() const -> json;
-
     /// Reset to default configuration.
     void reset();
 
-    /// Set persistence path. If set, changes are auto-saved.
-    void set_persist_path(const std::filesystem::path& path);
+    /// Set persistence path. If set, changes are auto-saved after
+    /// `debounce` (coalescing bursts of writes into one file write).
+    void set_persist_path(const std::filesystem::path& path,
+                          std::chrono::milliseconds debounce = std::chrono::milliseconds(200));
+
+    [[nodiscard]] auto persist_path() const -> std::filesystem::path;
+
+    /// Block until every change so far has been written.
+    void flush();
+
+    /// Adopt the document in `path` after an external edit. Returns false
+    /// if it matches the current version or the last file we wrote.
+    auto reload(const std::filesystem::path& path) -> Result<bool>;
 
     /// List all top-level config keys.
     [[nodiscard]] auto list_keys() const -> std::vector<std::string>;
 
+    /// Subscribe to changes, e.g. to apply settings that live elsewhere.
+    void on_change(ChangeHandler handler);
+
 private:
-    void persist() const;
+    void publish(json document, bool persist);
+    void persist_loop();
+    auto write_file(const std::filesystem::path& path, const ConfigSnapshot& snapshot)
+        -> Result<void>;
     static auto navigate(json& root, std::string_view path, bool create) -> json*;
-    static auto navigate(const json& root, std::string_view path) -> const json*;
     static auto compute_hash(const json& j) -> std::string;
 
-    mutable std::mutex mutex_;
-    json config_;
+    std::atomic<std::shared_ptr<const ConfigSnapshot>> current_;
+    std::mutex write_mutex_;
+    std::vector<ChangeHandler> change_handlers_;  // Guarded by write_mutex_
     json default_config_;
+
+    // Persistence, shared with the writer thread
+    mutable std::mutex persist_mutex_;
+    std::condition_variable persist_cv_;
     std::filesystem::path persist_path_;
+    std::chrono::milliseconds debounce_{200};
+    std::shared_ptr<const ConfigSnapshot> dirty_;  // Latest version not yet written
+    std::string written_hash_;                     // Hash of the last file written
+    bool writing_ = false;
+    bool flush_requested_ = false;
+    bool stopping_ = false;
+    std::thread persist_thread_;
+};
+
+/// Hot-reloads the persisted config file when something other than the
+/// gateway edits it. Watches the file's directory with inotify and
+/// debounces bursts of events. Linux only; start() fails elsewhere.
+///
+/// Runs on the io_context thread and must outlive it.
+class ConfigWatcher {
+public:
+    ConfigWatcher(boost::asio::io_context& ioc, RuntimeConfig& config,
+                  std::filesystem::path path,
+                  std::chrono::milliseconds debounce = std::chrono::milliseconds(250));
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    auto start() -> Result<void>;
+    void stop();
+
+private:
+    auto read_loop() -> awaitable<void>;
+    auto debounce_loop() -> awaitable<void>;
+
+    boost::asio::io_context& ioc_;
+    RuntimeConfig& config_;
+    std::filesystem::path path_;
+    std::chrono::milliseconds debounce_;
+    boost::asio::posix::stream_descriptor stream_;
+    boost::asio::steady_timer timer_;
+    bool running_ = false;
 };
 
 /// Registers config.get, config.set, config.patch, config.list,
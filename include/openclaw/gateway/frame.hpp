@@ -4,6 +4,7 @@
 #include <string>
 #include <string_view>
 #include <variant>
+#include <vector>
 
 #include <nlohmann/json.hpp>
 
@@ -69,4 +70,15 @@ auto make_error_response(const std::string& id, ErrorCode code,
 /// Build an EventFrame.
 auto make_event(std::string event, json data = json::object()) -> EventFrame;
 
+/// Moves the binary values (json::binary) out of a response payload so they
+/// can travel as binary WebSocket frames instead of base64 text. Each one
+/// is replaced in place by {"$binary": {"index": i, "size": n}}.
+auto detach_binary(json& payload) -> std::vector<json::binary_t>;
+
+/// Encodes one detached payload as a binary WebSocket message: a one-line
+/// JSON header {"id", "index"} naming the response it belongs to, a '\n',
+/// then the raw bytes.
+auto make_binary_frame(std::string_view request_id, size_t index,
+                       const json::binary_t& bytes) -> std::string;
+
 } // namespace openclaw::gateway
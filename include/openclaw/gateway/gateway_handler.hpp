@@ -7,7 +7,8 @@ namespace openclaw::gateway {
 
 /// Registers gateway.info, gateway.ping, gateway.status, gateway.methods,
 /// gateway.subscribe, gateway.unsubscribe, gateway.shutdown, gateway.reload,
-/// gateway.metrics, gateway.logs handlers on the protocol.
+/// gateway.metrics, gateway.logs, gateway.logs.subscribe and
+/// gateway.logs.unsubscribe handlers on the protocol.
 void register_gateway_handlers(Protocol& protocol, GatewayServer& server);
 
 } // namespace openclaw::gateway
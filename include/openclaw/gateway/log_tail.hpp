@@ -0,0 +1,95 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+#include <nlohmann/json.hpp>
+
+#include "openclaw/core/error.hpp"
+#include "openclaw/core/logger.hpp"
+
+namespace openclaw::gateway {
+
+using json = nlohmann::json;
+using boost::asio::awaitable;
+
+class GatewayServer;
+
+/// Server-side filter of a log tail subscription, checked against raw
+/// records before anything is serialized. Cheap checks run first.
+struct LogFilter {
+    spdlog::level::level_enum level = spdlog::level::trace;  // Minimum level
+    std::vector<std::string> categories;  // Empty matches any category
+    std::vector<std::string> needles;     // Substrings the message must all contain
+    std::string pattern;                  // Glob searched in the message
+    uint32_t sample_every = 1;            // Keep one of every N matches
+
+    /// Reads "level", "category" (string or array), "session", "run",
+    /// "contains", "pattern" and "sample" (a rate in (0, 1]) from `params`.
+    /// Records carry no structured session or run id, so those two match
+    /// the id anywhere in the message. A pattern is a glob, `*` matching
+    /// any run and `?` any one character, so matching is linear in the
+    /// message for each pattern character and cannot blow up.
+    [[nodiscard]] static auto parse(const json& params) -> Result<LogFilter>;
+
+    /// Whether `record` passes, ignoring sampling.
+    [[nodiscard]] auto matches(const LogRecord& record) const -> bool;
+};
+
+/// Streams newly logged records to subscribed connections as
+/// "gateway.logs" events.
+///
+/// One pump reads the log ring while any subscription exists; each
+/// subscription filters the new records into a bounded batch that is sent
+/// once per flush interval. A subscriber whose connection is still busy
+/// with the previous batch keeps accumulating up to `max_buffered` records
+/// and then drops the rest, reporting the count in its next event.
+class LogTail : public std::enable_shared_from_this<LogTail> {
+public:
+    struct Options {
+        std::chrono::milliseconds interval{1000};
+        size_t max_buffered = 500;
+    };
+
+    explicit LogTail(GatewayServer& server);
+
+    /// Starts streaming records that pass `filter` to `connection_id`.
+    /// Returns the subscription id.
+    auto subscribe(std::string connection_id, LogFilter filter, Options options)
+        -> awaitable<std::string>;
+
+    /// Ends a subscription; only the connection that created it may.
+    auto unsubscribe(const std::string& id, const std::string& connection_id) -> bool;
+
+    [[nodiscard]] auto size() const -> size_t { return subscriptions_.size(); }
+
+private:
+    struct Subscription {
+        std::string id;
+        std::string connection_id;
+        LogFilter filter;
+        Options options;
+        std::vector<LogRecord> pending;
+        uint64_t matched = 0;
+        uint64_t dropped = 0;  // Since the last event
+        std::chrono::steady_clock::time_point next_flush;
+        bool sending = false;
+    };
+
+    auto pump() -> awaitable<void>;
+    void collect(const std::vector<LogRecord>& records, uint64_t missed);
+    auto deliver(std::shared_ptr<Subscription> subscription) -> awaitable<void>;
+
+    GatewayServer& server_;
+    std::unordered_map<std::string, std::shared_ptr<Subscription>> subscriptions_;
+    uint64_t cursor_ = 0;
+    bool pumping_ = false;
+};
+
+} // namespace openclaw::gateway
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <nlohmann/json.hpp>
+
+#include "openclaw/core/error.hpp"
+#include "openclaw/gateway/frame.hpp"
+#include "openclaw/gateway/stream_buffer.hpp"
+
+namespace openclaw::gateway {
+
+using boost::asio::awaitable;
+
+/// How long a Pause outbox may hold a run before its delta is dropped.
+inline constexpr auto kStreamPauseLimit = std::chrono::seconds(30);
+
+/// runId of a run's event, or empty.
+[[nodiscard]] auto run_id_of(const EventFrame& event) -> std::string;
+
+/// The frames queued for one connection's writer.
+///
+/// Connection owns the socket and the writer coroutine; the outbox holds
+/// what is waiting to be written and applies the StreamPolicy to streamed
+/// deltas once the queue passes the stream limit. A frame's bytes count
+/// until the writer reports it done(), so the frame being written still
+/// holds back paused runs. Used from its executor's thread only.
+class Outbox {
+public:
+    /// Completion of an awaited write.
+    struct Waiter {
+        explicit Waiter(const boost::asio::any_io_executor& executor)
+            : timer(executor, boost::asio::steady_timer::time_point::max()) {}
+        boost::asio::steady_timer timer;
+        std::optional<Result<void>> result;
+    };
+
+    struct Item {
+        std::string data;                  // Serialized frame or binary message
+        bool binary = false;
+        std::optional<EventFrame> delta;   // Serialized when written
+        size_t bytes = 0;
+        std::shared_ptr<Waiter> waiter;    // Set for awaited writes
+        std::string run_id;                // runId of a run's event
+    };
+
+    explicit Outbox(boost::asio::any_io_executor executor);
+
+    void set_policy(StreamPolicy policy, size_t limit_bytes,
+                    std::chrono::milliseconds pause_limit = kStreamPauseLimit);
+    [[nodiscard]] auto policy() const noexcept -> StreamPolicy { return policy_; }
+
+    /// Queue a frame regardless of the stream limit.
+    void push(Item item);
+
+    /// Queue a streamed delta: an event whose payload "text" continues the
+    /// previous delta with the same runId and stream. Under Coalesce it is
+    /// merged into the run's latest queued frame when that is a matching
+    /// delta; over the limit it is dropped, or under Pause waits up to the
+    /// pause limit for the writer to drain. Returns false if dropped.
+    auto push_delta(EventFrame event) -> awaitable<bool>;
+
+    /// Take the next frame for the writer. Requires !empty().
+    auto pop() -> Item;
+
+    /// The writer is finished with `item`: frees its bytes and resumes
+    /// paused runs once below the limit.
+    void done(const Item& item);
+
+    /// Resumes paused runs, which drop their deltas, as do later calls to
+    /// push_delta(). Queued frames stay for the writer to fail.
+    void close();
+
+    [[nodiscard]] auto empty() const noexcept -> bool { return items_.empty(); }
+    [[nodiscard]] auto bytes() const noexcept -> size_t { return bytes_; }
+
+    /// Occupancy and policy counters.
+    [[nodiscard]] auto stats() const -> nlohmann::json;
+
+private:
+    auto merge(const EventFrame& event) -> bool;
+    auto wait_for_room() -> awaitable<bool>;
+    void wake_room_waiters();
+
+    boost::asio::any_io_executor executor_;
+    std::deque<Item> items_;
+    size_t bytes_ = 0;  // Queued plus the frames being written
+    bool closed_ = false;
+    std::vector<boost::asio::steady_timer*> room_waiters_;
+
+    StreamPolicy policy_ = StreamPolicy::Coalesce;
+    size_t limit_ = 1024 * 1024;
+    std::chrono::milliseconds pause_limit_ = kStreamPauseLimit;
+    size_t peak_bytes_ = 0;
+    uint64_t coalesced_ = 0;
+    uint64_t dropped_ = 0;
+    uint64_t pauses_ = 0;
+};
+
+} // namespace openclaw::gateway
@@ -5,9 +5,17 @@
 
 namespace openclaw::gateway {
 
+/// Moves the methods of a swapped plugin over in `protocol`: withdraws
+/// those `retired` published and publishes `published`'s, skipping names
+/// another owner already holds. Records what was published on `published`.
+void swap_plugin_methods(Protocol& protocol,
+                         const std::shared_ptr<plugins::LoadedPlugin>& retired,
+                         const std::shared_ptr<plugins::LoadedPlugin>& published);
+
 /// Registers plugin.list, plugin.install, plugin.uninstall,
 /// plugin.enable, plugin.disable, plugin.configure,
-/// plugin.call, plugin.status handlers.
+/// plugin.call, plugin.status, plugin.reload handlers, and keeps methods
+/// registered by plugins published in `protocol` across reloads.
 void register_plugin_handlers(Protocol& protocol,
                               plugins::PluginLoader& plugins);
 
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -21,6 +24,15 @@ using boost::asio::awaitable;
 /// Receives params as JSON, returns result as JSON.
 using MethodHandler = std::function<awaitable<json>(json params)>;
 
+/// Where a request came from, for handlers that push events back to the
+/// caller. Empty for requests that did not arrive over a connection.
+struct RequestContext {
+    std::string connection_id;
+};
+
+/// Handler that also receives the request's context.
+using ContextMethodHandler = std::function<awaitable<json>(json params, RequestContext context)>;
+
 /// Metadata about a registered RPC method.
 struct MethodInfo {
     std::string name;
@@ -31,6 +43,11 @@ struct MethodInfo {
 /// The Protocol class manages method registration, discovery, and dispatch.
 /// It maintains a registry of named RPC methods, each with a handler function,
 /// and routes incoming RequestFrames to the appropriate handler.
+///
+/// The method table is published as an immutable snapshot: registration
+/// copies and swaps it, dispatch reads it without locking and keeps the
+/// matched handler alive until the call completes, so methods can be
+/// replaced (e.g. by a plugin reload) while requests are in flight.
 class Protocol {
 public:
     Protocol();
@@ -40,6 +57,17 @@ public:
                          std::string description = "",
                          std::string group = "");
 
+    /// Register a handler that needs to know which connection called it.
+    void register_method(std::string name, ContextMethodHandler handler,
+                         std::string description = "",
+                         std::string group = "");
+
+    /// Remove the methods named in `remove` and register `add` in a single
+    /// publication. Calls already dispatched to a removed handler finish
+    /// against it.
+    void replace_methods(const std::vector<std::string>& remove,
+                         std::vector<std::pair<MethodInfo, MethodHandler>> add);
+
     /// Check whether a method is registered.
     [[nodiscard]] auto has_method(std::string_view name) const -> bool;
 
@@ -52,7 +80,8 @@ public:
 
     /// Dispatch a request to the matching handler.
     /// Returns an error if the method is not found.
-    auto dispatch(const RequestFrame& request) -> awaitable<Result<json>>;
+    auto dispatch(const RequestFrame& request, RequestContext context = {})
+        -> awaitable<Result<json>>;
 
     /// Register all built-in method stubs.
     /// These are placeholder implementations that return
@@ -61,11 +90,15 @@ public:
 
 private:
     struct Entry {
-        MethodHandler handler;
+        ContextMethodHandler handler;
         MethodInfo info;
     };
+    using MethodMap = std::unordered_map<std::string, std::shared_ptr<const Entry>>;
+
+    [[nodiscard]] auto snapshot() const -> std::shared_ptr<const MethodMap>;
 
-    std::unordered_map<std::string, Entry> methods_;
+    std::atomic<std::shared_ptr<const MethodMap>> methods_;
+    std::mutex write_mutex_;
 
     // Helpers for registering grouped stubs.
     void register_gateway_methods();
@@ -6,6 +6,7 @@
 #include "openclaw/gateway/protocol.hpp"
 #include "openclaw/gateway/server.hpp"
 #include "openclaw/providers/provider.hpp"
+#include "openclaw/providers/usage_ledger.hpp"
 
 namespace openclaw::gateway {
 
@@ -25,9 +26,29 @@ private:
 
 /// Registers provider.list, provider.chat, provider.chat.stream,
 /// provider.models, provider.embed, provider.status, provider.configure,
-/// provider.usage handlers on the protocol.
+/// provider.usage handlers on the protocol. Completions are metered into
+/// `usage` when given; provider.usage reports from it.
 void register_provider_handlers(Protocol& protocol,
                                 GatewayServer& server,
-                                ProviderRegistry& providers);
+                                ProviderRegistry& providers,
+                                providers::UsageLedger* usage = nullptr);
+
+/// The authenticated identity of the connection a request came in on;
+/// empty for open gateways and requests without a connection.
+[[nodiscard]] auto usage_caller(GatewayServer& server, const RequestContext& context)
+    -> std::string;
+
+/// Usage labels for a run: the provider and model, the sessionKey, agentId
+/// and channel params of the request, and the caller from usage_caller().
+/// Only the caller is not up to the request, so only caller budgets are
+/// enforced against a client that lies about the rest.
+[[nodiscard]] auto usage_labels(const nlohmann::json& params, std::string provider,
+                                std::string model, std::string caller)
+    -> providers::UsageLabels;
+
+/// The error response for a request over its hard usage budget, or nullopt.
+[[nodiscard]] auto usage_budget_refusal(providers::UsageLedger* usage,
+                                        const providers::UsageLabels& labels)
+    -> std::optional<nlohmann::json>;
 
 } // namespace openclaw::gateway
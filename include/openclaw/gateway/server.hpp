@@ -16,6 +16,7 @@
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/beast/core/tcp_stream.hpp>
 #include <boost/beast/websocket/stream.hpp>
@@ -25,7 +26,9 @@
 #include "openclaw/gateway/auth.hpp"
 #include "openclaw/gateway/frame.hpp"
 #include "openclaw/gateway/hooks.hpp"
+#include "openclaw/gateway/outbox.hpp"
 #include "openclaw/gateway/protocol.hpp"
+#include "openclaw/gateway/stream_buffer.hpp"
 #include "openclaw/infra/device.hpp"
 
 namespace openclaw::gateway {
@@ -36,7 +39,18 @@ namespace beast = boost::beast;
 namespace websocket = beast::websocket;
 using tcp = net::ip::tcp;
 
+/// Strips script tags, inline event handlers and javascript: URIs from an
+/// outgoing text message. Connection::send_text() applies it to every send.
+auto sanitize_outbound_text(std::string& text) -> void;
+
 /// Represents a single connected WebSocket client session.
+///
+/// All writes go through an Outbox drained by a single writer coroutine,
+/// so frames from different coroutines never interleave on the socket.
+/// Streamed deltas (send_delta()) are bounded by the stream limit and
+/// handled by the connection's StreamPolicy; other frames always queue.
+/// An outbox above GatewayServer::MAX_BUFFERED_BYTES closes the connection.
+/// Used from the io_context thread only.
 class Connection : public std::enable_shared_from_this<Connection> {
 public:
     using WsStream = websocket::stream<beast::tcp_stream>;
@@ -53,6 +67,23 @@ public:
     /// Send a raw string message.
     auto send_text(std::string message) -> awaitable<Result<void>>;
 
+    /// Send a binary message (see make_binary_frame()).
+    auto send_binary(std::string message) -> awaitable<Result<void>>;
+
+    /// Queue a frame without waiting for it to be written.
+    void post(const Frame& frame);
+
+    /// Queue a streamed delta: an event whose payload "text" continues the
+    /// previous delta with the same runId and stream. Suspends only under
+    /// StreamPolicy::Pause while the outbox is over the stream limit.
+    auto send_delta(const EventFrame& event) -> awaitable<void>;
+
+    void set_stream_policy(StreamPolicy policy, size_t limit_bytes);
+    [[nodiscard]] auto stream_policy() const noexcept -> StreamPolicy { return outbox_.policy(); }
+
+    /// Outbox occupancy and policy counters.
+    [[nodiscard]] auto stream_stats() const -> nlohmann::json;
+
     /// Close the connection.
     auto close() -> awaitable<void>;
 
@@ -80,6 +111,12 @@ private:
     auto handle_frame(const Frame& frame) -> awaitable<void>;
     auto handle_request(const RequestFrame& req) -> awaitable<void>;
 
+    auto write(std::string data, bool binary) -> awaitable<Result<void>>;
+    void enqueue(Outbox::Item item);
+    void start_writer();
+    auto write_loop() -> awaitable<void>;
+    void mark_closed();
+
     WsStream ws_;
     std::string id_;
     std::shared_ptr<Protocol> protocol_;
@@ -89,6 +126,10 @@ private:
     std::string device_public_key_;
     std::string connect_nonce_;
     std::atomic<bool> open_{true};
+
+    Outbox outbox_;
+    bool writing_ = false;
+    net::steady_timer writer_done_;
 };
 
 /// Callback type for new connection events.
@@ -180,9 +221,21 @@ public:
     /// Get the authenticator.
     [[nodiscard]] auto authenticator() -> Authenticator&;
 
-    /// Broadcast an event to all connected clients.
+    /// Broadcast an event to all connected clients. The event is queued on
+    /// each connection; this does not wait for slow clients.
     auto broadcast(const EventFrame& event) -> awaitable<void>;
 
+    /// Broadcast a streamed delta (see Connection::send_delta()). Waits
+    /// only for connections with StreamPolicy::Pause.
+    auto broadcast_delta(const EventFrame& event) -> awaitable<void>;
+
+    /// Outbox occupancy of every connection plus the run buffer metrics.
+    [[nodiscard]] auto stream_stats() const -> nlohmann::json;
+
+    /// The open connection with this id, or nullptr.
+    [[nodiscard]] auto find_connection(const std::string& id) const
+        -> std::shared_ptr<Connection>;
+
     /// Return current number of active connections.
     [[nodiscard]] auto connection_count() const noexcept -> size_t;
 
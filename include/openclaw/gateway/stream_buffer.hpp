@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string_view>
+
+#include <boost/asio/awaitable.hpp>
+#include <nlohmann/json.hpp>
+
+#include "openclaw/core/error.hpp"
+#include "openclaw/providers/provider.hpp"
+
+namespace openclaw::gateway {
+
+/// What a connection does with streamed deltas once its outbox is full.
+enum class StreamPolicy {
+    Pause,     // Hold the run until the outbox drains; the provider read stalls
+    Coalesce,  // Merge queued deltas of a run into one; drop when still full
+    Drop,      // Discard deltas; final and tool events are always sent
+};
+
+[[nodiscard]] auto parse_stream_policy(std::string_view name) -> std::optional<StreamPolicy>;
+[[nodiscard]] auto stream_policy_name(StreamPolicy policy) -> std::string_view;
+
+/// Process-wide counters of the run stream buffers.
+struct RunBufferMetrics {
+    std::atomic<int64_t> active_runs{0};
+    std::atomic<int64_t> buffered_bytes{0};
+    std::atomic<int64_t> paused_producers{0};
+    std::atomic<uint64_t> pauses{0};          // Times a producer had to wait
+    std::atomic<uint64_t> coalesced{0};       // Chunks merged into the previous one
+    std::atomic<uint64_t> dropped{0};         // Chunks dropped after the pause limit
+
+    [[nodiscard]] auto to_json() const -> nlohmann::json;
+};
+
+[[nodiscard]] auto run_buffer_metrics() -> RunBufferMetrics&;
+
+/// Bounded buffer between a provider's stream thread and the coroutine
+/// that fans a run's chunks out to the connections.
+///
+/// A text or thinking chunk is merged into the previous chunk when that
+/// one has the same type and has not been taken yet, so a consumer that
+/// falls behind receives fewer, larger deltas. Once `capacity` bytes are
+/// buffered, push() blocks the provider thread, which stops reading the
+/// provider socket until take() makes room. A producer that waits longer
+/// than `pause_limit` drops its chunk instead; the final response is
+/// assembled by the provider and does not depend on the deltas.
+class RunStreamBuffer {
+public:
+    explicit RunStreamBuffer(size_t capacity,
+                             std::chrono::milliseconds pause_limit = std::chrono::seconds(60));
+    ~RunStreamBuffer();
+
+    RunStreamBuffer(const RunStreamBuffer&) = delete;
+    auto operator=(const RunStreamBuffer&) -> RunStreamBuffer& = delete;
+
+    /// Producer side. Returns false if the chunk was dropped.
+    auto push(const providers::CompletionChunk& chunk) -> bool;
+
+    /// Consumer side: takes everything buffered and wakes a waiting producer.
+    auto take() -> std::deque<providers::CompletionChunk>;
+
+    /// Ends the run. Buffered chunks can still be taken; later pushes are
+    /// dropped and a waiting producer returns at once.
+    void close();
+
+    [[nodiscard]] auto closed() const -> bool;
+    [[nodiscard]] auto bytes() const -> size_t;
+
+private:
+    static auto size_of(const providers::CompletionChunk& chunk) -> size_t;
+
+    const size_t capacity_;
+    const std::chrono::milliseconds pause_limit_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable room_;
+    std::deque<providers::CompletionChunk> chunks_;
+    size_t bytes_ = 0;
+    bool closed_ = false;
+};
+
+/// Generates a run, calling its callback for every chunk, possibly from a
+/// thread of its own.
+using RunProducer = std::function<boost::asio::awaitable<Result<providers::CompletionResponse>>(
+    providers::StreamCallback)>;
+
+/// Delivers one chunk of a run to its clients.
+using RunChunkSink = std::function<boost::asio::awaitable<void>(const providers::CompletionChunk&)>;
+
+/// Streams a run through a RunStreamBuffer of `capacity` bytes. A consumer
+/// on the calling executor starts before `produce` does and hands chunks
+/// to `sink` while the run is still generating. Returns what `produce`
+/// returns once every chunk it pushed has been through `sink`; an
+/// exception from either side is rethrown after both have stopped.
+auto stream_run(size_t capacity, RunProducer produce, RunChunkSink sink,
+                std::chrono::milliseconds pause_limit = std::chrono::seconds(60))
+    -> boost::asio::awaitable<Result<providers::CompletionResponse>>;
+
+} // namespace openclaw::gateway
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <optional>
 #include <set>
 #include <string>
 #include <string_view>
@@ -23,9 +26,15 @@ enum class ToolProfile {
 
 /// Manages tool invocation authorization.
 /// Supports owner-only tools, tool groups, profiles, and allow/deny overrides.
+///
+/// Every change compiles the rules into a flat table indexed by tool id, so
+/// a check is one hash lookup and an array read. Tool names the policy has
+/// never seen are denied without touching the table.
 class ToolPolicy {
 public:
-    ToolPolicy() = default;
+    using ToolId = uint32_t;
+
+    ToolPolicy();
 
     /// Configure from gateway settings JSON.
     /// Expected keys: "tools.allow", "tools.deny", "tools.profile"
@@ -36,6 +45,14 @@ public:
     [[nodiscard]] auto is_allowed(std::string_view tool_name,
                                    std::string_view identity) const -> bool;
 
+    /// Same check for a tool id from tool_id(); ids stay valid for the
+    /// lifetime of the policy.
+    [[nodiscard]] auto is_allowed(ToolId id, std::string_view identity) const -> bool;
+
+    /// Resolves a tool name once so a catalog can be checked by id.
+    /// Returns nullopt for tools the policy never mentions (always denied).
+    [[nodiscard]] auto tool_id(std::string_view tool_name) const -> std::optional<ToolId>;
+
     /// Sets the owner identity (has access to owner-only tools).
     void set_owner(std::string_view owner_identity);
 
@@ -60,13 +77,30 @@ public:
 
     /// Returns the tools included in a given profile.
     [[nodiscard]] static auto profile_tools(ToolProfile profile)
-        -> std::unordered_set<std::string>;
+        -> const std::unordered_set<std::string>&;
 
 private:
+    /// Outcome of the rules for one tool; only owner-only tools depend on
+    /// the caller, so the identity never needs to be part of the key.
+    enum class Decision : uint8_t { Deny, Allow, OwnerOnly };
+
+    struct NameHash {
+        using is_transparent = void;
+        auto operator()(std::string_view name) const -> size_t {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    auto intern(std::string_view tool_name) -> ToolId;
+    void compile();
+
     std::string owner_identity_;
     ToolProfile profile_ = ToolProfile::Full;
     std::unordered_set<std::string> allow_list_;
     std::unordered_set<std::string> deny_list_;
+
+    std::unordered_map<std::string, ToolId, NameHash, std::equal_to<>> ids_;
+    std::vector<Decision> table_;
 };
 
 } // namespace openclaw::gateway
@@ -12,6 +12,14 @@
 
 namespace openclaw::infra {
 
+/// Readable text of a page fetched with FetchGuard::safe_fetch_text().
+struct FetchedText {
+    int status = 0;
+    std::string text;
+    bool truncated = false;  // Stopped at max_bytes; the rest was not downloaded
+    size_t bytes_read = 0;   // Bytes of HTML received
+};
+
 /// SSRF protection for outbound HTTP requests.
 /// Validates URLs against private/reserved IP ranges before allowing fetches.
 ///
@@ -47,6 +55,16 @@ public:
                     int max_redirects = 3)
         -> boost::asio::awaitable<openclaw::Result<HttpResponse>>;
 
+    /// Like safe_fetch(), but streams the body through an HtmlSanitizer as it
+    /// arrives and returns readable text of at most `max_bytes` (0 =
+    /// unlimited). The download stops as soon as the cap is reached.
+    auto safe_fetch_text(std::string_view url,
+                         HttpClient& http,
+                         boost::asio::io_context& ioc,
+                         size_t max_bytes,
+                         int max_redirects = 3)
+        -> boost::asio::awaitable<openclaw::Result<FetchedText>>;
+
     /// Extracts the origin (scheme + host + port) from a URL.
     [[nodiscard]] static auto extract_origin(std::string_view url) -> std::string;
 
@@ -57,13 +75,18 @@ public:
 
     /// Sanitizes HTML content by removing hidden/invisible elements that could
     /// contain prompt injection payloads. Strips elements with display:none,
-    /// visibility:hidden, sr-only class, aria-hidden, opacity:0, font-size:0.
+    /// visibility:hidden, sr-only class, aria-hidden, opacity:0, font-size:0,
+    /// and comments. Single pass; see HtmlSanitizer.
     [[nodiscard]] static auto sanitize_html_content(std::string_view html) -> std::string;
 
     /// Returns true if private IP access is currently allowed (trusted-network mode).
     [[nodiscard]] auto allows_private() const noexcept -> bool { return allow_private_; }
 
 private:
+    /// If `response` is a redirect with a Location, moves `current_url` to
+    /// it and returns true.
+    static auto follow_redirect(const HttpResponse& response, std::string& current_url) -> bool;
+
     /// Extracts hostname from a URL string.
     [[nodiscard]] static auto extract_hostname(std::string_view url) -> std::string;
 
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace openclaw::infra {
+
+/// Single-pass, streaming HTML sanitizer.
+///
+/// Input is fed in chunks as it arrives; a small tokenizer keeps only the
+/// tag, entity or end-tag candidate that straddles a chunk boundary, so
+/// memory is bounded by the output cap rather than by the document. There
+/// is no backtracking: every input byte is looked at once.
+///
+/// Elements that are invisible to a reader are dropped with everything
+/// inside them, in both output modes: inline styles with display:none,
+/// visibility:hidden, opacity:0 or font-size:0, the sr-only class,
+/// aria-hidden="true" and the hidden attribute. Comments are dropped too.
+/// A start tag longer than 16 KiB is treated as hidden.
+///
+/// Output::Html keeps everything else byte for byte. Output::Text emits
+/// readable text instead: tags, scripts, styles, noscript, template and svg
+/// are removed, entities are decoded, whitespace runs collapse to one space
+/// and block elements become line breaks.
+class HtmlSanitizer {
+public:
+    enum class Output { Html, Text };
+
+    struct Options {
+        Output output = Output::Text;
+        size_t max_bytes = 0;  // Output cap, cut on a UTF-8 boundary; 0 = unlimited
+    };
+
+    explicit HtmlSanitizer(Options options);
+    HtmlSanitizer() : HtmlSanitizer(Options{}) {}
+
+    /// Consumes the next chunk. Returns false once the output cap has been
+    /// reached; later input is ignored, so a streaming caller can stop
+    /// reading.
+    auto feed(std::string_view chunk) -> bool;
+
+    /// Ends the document (an unterminated tag is dropped) and returns the
+    /// output not yet taken.
+    auto finish() -> std::string;
+
+    /// Moves out the output produced so far.
+    auto take() -> std::string;
+
+    [[nodiscard]] auto truncated() const -> bool { return truncated_; }
+    [[nodiscard]] auto bytes_in() const -> size_t { return bytes_in_; }
+    [[nodiscard]] auto bytes_out() const -> size_t { return bytes_out_; }
+
+    /// Sanitizes a whole document in one call.
+    [[nodiscard]] static auto sanitize(std::string_view html, Options options) -> std::string;
+
+private:
+    enum class State { Data, Tag, Comment, RawText, Entity };
+
+    void step(char c);
+    void data(char c);
+    void tag(char c);
+    void comment(char c);
+    void raw_text(char c);
+    void entity(char c);
+    void handle_tag();
+    void end_raw_candidate(char c);
+
+    [[nodiscard]] auto skipping() const -> bool { return !skip_stack_.empty(); }
+    [[nodiscard]] auto text_mode() const -> bool { return options_.output == Output::Text; }
+
+    void emit(std::string_view s);       // Html mode: raw bytes
+    void text(char c);                   // Text mode: one character of text
+    void text(std::string_view s);
+    void text_run(std::string_view s);  // Text mode: a run without markup
+    void line_break(int count);
+    void flush_spacing();
+    void append(std::string_view s);
+
+    Options options_;
+    State state_ = State::Data;
+    std::string out_;
+
+    std::string tag_;          // Current tag, from '<'
+    char quote_ = 0;           // Quote of the attribute value being read
+    bool after_equals_ = false;
+    bool tag_overflow_ = false;
+    int dashes_ = 0;           // Trailing '-' seen inside a comment
+
+    std::string raw_name_;     // Element whose raw text is being read
+    std::string raw_match_;    // Candidate "</name" inside raw text
+
+    std::string entity_;
+
+    std::vector<std::string> open_;        // Elements open outside hidden ones
+    std::vector<std::string> skip_stack_;  // Element being dropped, then those open in it
+
+    bool has_text_ = false;    // Text mode: anything emitted yet
+    bool pending_space_ = false;
+    int pending_breaks_ = 0;
+
+    size_t bytes_in_ = 0;
+    size_t bytes_out_ = 0;
+    bool truncated_ = false;
+};
+
+} // namespace openclaw::infra
@@ -73,6 +73,15 @@ public:
                      HttpChunkCallback chunk_callback)
         -> boost::asio::awaitable<openclaw::Result<HttpResponse>>;
 
+    /// Performs a streaming HTTP GET request, with the same threading and
+    /// error-body behaviour as post_stream(). Returning false from the
+    /// callback ends the transfer early; the result is then the response's
+    /// status, without headers or body.
+    auto get_stream(std::string_view path,
+                    const std::map<std::string, std::string>& headers,
+                    HttpChunkCallback chunk_callback)
+        -> boost::asio::awaitable<openclaw::Result<HttpResponse>>;
+
     /// Performs an asynchronous HTTP PUT request.
     auto put(std::string_view path,
              std::string_view body,
@@ -92,6 +101,14 @@ public:
     [[nodiscard]] auto base_url() const -> const std::string&;
 
 private:
+    auto stream_request(std::string method,
+                        std::string_view path,
+                        std::string_view body,
+                        std::string_view content_type,
+                        const std::map<std::string, std::string>& headers,
+                        HttpChunkCallback chunk_callback)
+        -> boost::asio::awaitable<openclaw::Result<HttpResponse>>;
+
     struct Impl;
     std::unique_ptr<Impl> impl_;
 };
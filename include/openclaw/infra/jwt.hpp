@@ -1,8 +1,16 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <nlohmann/json.hpp>
 
@@ -32,4 +40,89 @@ auto verify_token(std::string_view token,
 auto decode_token_unverified(std::string_view token)
     -> openclaw::Result<json>;
 
+/// Checks a key set before it is used: at least one secret, none empty,
+/// and none still holding a `${VAR}` reference that was never resolved,
+/// which would make the variable's name the key.
+auto validate_jwt_secrets(const std::vector<std::string>& secrets)
+    -> openclaw::Result<void>;
+
+/// Counters of a JwtVerifier.
+struct JwtVerifierStats {
+    uint64_t hits = 0;      // Served from the cache
+    uint64_t misses = 0;    // Signature checked
+    uint64_t rejected = 0;  // Failed verification
+    uint64_t revoked = 0;   // Refused by revoke() or the revocation hook
+    size_t cached = 0;
+};
+
+/// Verifies HS256 tokens against a key set, caching the ones that pass.
+///
+/// The jwt-cpp verifiers are built once per key set, one per secret and
+/// tried in order, so a rotation can keep the previous secret valid for a
+/// while. set_keys() rebuilds them and clears the cache. A key set that
+/// fails validate_jwt_secrets() is never used: the constructor then
+/// refuses every token, and set_keys() keeps the current keys.
+///
+/// A validated token's claims are cached under the SHA-256 of the token
+/// until its `exp`; tokens without `exp` are never cached. When the cache
+/// is full, expired entries go first, then the one expiring soonest.
+/// Revocation applies to cached tokens too: revoke() refuses one token
+/// until it expires, and the revocation hook sees the claims of every
+/// token, cached or not. Thread-safe.
+class JwtVerifier {
+public:
+    struct Options {
+        size_t max_entries = 4096;
+        std::chrono::seconds leeway{5};  // Clock skew allowed on exp/nbf/iat
+    };
+
+    /// Returns true if a token with these claims must be refused.
+    using RevocationHook = std::function<bool(const json& claims)>;
+
+    explicit JwtVerifier(std::vector<std::string> secrets, Options options);
+    explicit JwtVerifier(std::vector<std::string> secrets)
+        : JwtVerifier(std::move(secrets), Options{}) {}
+    ~JwtVerifier();
+
+    JwtVerifier(const JwtVerifier&) = delete;
+    auto operator=(const JwtVerifier&) -> JwtVerifier& = delete;
+
+    /// Same contract as verify_token().
+    auto verify(std::string_view token) -> openclaw::Result<json>;
+
+    /// Replaces the key set (e.g. on rotation).
+    auto set_keys(std::vector<std::string> secrets) -> openclaw::Result<void>;
+
+    /// Refuses `token` from now on, until it expires.
+    void revoke(std::string_view token);
+
+    void set_revocation_hook(RevocationHook hook);
+
+    [[nodiscard]] auto stats() const -> JwtVerifierStats;
+
+private:
+    using Clock = std::chrono::system_clock;
+    struct Keys;  // Prebuilt jwt-cpp verifiers
+
+    struct Entry {
+        std::shared_ptr<const json> claims;
+        Clock::time_point expires;
+    };
+
+    [[nodiscard]] static auto digest(std::string_view token) -> std::string;
+
+    /// Evicts until there is room for one more entry. Called with mutex_ held.
+    void make_room(Clock::time_point now);
+
+    Options options_;
+    mutable std::mutex mutex_;
+    std::shared_ptr<const Keys> keys_;
+    uint64_t generation_ = 0;  // Bumped by set_keys()
+    std::shared_ptr<const RevocationHook> revocation_hook_;
+    std::unordered_map<std::string, Entry> cache_;
+    std::set<std::pair<Clock::time_point, std::string>> by_expiry_;
+    std::unordered_map<std::string, Clock::time_point> revoked_;
+    JwtVerifierStats stats_;
+};
+
 } // namespace openclaw::infra
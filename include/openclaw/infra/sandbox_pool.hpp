@@ -0,0 +1,128 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <nlohmann/json.hpp>
+
+#include "openclaw/agent/tool.hpp"
+#include "openclaw/core/config.hpp"
+#include "openclaw/core/error.hpp"
+
+namespace openclaw::infra {
+
+using boost::asio::awaitable;
+using json = nlohmann::json;
+
+/// Outcome of one snippet run by a SandboxPool.
+struct CodeRunResult {
+    int exit_code = 0;
+    std::string out;
+    std::string err;
+    bool truncated = false;  // Output went past max_output_bytes
+    bool reused = false;     // Ran on a worker that had served a job before
+    std::chrono::milliseconds duration{0};
+
+    [[nodiscard]] auto to_json() const -> json;
+};
+
+/// Runs code snippets on pools of pre-forked interpreter processes.
+///
+/// Each runtime keeps `workers` interpreters started ahead of time, each
+/// running a small job loop in a working directory of its own, so a job
+/// costs a round trip over a socket instead of an interpreter startup.
+/// Workers are forked with rlimits applied, optionally inside a cgroup of
+/// their own, and in an empty network namespace when `network_mode` is
+/// "none". After a job the worker's directory is emptied and the next job
+/// gets a fresh top-level namespace, but the interpreter itself is reused:
+/// imported modules, builtins a job patched and the like carry over until
+/// the worker is recycled. After `max_jobs_per_worker` jobs, a timeout,
+/// oversized output, a job that leaves processes running or anything
+/// unexpected, the worker and everything it started are killed and a new
+/// one is forked in its place. Set `max_jobs_per_worker` to 1 for a fresh
+/// interpreter per job.
+///
+/// Workers share the gateway's filesystem view: the working directory and
+/// limits bound a well-behaved snippet, not a hostile one. Untrusted code
+/// belongs in the Docker sandbox.
+///
+/// Linux only. Lives on the io_context thread.
+class SandboxPool : public std::enable_shared_from_this<SandboxPool> {
+public:
+    SandboxPool(boost::asio::io_context& ioc, CodeSandboxConfig config,
+                std::filesystem::path work_dir);
+    ~SandboxPool();
+
+    SandboxPool(const SandboxPool&) = delete;
+    SandboxPool& operator=(const SandboxPool&) = delete;
+
+    /// Validates the configuration and forks every runtime's workers.
+    /// Runtimes whose interpreter is not installed are skipped.
+    auto start() -> Result<void>;
+
+    /// Kills all workers; jobs in flight fail.
+    void stop();
+
+    /// Runs `code` on a worker of `runtime`, waiting for one to come free
+    /// within the job timeout.
+    auto run(std::string runtime, std::string code) -> awaitable<Result<CodeRunResult>>;
+
+    [[nodiscard]] auto runtimes() const -> std::vector<std::string>;
+    [[nodiscard]] auto stats() const -> json;
+
+private:
+    struct Worker;
+    struct Runtime {
+        std::string name;
+        std::vector<std::string> argv;  // Resolved interpreter, then the job loop
+        int memory_mb = 0;
+        bool job_in_child = false;
+        std::vector<std::shared_ptr<Worker>> slots;  // Null while a slot is empty
+        std::deque<std::shared_ptr<boost::asio::steady_timer>> waiters;
+        uint64_t jobs = 0;
+        uint64_t spawned = 0;
+        uint64_t recycled = 0;
+        uint64_t timeouts = 0;
+    };
+
+    auto spawn(Runtime& runtime, size_t slot) -> Result<std::shared_ptr<Worker>>;
+    auto prepare_dir(const std::string& name) -> Result<std::filesystem::path>;
+    auto join_cgroup(const Runtime& runtime, const std::string& name) -> int;
+    auto acquire(Runtime& runtime, std::chrono::steady_clock::time_point deadline)
+        -> awaitable<std::shared_ptr<Worker>>;
+    auto exchange(Worker& worker, const std::string& code) -> awaitable<Result<CodeRunResult>>;
+    auto reset(const Runtime& runtime, Worker& worker) -> bool;
+    void release(Runtime& runtime, const std::shared_ptr<Worker>& worker, bool recycle);
+    void retire(Worker& worker);
+
+    boost::asio::io_context& ioc_;
+    CodeSandboxConfig config_;
+    std::filesystem::path work_dir_;
+    std::map<std::string, Runtime> runtimes_;
+    bool isolate_network_ = true;
+    bool cgroup_warned_ = false;
+    bool stopped_ = true;
+};
+
+/// The `code_run` tool: runs `code` on the pool's runtime for `language`.
+class CodeRunTool : public agent::Tool {
+public:
+    explicit CodeRunTool(std::shared_ptr<SandboxPool> pool) : pool_(std::move(pool)) {}
+
+    [[nodiscard]] auto definition() const -> agent::ToolDefinition override;
+    auto execute(json params) -> awaitable<Result<json>> override;
+
+private:
+    std::shared_ptr<SandboxPool> pool_;
+};
+
+} // namespace openclaw::infra
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/types.h>
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "openclaw/core/error.hpp"
+
+namespace openclaw::infra {
+
+/// Owning file descriptor; closes on destruction.
+class FileHandle {
+public:
+    FileHandle() = default;
+    explicit FileHandle(int fd) : fd_(fd) {}
+    ~FileHandle();
+
+    FileHandle(FileHandle&& other) noexcept : fd_(other.release()) {}
+    auto operator=(FileHandle&& other) noexcept -> FileHandle&;
+    FileHandle(const FileHandle&) = delete;
+    auto operator=(const FileHandle&) -> FileHandle& = delete;
+
+    [[nodiscard]] auto get() const noexcept -> int { return fd_; }
+    [[nodiscard]] explicit operator bool() const noexcept { return fd_ >= 0; }
+
+    /// Gives up ownership without closing.
+    auto release() noexcept -> int;
+
+private:
+    int fd_ = -1;
+};
+
+/// File access confined to a set of workspace roots.
+///
+/// Each root is opened once as an O_PATH directory fd and kept. Paths are
+/// resolved relative to it by the kernel with openat2(RESOLVE_BENEATH |
+/// RESOLVE_NO_MAGICLINKS), so the containment check and the open are one
+/// atomic step and callers get back the descriptor that was checked rather
+/// than a path that could be swapped afterwards.
+///
+/// Where openat2 is unavailable (kernels before 5.6, seccomp filters), and
+/// for absolute symlinks that RESOLVE_BENEATH always refuses, open() walks
+/// the path itself, one O_NOFOLLOW openat() per component below the root
+/// descriptor. Symlinks are read and their targets walked in their place;
+/// an absolute target must name a path inside the same root.
+class WorkspaceFs {
+public:
+    explicit WorkspaceFs(std::vector<std::filesystem::path> roots);
+
+    /// Opens `path` with open(2)-style `flags`. Absolute paths must lie in
+    /// one of the roots; relative paths are taken against the first root.
+    /// Percent-encoding is decoded first, with the same fail-closed rules
+    /// as assert_no_path_alias_escape(). Regular files with more than one
+    /// hard link are rejected; O_TRUNC is applied only after that check.
+    ///
+    /// Returns ErrorCode::Forbidden for anything that would leave the
+    /// workspace, ErrorCode::NotFound for a missing path.
+    [[nodiscard]] auto open(const std::filesystem::path& path,
+                            int flags = O_RDONLY, mode_t mode = 0644) -> Result<FileHandle>;
+
+    /// Closes the cached root descriptors, e.g. after a root directory was
+    /// moved or recreated. They are reopened on next use.
+    void invalidate();
+
+    [[nodiscard]] auto roots() const -> const std::vector<std::filesystem::path>& {
+        return roots_;
+    }
+
+    /// Whether this process can use openat2 with RESOLVE_BENEATH.
+    [[nodiscard]] static auto beneath_supported() -> bool;
+
+private:
+    struct Root {
+        std::filesystem::path canonical;
+        FileHandle fd;  // O_PATH | O_DIRECTORY
+    };
+
+    /// Index of the root `path` lies in, and the part of `path` below it.
+    auto locate(const std::filesystem::path& path)
+        -> Result<std::pair<size_t, std::filesystem::path>>;
+    auto root(size_t index) -> Result<std::shared_ptr<const Root>>;
+    auto open_beneath(int root_fd, const std::filesystem::path& relative,
+                      int flags, mode_t mode) -> Result<FileHandle>;
+    auto open_walk(size_t index, const Root& root, const std::filesystem::path& relative,
+                   int flags, mode_t mode) -> Result<FileHandle>;
+
+    std::vector<std::filesystem::path> roots_;
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<const Root>> cache_;  // Lazily opened, one per root
+};
+
+} // namespace openclaw::infra
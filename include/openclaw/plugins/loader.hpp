@@ -1,26 +1,77 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include "openclaw/agent/tool_registry.hpp"
+#include "openclaw/core/config.hpp"
 #include "openclaw/core/error.hpp"
 #include "openclaw/plugins/plugin.hpp"
+#include "openclaw/plugins/sdk.hpp"
 
 namespace openclaw::plugins {
 
+/// Returns true if `path` has the platform's shared library extension.
+[[nodiscard]] auto is_plugin_library(const std::filesystem::path& path) -> bool;
+
+/// One loaded instance of a plugin and everything it registered.
+///
+/// The instance is shared by the loader's published snapshot and by every
+/// tool and method handed out from it, so the library stays mapped until
+/// the last in-flight call returns. Members are destroyed in reverse order:
+/// registrations, then the plugin, then the library handle.
+struct LoadedPlugin {
+    std::shared_ptr<void> library;  // Closed on last release
+    std::unique_ptr<Plugin> plugin;
+    std::vector<std::unique_ptr<agent::Tool>> tools;
+    std::vector<std::unique_ptr<channels::Channel>> channels;
+    std::vector<PluginMethod> methods;
+    std::vector<std::string> published_methods;  // Names the gateway registered
+
+    std::string name;
+    std::string version;
+    std::filesystem::path path;
+    uint64_t generation = 0;        // Increases with every load
+
+    /// The plugin's tools, each keeping this instance alive while held.
+    [[nodiscard]] static auto shared_tools(const std::shared_ptr<LoadedPlugin>& self)
+        -> std::vector<std::shared_ptr<agent::Tool>>;
+};
+
 /// Dynamically loads plugin shared libraries using dlopen/dlsym (Unix)
 /// or LoadLibrary/GetProcAddress (Windows, future).
 ///
-/// Loaded plugins are tracked by name. The loader takes ownership of both
-/// the dlopen handle and the plugin instance, ensuring proper unload order
-/// (plugin destroyed before dlclose).
+/// Loaded plugins are tracked by name in an immutable snapshot. Loading a
+/// plugin that is already loaded is a reload: the new library is opened
+/// and initialized off to the side, then swapped in atomically. The old
+/// instance is retired rather than closed; it is unloaded once the calls
+/// still running its tools or methods have drained. A failed reload leaves
+/// the previous instance published.
+///
+/// Reads (get, find, snapshot) never take the writer lock.
 class PluginLoader {
 public:
-    PluginLoader() = default;
+    using PluginMap = std::unordered_map<std::string, std::shared_ptr<LoadedPlugin>>;
+
+    /// Called after every swap, under the loader's writer lock. `retired`
+    /// is null for a first load and `published` is null for an unload.
+    using SwapHandler = std::function<void(const std::shared_ptr<LoadedPlugin>& retired,
+                                           const std::shared_ptr<LoadedPlugin>& published)>;
+
+    PluginLoader();
+
+    /// @param config    Host configuration exposed to plugins via the SDK.
+    /// @param data_dir  Parent of each plugin's data directory.
+    PluginLoader(const Config& config, std::filesystem::path data_dir);
+
     ~PluginLoader();
 
     // Non-copyable, non-movable (owns dlopen handles).
@@ -29,7 +80,14 @@ public:
     PluginLoader(PluginLoader&&) = delete;
     PluginLoader& operator=(PluginLoader&&) = delete;
 
-    /// Load a single plugin from a shared library file.
+    /// Subscribe to swaps, e.g. to mirror plugin methods into a registry.
+    void on_swap(SwapHandler handler);
+
+    /// Keep `tools` in step with the plugins' tools across loads,
+    /// reloads and unloads.
+    void publish_tools(agent::ToolRegistry& tools);
+
+    /// Load (or reload) a single plugin from a shared library file.
     /// @param path  Path to the .so / .dylib file.
     /// @returns     Non-owning pointer to the loaded plugin on success.
     auto load(const std::filesystem::path& path) -> Result<Plugin*>;
@@ -41,29 +99,52 @@ public:
     auto load_all(const std::filesystem::path& dir)
         -> Result<std::vector<Plugin*>>;
 
-    /// Unload a plugin by name, destroying the instance and closing the library.
+    /// Reload a plugin by name from the path it was loaded from.
+    auto reload(std::string_view name) -> Result<Plugin*>;
+
+    /// Unpublish a plugin by name. The library is closed once calls in
+    /// flight through it have returned.
     auto unload(std::string_view name) -> Result<void>;
 
     /// Unload all plugins.
     auto unload_all() -> void;
 
     /// Returns a non-owning pointer to a loaded plugin by name, or nullptr.
+    /// Prefer find() when the plugin must survive a concurrent reload.
     [[nodiscard]] auto get(std::string_view name) const -> Plugin*;
 
+    /// Returns the loaded instance of a plugin by name, or nullptr.
+    [[nodiscard]] auto find(std::string_view name) const -> std::shared_ptr<LoadedPlugin>;
+
+    /// The currently published plugins.
+    [[nodiscard]] auto snapshot() const -> std::shared_ptr<const PluginMap>;
+
     /// Returns the names of all currently loaded plugins.
-    [[nodiscard]] auto loaded_names() const -> std::vector<std::string_view>;
+    [[nodiscard]] auto loaded_names() const -> std::vector<std::string>;
 
     /// Returns the number of loaded plugins.
     [[nodiscard]] auto size() const noexcept -> size_t;
 
+    /// Retired instances still kept alive by calls in flight.
+    [[nodiscard]] auto draining() -> size_t;
+
 private:
-    struct LoadedPlugin {
-        void* handle = nullptr;
-        std::unique_ptr<Plugin> plugin;
-        std::filesystem::path path;
-    };
+    /// Opens, instantiates and initializes a plugin without publishing it.
+    auto open(const std::filesystem::path& path) -> Result<std::shared_ptr<LoadedPlugin>>;
+
+    /// Publishes `next` under `name` (or removes `name` if null) and
+    /// notifies swap handlers. Caller holds write_mutex_.
+    void swap_locked(const std::string& name, std::shared_ptr<LoadedPlugin> next);
+
+    Config config_;
+    std::filesystem::path data_dir_;
+    std::filesystem::path shadow_dir_;  // Private copies of libraries being opened
 
-    std::unordered_map<std::string, LoadedPlugin> loaded_;
+    std::atomic<std::shared_ptr<const PluginMap>> plugins_;
+    std::mutex write_mutex_;
+    std::vector<SwapHandler> swap_handlers_;
+    std::vector<std::weak_ptr<LoadedPlugin>> retired_;
+    std::atomic<uint64_t> generation_{0};
 };
 
 } // namespace openclaw::plugins
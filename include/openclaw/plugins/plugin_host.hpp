@@ -0,0 +1,136 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <nlohmann/json.hpp>
+
+#include "openclaw/agent/tool_registry.hpp"
+#include "openclaw/core/config.hpp"
+#include "openclaw/core/error.hpp"
+
+namespace openclaw::plugins {
+
+using boost::asio::awaitable;
+using json = nlohmann::json;
+
+/// Descriptors a plugin host process inherits from the gateway.
+struct PluginHostEndpoint {
+    int memfd = -1;         // Shared region: request ring, then response ring
+    int request_fd = -1;    // eventfd doorbell, gateway -> host
+    int response_fd = -1;   // eventfd doorbell, host -> gateway
+    size_t ring_bytes = 0;  // Data bytes of each ring
+};
+
+/// Options for running one plugin library out of process.
+struct PluginHostOptions {
+    std::filesystem::path library;
+
+    /// Host program and its leading arguments. The endpoint and library
+    /// are appended as --memfd, --request-fd, --response-fd, --ring-bytes
+    /// and --library. Empty runs this executable's `plugin-host` command.
+    std::vector<std::string> command;
+
+    size_t ring_bytes = 1 << 20;  // Per direction; also caps one message
+    std::chrono::milliseconds call_timeout{60000};
+    std::chrono::milliseconds restart_delay{100};        // Doubles per crash
+    std::chrono::milliseconds max_restart_delay{10000};
+    std::chrono::milliseconds stable_after{30000};       // Uptime that resets the delay
+};
+
+/// Runs a plugin in a child process and forwards tool calls to it.
+///
+/// Calls travel through two single-producer rings (ShmRing) in a memfd
+/// region mapped by both processes, each with an eventfd doorbell, so a
+/// call costs two wakeups and no socket copies. A slow plugin no longer
+/// stalls the gateway's io_context, and a crashing one only fails the
+/// calls it had in flight: the host is restarted with exponential backoff
+/// and its tools are republished once the new process reports ready.
+///
+/// Linux only. Lives on the io_context thread.
+class PluginHost : public std::enable_shared_from_this<PluginHost> {
+public:
+    /// Receives the plugin's tools (as proxies) each time a host process
+    /// reports ready.
+    using ToolsHandler = std::function<void(std::vector<std::shared_ptr<agent::Tool>>)>;
+
+    PluginHost(boost::asio::io_context& ioc, PluginHostOptions options);
+    ~PluginHost();
+
+    PluginHost(const PluginHost&) = delete;
+    PluginHost& operator=(const PluginHost&) = delete;
+
+    /// Spawns the host process. Tools become callable once it is ready.
+    auto start() -> Result<void>;
+
+    /// Stops the host process and fails calls in flight. No restart.
+    void stop();
+
+    void on_tools(ToolsHandler handler);
+
+    /// Keep `tools` in step with the plugin's tools across restarts.
+    void publish_tools(agent::ToolRegistry& tools);
+
+    /// Invoke `tool` in the host process.
+    auto call(std::string tool, json params) -> awaitable<Result<json>>;
+
+    [[nodiscard]] auto name() const -> const std::string& { return name_; }
+    [[nodiscard]] auto version() const -> const std::string& { return version_; }
+    [[nodiscard]] auto library() const -> const std::filesystem::path& { return options_.library; }
+    [[nodiscard]] auto ready() const -> bool { return ready_; }
+    [[nodiscard]] auto pid() const -> int;
+    [[nodiscard]] auto restarts() const -> uint64_t { return restarts_; }
+
+private:
+    struct Process;
+    struct PendingCall {
+        boost::asio::steady_timer timer;
+        std::optional<Result<json>> result;
+        explicit PendingCall(boost::asio::io_context& ioc) : timer(ioc) {}
+    };
+
+    auto spawn() -> Result<void>;
+    auto read_responses(std::shared_ptr<Process> process) -> awaitable<void>;
+    auto watch_exit(std::shared_ptr<Process> process) -> awaitable<void>;
+    auto restart_later(std::chrono::milliseconds delay) -> awaitable<void>;
+    void handle_message(const std::string& message);
+    void fail_pending(const Error& error);
+
+    boost::asio::io_context& ioc_;
+    PluginHostOptions options_;
+    std::shared_ptr<Process> process_;
+    std::unordered_map<uint64_t, std::shared_ptr<PendingCall>> pending_;
+    std::vector<ToolsHandler> tools_handlers_;
+    std::string name_;
+    std::string version_;
+    uint64_t next_id_ = 1;
+    uint64_t restarts_ = 0;
+    std::chrono::milliseconds next_delay_;
+    bool ready_ = false;
+    bool stopped_ = false;
+};
+
+/// Serves tool calls arriving over `endpoint` until the process is killed.
+/// Runs its own io_context; returns non-zero if the endpoint is unusable.
+auto serve_plugin_host(const PluginHostEndpoint& endpoint,
+                       std::string name, std::string version,
+                       std::vector<std::shared_ptr<agent::Tool>> tools) -> int;
+
+/// Body of the `plugin-host` command: loads `library` in this process and
+/// serves its tools over `endpoint`.
+auto run_plugin_host(const PluginHostEndpoint& endpoint,
+                     const std::filesystem::path& library,
+                     const Config& config,
+                     const std::filesystem::path& data_dir) -> int;
+
+} // namespace openclaw::plugins
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include <boost/asio/awaitable.hpp>
 #include <nlohmann/json.hpp>
 
 #include "openclaw/agent/tool.hpp"
@@ -17,6 +19,14 @@ namespace openclaw::plugins {
 
 using json = nlohmann::json;
 
+/// Gateway RPC method contributed by a plugin. The handler has the same
+/// shape as a gateway MethodHandler: params in, result out.
+struct PluginMethod {
+    std::string name;
+    std::string description;
+    std::function<boost::asio::awaitable<json>(json params)> handler;
+};
+
 /// SDK context exposed to plugins during initialization.
 ///
 /// Provides methods for plugins to register tools, channels, and other
@@ -45,6 +55,12 @@ public:
     /// Ownership of the channel is transferred to the host.
     auto register_channel(std::unique_ptr<openclaw::channels::Channel> channel) -> void;
 
+    /// Register a gateway RPC method. Plugin methods are published together
+    /// with the plugin's tools and replaced as a set when it is reloaded.
+    auto register_method(std::string name, std::string description,
+                         std::function<boost::asio::awaitable<json>(json params)> handler)
+        -> void;
+
     /// Log a message at the given level through the host's logger.
     /// @param level   One of: "trace", "debug", "info", "warn", "error", "fatal".
     /// @param message The log message.
@@ -63,11 +79,15 @@ public:
     /// Returns all channels registered by plugins via this SDK.
     [[nodiscard]] auto channels() -> std::vector<std::unique_ptr<openclaw::channels::Channel>>&;
 
+    /// Returns all RPC methods registered by plugins via this SDK.
+    [[nodiscard]] auto methods() -> std::vector<PluginMethod>&;
+
 private:
     json config_json_;
     std::filesystem::path data_dir_;
     std::vector<std::unique_ptr<openclaw::agent::Tool>> tools_;
     std::vector<std::unique_ptr<openclaw::channels::Channel>> channels_;
+    std::vector<PluginMethod> methods_;
 };
 
 } // namespace openclaw::plugins
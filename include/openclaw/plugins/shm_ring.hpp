@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace openclaw::plugins {
+
+/// Single-producer, single-consumer ring of length-prefixed messages laid
+/// out in a caller-provided memory region, typically shared between the
+/// gateway and a plugin host process.
+///
+/// Positions are monotonically increasing byte counters; the producer only
+/// writes `head` and the consumer only writes `tail`, so no locks are
+/// needed. Each message is a 4-byte length followed by the payload, padded
+/// to 8 bytes and never split across the end of the buffer: when it does
+/// not fit, a wrap marker sends the consumer back to offset 0.
+///
+/// The region may be shared with a process that is not trusted, so the
+/// consumer never believes it: the capacity is the one this side was
+/// created or attached with, and a record that does not fit the ring
+/// marks it corrupt() instead of being read.
+class ShmRing {
+public:
+    /// Shared control block at the start of the region. Head and tail sit
+    /// on separate cache lines so producer and consumer do not false-share.
+    struct Header {
+        alignas(64) std::atomic<uint64_t> head;  // Next write position
+        alignas(64) std::atomic<uint64_t> tail;  // Next read position
+        alignas(64) uint64_t capacity;           // Data bytes, a power of two
+    };
+    static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                  "ShmRing needs address-free 64-bit atomics");
+
+    /// Bytes needed for a ring with `capacity` data bytes (rounded up to a
+    /// power of two, at least 64).
+    [[nodiscard]] static auto region_size(size_t capacity) -> size_t;
+
+    /// Formats `region` (of at least region_size(capacity) bytes) as an
+    /// empty ring. Done once, by whichever side creates the region.
+    [[nodiscard]] static auto create(void* region, size_t capacity) -> ShmRing;
+
+    /// Attaches to a ring that create() formatted with the same `capacity`.
+    [[nodiscard]] static auto attach(void* region, size_t capacity) -> ShmRing;
+
+    /// Appends a message. Returns false if the ring lacks room right now
+    /// or the message exceeds max_message_size().
+    auto try_push(std::string_view message) -> bool;
+
+    /// Removes the oldest message into `out`. Returns false if empty, or
+    /// if the ring is corrupt(), from then on.
+    auto try_pop(std::string& out) -> bool;
+
+    /// Whether try_pop() met a record the producer could not have written.
+    [[nodiscard]] auto corrupt() const -> bool { return corrupt_; }
+
+    [[nodiscard]] auto empty() const -> bool;
+
+    /// Largest message that is guaranteed to fit into an empty ring.
+    [[nodiscard]] auto max_message_size() const -> size_t;
+
+    [[nodiscard]] auto capacity() const -> size_t { return capacity_; }
+
+private:
+    ShmRing(Header* header, char* data, size_t capacity)
+        : header_(header), data_(data), capacity_(capacity) {}
+
+    Header* header_;
+    char* data_;
+    size_t capacity_;  // Never re-read from the shared header
+    bool corrupt_ = false;
+};
+
+} // namespace openclaw::plugins
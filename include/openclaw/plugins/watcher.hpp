@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include "openclaw/core/error.hpp"
+#include "openclaw/plugins/loader.hpp"
+
+namespace openclaw::plugins {
+
+/// Reloads plugins when their libraries change on disk.
+///
+/// Watches one directory with inotify. A library that is written or moved
+/// in is (re)loaded through the PluginLoader, which swaps it in without
+/// dropping calls in flight; a library that is deleted or moved out is
+/// unloaded. Events are debounced so a build or copy that touches the
+/// file several times triggers a single reload. Linux only; start()
+/// fails elsewhere.
+///
+/// Runs on the io_context thread and must outlive it.
+class PluginWatcher {
+public:
+    PluginWatcher(boost::asio::io_context& ioc, PluginLoader& loader,
+                  std::filesystem::path dir,
+                  std::chrono::milliseconds debounce = std::chrono::milliseconds(250));
+    ~PluginWatcher();
+
+    PluginWatcher(const PluginWatcher&) = delete;
+    PluginWatcher& operator=(const PluginWatcher&) = delete;
+
+    /// Start watching. Existing libraries are not loaded; use
+    /// PluginLoader::load_all() first.
+    auto start() -> Result<void>;
+
+    void stop();
+
+    [[nodiscard]] auto directory() const -> const std::filesystem::path& { return dir_; }
+
+private:
+    enum class Change { Written, Removed };
+
+    auto read_loop() -> boost::asio::awaitable<void>;
+    auto debounce_loop() -> boost::asio::awaitable<void>;
+    void apply_pending();
+
+    boost::asio::io_context& ioc_;
+    PluginLoader& loader_;
+    std::filesystem::path dir_;
+    std::chrono::milliseconds debounce_;
+    boost::asio::posix::stream_descriptor stream_;
+    boost::asio::steady_timer timer_;
+    std::map<std::filesystem::path, Change> pending_;  // Latest change per file
+    bool running_ = false;
+};
+
+} // namespace openclaw::plugins
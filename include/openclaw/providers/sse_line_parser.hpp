@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace openclaw::providers {
+
+/// Incremental SSE line parser for streaming responses.
+/// Handles partial lines spanning chunk boundaries.
+class SseLineParser {
+public:
+    using LineCallback = std::function<void(std::string_view data_line)>;
+
+    explicit SseLineParser(LineCallback cb) : cb_(std::move(cb)) {}
+
+    /// Feed raw bytes from an HTTP chunk. Parses complete lines and
+    /// invokes the callback for each "data: ..." line.
+    void feed(const char* data, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            char c = data[i];
+            if (c == '\n') {
+                // Remove trailing \r
+                if (!partial_.empty() && partial_.back() == '\r') {
+                    partial_.pop_back();
+                }
+                process_line(partial_);
+                partial_.clear();
+            } else {
+                partial_ += c;
+            }
+        }
+    }
+
+private:
+    void process_line(const std::string& line) {
+        if (line.starts_with("data: ")) {
+            auto data_part = std::string_view(line).substr(6);
+            if (data_part != "[DONE]") {
+                cb_(data_part);
+            }
+        }
+    }
+
+    LineCallback cb_;
+    std::string partial_;
+};
+
+} // namespace openclaw::providers
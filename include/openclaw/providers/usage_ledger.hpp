@@ -0,0 +1,187 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <nlohmann/json.hpp>
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "openclaw/core/config.hpp"
+#include "openclaw/core/error.hpp"
+#include "openclaw/core/types.hpp"
+
+namespace openclaw::providers {
+
+using json = nlohmann::json;
+
+/// The dimensions usage is aggregated by. Empty means unknown.
+///
+/// session, agent and channel are whatever the request claimed; caller is
+/// the authenticated identity of the connection it arrived on, so only
+/// caller budgets cannot be dodged by changing the request.
+struct UsageLabels {
+    std::string provider;
+    std::string model;
+    std::string session;
+    std::string agent;
+    std::string channel;
+    std::string caller;
+
+    auto operator==(const UsageLabels&) const -> bool = default;
+};
+
+/// Token usage of one run (all provider calls of one request).
+struct UsageEvent {
+    UsageLabels labels;
+    int64_t input_tokens = 0;
+    int64_t output_tokens = 0;
+    Timestamp at = Clock::now();
+};
+
+struct UsageTotals {
+    int64_t runs = 0;
+    int64_t input_tokens = 0;
+    int64_t output_tokens = 0;
+    int64_t cost_micros = 0;  // Millionths of a USD
+
+    void add(const UsageTotals& other);
+    [[nodiscard]] auto cost_usd() const -> double {
+        return static_cast<double>(cost_micros) / 1e6;
+    }
+};
+
+struct UsageQuery {
+    std::optional<Timestamp> from;             // Inclusive, rounded down to a bucket
+    std::optional<Timestamp> to;               // Exclusive
+    std::vector<std::string> group_by;         // Dimensions, or "bucket"
+    std::map<std::string, std::string> where;  // Dimension -> value
+    size_t limit = 100;                        // Rows, most expensive first
+};
+
+struct UsageRow {
+    json keys = json::object();  // group_by entry -> value; "bucket" in unix ms
+    UsageTotals totals;
+};
+
+enum class BudgetState { Ok, Soft, Hard };
+
+struct BudgetStatus {
+    BudgetState state = BudgetState::Ok;
+    std::string tenant;  // "<dimension>:<key>" of the budget that decided it
+    double spent_usd = 0.0;
+    double limit_usd = 0.0;
+};
+
+/// Meters token usage and cost.
+///
+/// record() adds an event to in-memory totals keyed by time bucket and
+/// labels; it costs one hash lookup under a mutex and never touches the
+/// database. flush() upserts those totals into the usage_rollup table, one
+/// row per bucket and label combination, so the table grows with the
+/// number of active combinations rather than with traffic. Raw events are
+/// not stored: queries aggregate the rollups.
+///
+/// Cost is computed when an event is recorded, from the configured price
+/// table. Budgets keep their current period's spend in memory (seeded from
+/// the table on open), so check_budget() needs no query.
+///
+/// flush_loop() and async_query() run their SQLite work on a thread of
+/// the ledger's own, so a slow disk never stalls the io_context.
+class UsageLedger {
+public:
+    /// Opens (or creates) the rollup table at `db_path`; ":memory:" works.
+    UsageLedger(const UsageConfig& config, const std::string& db_path);
+
+    /// Flushes what is still pending.
+    ~UsageLedger();
+
+    UsageLedger(const UsageLedger&) = delete;
+    auto operator=(const UsageLedger&) -> UsageLedger& = delete;
+
+    void record(const UsageEvent& event);
+
+    /// The strictest state of the budgets that apply to these labels.
+    [[nodiscard]] auto check_budget(const UsageLabels& labels,
+                                    Timestamp now = Clock::now()) -> BudgetStatus;
+
+    /// Status of every configured budget.
+    [[nodiscard]] auto budgets(Timestamp now = Clock::now()) -> json;
+
+    /// Writes the pending totals. Returns the number of rollup rows touched.
+    auto flush() -> Result<size_t>;
+
+    /// Flushes, then aggregates the rollups matching the query. Blocks.
+    auto query(const UsageQuery& query) -> Result<std::vector<UsageRow>>;
+
+    /// query() on the database thread, resuming on the caller's executor.
+    auto async_query(UsageQuery query)
+        -> boost::asio::awaitable<Result<std::vector<UsageRow>>>;
+
+    /// Flushes every flush_interval_seconds, on the database thread, until
+    /// stop().
+    auto flush_loop() -> boost::asio::awaitable<void>;
+    void stop();
+
+    /// Cost in millionths of a USD; 0 for a model without a price.
+    [[nodiscard]] auto cost_micros(std::string_view model, int64_t input_tokens,
+                                   int64_t output_tokens) const -> int64_t;
+
+    [[nodiscard]] static auto is_dimension(std::string_view name) -> bool;
+
+private:
+    struct RollupKey {
+        int64_t bucket = 0;  // Bucket start, unix seconds
+        UsageLabels labels;
+        auto operator==(const RollupKey&) const -> bool = default;
+    };
+    struct RollupKeyHash {
+        auto operator()(const RollupKey& key) const noexcept -> size_t;
+    };
+    using Pending = std::unordered_map<RollupKey, UsageTotals, RollupKeyHash>;
+
+    struct Budget {
+        UsageBudgetConfig config;
+        int64_t soft_micros = 0;
+        int64_t hard_micros = 0;
+        int64_t period_start = 0;  // Unix seconds
+        int64_t spent_micros = 0;
+        bool warned = false;
+    };
+
+    void init_schema();
+    void migrate_schema();
+    void seed_budgets();
+    auto write(const Pending& rows) -> size_t;
+    auto bucket_of(Timestamp at) const -> int64_t;
+    static auto period_start(const UsageBudgetConfig& budget, Timestamp at) -> int64_t;
+    static auto label(const UsageLabels& labels, std::string_view dimension)
+        -> const std::string&;
+    void roll(Budget& budget, Timestamp now);
+    auto status_of(const Budget& budget) const -> BudgetStatus;
+
+    UsageConfig config_;
+    std::vector<ModelPriceConfig> prices_;  // Longest model name first
+
+    std::mutex mutex_;  // pending_, budgets_
+    Pending pending_;
+    std::vector<Budget> budgets_;
+
+    std::mutex db_mutex_;
+    std::unique_ptr<SQLite::Database> db_;
+    boost::asio::thread_pool db_thread_{1};
+
+    std::atomic<bool> stopped_{false};
+};
+
+} // namespace openclaw::providers
@@ -4,7 +4,18 @@
 
 namespace openclaw::agent {
 
-void ToolRegistry::register_tool(std::unique_ptr<Tool> tool) {
+ToolRegistry::ToolRegistry()
+    : tools_(std::make_shared<const ToolMap>()) {}
+
+template <typename Change>
+void ToolRegistry::update(Change&& change) {
+    std::lock_guard lock(write_mutex_);
+    auto next = std::make_shared<ToolMap>(*tools_.load(std::memory_order_acquire));
+    change(*next);
+    tools_.store(std::move(next), std::memory_order_release);
+}
+
+void ToolRegistry::register_tool(std::shared_ptr<Tool> tool) {
     if (!tool) {
         LOG_WARN("Attempted to register a null tool");
         return;
@@ -13,36 +24,58 @@ void ToolRegistry::register_tool(std::unique_ptr<Tool> tool) {
     auto def = tool->definition();
     auto name = def.name;
 
-    if (tools_.contains(name)) {
-        LOG_WARN("Replacing existing tool: {}", name);
-    } else {
-        LOG_INFO("Registered tool: {}", name);
-    }
+    update([&](ToolMap& tools) {
+        if (tools.contains(name)) {
+            LOG_WARN("Replacing existing tool: {}", name);
+        } else {
+            LOG_INFO("Registered tool: {}", name);
+        }
+        tools[std::move(name)] = std::move(tool);
+    });
+}
 
-    tools_[std::move(name)] = std::move(tool);
+void ToolRegistry::replace(const std::vector<std::string>& remove,
+                           std::vector<std::shared_ptr<Tool>> add) {
+    update([&](ToolMap& tools) {
+        for (const auto& name : remove) {
+            tools.erase(name);
+        }
+        for (auto& tool : add) {
+            if (tool) {
+                tools[tool->definition().name] = std::move(tool);
+            }
+        }
+    });
+    LOG_INFO("Replaced tools: {} removed, {} added", remove.size(), add.size());
 }
 
 auto ToolRegistry::get(std::string_view name) -> Tool* {
-    auto it = tools_.find(std::string(name));
-    if (it != tools_.end()) {
-        return it->second.get();
-    }
-    return nullptr;
+    return find(name).get();
 }
 
 auto ToolRegistry::get(std::string_view name) const -> const Tool* {
-    auto it = tools_.find(std::string(name));
-    if (it != tools_.end()) {
-        return it->second.get();
+    return find(name).get();
+}
+
+auto ToolRegistry::find(std::string_view name) const -> std::shared_ptr<Tool> {
+    auto tools = snapshot();
+    auto it = tools->find(std::string(name));
+    if (it != tools->end()) {
+        return it->second;
     }
     return nullptr;
 }
 
+auto ToolRegistry::snapshot() const -> std::shared_ptr<const ToolMap> {
+    return tools_.load(std::memory_order_acquire);
+}
+
 auto ToolRegistry::list() const -> std::vector<ToolDefinition> {
     std::vector<ToolDefinition> defs;
-    defs.reserve(tools_.size());
+    auto tools = snapshot();
+    defs.reserve(tools->size());
 
-    for (const auto& [name, tool] : tools_) {
+    for (const auto& [name, tool] : *tools) {
         defs.push_back(tool->definition());
     }
 
@@ -51,9 +84,10 @@ auto ToolRegistry::list() const -> std::vector<ToolDefinition> {
 
 auto ToolRegistry::to_json() const -> std::vector<json> {
     std::vector<json> result;
-    result.reserve(tools_.size());
+    auto tools = snapshot();
+    result.reserve(tools->size());
 
-    for (const auto& [name, tool] : tools_) {
+    for (const auto& [name, tool] : *tools) {
         result.push_back(tool->definition().to_json());
     }
 
@@ -62,9 +96,10 @@ auto ToolRegistry::to_json() const -> std::vector<json> {
 
 auto ToolRegistry::to_anthropic_json() const -> std::vector<json> {
     std::vector<json> result;
-    result.reserve(tools_.size());
+    auto tools = snapshot();
+    result.reserve(tools->size());
 
-    for (const auto& [name, tool] : tools_) {
+    for (const auto& [name, tool] : *tools) {
         result.push_back(tool->definition().to_anthropic_json());
     }
 
@@ -73,9 +108,10 @@ auto ToolRegistry::to_anthropic_json() const -> std::vector<json> {
 
 auto ToolRegistry::to_openai_json() const -> std::vector<json> {
     std::vector<json> result;
-    result.reserve(tools_.size());
+    auto tools = snapshot();
+    result.reserve(tools->size());
 
-    for (const auto& [name, tool] : tools_) {
+    for (const auto& [name, tool] : *tools) {
         result.push_back(tool->definition().to_openai_json());
     }
 
@@ -85,7 +121,8 @@ auto ToolRegistry::to_openai_json() const -> std::vector<json> {
 auto ToolRegistry::execute(std::string_view name, json params)
     -> boost::asio::awaitable<Result<json>> {
 
-    auto* tool = get(name);
+    // Held across the call so a concurrent replace cannot free the tool
+    auto tool = find(name);
     if (!tool) {
         co_return make_fail(make_error(
             ErrorCode::NotFound,
@@ -107,26 +144,28 @@ auto ToolRegistry::execute(std::string_view name, json params)
 }
 
 auto ToolRegistry::size() const noexcept -> std::size_t {
-    return tools_.size();
+    return snapshot()->size();
 }
 
 auto ToolRegistry::contains(std::string_view name) const -> bool {
-    return tools_.contains(std::string(name));
+    return snapshot()->contains(std::string(name));
 }
 
 auto ToolRegistry::remove(std::string_view name) -> bool {
-    auto it = tools_.find(std::string(name));
-    if (it != tools_.end()) {
+    bool removed = false;
+    update([&](ToolMap& tools) {
+        removed = tools.erase(std::string(name)) > 0;
+    });
+    if (removed) {
         LOG_INFO("Removed tool: {}", name);
-        tools_.erase(it);
-        return true;
     }
-    return false;
+    return removed;
 }
 
 void ToolRegistry::clear() {
-    LOG_INFO("Clearing all {} registered tools", tools_.size());
-    tools_.clear();
+    std::lock_guard lock(write_mutex_);
+    LOG_INFO("Clearing all {} registered tools", snapshot()->size());
+    tools_.store(std::make_shared<const ToolMap>(), std::memory_order_release);
 }
 
 } // namespace openclaw::agent
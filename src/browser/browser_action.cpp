@@ -5,21 +5,136 @@
 #include <boost/asio/steady_timer.hpp>
 
 #include <chrono>
+#include <limits>
+#include <unordered_set>
 
 namespace openclaw::browser {
 
+/// Binding the wait_for() MutationObserver calls with its token.
+static constexpr const char* kWaitBinding = "__openclawWaitFor";
+
+/// CDP lifecycle event that a NavigateOptions::wait_until value waits for.
+static auto lifecycle_event(std::string_view wait_until) -> std::string {
+    if (wait_until == "domcontentloaded") return "DOMContentLoaded";
+    if (wait_until == "networkidle0") return "networkIdle";
+    if (wait_until == "networkidle2") return "networkAlmostIdle";
+    return "load";
+}
+
+/// Collapses the results of a pipelined batch to the first failure, if any.
+static auto first_error(const std::vector<Result<json>>& results)
+    -> Result<void> {
+    for (const auto& result : results) {
+        if (!result) {
+            return std::unexpected(result.error());
+        }
+    }
+    return {};
+}
+
+static auto mouse_event(std::string_view type, double x, double y,
+                        const ClickOptions& options) -> CdpCommand {
+    return {"Input.dispatchMouseEvent", {
+        {"type", std::string(type)},
+        {"x", x},
+        {"y", y},
+        {"button", options.button},
+        {"clickCount", options.click_count},
+    }};
+}
+
 namespace net = boost::asio;
 
 // ---------------------------------------------------------------------------
 // BrowserAction
 // ---------------------------------------------------------------------------
 
-BrowserAction::BrowserAction(CdpClient& cdp) : cdp_(cdp) {}
+/// Main-frame lifecycle and wait_for() signals, fed by CDP listeners.
+/// Waiters park on a timer set to their deadline; every event cancels
+/// the timers so each waiter re-checks its condition.
+struct BrowserAction::WaitState {
+    bool enabled = false;
+    std::string frame_id;                    // Main frame
+    std::string loader_id;                   // Main-frame document the events below belong to
+    std::unordered_set<std::string> events;  // Lifecycle events seen for it
+    bool stopped = false;                    // Page.frameStoppedLoading since it started loading
+    uint64_t next_token = 1;
+    std::unordered_set<uint64_t> fired;      // wait_for() observers that matched
+    std::vector<std::shared_ptr<net::steady_timer>> waiters;
+
+    void notify() {
+        for (auto& waiter : waiters) {
+            waiter->cancel();
+        }
+    }
+
+    /// True once the current document reached `event`. A stopped frame
+    /// counts as loaded even when no load event fires (error pages,
+    /// downloads); network idle has no such fallback.
+    [[nodiscard]] auto reached(const std::string& event) const -> bool {
+        return events.contains(event) ||
+               (stopped && (event == "load" || event == "DOMContentLoaded"));
+    }
+};
+
+BrowserAction::BrowserAction(CdpClient& cdp)
+    : cdp_(cdp), waits_(std::make_shared<WaitState>()) {
+    listeners_.push_back(cdp_.listen("Page.lifecycleEvent", [w = waits_](const json& params) {
+        if (w->frame_id.empty() || params.value("frameId", "") != w->frame_id) {
+            return;
+        }
+        auto name = params.value("name", "");
+        auto loader = params.value("loaderId", "");
+        if (name == "init" || loader != w->loader_id) {
+            w->loader_id = std::move(loader);
+            w->events.clear();
+            w->stopped = false;
+        }
+        w->events.insert(std::move(name));
+        w->notify();
+    }));
+    listeners_.push_back(cdp_.listen("Page.frameStartedLoading", [w = waits_](const json& params) {
+        if (params.value("frameId", "") == w->frame_id) {
+            w->stopped = false;
+        }
+    }));
+    listeners_.push_back(cdp_.listen("Page.frameStoppedLoading", [w = waits_](const json& params) {
+        if (params.value("frameId", "") == w->frame_id) {
+            w->stopped = true;
+            w->notify();
+        }
+    }));
+    listeners_.push_back(cdp_.listen("Runtime.bindingCalled", [w = waits_](const json& params) {
+        if (params.value("name", "") != kWaitBinding) {
+            return;
+        }
+        try {
+            w->fired.insert(std::stoull(params.value("payload", "")));
+        } catch (const std::exception&) {
+            return;
+        }
+        w->notify();
+    }));
+}
+
+BrowserAction::~BrowserAction() {
+    for (auto id : listeners_) {
+        cdp_.unlisten(id);
+    }
+    waits_->notify();
+}
 
 // -- Navigation --
 
 auto BrowserAction::navigate(std::string_view url, const NavigateOptions& options)
     -> awaitable<Result<void>> {
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(options.timeout_ms);
+    auto enabled = co_await enable_waits();
+    if (!enabled) {
+        co_return make_fail(enabled.error());
+    }
+
     auto result = co_await cdp_.send_command("Page.navigate", {
         {"url", std::string(url)},
     });
@@ -35,8 +150,22 @@ auto BrowserAction::navigate(std::string_view url, const NavigateOptions& option
                        (*result)["errorText"].get<std::string>()));
     }
 
-    // Wait for load event
-    co_await wait_for_navigation(options.timeout_ms);
+    // Same-document navigations (fragment changes) commit without a new loader
+    if (result->contains("loaderId")) {
+        auto loader = (*result)["loaderId"].get<std::string>();
+        auto event = lifecycle_event(options.wait_until);
+        auto waits = waits_;
+        bool loaded = co_await wait_until([&] {
+            return waits->loader_id == loader && waits->reached(event);
+        }, deadline);
+        if (!loaded) {
+            co_return make_fail(
+                make_error(ErrorCode::Timeout,
+                           "Navigation timeout",
+                           std::string(url)));
+        }
+    }
+
     LOG_DEBUG("Navigated to: {}", std::string(url));
     co_return ok_result();
 }
@@ -144,6 +273,22 @@ auto BrowserAction::click(std::string_view selector, const ClickOptions& options
     double cy = (content[1].get<double>() + content[3].get<double>() +
                  content[5].get<double>() + content[7].get<double>()) / 4.0;
 
+    // Without a delay the whole gesture is pipelined in one round trip
+    if (options.delay_ms <= 0) {
+        std::vector<CdpCommand> events;
+        events.push_back(mouse_event("mouseMoved", cx, cy, {}));
+        for (int i = 0; i < options.click_count; ++i) {
+            events.push_back(mouse_event("mousePressed", cx, cy, options));
+            events.push_back(mouse_event("mouseReleased", cx, cy, options));
+        }
+        auto results = co_await cdp_.send_many(std::move(events));
+        if (auto status = first_error(results); !status) {
+            co_return make_fail(status.error());
+        }
+        LOG_DEBUG("Clicked: {}", std::string(selector));
+        co_return ok_result();
+    }
+
     // Move mouse to element center
     auto move_result = co_await dispatch_mouse_event("mouseMoved", cx, cy);
     if (!move_result) {
@@ -179,36 +324,59 @@ auto BrowserAction::type(std::string_view selector, std::string_view text,
         co_return make_fail(focus_result.error());
     }
 
+    std::vector<CdpCommand> events;
+
     // Optionally clear existing content
     if (options.clear_first) {
-        co_await cdp_.send_command("Input.dispatchKeyEvent", {
+        events.push_back({"Input.dispatchKeyEvent", {
             {"type", "rawKeyDown"},
             {"key", "a"},
             {"code", "KeyA"},
             {"windowsVirtualKeyCode", 65},
             {"nativeVirtualKeyCode", 65},
             {"modifiers", 2},  // Ctrl/Cmd
-        });
-        co_await cdp_.send_command("Input.dispatchKeyEvent", {
+        }});
+        events.push_back({"Input.dispatchKeyEvent", {
             {"type", "keyUp"},
             {"key", "a"},
             {"code", "KeyA"},
             {"windowsVirtualKeyCode", 65},
             {"modifiers", 2},
-        });
-        co_await cdp_.send_command("Input.dispatchKeyEvent", {
+        }});
+        events.push_back({"Input.dispatchKeyEvent", {
             {"type", "rawKeyDown"},
             {"key", "Backspace"},
             {"code", "Backspace"},
             {"windowsVirtualKeyCode", 8},
             {"nativeVirtualKeyCode", 8},
-        });
-        co_await cdp_.send_command("Input.dispatchKeyEvent", {
+        }});
+        events.push_back({"Input.dispatchKeyEvent", {
             {"type", "keyUp"},
             {"key", "Backspace"},
             {"code", "Backspace"},
             {"windowsVirtualKeyCode", 8},
-        });
+        }});
+        // Clearing is best-effort, as before: failures are not reported
+        co_await cdp_.send_many(std::move(events));
+        events.clear();
+    }
+
+    // Without a delay the characters are pipelined; send_many() bounds
+    // how many are in flight, so long text needs no batching here
+    if (options.delay_ms <= 0) {
+        events.reserve(text.size());
+        for (char ch : text) {
+            events.push_back({"Input.dispatchKeyEvent", {
+                {"type", "char"},
+                {"text", std::string(1, ch)},
+            }});
+        }
+        auto results = co_await cdp_.send_many(std::move(events));
+        if (auto status = first_error(results); !status) {
+            co_return make_fail(status.error());
+        }
+        LOG_DEBUG("Typed into {}: {} chars", std::string(selector), text.size());
+        co_return ok_result();
     }
 
     // Type each character
@@ -221,9 +389,7 @@ auto BrowserAction::type(std::string_view selector, std::string_view text,
             co_return make_fail(result.error());
         }
 
-        if (options.delay_ms > 0) {
-            co_await wait(options.delay_ms);
-        }
+        co_await wait(options.delay_ms);
     }
 
     LOG_DEBUG("Typed into {}: {} chars", std::string(selector), text.size());
@@ -332,20 +498,18 @@ auto BrowserAction::hover(std::string_view selector) -> awaitable<Result<void>>
 }
 
 auto BrowserAction::press_key(std::string_view key) -> awaitable<Result<void>> {
-    auto down = co_await cdp_.send_command("Input.dispatchKeyEvent", {
-        {"type", "rawKeyDown"},
-        {"key", std::string(key)},
-    });
-    if (!down) {
-        co_return make_fail(down.error());
-    }
-
-    auto up = co_await cdp_.send_command("Input.dispatchKeyEvent", {
-        {"type", "keyUp"},
-        {"key", std::string(key)},
+    auto results = co_await cdp_.send_many({
+        {"Input.dispatchKeyEvent", {
+            {"type", "rawKeyDown"},
+            {"key", std::string(key)},
+        }},
+        {"Input.dispatchKeyEvent", {
+            {"type", "keyUp"},
+            {"key", std::string(key)},
+        }},
     });
-    if (!up) {
-        co_return make_fail(up.error());
+    if (auto status = first_error(results); !status) {
+        co_return make_fail(status.error());
     }
 
     co_return ok_result();
@@ -368,38 +532,79 @@ auto BrowserAction::scroll(int x, int y) -> awaitable<Result<void>> {
 // -- Extraction --
 
 auto BrowserAction::screenshot(const ScreenshotOptions& options)
-    -> awaitable<Result<std::string>> {
-    json params = {
-        {"format", options.format},
+    -> awaitable<Result<Screenshot>> {
+    auto metrics = co_await cdp_.send_command("Page.getLayoutMetrics");
+    if (!metrics) {
+        co_return make_fail(metrics.error());
+    }
+
+    // Capture region in CSS pixels: the visible viewport by default
+    auto& viewport = (*metrics)["cssVisualViewport"];
+    CaptureRegion region{
+        viewport.value("pageX", 0.0),
+        viewport.value("pageY", 0.0),
+        viewport.value("clientWidth", 0.0),
+        viewport.value("clientHeight", 0.0),
     };
-    if (options.format == "jpeg") {
-        params["quality"] = options.quality;
-    }
     if (options.full_page) {
-        // Get layout metrics for full-page capture
-        auto metrics = co_await cdp_.send_command(
-            "Page.getLayoutMetrics");
-        if (metrics) {
-            auto& content_size = (*metrics)["cssContentSize"];
-            params["clip"] = {
-                {"x", 0},
-                {"y", 0},
-                {"width", content_size["width"]},
-                {"height", content_size["height"]},
-                {"scale", 1},
-            };
-            params["captureBeyondViewport"] = true;
-        }
+        auto& content_size = (*metrics)["cssContentSize"];
+        region = {0, 0, content_size.value("width", 0.0),
+                  content_size.value("height", 0.0)};
     } else if (options.clip) {
-        params["clip"] = *options.clip;
+        region = {options.clip->value("x", 0.0), options.clip->value("y", 0.0),
+                  options.clip->value("width", 0.0),
+                  options.clip->value("height", 0.0)};
     }
 
-    auto result = co_await cdp_.send_command("Page.captureScreenshot", params);
-    if (!result) {
-        co_return make_fail(result.error());
+    // Device pixels per CSS pixel, from the two viewport measurements
+    double device_scale = 1.0;
+    if (auto css_width = viewport.value("clientWidth", 0.0); css_width > 0) {
+        auto device_width = (*metrics)["visualViewport"].value("clientWidth", 0.0);
+        if (device_width > 0) {
+            device_scale = device_width / css_width;
+        }
     }
 
-    co_return (*result)["data"].get<std::string>();
+    // No budget: capture as is (an unlimited budget keeps scale 1)
+    ImageBudget unlimited{std::numeric_limits<int>::max(),
+                          std::numeric_limits<size_t>::max()};
+    const auto& budget = options.budget ? *options.budget : unlimited;
+    auto plan = plan_capture(region, device_scale, options.format,
+                             options.quality, budget);
+
+    constexpr int kMaxAttempts = 4;
+    for (int attempt = 1;; ++attempt) {
+        auto params = plan.to_params();
+        if (options.full_page) {
+            params["captureBeyondViewport"] = true;
+        }
+        auto result = co_await cdp_.send_command("Page.captureScreenshot", params);
+        if (!result) {
+            co_return make_fail(result.error());
+        }
+
+        Screenshot shot;
+        shot.data = (*result)["data"].get<std::string>();
+        shot.format = plan.format;
+        shot.width = plan.output_width();
+        shot.height = plan.output_height();
+        shot.bytes = base64_decoded_size(shot.data);
+        shot.attempts = attempt;
+
+        auto next = refine_capture(plan, shot.bytes, budget);
+        if (!next || attempt == kMaxAttempts) {
+            if (shot.bytes > budget.max_bytes) {
+                co_return make_fail(
+                    make_error(ErrorCode::BrowserError,
+                               "Screenshot exceeds image size limit",
+                               std::to_string(shot.bytes) + " bytes"));
+            }
+            co_return shot;
+        }
+        LOG_DEBUG("Screenshot {}x{} {} q{} is {} bytes, retrying", shot.width,
+                  shot.height, plan.format, plan.quality, shot.bytes);
+        plan = *next;
+    }
 }
 
 auto BrowserAction::get_text(std::string_view selector)
@@ -555,15 +760,54 @@ auto BrowserAction::wait_for(std::string_view selector,
                               const WaitOptions& options) -> awaitable<Result<void>> {
     auto deadline = std::chrono::steady_clock::now() +
                     std::chrono::milliseconds(options.timeout_ms);
+    auto enabled = co_await enable_waits();
+    if (!enabled) {
+        co_return make_fail(enabled.error());
+    }
+
+    auto waits = waits_;
+    auto selector_js = json(std::string(selector)).dump();
 
+    // Each round checks the selector and, if it does not match yet, leaves
+    // an observer behind that calls the binding once it does. A new
+    // document drops the observer, so the round is repeated after one.
     while (std::chrono::steady_clock::now() < deadline) {
-        auto js = "!!document.querySelector('" + std::string(selector) + "')";
-        auto result = co_await evaluate(js);
+        auto token = waits->next_token++;
+        auto loader = waits->loader_id;
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+
+        auto script =
+            "(() => {"
+            "  const sel = " + selector_js + ";"
+            "  if (document.querySelector(sel)) return true;"
+            "  const observer = new MutationObserver(() => {"
+            "    if (!document.querySelector(sel)) return;"
+            "    observer.disconnect();"
+            "    " + std::string(kWaitBinding) + "('" + std::to_string(token) + "');"
+            "  });"
+            "  observer.observe(document, {childList: true, subtree: true, attributes: true});"
+            "  setTimeout(() => observer.disconnect(), " + std::to_string(remaining) + ");"
+            "  return false;"
+            "})()";
+
+        auto result = co_await evaluate(script);
+        if (result && result->exception) {
+            co_return make_fail(
+                make_error(ErrorCode::InvalidArgument,
+                           "Invalid selector",
+                           *result->exception));
+        }
         if (result && result->value.is_boolean() && result->value.get<bool>()) {
             co_return ok_result();
         }
 
-        co_await wait(options.polling_ms);
+        // A failed evaluate usually means the context is being replaced;
+        // the next document's lifecycle events end this wait either way.
+        co_await wait_until([&] {
+            return waits->fired.contains(token) || waits->loader_id != loader;
+        }, deadline);
+        waits->fired.erase(token);
     }
 
     co_return make_fail(
@@ -572,27 +816,40 @@ auto BrowserAction::wait_for(std::string_view selector,
                    std::string(selector)));
 }
 
-auto BrowserAction::wait_for_navigation(int timeout_ms)
+auto BrowserAction::wait_for_navigation(int timeout_ms, std::string_view wait_until)
     -> awaitable<Result<void>> {
-    // We wait for the Page.loadEventFired event by polling the readyState
     auto deadline = std::chrono::steady_clock::now() +
                     std::chrono::milliseconds(timeout_ms);
-
-    while (std::chrono::steady_clock::now() < deadline) {
-        auto result = co_await evaluate("document.readyState");
-        if (result && result->value.is_string()) {
-            auto state = result->value.get<std::string>();
-            if (state == "complete" || state == "interactive") {
+    auto enabled = co_await enable_waits();
+    if (!enabled) {
+        co_return make_fail(enabled.error());
+    }
+
+    auto waits = waits_;
+    auto event = lifecycle_event(wait_until);
+
+    // A document that finished loading before lifecycle events were
+    // enabled may not have reported them; its readyState still tells.
+    if (!waits->reached(event) && (event == "load" || event == "DOMContentLoaded")) {
+        auto state = co_await evaluate("document.readyState");
+        if (state && state->value.is_string()) {
+            auto ready_state = state->value.get<std::string>();
+            if (ready_state == "complete" ||
+                (ready_state == "interactive" && event == "DOMContentLoaded")) {
                 co_return ok_result();
             }
         }
-        co_await wait(100);
     }
 
-    co_return make_fail(
-        make_error(ErrorCode::Timeout,
-                   "Navigation timeout",
-                   std::to_string(timeout_ms) + "ms"));
+    bool reached = co_await this->wait_until([&] { return waits->reached(event); },
+                                             deadline);
+    if (!reached) {
+        co_return make_fail(
+            make_error(ErrorCode::Timeout,
+                       "Navigation timeout",
+                       std::to_string(timeout_ms) + "ms"));
+    }
+    co_return ok_result();
 }
 
 auto BrowserAction::wait(int ms) -> awaitable<void> {
@@ -603,6 +860,49 @@ auto BrowserAction::wait(int ms) -> awaitable<void> {
 
 // -- Private helpers --
 
+auto BrowserAction::enable_waits() -> awaitable<Result<void>> {
+    if (waits_->enabled) {
+        co_return ok_result();
+    }
+
+    // The main frame id must be known before lifecycle events start
+    // arriving, or the replayed events of the current document are lost.
+    auto tree = co_await cdp_.send_command("Page.getFrameTree");
+    if (!tree) {
+        co_return make_fail(tree.error());
+    }
+    waits_->frame_id = (*tree)["frameTree"]["frame"].value("id", std::string{});
+
+    auto results = co_await cdp_.send_many({
+        {"Page.setLifecycleEventsEnabled", {{"enabled", true}}},
+        {"Runtime.addBinding", {{"name", kWaitBinding}}},
+    });
+    if (auto enabled = first_error(results); !enabled) {
+        co_return make_fail(enabled.error());
+    }
+
+    waits_->enabled = true;
+    co_return ok_result();
+}
+
+auto BrowserAction::wait_until(std::function<bool()> ready, Deadline deadline)
+    -> awaitable<bool> {
+    auto waits = waits_;
+    auto timer = std::make_shared<net::steady_timer>(
+        co_await net::this_coro::executor, deadline);
+    waits->waiters.push_back(timer);
+
+    bool satisfied = ready();
+    while (!satisfied && std::chrono::steady_clock::now() < deadline) {
+        boost::system::error_code ec;
+        co_await timer->async_wait(net::redirect_error(net::use_awaitable, ec));
+        satisfied = ready();
+    }
+
+    std::erase(waits->waiters, timer);
+    co_return satisfied;
+}
+
 auto BrowserAction::resolve_selector(std::string_view selector)
     -> awaitable<Result<int>> {
     // Get the document root node
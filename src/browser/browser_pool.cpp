@@ -1,23 +1,29 @@
 #include "openclaw/browser/browser_pool.hpp"
 #include "openclaw/core/logger.hpp"
 #include "openclaw/core/utils.hpp"
-#include "openclaw/infra/http_client.hpp"
 
 #include <boost/asio.hpp>
+#include <boost/asio/experimental/awaitable_operators.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
 #include <nlohmann/json.hpp>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdlib>
+#include <deque>
 #include <filesystem>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
 #include <process.h>
 #else
+#include <cerrno>
 #include <csignal>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -27,17 +33,98 @@ namespace openclaw::browser {
 
 namespace fs = std::filesystem;
 namespace net = boost::asio;
+namespace beast = boost::beast;
+namespace http = beast::http;
 using json = nlohmann::json;
 
 // ---------------------------------------------------------------------------
 // Platform helpers
 // ---------------------------------------------------------------------------
 
-static void platform_sleep_ms(int ms) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+/// Interval between DevTools endpoint probes while Chrome starts up.
+static constexpr int kEndpointPollMs = 100;
+
+/// Max time a health-check round trip may take before the process is
+/// considered hung.
+static constexpr int kHealthCheckTimeoutMs = 5000;
+
+/// Flags passed to every headless Chrome process.
+static constexpr std::array<const char*, 10> kChromeFlags = {
+    "--headless=new",
+    "--no-first-run",
+    "--no-default-browser-check",
+    "--disable-gpu",
+    "--disable-extensions",
+    "--disable-background-networking",
+    "--disable-sync",
+    "--disable-translate",
+    "--mute-audio",
+    "--no-sandbox",
+};
+
+/// Time a Chrome process gets to exit after SIGTERM before it is killed.
+static constexpr int kKillGraceMs = 2000;
+
+/// Interval between reap attempts while a process shuts down.
+static constexpr int kReapPollMs = 50;
+
+static void remove_user_data_dir(const fs::path& dir) {
+    if (dir.empty()) return;
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    if (ec) {
+        LOG_WARN("Failed to remove Chrome profile {}: {}", dir.string(), ec.message());
+    }
+}
+
+#ifndef _WIN32
+/// Reaps a Chrome process that was sent SIGTERM, escalating to SIGKILL
+/// after kKillGraceMs, then deletes its profile directory.
+static auto reap_browser_process(pid_t pid, fs::path user_data_dir) -> awaitable<void> {
+    net::steady_timer timer(co_await net::this_coro::executor);
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(kKillGraceMs);
+    while (::waitpid(pid, nullptr, WNOHANG) == 0) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            ::kill(pid, SIGKILL);
+            ::waitpid(pid, nullptr, 0);
+            break;
+        }
+        timer.expires_after(std::chrono::milliseconds(kReapPollMs));
+        boost::system::error_code ec;
+        co_await timer.async_wait(net::redirect_error(net::use_awaitable, ec));
+    }
+    remove_user_data_dir(user_data_dir);
+}
+#endif
+
+/// Stops a Chrome process without blocking the event loop: the process
+/// gets SIGTERM and is reaped (and its profile removed) in the background.
+static void kill_browser_process(net::io_context& ioc, BrowserInstance& inst) {
+#ifdef _WIN32
+    if (inst.process_handle) {
+        ::TerminateProcess(inst.process_handle, 1);
+        ::WaitForSingleObject(inst.process_handle, 3000);
+        ::CloseHandle(inst.process_handle);
+        inst.process_handle = nullptr;
+    }
+    remove_user_data_dir(inst.user_data_dir);
+#else
+    if (inst.pid > 0) {
+        ::kill(inst.pid, SIGTERM);
+        net::co_spawn(ioc, reap_browser_process(inst.pid, std::move(inst.user_data_dir)),
+                      net::detached);
+        inst.pid = 0;
+    } else {
+        remove_user_data_dir(inst.user_data_dir);
+    }
+#endif
+    inst.user_data_dir.clear();
 }
 
-static void kill_browser_process(BrowserInstance& inst) {
+/// Stops a Chrome process and waits for it, for use when the event loop
+/// may no longer run (pool destruction).
+static void kill_browser_process_now(BrowserInstance& inst) {
 #ifdef _WIN32
     if (inst.process_handle) {
         ::TerminateProcess(inst.process_handle, 1);
@@ -48,25 +135,219 @@ static void kill_browser_process(BrowserInstance& inst) {
 #else
     if (inst.pid > 0) {
         ::kill(inst.pid, SIGTERM);
-        int status = 0;
-        ::waitpid(inst.pid, &status, WNOHANG);
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(kKillGraceMs);
+        while (::waitpid(inst.pid, nullptr, WNOHANG) == 0) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                ::kill(inst.pid, SIGKILL);
+                ::waitpid(inst.pid, nullptr, 0);
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(kReapPollMs));
+        }
+        inst.pid = 0;
     }
 #endif
+    remove_user_data_dir(inst.user_data_dir);
+    inst.user_data_dir.clear();
+}
+
+/// Returns true if the Chrome process has already exited (e.g. bad flags,
+/// port in use), so endpoint discovery can fail fast instead of timing out.
+/// An exited process is reaped here and its pid cleared, so the kill
+/// functions never signal a pid the kernel may have handed to another
+/// process.
+static auto browser_process_exited(BrowserInstance& inst) -> bool {
+#ifdef _WIN32
+    return inst.process_handle &&
+           ::WaitForSingleObject(inst.process_handle, 0) == WAIT_OBJECT_0;
+#else
+    if (inst.pid <= 0) return true;
+    int status = 0;
+    auto reaped = ::waitpid(inst.pid, &status, WNOHANG);
+    if (reaped == 0) return false;
+    if (reaped < 0 && errno != ECHILD) return false;
+    inst.pid = 0;
+    return true;
+#endif
+}
+
+/// Fetches http://127.0.0.1:<port>/json/version on the calling executor.
+static auto fetch_devtools_version(int debug_port)
+    -> awaitable<Result<std::string>> {
+    beast::tcp_stream stream(co_await net::this_coro::executor);
+    stream.expires_after(std::chrono::seconds(2));
+
+    boost::system::error_code ec;
+    net::ip::tcp::endpoint ep(net::ip::make_address_v4("127.0.0.1"),
+                              static_cast<unsigned short>(debug_port));
+    co_await stream.async_connect(ep, net::redirect_error(net::use_awaitable, ec));
+    if (ec) {
+        co_return make_fail(
+            make_error(ErrorCode::ConnectionFailed,
+                       "DevTools endpoint not reachable", ec.message()));
+    }
+
+    http::request<http::empty_body> req{http::verb::get, "/json/version", 11};
+    req.set(http::field::host, "127.0.0.1:" + std::to_string(debug_port));
+    req.set(http::field::connection, "close");
+    co_await http::async_write(stream, req,
+                               net::redirect_error(net::use_awaitable, ec));
+    if (ec) {
+        co_return make_fail(
+            make_error(ErrorCode::ConnectionFailed,
+                       "DevTools endpoint write failed", ec.message()));
+    }
+
+    beast::flat_buffer buffer;
+    http::response<http::string_body> res;
+    co_await http::async_read(stream, buffer, res,
+                              net::redirect_error(net::use_awaitable, ec));
+    if (ec) {
+        co_return make_fail(
+            make_error(ErrorCode::ConnectionFailed,
+                       "DevTools endpoint read failed", ec.message()));
+    }
+
+    co_return std::move(res.body());
+}
+
+static auto elapsed_ms(std::chrono::steady_clock::time_point since) -> int64_t {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - since).count();
+}
+
+void to_json(nlohmann::json& j, const BrowserPoolStats& s) {
+    j = nlohmann::json{
+        {"processes", s.processes},
+        {"idle_processes", s.idle_processes},
+        {"launching", s.launching},
+        {"sessions", s.sessions},
+        {"capacity", s.capacity},
+        {"waiters", s.waiters},
+        {"acquires", s.acquires},
+        {"acquire_waits", s.acquire_waits},
+        {"acquire_timeouts", s.acquire_timeouts},
+        {"acquire_wait_total_ms", s.acquire_wait_total_ms},
+        {"acquire_wait_max_ms", s.acquire_wait_max_ms},
+        {"launches", s.launches},
+        {"launch_failures", s.launch_failures},
+        {"launch_total_ms", s.launch_total_ms},
+        {"launch_max_ms", s.launch_max_ms},
+        {"contexts_created", s.contexts_created},
+        {"contexts_disposed", s.contexts_disposed},
+        {"health_check_failures", s.health_check_failures},
+        {"restarts", s.restarts},
+    };
 }
 
 // ---------------------------------------------------------------------------
 // BrowserPool::Impl
 // ---------------------------------------------------------------------------
 
+/// A caller parked in acquire() until a context slot is handed to it.
+/// The timer doubles as the wake-up signal: it expires at the acquire
+/// deadline, and is moved into the past when a slot (or error) arrives,
+/// which also completes a wait that has not started yet.
+struct AcquireWaiter {
+    net::steady_timer timer;
+    std::shared_ptr<BrowserInstance> granted;  // process with a reserved slot
+    std::optional<Error> error;
+
+    explicit AcquireWaiter(net::any_io_executor ex) : timer(std::move(ex)) {}
+
+    void wake() { timer.expires_at(net::steady_timer::time_point::min()); }
+};
+
 struct BrowserPool::Impl {
     net::io_context& ioc;
     BrowserConfig config;
     std::mutex pool_mutex;
-    std::vector<std::unique_ptr<BrowserInstance>> instances;
+    std::vector<std::shared_ptr<BrowserInstance>> instances;
+    std::unordered_map<std::string, std::shared_ptr<BrowserSession>> sessions;
+    std::deque<std::shared_ptr<AcquireWaiter>> waiters;  // FIFO
+    size_t launching = 0;
+    bool closed = false;  // By close_all(); sessions let go are not disposed
+    std::shared_ptr<bool> alive = std::make_shared<bool>(true);  // Seen by session deleters
+    bool health_checks_started = false;
+    BrowserPoolStats counters;  // cumulative fields only
     int next_debug_port = 9222;
+    std::unique_ptr<PageCache> page_cache;
 
     Impl(net::io_context& ctx, const BrowserConfig& cfg)
-        : ioc(ctx), config(cfg) {}
+        : ioc(ctx), config(cfg) {
+        if (config.page_cache_bytes > 0) {
+            page_cache = std::make_unique<PageCache>(
+                config.page_cache_bytes,
+                static_cast<int64_t>(config.page_cache_ttl_seconds) * 1000);
+        }
+    }
+
+    auto slots_per_instance() const -> size_t {
+        return std::max<size_t>(1, config.contexts_per_browser);
+    }
+
+    auto free_slots_locked() const -> size_t {
+        size_t free = 0;
+        for (const auto& inst : instances) {
+            if (inst->healthy && inst->leased < slots_per_instance()) {
+                free += slots_per_instance() - inst->leased;
+            }
+        }
+        return free;
+    }
+
+    auto idle_processes_locked() const -> size_t {
+        return std::count_if(instances.begin(), instances.end(),
+                             [](const auto& inst) {
+                                 return inst->healthy && inst->leased == 0;
+                             });
+    }
+
+    auto find_instance_locked(std::string_view id) const
+        -> std::shared_ptr<BrowserInstance> {
+        for (const auto& inst : instances) {
+            if (inst->id == id) return inst;
+        }
+        return nullptr;
+    }
+
+    /// Reserves a slot on the least-loaded healthy process, spreading
+    /// sessions across processes so one page cannot starve the others.
+    auto reserve_slot_locked() -> std::shared_ptr<BrowserInstance> {
+        std::shared_ptr<BrowserInstance> best;
+        for (const auto& inst : instances) {
+            if (!inst->healthy || inst->leased >= slots_per_instance()) continue;
+            if (!best || inst->leased < best->leased) best = inst;
+        }
+        if (best) {
+            ++best->leased;
+            best->last_used = utils::timestamp_ms();
+        }
+        return best;
+    }
+
+    /// Hands a slot on `inst` to the oldest waiter. The caller has already
+    /// accounted for the slot in `inst->leased`. Returns false if none queued.
+    auto grant_locked(const std::shared_ptr<BrowserInstance>& inst) -> bool {
+        if (waiters.empty()) return false;
+        auto waiter = std::move(waiters.front());
+        waiters.pop_front();
+        inst->last_used = utils::timestamp_ms();
+        waiter->granted = inst;
+        waiter->wake();
+        return true;
+    }
+
+    void record_acquire_locked(std::chrono::steady_clock::time_point started,
+                               bool waited) {
+        ++counters.acquires;
+        if (!waited) return;
+        auto ms = elapsed_ms(started);
+        ++counters.acquire_waits;
+        counters.acquire_wait_total_ms += ms;
+        counters.acquire_wait_max_ms = std::max(counters.acquire_wait_max_ms, ms);
+    }
 };
 
 // ---------------------------------------------------------------------------
@@ -76,16 +357,21 @@ struct BrowserPool::Impl {
 BrowserPool::BrowserPool(boost::asio::io_context& ioc,
                          const BrowserConfig& config)
     : impl_(std::make_unique<Impl>(ioc, config)) {
-    LOG_INFO("BrowserPool created (max_size={})", config.pool_size);
+    LOG_INFO("BrowserPool created (max_processes={}, contexts_per_browser={}, "
+             "prewarm={})",
+             config.pool_size, impl_->slots_per_instance(), config.prewarm_count);
 }
 
 BrowserPool::~BrowserPool() {
     if (!impl_) return;
 
-    // Kill all browser processes on destruction
+    // Kill all browser processes on destruction; sessions callers still
+    // hold are deleted without disposal when they let go
     std::lock_guard lock(impl_->pool_mutex);
+    impl_->alive.reset();
+    impl_->sessions.clear();
     for (auto& inst : impl_->instances) {
-        kill_browser_process(*inst);
+        kill_browser_process_now(*inst);
     }
     impl_->instances.clear();
 }
@@ -93,141 +379,486 @@ BrowserPool::~BrowserPool() {
 BrowserPool::BrowserPool(BrowserPool&&) noexcept = default;
 BrowserPool& BrowserPool::operator=(BrowserPool&&) noexcept = default;
 
-auto BrowserPool::acquire() -> awaitable<Result<BrowserInstance*>> {
-    std::lock_guard lock(impl_->pool_mutex);
-
-    // Try to find an idle instance
-    for (auto& inst : impl_->instances) {
-        if (!inst->in_use) {
-            inst->in_use = true;
-            inst->last_used = utils::timestamp_ms();
-            LOG_DEBUG("Reusing browser instance: {}", inst->id);
-            co_return inst.get();
+auto BrowserPool::acquire(std::string owner)
+    -> awaitable<Result<std::shared_ptr<BrowserSession>>> {
+    auto started = std::chrono::steady_clock::now();
+    auto waiter = std::make_shared<AcquireWaiter>(
+        co_await net::this_coro::executor);
+
+    std::shared_ptr<BrowserInstance> instance;
+    {
+        std::lock_guard lock(impl_->pool_mutex);
+
+        // Fast path: a free context slot on a running process. Otherwise
+        // queue behind earlier callers; a launch starts if below capacity.
+        instance = impl_->reserve_slot_locked();
+        if (!instance) {
+            impl_->waiters.push_back(waiter);
         }
+        replenish_locked();
     }
 
-    // Check pool capacity
-    if (impl_->instances.size() >= impl_->config.pool_size) {
-        co_return make_fail(
-            make_error(ErrorCode::BrowserError,
-                       "Browser pool exhausted",
-                       "max_size=" + std::to_string(impl_->config.pool_size)));
+    bool waited = !instance;
+    if (waited) {
+        bool ready = false;
+        {
+            // A slot may have been granted since the waiter was queued;
+            // arming the timer then would discard that wake-up
+            std::lock_guard lock(impl_->pool_mutex);
+            ready = waiter->granted || waiter->error;
+            if (!ready) {
+                waiter->timer.expires_after(
+                    std::chrono::milliseconds(impl_->config.acquire_timeout_ms));
+            }
+        }
+        if (!ready) {
+            boost::system::error_code ec;
+            co_await waiter->timer.async_wait(
+                net::redirect_error(net::use_awaitable, ec));
+        }
+
+        std::lock_guard lock(impl_->pool_mutex);
+        if (waiter->granted) {
+            instance = std::move(waiter->granted);
+        } else {
+            std::erase(impl_->waiters, waiter);
+            if (waiter->error) {
+                co_return make_fail(std::move(*waiter->error));
+            }
+            ++impl_->counters.acquire_timeouts;
+            co_return make_fail(
+                make_error(ErrorCode::Timeout,
+                           "Timed out waiting for a browser session",
+                           "capacity=" + std::to_string(
+                               impl_->config.pool_size *
+                               impl_->slots_per_instance()) +
+                           ", acquire_timeout_ms=" +
+                           std::to_string(impl_->config.acquire_timeout_ms)));
+        }
     }
 
-    // Launch a new browser instance
-    auto instance = launch_browser();
-    if (!instance) {
-        co_return make_fail(instance.error());
+    // Create the isolated context and its page target on the reserved slot
+    auto session = co_await open_session(instance);
+
+    std::lock_guard lock(impl_->pool_mutex);
+    if (!session) {
+        return_slot_locked(instance->id);
+        co_return make_fail(session.error());
     }
 
-    auto* ptr = instance->get();
+    impl_->record_acquire_locked(started, waited);
+    (*session)->owner = std::move(owner);
+    auto shared = share_session(std::move(*session));
+    impl_->sessions.emplace(shared->id, shared);
+    LOG_DEBUG("Acquired browser session {} on instance {} ({}ms)",
+              shared->id, shared->instance_id, elapsed_ms(started));
+    co_return shared;
+}
 
-    // Connect CDP client
-    auto connect_result = co_await ptr->cdp->connect(ptr->ws_endpoint);
-    if (!connect_result) {
-        // Kill the process since we can't connect
-        kill_browser_process(*ptr);
-        co_return make_fail(connect_result.error());
+/// Wraps a session so that letting go of the last reference disposes its
+/// browser context in the background instead of deleting it in place.
+auto BrowserPool::share_session(std::unique_ptr<BrowserSession> session)
+    -> std::shared_ptr<BrowserSession> {
+    std::weak_ptr<bool> alive = impl_->alive;
+    return std::shared_ptr<BrowserSession>(session.release(),
+        [this, alive](BrowserSession* raw) {
+            std::unique_ptr<BrowserSession> owned(raw);
+            if (alive.expired()) return;  // Pool destroyed
+            {
+                std::lock_guard lock(impl_->pool_mutex);
+                if (impl_->closed) return;
+            }
+            net::co_spawn(impl_->ioc, dispose_session(std::move(owned)), net::detached);
+        });
+}
+
+void BrowserPool::release(const std::shared_ptr<BrowserSession>& session) {
+    if (!session) return;
+
+    std::shared_ptr<BrowserSession> owned;  // Let go of outside the lock
+    {
+        std::lock_guard lock(impl_->pool_mutex);
+        auto it = impl_->sessions.find(session->id);
+        if (it == impl_->sessions.end()) return;
+        owned = std::move(it->second);
+        impl_->sessions.erase(it);
     }
+    LOG_DEBUG("Released browser session: {}", owned->id);
+}
 
-    // Enable necessary CDP domains
-    auto page_result = co_await ptr->cdp->send_command("Page.enable");
-    if (!page_result) {
-        LOG_WARN("Failed to enable Page domain: {}", page_result.error().what());
+auto BrowserPool::find(std::string_view session_id, std::string_view owner)
+    -> std::shared_ptr<BrowserSession> {
+    std::lock_guard lock(impl_->pool_mutex);
+    auto it = impl_->sessions.find(std::string(session_id));
+    if (it == impl_->sessions.end() || it->second->owner != owner) {
+        return nullptr;
     }
+    return it->second;
+}
 
-    auto runtime_result = co_await ptr->cdp->send_command("Runtime.enable");
-    if (!runtime_result) {
-        LOG_WARN("Failed to enable Runtime domain: {}",
-                 runtime_result.error().what());
+void BrowserPool::prewarm() {
+    std::lock_guard lock(impl_->pool_mutex);
+    replenish_locked();
+}
+
+auto BrowserPool::close(std::string_view session_id, std::string_view owner)
+    -> awaitable<Result<void>> {
+    std::shared_ptr<BrowserSession> owned;
+    {
+        std::lock_guard lock(impl_->pool_mutex);
+        auto it = impl_->sessions.find(std::string(session_id));
+        if (it == impl_->sessions.end() || it->second->owner != owner) {
+            co_return make_fail(
+                make_error(ErrorCode::NotFound,
+                           "Browser session not found",
+                           std::string(session_id)));
+        }
+        owned = std::move(it->second);
+        impl_->sessions.erase(it);
     }
 
-    auto dom_result = co_await ptr->cdp->send_command("DOM.enable");
-    if (!dom_result) {
-        LOG_WARN("Failed to enable DOM domain: {}", dom_result.error().what());
+    // Disposed by the last holder: now, or when requests using it finish
+    owned.reset();
+    LOG_INFO("Closed browser session: {}", std::string(session_id));
+    co_return ok_result();
+}
+
+auto BrowserPool::close_all() -> awaitable<void> {
+    std::vector<std::shared_ptr<BrowserInstance>> closing;
+    std::unordered_map<std::string, std::shared_ptr<BrowserSession>> sessions;
+    {
+        std::lock_guard lock(impl_->pool_mutex);
+        impl_->closed = true;
+        closing = std::move(impl_->instances);
+        impl_->instances.clear();
+        sessions = std::move(impl_->sessions);
+        impl_->sessions.clear();
+
+        for (auto& waiter : impl_->waiters) {
+            waiter->error = make_error(ErrorCode::BrowserError,
+                                       "Browser pool closed");
+            waiter->wake();
+        }
+        impl_->waiters.clear();
     }
 
-    ptr->in_use = true;
-    ptr->last_used = utils::timestamp_ms();
-    impl_->instances.push_back(std::move(*instance));
+    for (auto& [_, session] : sessions) {
+        if (session->cdp && session->cdp->is_connected()) {
+            co_await session->cdp->disconnect();
+        }
+    }
+
+    for (auto& inst : closing) {
+        if (inst->cdp && inst->cdp->is_connected()) {
+            co_await inst->cdp->disconnect();
+        }
+        kill_browser_process(impl_->ioc, *inst);
+    }
 
-    LOG_INFO("Launched new browser instance: {}", ptr->id);
-    co_return impl_->instances.back().get();
+    LOG_INFO("Closed all {} browser instances ({} sessions)",
+             closing.size(), sessions.size());
 }
 
-void BrowserPool::release(BrowserInstance* instance) {
-    if (!instance) return;
+auto BrowserPool::active_count() const -> size_t {
+    std::lock_guard lock(impl_->pool_mutex);
+    return impl_->sessions.size();
+}
 
+auto BrowserPool::total_count() const -> size_t {
     std::lock_guard lock(impl_->pool_mutex);
-    instance->in_use = false;
-    instance->last_used = utils::timestamp_ms();
-    LOG_DEBUG("Released browser instance: {}", instance->id);
+    return impl_->instances.size();
 }
 
-auto BrowserPool::close(std::string_view instance_id) -> awaitable<Result<void>> {
+auto BrowserPool::page_cache() -> PageCache* {
+    return impl_->page_cache.get();
+}
+
+auto BrowserPool::fetch_guard() const -> infra::FetchGuard {
+    return infra::FetchGuard(resolve_ssrf_allow_private(impl_->config.ssrf_policy));
+}
+
+auto BrowserPool::io_context() const -> net::io_context& {
+    return impl_->ioc;
+}
+
+auto BrowserPool::max_size() const -> size_t {
+    return impl_->config.pool_size * impl_->slots_per_instance();
+}
+
+auto BrowserPool::stats() const -> BrowserPoolStats {
     std::lock_guard lock(impl_->pool_mutex);
+    auto s = impl_->counters;
+    s.processes = impl_->instances.size();
+    s.idle_processes = impl_->idle_processes_locked();
+    s.launching = impl_->launching;
+    s.sessions = impl_->sessions.size();
+    s.capacity = impl_->config.pool_size * impl_->slots_per_instance();
+    s.waiters = impl_->waiters.size();
+    return s;
+}
 
-    auto it = std::find_if(impl_->instances.begin(), impl_->instances.end(),
-                           [&](const auto& inst) {
-                               return inst->id == instance_id;
-                           });
+void BrowserPool::return_slot_locked(const std::string& instance_id) {
+    auto inst = impl_->find_instance_locked(instance_id);
+    if (!inst) {
+        // Process was restarted; its slots went with it.
+        replenish_locked();
+        return;
+    }
 
-    if (it == impl_->instances.end()) {
-        co_return make_fail(
-            make_error(ErrorCode::NotFound,
-                       "Browser instance not found",
-                       std::string(instance_id)));
+    // Transfer the slot straight to the oldest waiter, if any
+    if (inst->healthy && impl_->grant_locked(inst)) return;
+
+    if (inst->leased > 0) --inst->leased;
+    inst->last_used = utils::timestamp_ms();
+}
+
+void BrowserPool::replenish_locked() {
+    auto& impl = *impl_;
+    auto per = impl.slots_per_instance();
+
+    // Processes needed for queued waiters beyond the free and in-flight slots
+    size_t supply = impl.free_slots_locked() + impl.launching * per;
+    size_t for_waiters = impl.waiters.size() > supply
+        ? (impl.waiters.size() - supply + per - 1) / per : 0;
+
+    // Processes needed to keep the pre-warm target of idle processes
+    size_t idle = impl.idle_processes_locked() + impl.launching;
+    size_t for_prewarm = impl.config.prewarm_count > idle
+        ? impl.config.prewarm_count - idle : 0;
+
+    size_t occupied = impl.instances.size() + impl.launching;
+    size_t headroom = impl.config.pool_size > occupied
+        ? impl.config.pool_size - occupied : 0;
+    size_t count = std::min(std::max(for_waiters, for_prewarm), headroom);
+
+    for (size_t i = 0; i < count; ++i) {
+        ++impl.launching;
+        net::co_spawn(impl.ioc, launch_and_admit(), net::detached);
     }
+}
+
+auto BrowserPool::launch_and_admit() -> awaitable<void> {
+    auto started = std::chrono::steady_clock::now();
+    auto instance = co_await launch_browser();
+    auto launch_ms = elapsed_ms(started);
 
-    auto& inst = *it;
+    std::lock_guard lock(impl_->pool_mutex);
+    --impl_->launching;
 
-    // Disconnect CDP
-    if (inst->cdp && inst->cdp->is_connected()) {
-        co_await inst->cdp->disconnect();
+    if (!instance) {
+        ++impl_->counters.launch_failures;
+        LOG_WARN("Browser launch failed: {}", instance.error().what());
+
+        // Launches are started on behalf of queued demand, so surface the
+        // error to the oldest waiter instead of letting it time out.
+        if (!impl_->waiters.empty()) {
+            auto waiter = std::move(impl_->waiters.front());
+            impl_->waiters.pop_front();
+            waiter->error = instance.error();
+            waiter->wake();
+        }
+        co_return;
     }
 
-    // Kill the process
-    kill_browser_process(*inst);
+    ++impl_->counters.launches;
+    impl_->counters.launch_total_ms += launch_ms;
+    impl_->counters.launch_max_ms = std::max(impl_->counters.launch_max_ms, launch_ms);
 
-    impl_->instances.erase(it);
-    LOG_INFO("Closed browser instance: {}", std::string(instance_id));
-    co_return ok_result();
+    auto inst = std::move(*instance);
+    impl_->instances.push_back(inst);
+
+    // Hand the new process's slots to queued waiters
+    size_t granted = 0;
+    while (inst->leased < impl_->slots_per_instance()) {
+        ++inst->leased;
+        if (!impl_->grant_locked(inst)) {
+            --inst->leased;
+            break;
+        }
+        ++granted;
+    }
+
+    LOG_INFO("Launched browser instance: {} ({}ms, {} queued sessions served)",
+             inst->id, launch_ms, granted);
+
+    if (!impl_->health_checks_started &&
+        impl_->config.health_check_interval_ms > 0) {
+        impl_->health_checks_started = true;
+        net::co_spawn(impl_->ioc, health_check_loop(), net::detached);
+    }
 }
 
-auto BrowserPool::close_all() -> awaitable<void> {
-    std::lock_guard lock(impl_->pool_mutex);
+auto BrowserPool::network_profile(std::string_view name) const
+    -> std::optional<NetworkProfile> {
+    auto profile = NetworkProfile::named(
+        name.empty() ? std::string_view(impl_->config.network_profile) : name);
+    if (profile) {
+        profile->max_response_bytes = impl_->config.max_response_bytes;
+        profile->blocked_domains = impl_->config.blocked_domains;
+    }
+    return profile;
+}
 
-    for (auto& inst : impl_->instances) {
-        if (inst->cdp && inst->cdp->is_connected()) {
-            co_await inst->cdp->disconnect();
+auto BrowserPool::open_session(std::shared_ptr<BrowserInstance> instance)
+    -> awaitable<Result<std::unique_ptr<BrowserSession>>> {
+    auto& browser = *instance->cdp;
+
+    // A fresh browser context isolates cookies, storage and cache
+    auto context = co_await browser.send_command(
+        "Target.createBrowserContext", json::object());
+    if (!context) {
+        co_return make_fail(context.error());
+    }
+
+    auto session = std::make_unique<BrowserSession>();
+    session->id = utils::generate_id(12);
+    session->instance_id = instance->id;
+    session->browser_context_id =
+        context->value("browserContextId", std::string{});
+    session->created_at = utils::timestamp_ms();
+    session->last_used = session->created_at;
+
+    auto target = co_await browser.send_command("Target.createTarget", {
+        {"url", "about:blank"},
+        {"browserContextId", session->browser_context_id},
+    });
+    if (!target) {
+        co_await browser.send_command("Target.disposeBrowserContext", {
+            {"browserContextId", session->browser_context_id},
+        });
+        co_return make_fail(target.error());
+    }
+    session->target_id = target->value("targetId", std::string{});
+
+    // Attach to the page over the browser connection (flat session) and
+    // enable the domains actions rely on, in a single round trip
+    auto attached = co_await browser.attach(session->target_id);
+    if (!attached) {
+        co_await browser.send_command("Target.disposeBrowserContext", {
+            {"browserContextId", session->browser_context_id},
+        });
+        co_return make_fail(attached.error());
+    }
+    session->cdp = std::move(*attached);
+
+    auto enabled = co_await session->cdp->send_many({
+        {"Page.enable"}, {"Runtime.enable"}, {"DOM.enable"},
+    });
+    for (const auto& result : enabled) {
+        if (!result) {
+            LOG_WARN("Failed to enable CDP domain for session {}: {}",
+                     session->id, result.error().what());
         }
-        kill_browser_process(*inst);
     }
 
-    auto count = impl_->instances.size();
-    impl_->instances.clear();
-    LOG_INFO("Closed all {} browser instances", count);
+    // Enforce the configured network profile before the first navigation
+    session->network = std::make_unique<RequestInterceptor>(
+        impl_->ioc, *session->cdp, fetch_guard());
+    auto applied = co_await session->network->apply(
+        network_profile().value_or(NetworkProfile{}));
+    if (!applied) {
+        LOG_WARN("Failed to apply network profile for session {}: {}",
+                 session->id, applied.error().what());
+    }
+
+    {
+        std::lock_guard lock(impl_->pool_mutex);
+        ++impl_->counters.contexts_created;
+    }
+    co_return session;
 }
 
-auto BrowserPool::active_count() const -> size_t {
+auto BrowserPool::dispose_session(std::unique_ptr<BrowserSession> session)
+    -> awaitable<void> {
+    if (session->cdp && session->cdp->is_connected()) {
+        co_await session->cdp->disconnect();
+    }
+
+    std::shared_ptr<BrowserInstance> instance;
+    {
+        std::lock_guard lock(impl_->pool_mutex);
+        instance = impl_->find_instance_locked(session->instance_id);
+    }
+
+    // Disposing the context closes its targets and wipes its storage,
+    // so the slot can be reused without leaking state between sessions.
+    if (instance && instance->cdp && instance->cdp->is_connected()) {
+        auto disposed = co_await instance->cdp->send_command(
+            "Target.disposeBrowserContext", {
+                {"browserContextId", session->browser_context_id},
+            });
+        if (!disposed) {
+            LOG_WARN("Failed to dispose browser context {}: {}",
+                     session->browser_context_id, disposed.error().what());
+        }
+    }
+
     std::lock_guard lock(impl_->pool_mutex);
-    return std::count_if(impl_->instances.begin(), impl_->instances.end(),
-                         [](const auto& inst) { return inst->in_use; });
+    ++impl_->counters.contexts_disposed;
+    return_slot_locked(session->instance_id);
 }
 
-auto BrowserPool::total_count() const -> size_t {
-    std::lock_guard lock(impl_->pool_mutex);
-    return impl_->instances.size();
+auto BrowserPool::health_check_loop() -> awaitable<void> {
+    net::steady_timer timer(impl_->ioc);
+
+    for (;;) {
+        timer.expires_after(
+            std::chrono::milliseconds(impl_->config.health_check_interval_ms));
+        boost::system::error_code ec;
+        co_await timer.async_wait(net::redirect_error(net::use_awaitable, ec));
+        if (ec) co_return;
+
+        std::vector<std::shared_ptr<BrowserInstance>> snapshot;
+        {
+            std::lock_guard lock(impl_->pool_mutex);
+            snapshot = impl_->instances;
+        }
+
+        for (auto& inst : snapshot) {
+            if (co_await check_instance(inst)) continue;
+
+            LOG_WARN("Browser instance {} failed health check; restarting",
+                     inst->id);
+            {
+                std::lock_guard lock(impl_->pool_mutex);
+                ++impl_->counters.health_check_failures;
+                inst->healthy = false;
+                if (std::erase(impl_->instances, inst) > 0) {
+                    ++impl_->counters.restarts;
+                }
+                // Launch a replacement if waiters or the pre-warm target need it
+                replenish_locked();
+            }
+            kill_browser_process(impl_->ioc, *inst);
+        }
+    }
 }
 
-auto BrowserPool::max_size() const -> size_t {
-    return impl_->config.pool_size;
+auto BrowserPool::check_instance(std::shared_ptr<BrowserInstance> instance)
+    -> awaitable<bool> {
+    if (browser_process_exited(*instance) || !instance->cdp ||
+        !instance->cdp->is_connected()) {
+        co_return false;
+    }
+
+    using namespace net::experimental::awaitable_operators;
+    net::steady_timer timeout(co_await net::this_coro::executor);
+    timeout.expires_after(std::chrono::milliseconds(kHealthCheckTimeoutMs));
+
+    auto result = co_await (
+        instance->cdp->send_command("Browser.getVersion") ||
+        timeout.async_wait(net::use_awaitable));
+    if (result.index() != 0) {
+        co_return false;  // timed out
+    }
+    co_return std::get<0>(result).has_value();
 }
 
-auto BrowserPool::launch_browser() -> Result<std::unique_ptr<BrowserInstance>> {
+auto BrowserPool::launch_browser()
+    -> awaitable<Result<std::shared_ptr<BrowserInstance>>> {
     auto chrome_path = find_chrome();
     if (chrome_path.empty()) {
-        return std::unexpected(
+        co_return make_fail(
             make_error(ErrorCode::BrowserError,
                        "Chrome/Chromium not found",
                        "Set browser.chrome_path in config"));
@@ -240,23 +871,20 @@ auto BrowserPool::launch_browser() -> Result<std::unique_ptr<BrowserInstance>> {
     auto user_data_dir = fs::temp_directory_path() / ("openclaw-chrome-" + instance_id);
     fs::create_directories(user_data_dir);
 
+    auto instance = std::make_shared<BrowserInstance>();
+    instance->id = instance_id;
+    instance->user_data_dir = user_data_dir;
+    instance->cdp = std::make_unique<CdpClient>(impl_->ioc);
+
 #ifdef _WIN32
     // Windows: use CreateProcessA
-    auto port_str = std::to_string(debug_port);
-    auto cmd_line = "\"" + chrome_path + "\""
-                    " --headless=new"
-                    " --no-first-run"
-                    " --no-default-browser-check"
-                    " --disable-gpu"
-                    " --disable-extensions"
-                    " --disable-background-networking"
-                    " --disable-sync"
-                    " --disable-translate"
-                    " --mute-audio"
-                    " --no-sandbox"
-                    " --remote-debugging-port=" + port_str +
-                    " --user-data-dir=" + user_data_dir.string() +
-                    " about:blank";
+    auto cmd_line = "\"" + chrome_path + "\"";
+    for (const auto* flag : kChromeFlags) {
+        cmd_line += std::string(" ") + flag;
+    }
+    cmd_line += " --remote-debugging-port=" + std::to_string(debug_port) +
+                " --user-data-dir=" + user_data_dir.string() +
+                " about:blank";
 
     STARTUPINFOA si = {};
     si.cb = sizeof(si);
@@ -264,39 +892,38 @@ auto BrowserPool::launch_browser() -> Result<std::unique_ptr<BrowserInstance>> {
 
     if (!::CreateProcessA(nullptr, cmd_line.data(), nullptr, nullptr, FALSE,
                           CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi)) {
-        return std::unexpected(
+        remove_user_data_dir(user_data_dir);
+        co_return make_fail(
             make_error(ErrorCode::BrowserError,
                        "Failed to launch Chrome process",
                        "GetLastError=" + std::to_string(::GetLastError())));
     }
 
     ::CloseHandle(pi.hThread);
-
-    // Wait for Chrome to start
-    platform_sleep_ms(500);
-
-    auto ws_endpoint = get_ws_endpoint(debug_port);
-    if (!ws_endpoint) {
-        ::TerminateProcess(pi.hProcess, 1);
-        ::CloseHandle(pi.hProcess);
-        return std::unexpected(ws_endpoint.error());
-    }
-
-    auto instance = std::make_unique<BrowserInstance>();
-    instance->id = instance_id;
-    instance->cdp = std::make_unique<CdpClient>(impl_->ioc);
-    instance->ws_endpoint = std::move(*ws_endpoint);
     instance->pid = pi.dwProcessId;
     instance->process_handle = pi.hProcess;
-
-    LOG_DEBUG("Chrome launched (pid={}, port={}, id={})", pi.dwProcessId,
-              debug_port, instance_id);
-    return instance;
 #else
-    // POSIX: fork and exec Chrome with remote debugging
+    // POSIX: fork and exec Chrome with remote debugging. The argv is built
+    // before fork so the child only calls async-signal-safe functions.
+    std::vector<std::string> args = {chrome_path};
+    for (const auto* flag : kChromeFlags) {
+        args.emplace_back(flag);
+    }
+    args.push_back("--remote-debugging-port=" + std::to_string(debug_port));
+    args.push_back("--user-data-dir=" + user_data_dir.string());
+    args.emplace_back("about:blank");
+
+    std::vector<char*> argv;
+    argv.reserve(args.size() + 1);
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
     pid_t pid = ::fork();
     if (pid < 0) {
-        return std::unexpected(
+        remove_user_data_dir(user_data_dir);
+        co_return make_fail(
             make_error(ErrorCode::BrowserError,
                        "Failed to fork Chrome process",
                        "errno=" + std::to_string(errno)));
@@ -304,51 +931,35 @@ auto BrowserPool::launch_browser() -> Result<std::unique_ptr<BrowserInstance>> {
 
     if (pid == 0) {
         // Child process: exec Chrome
-        auto port_str = std::to_string(debug_port);
-        auto debug_arg = "--remote-debugging-port=" + port_str;
-        auto user_data_arg = "--user-data-dir=" + user_data_dir.string();
-
-        ::execlp(chrome_path.c_str(), chrome_path.c_str(),
-                 "--headless=new",
-                 "--no-first-run",
-                 "--no-default-browser-check",
-                 "--disable-gpu",
-                 "--disable-extensions",
-                 "--disable-background-networking",
-                 "--disable-sync",
-                 "--disable-translate",
-                 "--mute-audio",
-                 "--no-sandbox",
-                 debug_arg.c_str(),
-                 user_data_arg.c_str(),
-                 "about:blank",
-                 nullptr);
-
-        // If execlp returns, it failed
+        ::execvp(argv[0], argv.data());
+
+        // If execvp returns, it failed
         ::_exit(127);
     }
 
-    // Parent process: wait a bit for Chrome to start
-    platform_sleep_ms(500);
+    instance->pid = pid;
+#endif
 
-    auto ws_endpoint = get_ws_endpoint(debug_port);
+    // Discover the DevTools endpoint without blocking the event loop
+    auto ws_endpoint = co_await get_ws_endpoint(debug_port, *instance);
     if (!ws_endpoint) {
-        ::kill(pid, SIGTERM);
-        int status = 0;
-        ::waitpid(pid, &status, WNOHANG);
-        return std::unexpected(ws_endpoint.error());
+        kill_browser_process(impl_->ioc, *instance);
+        co_return make_fail(ws_endpoint.error());
     }
-
-    auto instance = std::make_unique<BrowserInstance>();
-    instance->id = instance_id;
-    instance->cdp = std::make_unique<CdpClient>(impl_->ioc);
     instance->ws_endpoint = std::move(*ws_endpoint);
-    instance->pid = pid;
 
-    LOG_DEBUG("Chrome launched (pid={}, port={}, id={})", pid, debug_port,
-              instance_id);
-    return instance;
-#endif
+    LOG_DEBUG("Chrome launched (pid={}, port={}, id={})", instance->pid,
+              debug_port, instance_id);
+
+    // Connect the browser-level CDP client used to manage contexts
+    auto connect_result = co_await instance->cdp->connect(instance->ws_endpoint);
+    if (!connect_result) {
+        // Kill the process since we can't connect
+        kill_browser_process(impl_->ioc, *instance);
+        co_return make_fail(connect_result.error());
+    }
+
+    co_return instance;
 }
 
 auto BrowserPool::find_chrome() const -> std::string {
@@ -408,67 +1019,47 @@ auto BrowserPool::find_chrome() const -> std::string {
     return {};
 }
 
-auto BrowserPool::get_ws_endpoint(int debug_port) -> Result<std::string> {
-    // Chrome exposes /json/version at the debug port to get the WS URL
-    try {
-        // Try multiple times since Chrome might still be starting
-        for (int attempt = 0; attempt < 10; ++attempt) {
-            try {
-                // Simple TCP connect + HTTP request
-                net::io_context tmp_ioc;
-                net::ip::tcp::socket sock(tmp_ioc);
-                net::ip::tcp::resolver resolver(tmp_ioc);
-                auto results = resolver.resolve("127.0.0.1",
-                                                std::to_string(debug_port));
-                net::connect(sock, results);
-
-                std::string request = "GET /json/version HTTP/1.1\r\n"
-                                      "Host: 127.0.0.1:" +
-                                      std::to_string(debug_port) +
-                                      "\r\n"
-                                      "Connection: close\r\n\r\n";
-                net::write(sock, net::buffer(request));
-
-                std::string response;
-                boost::system::error_code ec;
-                char buf[4096];
-                while (auto n = sock.read_some(net::buffer(buf), ec)) {
-                    response.append(buf, n);
-                }
-
-                // Extract the JSON body (after the HTTP headers)
-                auto body_pos = response.find("\r\n\r\n");
-                if (body_pos == std::string::npos) {
-                    platform_sleep_ms(200);
-                    continue;
-                }
-
-                auto body = response.substr(body_pos + 4);
-                auto j = json::parse(body);
-
-                if (j.contains("webSocketDebuggerUrl")) {
-                    return j["webSocketDebuggerUrl"].get<std::string>();
-                }
+auto BrowserPool::get_ws_endpoint(int debug_port, BrowserInstance& process)
+    -> awaitable<Result<std::string>> {
+    // Chrome exposes /json/version at the debug port to get the WS URL.
+    // Poll it on a timer until Chrome is listening, the process exits, or
+    // launch_timeout_ms elapses.
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(impl_->config.launch_timeout_ms);
+    net::steady_timer timer(co_await net::this_coro::executor);
+    std::string last_error = "no response";
+
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (browser_process_exited(process)) {
+            co_return make_fail(
+                make_error(ErrorCode::BrowserError,
+                           "Chrome exited during startup",
+                           "port=" + std::to_string(debug_port)));
+        }
 
-                platform_sleep_ms(200);
-            } catch (...) {
-                platform_sleep_ms(200);
+        auto body = co_await fetch_devtools_version(debug_port);
+        if (body) {
+            auto j = json::parse(*body, nullptr, false);
+            if (!j.is_discarded() && j.contains("webSocketDebuggerUrl")) {
+                co_return j["webSocketDebuggerUrl"].get<std::string>();
             }
+            last_error = "missing webSocketDebuggerUrl";
+        } else {
+            last_error = body.error().what();
         }
 
-        return std::unexpected(
-            make_error(ErrorCode::BrowserError,
-                       "Failed to get Chrome DevTools WebSocket URL",
-                       "port=" + std::to_string(debug_port)));
-    } catch (const std::exception& e) {
-        return std::unexpected(
-            make_error(ErrorCode::BrowserError,
-                       "Failed to get Chrome WebSocket endpoint",
-                       e.what()));
+        timer.expires_after(std::chrono::milliseconds(kEndpointPollMs));
+        co_await timer.async_wait(net::use_awaitable);
     }
+
+    co_return make_fail(
+        make_error(ErrorCode::BrowserError,
+                   "Failed to get Chrome DevTools WebSocket URL",
+                   "port=" + std::to_string(debug_port) + ": " + last_error));
 }
 
 auto BrowserPool::allocate_debug_port() -> int {
+    std::lock_guard lock(impl_->pool_mutex);
     return impl_->next_debug_port++;
 }
 
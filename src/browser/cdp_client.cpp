@@ -6,9 +6,14 @@
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <deque>
 #include <mutex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace openclaw::browser {
 
@@ -17,38 +22,207 @@ namespace websocket = beast::websocket;
 namespace net = boost::asio;
 using tcp = net::ip::tcp;
 
+namespace {
+
+using ResultChannel = net::experimental::concurrent_channel<void(
+    boost::system::error_code, Result<json>)>;
+
+/// Handlers for one event, in registration order.
+using HandlerList = std::vector<std::pair<ListenerId, EventHandler>>;
+
 // ---------------------------------------------------------------------------
-// Pending command: a promise/future pair for awaiting CDP responses
+// PendingTable: in-flight commands keyed by id
 // ---------------------------------------------------------------------------
 
-struct PendingCommand {
-    net::any_io_executor executor;
-    std::function<void(Result<json>)> callback;
+/// Fixed-capacity open-addressing table of in-flight commands.
+/// Each slot is claimed and released by CAS on its id, so senders and the
+/// read loop never contend on a lock. Ids are allocated monotonically, so
+/// a command almost always lands in (and is found at) its home slot.
+class PendingTable {
+public:
+    using Callback = std::function<void(Result<json>)>;
+
+    /// Maximum in-flight commands per connection (power of two).
+    static constexpr size_t kCapacity = 1024;
+
+    auto insert(int id, Callback callback) -> bool {
+        for (size_t probe = 0; probe < kCapacity; ++probe) {
+            auto& slot = slots_[(static_cast<size_t>(id) + probe) & kMask];
+            int expected = kFree;
+            if (slot.id.compare_exchange_strong(expected, kBusy,
+                                                std::memory_order_acquire)) {
+                slot.callback = std::move(callback);
+                slot.id.store(id, std::memory_order_release);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Removes and returns the callback for `id`, or an empty function.
+    auto take(int id) -> Callback {
+        for (size_t probe = 0; probe < kCapacity; ++probe) {
+            auto& slot = slots_[(static_cast<size_t>(id) + probe) & kMask];
+            int expected = id;
+            if (slot.id.compare_exchange_strong(expected, kBusy,
+                                                std::memory_order_acquire)) {
+                auto callback = std::move(slot.callback);
+                slot.callback = nullptr;
+                slot.id.store(kFree, std::memory_order_release);
+                return callback;
+            }
+        }
+        return {};
+    }
+
+    /// Fails every in-flight command (connection closed).
+    void fail_all(const Error& error) {
+        for (auto& slot : slots_) {
+            int id = slot.id.load(std::memory_order_acquire);
+            if (id > 0) {
+                if (auto callback = take(id)) {
+                    callback(std::unexpected(error));
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr size_t kMask = kCapacity - 1;
+    static constexpr int kFree = 0;
+    static constexpr int kBusy = -1;
+
+    struct Slot {
+        std::atomic<int> id{kFree};
+        Callback callback;
+    };
+
+    std::array<Slot, kCapacity> slots_;
 };
 
+/// Commands send_many() keeps in flight; well under PendingTable::kCapacity
+/// so concurrent send_command() calls still find free slots.
+constexpr size_t kMaxPipelined = 256;
+
+} // anonymous namespace
+
 // ---------------------------------------------------------------------------
-// CdpClient::Impl
+// CdpClient::Transport: the WebSocket shared by a client and its sessions
 // ---------------------------------------------------------------------------
 
-struct CdpClient::Impl {
+struct CdpClient::Transport : std::enable_shared_from_this<Transport> {
     net::io_context& ioc;
     std::unique_ptr<websocket::stream<beast::tcp_stream>> ws;
     std::string url;
     std::atomic<bool> connected{false};
     std::atomic<int> next_id{1};
 
-    std::mutex pending_mutex;
-    std::unordered_map<int, PendingCommand> pending_commands;
+    PendingTable pending;
+
+    // beast allows one outstanding write; queued messages are drained in
+    // order by a single writer coroutine.
+    std::mutex write_mutex;
+    std::deque<std::pair<int, std::string>> write_queue;
+    bool writing = false;
 
+    // sessionId ("" for the connection itself) -> method -> handlers.
+    // Id 0 is the subscribe() slot; listen() ids start at 1.
     std::mutex handler_mutex;
-    std::unordered_map<std::string, EventHandler> event_handlers;
+    std::unordered_map<std::string,
+                       std::unordered_map<std::string, HandlerList>>
+        event_handlers;
+    ListenerId next_listener_id = 1;
 
-    explicit Impl(net::io_context& ctx) : ioc(ctx) {}
+    explicit Transport(net::io_context& ctx) : ioc(ctx) {}
 
     auto allocate_id() -> int {
         return next_id.fetch_add(1, std::memory_order_relaxed);
     }
 
+    /// Registers a command and queues it for writing. The returned channel
+    /// receives the response.
+    auto issue(const std::string& session_id, std::string_view method,
+               json params) -> Result<std::shared_ptr<ResultChannel>> {
+        if (!connected) {
+            return std::unexpected(
+                make_error(ErrorCode::ConnectionClosed,
+                           "CDP client not connected"));
+        }
+
+        int id = allocate_id();
+
+        json message = {
+            {"id", id},
+            {"method", std::string(method)},
+            {"params", params.is_null() ? json::object() : std::move(params)},
+        };
+        if (!session_id.empty()) {
+            message["sessionId"] = session_id;
+        }
+
+        auto channel = std::make_shared<ResultChannel>(ioc, 1);
+        bool registered = pending.insert(id, [channel](Result<json> result) {
+            channel->try_send(boost::system::error_code{}, std::move(result));
+        });
+        if (!registered) {
+            return std::unexpected(
+                make_error(ErrorCode::RateLimited,
+                           "Too many in-flight CDP commands",
+                           std::string(method)));
+        }
+
+        enqueue_write(id, message.dump());
+        return channel;
+    }
+
+    void enqueue_write(int id, std::string message) {
+        std::lock_guard lock(write_mutex);
+        write_queue.emplace_back(id, std::move(message));
+        if (!writing) {
+            writing = true;
+            net::co_spawn(ioc, write_loop(shared_from_this()), net::detached);
+        }
+    }
+
+    static auto write_loop(std::shared_ptr<Transport> self) -> awaitable<void> {
+        for (;;) {
+            std::pair<int, std::string> next;
+            {
+                std::lock_guard lock(self->write_mutex);
+                if (self->write_queue.empty()) {
+                    self->writing = false;
+                    co_return;
+                }
+                next = std::move(self->write_queue.front());
+                self->write_queue.pop_front();
+            }
+
+            try {
+                co_await self->ws->async_write(net::buffer(next.second),
+                                               net::use_awaitable);
+            } catch (const beast::system_error& se) {
+                LOG_ERROR("CDP write error: {}", se.what());
+                auto error = make_error(ErrorCode::ConnectionFailed,
+                                        "Failed to send CDP command",
+                                        se.what());
+
+                std::deque<std::pair<int, std::string>> unsent;
+                {
+                    std::lock_guard lock(self->write_mutex);
+                    unsent.swap(self->write_queue);
+                    self->writing = false;
+                }
+                unsent.emplace_front(std::move(next));
+                for (auto& [id, _] : unsent) {
+                    if (auto callback = self->pending.take(id)) {
+                        callback(std::unexpected(error));
+                    }
+                }
+                co_return;
+            }
+        }
+    }
+
     void dispatch_message(const std::string& msg) {
         try {
             auto j = json::parse(msg);
@@ -57,17 +231,7 @@ struct CdpClient::Impl {
             if (j.contains("id")) {
                 int id = j["id"].get<int>();
 
-                std::function<void(Result<json>)> callback;
-                {
-                    std::lock_guard lock(pending_mutex);
-                    auto it = pending_commands.find(id);
-                    if (it != pending_commands.end()) {
-                        callback = std::move(it->second.callback);
-                        pending_commands.erase(it);
-                    }
-                }
-
-                if (callback) {
+                if (auto callback = pending.take(id)) {
                     if (j.contains("error")) {
                         auto& err = j["error"];
                         callback(std::unexpected(
@@ -83,25 +247,68 @@ struct CdpClient::Impl {
                 return;
             }
 
-            // Otherwise, this is an event notification
+            // Otherwise, this is an event notification, routed by sessionId
             if (j.contains("method")) {
                 auto method = j["method"].get<std::string>();
-                EventHandler handler;
+                auto session_id = j.value("sessionId", std::string{});
+                HandlerList handlers;
                 {
                     std::lock_guard lock(handler_mutex);
-                    auto it = event_handlers.find(method);
-                    if (it != event_handlers.end()) {
-                        handler = it->second;
+                    auto sit = event_handlers.find(session_id);
+                    if (sit != event_handlers.end()) {
+                        auto it = sit->second.find(method);
+                        if (it != sit->second.end()) {
+                            handlers = it->second;
+                        }
                     }
                 }
-                if (handler) {
-                    handler(j.value("params", json::object()));
+                if (handlers.empty()) {
+                    return;
+                }
+                auto params = j.value("params", json::object());
+                for (auto& [_, handler] : handlers) {
+                    handler(params);
                 }
             }
         } catch (const json::exception& e) {
             LOG_WARN("Failed to parse CDP message: {}", e.what());
         }
     }
+
+    static auto read_loop(std::shared_ptr<Transport> self) -> awaitable<void> {
+        beast::flat_buffer buffer;
+        while (self->connected) {
+            try {
+                co_await self->ws->async_read(buffer, net::use_awaitable);
+                auto msg = beast::buffers_to_string(buffer.data());
+                buffer.consume(buffer.size());
+                self->dispatch_message(msg);
+            } catch (const beast::system_error& se) {
+                if (se.code() != websocket::error::closed) {
+                    LOG_ERROR("CDP read error: {}", se.what());
+                }
+                self->connected = false;
+                break;
+            }
+        }
+
+        // Fail all pending commands
+        self->pending.fail_all(
+            make_error(ErrorCode::ConnectionClosed, "CDP connection closed"));
+    }
+};
+
+// ---------------------------------------------------------------------------
+// CdpClient::Impl
+// ---------------------------------------------------------------------------
+
+struct CdpClient::Impl {
+    std::shared_ptr<Transport> transport;
+    std::string session_id;        // empty for the owning client
+    std::atomic<bool> attached{true};
+
+    Impl(std::shared_ptr<Transport> t, std::string sid)
+        : transport(std::move(t)), session_id(std::move(sid)) {}
 };
 
 // ---------------------------------------------------------------------------
@@ -109,16 +316,30 @@ struct CdpClient::Impl {
 // ---------------------------------------------------------------------------
 
 CdpClient::CdpClient(boost::asio::io_context& ioc)
-    : impl_(std::make_unique<Impl>(ioc)) {}
+    : impl_(std::make_unique<Impl>(std::make_shared<Transport>(ioc), "")) {}
+
+CdpClient::CdpClient(std::shared_ptr<Transport> transport, std::string session_id)
+    : impl_(std::make_unique<Impl>(std::move(transport), std::move(session_id))) {}
 
 CdpClient::~CdpClient() {
-    if (impl_ && impl_->connected) {
+    if (!impl_) return;
+    auto& t = *impl_->transport;
+
+    if (!impl_->session_id.empty()) {
+        // Session client: stop routing its events; the WebSocket stays
+        // open for the owning client and other sessions.
+        std::lock_guard lock(t.handler_mutex);
+        t.event_handlers.erase(impl_->session_id);
+        return;
+    }
+
+    if (t.connected) {
         // Best-effort close
-        if (impl_->ws) {
+        if (t.ws) {
             beast::error_code ec;
-            impl_->ws->close(websocket::close_code::normal, ec);
+            t.ws->close(websocket::close_code::normal, ec);
         }
-        impl_->connected = false;
+        t.connected = false;
     }
 }
 
@@ -126,7 +347,8 @@ CdpClient::CdpClient(CdpClient&&) noexcept = default;
 CdpClient& CdpClient::operator=(CdpClient&&) noexcept = default;
 
 auto CdpClient::connect(std::string_view ws_url) -> awaitable<Result<void>> {
-    impl_->url = std::string(ws_url);
+    auto& t = *impl_->transport;
+    t.url = std::string(ws_url);
 
     try {
         // Parse the WebSocket URL: ws://host:port/path
@@ -157,77 +379,44 @@ auto CdpClient::connect(std::string_view ws_url) -> awaitable<Result<void>> {
         }
 
         // Resolve the host
-        tcp::resolver resolver(impl_->ioc);
+        tcp::resolver resolver(t.ioc);
         auto results = co_await resolver.async_resolve(
             host, port, net::use_awaitable);
 
         // Create the WebSocket stream
-        impl_->ws = std::make_unique<websocket::stream<beast::tcp_stream>>(
-            impl_->ioc);
+        t.ws = std::make_unique<websocket::stream<beast::tcp_stream>>(t.ioc);
 
         // Set timeouts
-        beast::get_lowest_layer(*impl_->ws).expires_after(
-            std::chrono::seconds(30));
+        beast::get_lowest_layer(*t.ws).expires_after(std::chrono::seconds(30));
 
         // Connect TCP
-        auto ep = co_await beast::get_lowest_layer(*impl_->ws).async_connect(
+        auto ep = co_await beast::get_lowest_layer(*t.ws).async_connect(
             results, net::use_awaitable);
 
         // Update host string for the handshake
         auto host_str = host + ":" + std::to_string(ep.port());
 
         // Remove timeout for WebSocket (it has its own ping/pong)
-        beast::get_lowest_layer(*impl_->ws).expires_never();
+        beast::get_lowest_layer(*t.ws).expires_never();
 
         // Set WebSocket options
-        impl_->ws->set_option(websocket::stream_base::timeout::suggested(
+        t.ws->set_option(websocket::stream_base::timeout::suggested(
             beast::role_type::client));
 
-        impl_->ws->set_option(websocket::stream_base::decorator(
+        t.ws->set_option(websocket::stream_base::decorator(
             [](websocket::request_type& req) {
                 req.set(beast::http::field::user_agent,
                         "openclaw-cdp/1.0");
             }));
 
         // Perform WebSocket handshake
-        co_await impl_->ws->async_handshake(host_str, target,
-                                            net::use_awaitable);
+        co_await t.ws->async_handshake(host_str, target, net::use_awaitable);
 
-        impl_->connected = true;
+        t.connected = true;
         LOG_INFO("CDP connected to {}", url_str);
 
         // Start the read loop in the background
-        net::co_spawn(impl_->ioc,
-            [this]() -> awaitable<void> {
-                beast::flat_buffer buffer;
-                while (impl_->connected) {
-                    try {
-                        co_await impl_->ws->async_read(buffer,
-                                                       net::use_awaitable);
-                        auto msg = beast::buffers_to_string(buffer.data());
-                        buffer.consume(buffer.size());
-                        impl_->dispatch_message(msg);
-                    } catch (const beast::system_error& se) {
-                        if (se.code() != websocket::error::closed) {
-                            LOG_ERROR("CDP read error: {}", se.what());
-                        }
-                        impl_->connected = false;
-                        break;
-                    }
-                }
-
-                // Fail all pending commands
-                {
-                    std::lock_guard lock(impl_->pending_mutex);
-                    for (auto& [id, cmd] : impl_->pending_commands) {
-                        cmd.callback(std::unexpected(
-                            make_error(ErrorCode::ConnectionClosed,
-                                       "CDP connection closed")));
-                    }
-                    impl_->pending_commands.clear();
-                }
-            },
-            net::detached);
+        net::co_spawn(t.ioc, Transport::read_loop(impl_->transport), net::detached);
 
         co_return ok_result();
     } catch (const beast::system_error& se) {
@@ -243,98 +432,195 @@ auto CdpClient::connect(std::string_view ws_url) -> awaitable<Result<void>> {
     }
 }
 
+auto CdpClient::attach(std::string_view target_id)
+    -> awaitable<Result<std::unique_ptr<CdpClient>>> {
+    auto result = co_await send_command("Target.attachToTarget", {
+        {"targetId", std::string(target_id)},
+        {"flatten", true},
+    });
+    if (!result) {
+        co_return make_fail(result.error());
+    }
+
+    auto session_id = result->value("sessionId", std::string{});
+    if (session_id.empty()) {
+        co_return make_fail(
+            make_error(ErrorCode::ProtocolError,
+                       "Target.attachToTarget returned no sessionId",
+                       std::string(target_id)));
+    }
+
+    LOG_DEBUG("CDP attached to target {} (session {})",
+              std::string(target_id), session_id);
+    co_return std::unique_ptr<CdpClient>(
+        new CdpClient(impl_->transport, std::move(session_id)));
+}
+
 auto CdpClient::send_command(std::string_view method, json params)
     -> awaitable<Result<json>> {
-    if (!impl_->connected) {
+    if (!impl_->attached) {
         co_return make_fail(
             make_error(ErrorCode::ConnectionClosed,
-                       "CDP client not connected"));
+                       "CDP session detached"));
     }
 
-    int id = impl_->allocate_id();
+    auto channel = impl_->transport->issue(impl_->session_id, method,
+                                           std::move(params));
+    if (!channel) {
+        co_return make_fail(channel.error());
+    }
 
-    json message = {
-        {"id", id},
-        {"method", std::string(method)},
-        {"params", std::move(params)},
-    };
+    // Wait for the response
+    auto result = co_await (*channel)->async_receive(net::use_awaitable);
+    co_return result;
+}
 
-    // Create a channel to receive the result
-    using channel_t = net::experimental::concurrent_channel<void(
-        boost::system::error_code, Result<json>)>;
-    auto channel = std::make_shared<channel_t>(impl_->ioc, 1);
-
-    // Register the pending command
-    {
-        std::lock_guard lock(impl_->pending_mutex);
-        impl_->pending_commands[id] = PendingCommand{
-            co_await net::this_coro::executor,
-            [channel](Result<json> result) {
-                channel->try_send(boost::system::error_code{},
-                                  std::move(result));
-            },
-        };
+auto CdpClient::send_many(std::vector<CdpCommand> commands)
+    -> awaitable<std::vector<Result<json>>> {
+    std::vector<Result<json>> results(commands.size());
+    std::vector<std::shared_ptr<ResultChannel>> channels(commands.size());
+
+    // Queue commands ahead of their responses, but never more than
+    // kMaxPipelined at once so a long batch cannot fill the pending table
+    for (size_t i = 0; i < commands.size(); ++i) {
+        if (i >= kMaxPipelined && channels[i - kMaxPipelined]) {
+            auto& earlier = channels[i - kMaxPipelined];
+            results[i - kMaxPipelined] =
+                co_await earlier->async_receive(net::use_awaitable);
+            earlier.reset();
+        }
+        if (!impl_->attached) {
+            results[i] = std::unexpected(
+                make_error(ErrorCode::ConnectionClosed,
+                           "CDP session detached"));
+            continue;
+        }
+        auto channel = impl_->transport->issue(
+            impl_->session_id, commands[i].method,
+            std::move(commands[i].params));
+        if (channel) {
+            channels[i] = std::move(*channel);
+        } else {
+            results[i] = std::unexpected(channel.error());
+        }
     }
 
-    // Send the message
-    try {
-        auto msg_str = message.dump();
-        co_await impl_->ws->async_write(
-            net::buffer(msg_str), net::use_awaitable);
-    } catch (const beast::system_error& se) {
-        // Remove the pending command
-        {
-            std::lock_guard lock(impl_->pending_mutex);
-            impl_->pending_commands.erase(id);
+    for (size_t i = 0; i < channels.size(); ++i) {
+        if (channels[i]) {
+            results[i] = co_await channels[i]->async_receive(net::use_awaitable);
         }
-        co_return make_fail(
-            make_error(ErrorCode::ConnectionFailed,
-                       "Failed to send CDP command",
-                       se.what()));
     }
 
-    // Wait for the response
-    auto result = co_await channel->async_receive(net::use_awaitable);
-    co_return result;
+    co_return results;
 }
 
 void CdpClient::subscribe(std::string_view event, EventHandler handler) {
-    std::lock_guard lock(impl_->handler_mutex);
-    impl_->event_handlers[std::string(event)] = std::move(handler);
+    auto& t = *impl_->transport;
+    std::lock_guard lock(t.handler_mutex);
+    auto& handlers = t.event_handlers[impl_->session_id][std::string(event)];
+    auto it = std::find_if(handlers.begin(), handlers.end(),
+                           [](const auto& h) { return h.first == 0; });
+    if (it != handlers.end()) {
+        it->second = std::move(handler);
+    } else {
+        handlers.emplace_back(0, std::move(handler));
+    }
     LOG_DEBUG("Subscribed to CDP event: {}", std::string(event));
 }
 
 void CdpClient::unsubscribe(std::string_view event) {
-    std::lock_guard lock(impl_->handler_mutex);
-    impl_->event_handlers.erase(std::string(event));
+    auto& t = *impl_->transport;
+    std::lock_guard lock(t.handler_mutex);
+    auto it = t.event_handlers.find(impl_->session_id);
+    if (it != t.event_handlers.end()) {
+        auto mit = it->second.find(std::string(event));
+        if (mit != it->second.end()) {
+            std::erase_if(mit->second, [](const auto& h) { return h.first == 0; });
+            if (mit->second.empty()) {
+                it->second.erase(mit);
+            }
+        }
+    }
     LOG_DEBUG("Unsubscribed from CDP event: {}", std::string(event));
 }
 
+auto CdpClient::listen(std::string_view event, EventHandler handler) -> ListenerId {
+    auto& t = *impl_->transport;
+    std::lock_guard lock(t.handler_mutex);
+    auto id = t.next_listener_id++;
+    t.event_handlers[impl_->session_id][std::string(event)].emplace_back(
+        id, std::move(handler));
+    return id;
+}
+
+void CdpClient::unlisten(ListenerId id) {
+    auto& t = *impl_->transport;
+    std::lock_guard lock(t.handler_mutex);
+    auto it = t.event_handlers.find(impl_->session_id);
+    if (it == t.event_handlers.end()) {
+        return;
+    }
+    for (auto mit = it->second.begin(); mit != it->second.end(); ++mit) {
+        if (std::erase_if(mit->second, [id](const auto& h) { return h.first == id; })) {
+            if (mit->second.empty()) {
+                it->second.erase(mit);
+            }
+            return;
+        }
+    }
+}
+
 auto CdpClient::disconnect() -> awaitable<void> {
-    if (!impl_->connected) {
+    auto& t = *impl_->transport;
+
+    if (!impl_->session_id.empty()) {
+        // Session client: detach from the target, keep the WebSocket
+        if (!impl_->attached.exchange(false)) {
+            co_return;
+        }
+        {
+            std::lock_guard lock(t.handler_mutex);
+            t.event_handlers.erase(impl_->session_id);
+        }
+        if (t.connected) {
+            auto channel = t.issue("", "Target.detachFromTarget",
+                                   json{{"sessionId", impl_->session_id}});
+            if (channel) {
+                co_await (*channel)->async_receive(net::use_awaitable);
+            }
+        }
+        LOG_DEBUG("CDP detached session {}", impl_->session_id);
         co_return;
     }
 
-    impl_->connected = false;
+    if (!t.connected) {
+        co_return;
+    }
 
-    if (impl_->ws) {
+    t.connected = false;
+
+    if (t.ws) {
         try {
-            co_await impl_->ws->async_close(websocket::close_code::normal,
-                                            net::use_awaitable);
+            co_await t.ws->async_close(websocket::close_code::normal,
+                                       net::use_awaitable);
         } catch (const beast::system_error&) {
             // Ignore close errors
         }
     }
 
-    LOG_INFO("CDP disconnected from {}", impl_->url);
+    LOG_INFO("CDP disconnected from {}", t.url);
 }
 
 auto CdpClient::is_connected() const -> bool {
-    return impl_ && impl_->connected;
+    return impl_ && impl_->attached && impl_->transport->connected;
 }
 
 auto CdpClient::ws_url() const -> std::string_view {
-    return impl_->url;
+    return impl_->transport->url;
+}
+
+auto CdpClient::session_id() const -> std::string_view {
+    return impl_->session_id;
 }
 
 } // namespace openclaw::browser
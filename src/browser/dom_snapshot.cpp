@@ -0,0 +1,429 @@
+#include "openclaw/browser/dom_snapshot.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace openclaw::browser {
+
+namespace {
+
+using Column = json::array_t;
+
+/// Returns the named array member of `obj`, or nullptr.
+auto column(const json& obj, std::string_view key) -> const Column* {
+    auto it = obj.find(key);
+    if (it == obj.end() || !it->is_array()) {
+        return nullptr;
+    }
+    return &it->get_ref<const Column&>();
+}
+
+auto int_at(const Column* col, size_t index, int fallback = -1) -> int {
+    if (!col || index >= col->size()) {
+        return fallback;
+    }
+    const auto& v = (*col)[index];
+    return v.is_number_integer() ? v.get<int>() : fallback;
+}
+
+auto is_whitespace(char c) -> bool {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+auto all_whitespace(std::string_view s) -> bool {
+    return std::all_of(s.begin(), s.end(), is_whitespace);
+}
+
+auto node_type_name(uint8_t type) -> const char* {
+    switch (type) {
+        case 1: return "element";
+        case 3: return "text";
+        case 9: return "document";
+        case 10: return "doctype";
+        case 11: return "fragment";
+        default: return "other";
+    }
+}
+
+auto one_of(std::string_view name, std::initializer_list<std::string_view> set)
+    -> bool {
+    return std::find(set.begin(), set.end(), name) != set.end();
+}
+
+/// Elements whose content is never page text.
+auto is_non_content(std::string_view name) -> bool {
+    return one_of(name, {"SCRIPT", "STYLE", "NOSCRIPT", "TEMPLATE", "HEAD",
+                         "svg", "IFRAME", "OBJECT"});
+}
+
+/// Elements that start and end a line in the text rendering.
+auto is_block(std::string_view name) -> bool {
+    return one_of(name, {"P", "DIV", "SECTION", "ARTICLE", "MAIN", "ASIDE",
+                         "HEADER", "FOOTER", "NAV", "UL", "OL", "LI", "DL",
+                         "DT", "DD", "TABLE", "TR", "FORM", "FIELDSET",
+                         "BLOCKQUOTE", "PRE", "FIGURE", "FIGCAPTION", "H1",
+                         "H2", "H3", "H4", "H5", "H6", "BR", "HR", "BODY",
+                         "HTML"});
+}
+
+/// Heading level for H1..H6, 0 otherwise.
+auto heading_level(std::string_view name) -> int {
+    if (name.size() == 2 && name[0] == 'H' && name[1] >= '1' && name[1] <= '6') {
+        return name[1] - '0';
+    }
+    return 0;
+}
+
+/// Accumulates text with HTML-like whitespace collapsing. A line prefix
+/// ("- ", "## ") only survives if text follows it.
+class TextWriter {
+public:
+    void text(std::string_view s) {
+        for (char c : s) {
+            if (is_whitespace(c)) {
+                pending_space_ = true;
+                continue;
+            }
+            if (pending_space_ && has_content()) {
+                out_ += ' ';
+            }
+            pending_space_ = false;
+            out_ += c;
+        }
+    }
+
+    void line_break() {
+        if (has_content()) {
+            out_ += '\n';
+            line_start_ = content_start_ = out_.size();
+        }
+        pending_space_ = false;
+    }
+
+    void prefix(std::string_view p) {
+        line_break();
+        out_.resize(line_start_);
+        out_ += p;
+        content_start_ = out_.size();
+    }
+
+    auto take() -> std::string {
+        if (!has_content()) {
+            out_.resize(line_start_);
+        }
+        while (!out_.empty() && out_.back() == '\n') {
+            out_.pop_back();
+        }
+        return std::move(out_);
+    }
+
+private:
+    auto has_content() const -> bool { return out_.size() > content_start_; }
+
+    std::string out_;
+    size_t line_start_ = 0;
+    size_t content_start_ = 0;
+    bool pending_space_ = false;
+};
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// Decoding
+// ---------------------------------------------------------------------------
+
+auto FlatDomSnapshot::capture_params() -> json {
+    return {
+        {"computedStyles", json::array()},
+        {"includeDOMRects", true},
+        {"includePaintOrder", false},
+    };
+}
+
+auto FlatDomSnapshot::decode(json result) -> Result<FlatDomSnapshot> {
+    FlatDomSnapshot snap;
+    snap.source_ = std::move(result);
+    const auto& src = snap.source_;
+
+    const auto* documents = column(src, "documents");
+    if (!documents || documents->empty()) {
+        return std::unexpected(
+            make_error(ErrorCode::BrowserError,
+                       "DOM snapshot returned no documents"));
+    }
+
+    // Resolve the string table once; nodes keep views into it
+    std::vector<std::string_view> strings;
+    if (const auto* table = column(src, "strings")) {
+        strings.reserve(table->size());
+        for (const auto& s : *table) {
+            strings.push_back(s.is_string()
+                                  ? std::string_view(s.get_ref<const std::string&>())
+                                  : std::string_view{});
+        }
+    }
+    auto str = [&](int idx) -> std::string_view {
+        return idx >= 0 && static_cast<size_t>(idx) < strings.size()
+                   ? strings[idx]
+                   : std::string_view{};
+    };
+
+    const auto& doc = (*documents)[0];
+    auto nodes_it = doc.find("nodes");
+    if (nodes_it == doc.end() || !nodes_it->is_object()) {
+        return snap;
+    }
+
+    // Resolve the node columns once
+    const auto* parents = column(*nodes_it, "parentIndex");
+    const auto* types = column(*nodes_it, "nodeType");
+    const auto* names = column(*nodes_it, "nodeName");
+    const auto* values = column(*nodes_it, "nodeValue");
+    const auto* attrs = column(*nodes_it, "attributes");
+    const auto* backend_ids = column(*nodes_it, "backendNodeId");
+
+    size_t count = names ? names->size() : 0;
+    snap.nodes_.resize(count);
+    std::vector<int32_t> last_child(count, -1);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto& node = snap.nodes_[i];
+        node.name = str(int_at(names, i));
+        node.value = str(int_at(values, i));
+        node.type = static_cast<uint8_t>(int_at(types, i, 0));
+        node.backend_id = int_at(backend_ids, i, 0);
+
+        // Attributes: flat [name, value, name, value, ...] string indices
+        if (attrs && i < attrs->size() && (*attrs)[i].is_array()) {
+            const auto& pairs = (*attrs)[i].get_ref<const Column&>();
+            node.attr_begin = static_cast<uint32_t>(snap.attributes_.size());
+            for (size_t a = 0; a + 1 < pairs.size(); a += 2) {
+                auto name = str(pairs[a].is_number_integer() ? pairs[a].get<int>() : -1);
+                if (name.empty()) continue;
+                auto value = str(pairs[a + 1].is_number_integer()
+                                     ? pairs[a + 1].get<int>() : -1);
+                snap.attributes_.push_back({name, value});
+            }
+            node.attr_count = static_cast<uint32_t>(snap.attributes_.size()) -
+                              node.attr_begin;
+        }
+
+        // Nodes are in document order, so a valid parent precedes its
+        // children; anything else is treated as a detached root.
+        int parent = int_at(parents, i);
+        if (parent < 0 || static_cast<size_t>(parent) >= i) {
+            continue;
+        }
+        node.parent = parent;
+        node.depth = snap.nodes_[parent].depth + 1;
+        if (last_child[parent] < 0) {
+            snap.nodes_[parent].first_child = static_cast<int32_t>(i);
+        } else {
+            snap.nodes_[last_child[parent]].next_sibling = static_cast<int32_t>(i);
+        }
+        last_child[parent] = static_cast<int32_t>(i);
+    }
+
+    // Layout boxes are indexed by layout object, mapped back via nodeIndex
+    if (auto layout_it = doc.find("layout"); layout_it != doc.end()) {
+        const auto* node_index = column(*layout_it, "nodeIndex");
+        const auto* bounds = column(*layout_it, "bounds");
+        if (node_index && bounds) {
+            size_t boxes = std::min(node_index->size(), bounds->size());
+            snap.bounds_.reserve(boxes);
+            for (size_t k = 0; k < boxes; ++k) {
+                int ni = int_at(node_index, k);
+                const auto& b = (*bounds)[k];
+                if (ni < 0 || static_cast<size_t>(ni) >= count ||
+                    !b.is_array() || b.size() < 4 || !b[0].is_number() ||
+                    !b[1].is_number() || !b[2].is_number() ||
+                    !b[3].is_number() || snap.nodes_[ni].layout >= 0) {
+                    continue;
+                }
+                snap.nodes_[ni].layout = static_cast<int32_t>(snap.bounds_.size());
+                snap.bounds_.push_back({b[0].get<double>(), b[1].get<double>(),
+                                        b[2].get<double>(), b[3].get<double>()});
+            }
+        }
+    }
+
+    return snap;
+}
+
+// ---------------------------------------------------------------------------
+// Accessors
+// ---------------------------------------------------------------------------
+
+auto FlatDomSnapshot::attributes(const FlatDomNode& node) const
+    -> std::span<const DomAttribute> {
+    return std::span<const DomAttribute>(attributes_).subspan(node.attr_begin,
+                                                              node.attr_count);
+}
+
+auto FlatDomSnapshot::attribute(const FlatDomNode& node,
+                                std::string_view name) const
+    -> std::string_view {
+    for (const auto& attr : attributes(node)) {
+        if (attr.name == name) {
+            return attr.value;
+        }
+    }
+    return {};
+}
+
+auto FlatDomSnapshot::has_attribute(const FlatDomNode& node,
+                                    std::string_view name) const -> bool {
+    auto attrs = attributes(node);
+    return std::any_of(attrs.begin(), attrs.end(),
+                       [&](const DomAttribute& a) { return a.name == name; });
+}
+
+auto FlatDomSnapshot::bounds(const FlatDomNode& node) const
+    -> std::optional<DomRect> {
+    if (node.layout < 0 || static_cast<size_t>(node.layout) >= bounds_.size()) {
+        return std::nullopt;
+    }
+    return bounds_[node.layout];
+}
+
+// ---------------------------------------------------------------------------
+// DomNode tree
+// ---------------------------------------------------------------------------
+
+auto FlatDomSnapshot::to_dom_node(const SnapshotOptions& options) const
+    -> DomNode {
+    auto build = [&](auto& self, int32_t index) -> DomNode {
+        DomNode out;
+        const auto& node = nodes_[index];
+        if (options.max_depth >= 0 && node.depth > options.max_depth) {
+            return out;
+        }
+
+        out.node_id = index;
+        out.node_type = node_type_name(node.type);
+        out.tag_name = node.name;
+        if (options.include_whitespace || !all_whitespace(node.value) ||
+            node.type != 3) {
+            out.text_content = node.value;
+        }
+
+        for (const auto& attr : attributes(node)) {
+            out.attributes[std::string(attr.name)] = attr.value;
+        }
+
+        if (auto box = bounds(node)) {
+            out.bounding_box = {
+                {"x", box->x},
+                {"y", box->y},
+                {"width", box->width},
+                {"height", box->height},
+            };
+        }
+
+        for (int32_t c = node.first_child; c >= 0; c = nodes_[c].next_sibling) {
+            auto child = self(self, c);
+            if (!child.tag_name.empty() || !child.text_content.empty() ||
+                !child.children.empty()) {
+                out.children.push_back(std::move(child));
+            }
+        }
+        return out;
+    };
+
+    if (nodes_.empty()) {
+        return {};
+    }
+    return build(build, 0);
+}
+
+// ---------------------------------------------------------------------------
+// Text rendering
+// ---------------------------------------------------------------------------
+
+auto FlatDomSnapshot::is_content(const FlatDomNode& node,
+                                 const SnapshotOptions& options) const -> bool {
+    if (options.max_depth >= 0 && node.depth > options.max_depth) {
+        return false;
+    }
+    switch (node.type) {
+        case 3:
+            // Text with no layout box is not rendered (display:none etc.)
+            if (!options.include_hidden && !bounds_.empty() && node.layout < 0) {
+                return false;
+            }
+            return options.include_whitespace || !all_whitespace(node.value);
+        case 1:
+            if (is_non_content(node.name)) {
+                return false;
+            }
+            return options.include_hidden ||
+                   !(has_attribute(node, "hidden") ||
+                     attribute(node, "aria-hidden") == "true");
+        case 9:
+        case 11:
+            return true;
+        default:
+            return false;  // comments, doctype, ...
+    }
+}
+
+auto FlatDomSnapshot::to_text(const SnapshotOptions& options,
+                              int32_t root) const -> std::string {
+    if (root < 0 || static_cast<size_t>(root) >= nodes_.size()) {
+        return {};
+    }
+
+    TextWriter writer;
+
+    // Decides whether to descend into `node`, emitting its opening text
+    auto enter = [&](const FlatDomNode& node) -> bool {
+        if (!is_content(node, options)) {
+            return false;
+        }
+        if (node.type == 3) {
+            writer.text(node.value);
+            return false;
+        }
+        if (int level = heading_level(node.name); level > 0) {
+            writer.prefix(std::string(level, '#') + " ");
+        } else if (node.name == "LI") {
+            writer.prefix("- ");
+        } else if (is_block(node.name)) {
+            writer.line_break();
+        }
+        return true;
+    };
+
+    auto leave = [&](const FlatDomNode& node) {
+        if (node.type == 1 && is_block(node.name)) {
+            writer.line_break();
+        }
+    };
+
+    // Iterative pre-order walk over the first_child/next_sibling links
+    int32_t i = root;
+    while (i >= 0) {
+        const auto& node = nodes_[i];
+        if (enter(node) && node.first_child >= 0) {
+            i = node.first_child;
+            continue;
+        }
+        // Leave this node and climb until a next sibling exists
+        while (i >= 0) {
+            leave(nodes_[i]);
+            if (i == root) {
+                i = -1;
+                break;
+            }
+            if (nodes_[i].next_sibling >= 0) {
+                i = nodes_[i].next_sibling;
+                break;
+            }
+            i = nodes_[i].parent;
+        }
+    }
+
+    return writer.take();
+}
+
+} // namespace openclaw::browser
@@ -0,0 +1,246 @@
+#include "openclaw/browser/page_cache.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+
+namespace openclaw::browser {
+
+namespace {
+
+auto to_lower(std::string_view s) -> std::string {
+    std::string out(s);
+    std::transform(out.begin(), out.end(), out.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return out;
+}
+
+auto trim(std::string_view s) -> std::string_view {
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+auto is_tracking_param(std::string_view param) -> bool {
+    auto name = param.substr(0, param.find('='));
+    return name.starts_with("utm_") || name == "gclid" || name == "fbclid";
+}
+
+} // anonymous namespace
+
+auto parse_cache_control(std::string_view header) -> CacheControl {
+    CacheControl control;
+    std::optional<int64_t> s_maxage;
+
+    while (!header.empty()) {
+        auto comma = header.find(',');
+        auto directive = trim(header.substr(0, comma));
+        header = comma == std::string_view::npos ? std::string_view{}
+                                                 : header.substr(comma + 1);
+
+        auto eq = directive.find('=');
+        auto name = to_lower(trim(directive.substr(0, eq)));
+        std::string_view value;
+        if (eq != std::string_view::npos) {
+            value = trim(directive.substr(eq + 1));
+            if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+                value = value.substr(1, value.size() - 2);
+            }
+        }
+
+        auto seconds = [&]() -> std::optional<int64_t> {
+            int64_t n = 0;
+            auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), n);
+            if (ec != std::errc{} || n < 0) return std::nullopt;
+            return n;
+        };
+
+        if (name == "no-store") {
+            control.no_store = true;
+        } else if (name == "no-cache") {
+            control.no_cache = true;
+        } else if (name == "private") {
+            control.is_private = true;
+        } else if (name == "max-age") {
+            control.max_age = seconds();
+        } else if (name == "s-maxage") {
+            s_maxage = seconds();
+        }
+    }
+
+    // This is a shared cache, so s-maxage takes precedence
+    if (s_maxage) {
+        control.max_age = s_maxage;
+    }
+    return control;
+}
+
+auto normalize_url(std::string_view url) -> std::string {
+    auto scheme_end = url.find("://");
+    if (scheme_end == std::string_view::npos) {
+        return std::string(url);
+    }
+    auto scheme = to_lower(url.substr(0, scheme_end));
+    auto rest = url.substr(scheme_end + 3);
+    rest = rest.substr(0, rest.find('#'));
+
+    auto authority_end = rest.find_first_of("/?");
+    auto authority = to_lower(rest.substr(0, authority_end));
+    rest = authority_end == std::string_view::npos ? std::string_view{}
+                                                   : rest.substr(authority_end);
+
+    if ((scheme == "http" && authority.ends_with(":80")) ||
+        (scheme == "https" && authority.ends_with(":443"))) {
+        authority.resize(authority.rfind(':'));
+    }
+
+    auto query_start = rest.find('?');
+    auto path = rest.substr(0, query_start);
+    std::string out = scheme + "://" + authority + (path.empty() ? "/" : std::string(path));
+
+    if (query_start != std::string_view::npos) {
+        auto query = rest.substr(query_start + 1);
+        std::string kept;
+        while (!query.empty()) {
+            auto amp = query.find('&');
+            auto param = query.substr(0, amp);
+            query = amp == std::string_view::npos ? std::string_view{}
+                                                  : query.substr(amp + 1);
+            if (param.empty() || is_tracking_param(param)) continue;
+            if (!kept.empty()) kept += '&';
+            kept += param;
+        }
+        if (!kept.empty()) {
+            out += '?' + kept;
+        }
+    }
+    return out;
+}
+
+auto CachedPage::bytes() const -> size_t {
+    return final_url.size() + title.size() + content.size() + etag.size() +
+           last_modified.size() + sizeof(CachedPage);
+}
+
+void to_json(json& j, const PageCacheStats& s) {
+    j = json{
+        {"entries", s.entries},
+        {"bytes", s.bytes},
+        {"max_bytes", s.max_bytes},
+        {"hits", s.hits},
+        {"revalidated", s.revalidated},
+        {"misses", s.misses},
+        {"stores", s.stores},
+        {"evictions", s.evictions},
+    };
+}
+
+// ---------------------------------------------------------------------------
+// PageCache
+// ---------------------------------------------------------------------------
+
+PageCache::PageCache(size_t max_bytes, int64_t default_ttl_ms)
+    : max_bytes_(max_bytes), default_ttl_ms_(default_ttl_ms) {
+    stats_.max_bytes = max_bytes;
+}
+
+auto PageCache::key(std::string_view url, std::string_view format) -> std::string {
+    return std::string(format) + ' ' + normalize_url(url);
+}
+
+auto PageCache::lookup(const std::string& key, int64_t now_ms)
+    -> std::optional<Lookup> {
+    std::lock_guard lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        ++stats_.misses;
+        return std::nullopt;
+    }
+
+    auto entry = it->second;
+    bool fresh = !entry->page.revalidate && now_ms < entry->page.expires_at_ms;
+    if (!fresh && !entry->page.has_validators()) {
+        erase_locked(entry);
+        ++stats_.misses;
+        return std::nullopt;
+    }
+
+    lru_.splice(lru_.begin(), lru_, entry);
+    if (fresh) {
+        ++stats_.hits;
+    }
+    return Lookup{entry->page, fresh};
+}
+
+auto PageCache::store(const std::string& key, CachedPage page,
+                      const CacheControl& control, int64_t now_ms) -> bool {
+    if (control.no_store || control.is_private || page.bytes() > max_bytes_) {
+        return false;
+    }
+    page.stored_at_ms = now_ms;
+    page.expires_at_ms = expiry(control, now_ms);
+    page.revalidate = control.no_cache;
+
+    std::lock_guard lock(mutex_);
+    if (auto it = index_.find(key); it != index_.end()) {
+        erase_locked(it->second);
+    }
+    stats_.bytes += page.bytes();
+    lru_.push_front(Entry{key, std::move(page)});
+    index_[key] = lru_.begin();
+    ++stats_.entries;
+    ++stats_.stores;
+
+    while (stats_.bytes > max_bytes_ && !lru_.empty()) {
+        erase_locked(std::prev(lru_.end()));
+        ++stats_.evictions;
+    }
+    return true;
+}
+
+void PageCache::refresh(const std::string& key, const CacheControl& control,
+                        int64_t now_ms) {
+    std::lock_guard lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        return;
+    }
+    auto& page = it->second->page;
+    page.expires_at_ms = expiry(control, now_ms);
+    page.revalidate = control.no_cache;
+    ++stats_.revalidated;
+}
+
+void PageCache::record_miss() {
+    std::lock_guard lock(mutex_);
+    ++stats_.misses;
+}
+
+void PageCache::erase(const std::string& key) {
+    std::lock_guard lock(mutex_);
+    if (auto it = index_.find(key); it != index_.end()) {
+        erase_locked(it->second);
+    }
+}
+
+auto PageCache::stats() const -> PageCacheStats {
+    std::lock_guard lock(mutex_);
+    return stats_;
+}
+
+auto PageCache::expiry(const CacheControl& control, int64_t now_ms) const -> int64_t {
+    return now_ms + (control.max_age ? *control.max_age * 1000 : default_ttl_ms_);
+}
+
+void PageCache::erase_locked(std::list<Entry>::iterator it) {
+    stats_.bytes -= it->page.bytes();
+    --stats_.entries;
+    index_.erase(it->key);
+    lru_.erase(it);
+}
+
+} // namespace openclaw::browser
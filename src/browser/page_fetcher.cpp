@@ -0,0 +1,367 @@
+#include "openclaw/browser/page_fetcher.hpp"
+
+#include "openclaw/browser/browser_action.hpp"
+#include "openclaw/browser/request_interceptor.hpp"
+#include "openclaw/browser/snapshot.hpp"
+#include "openclaw/core/logger.hpp"
+#include "openclaw/infra/http_client.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/asio/experimental/awaitable_operators.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <map>
+#include <optional>
+
+namespace openclaw::browser {
+
+namespace net = boost::asio;
+
+namespace {
+
+constexpr const char* kPageInfoScript =
+    "({url: window.location.href, title: document.title})";
+
+auto elapsed_ms(std::chrono::steady_clock::time_point since) -> int64_t {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - since).count();
+}
+
+auto now_ms() -> int64_t {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/// True if header `key` equals the lower-case `name`, ignoring case.
+auto header_is(std::string_view key, std::string_view name) -> bool {
+    return key.size() == name.size() &&
+           std::equal(key.begin(), key.end(), name.begin(), [](char a, char b) {
+               return std::tolower(static_cast<unsigned char>(a)) == b;
+           });
+}
+
+/// Header value by case-insensitive name from a CDP headers object;
+/// empty if absent.
+auto find_header(const json& headers, std::string_view name) -> std::string {
+    for (const auto& [key, value] : headers.items()) {
+        if (header_is(key, name) && value.is_string()) {
+            return value.get<std::string>();
+        }
+    }
+    return {};
+}
+
+auto find_header(const std::map<std::string, std::string>& headers,
+                 std::string_view name) -> std::string {
+    for (const auto& [key, value] : headers) {
+        if (header_is(key, name)) {
+            return value;
+        }
+    }
+    return {};
+}
+
+/// Removes a CDP listener when the owning scope exits, including when
+/// the coroutine is cancelled by a timeout.
+struct ScopedListener {
+    CdpClient& cdp;
+    ListenerId id;
+    ~ScopedListener() { cdp.unlisten(id); }
+};
+
+/// Cuts `text` to at most `max_chars` bytes without splitting a UTF-8
+/// sequence. Returns true if anything was removed.
+auto truncate_utf8(std::string& text, size_t max_chars) -> bool {
+    if (max_chars == 0 || text.size() <= max_chars) {
+        return false;
+    }
+    auto end = max_chars;
+    while (end > 0 && (static_cast<unsigned char>(text[end]) & 0xC0) == 0x80) {
+        --end;
+    }
+    text.resize(end);
+    return true;
+}
+
+} // anonymous namespace
+
+void to_json(json& j, const PageFetchResult& r) {
+    j = json{
+        {"index", r.index},
+        {"url", r.url},
+        {"ok", r.ok()},
+        {"cached", r.cached},
+        {"elapsed_ms", r.elapsed_ms},
+    };
+    if (r.ok()) {
+        j["final_url"] = r.final_url;
+        j["title"] = r.title;
+        j["content"] = r.content;
+        j["truncated"] = r.truncated;
+    } else {
+        j["error"] = r.error;
+    }
+}
+
+/// The state of one fetch_many() call. Workers pull the next URL index
+/// until the list is drained; the last one to finish wakes the caller.
+/// Each worker holds the wave, so none of it lives in the caller's frame.
+/// Everything runs on the io_context thread, so it needs no locking.
+struct PageFetcher::Wave {
+    std::vector<std::string> urls;
+    FetchManyOptions options;
+    ResultCallback on_result;
+    std::vector<PageFetchResult> results;
+    size_t next = 0;
+    size_t running = 0;
+    net::steady_timer done;
+
+    Wave(net::io_context& ioc, std::vector<std::string> urls_,
+         FetchManyOptions options_, ResultCallback on_result_)
+        : urls(std::move(urls_))
+        , options(std::move(options_))
+        , on_result(std::move(on_result_))
+        , results(urls.size())
+        , done(ioc, net::steady_timer::time_point::max()) {}
+};
+
+PageFetcher::PageFetcher(BrowserPool& pool)
+    : ioc_(pool.io_context()), pool_(pool), guard_(pool.fetch_guard()) {}
+
+auto PageFetcher::fetch_many(std::vector<std::string> urls,
+                             FetchManyOptions options,
+                             ResultCallback on_result)
+    -> awaitable<std::vector<PageFetchResult>> {
+    if (urls.empty()) {
+        co_return std::vector<PageFetchResult>{};
+    }
+
+    auto wave = std::make_shared<Wave>(ioc_, std::move(urls), std::move(options),
+                                       std::move(on_result));
+    auto workers = std::clamp<size_t>(wave->options.concurrency, 1,
+                                      std::max<size_t>(pool_.max_size(), 1));
+    workers = std::min(workers, wave->urls.size());
+
+    wave->running = workers;
+    for (size_t i = 0; i < workers; ++i) {
+        net::co_spawn(ioc_, run_worker(wave), net::detached);
+    }
+
+    boost::system::error_code ec;
+    co_await wave->done.async_wait(net::redirect_error(net::use_awaitable, ec));
+
+    auto failed = std::count_if(wave->results.begin(), wave->results.end(),
+                                [](const auto& r) { return !r.ok(); });
+    LOG_INFO("fetch_many: {} URLs, {} failed, {} workers", wave->urls.size(), failed,
+             workers);
+    co_return std::move(wave->results);
+}
+
+auto PageFetcher::run_worker(std::shared_ptr<Wave> wave) -> awaitable<void> {
+    while (wave->next < wave->urls.size()) {
+        auto index = wave->next++;
+        auto result = co_await fetch_one(wave->urls[index], wave->options);
+        result.index = index;
+        if (wave->on_result) {
+            wave->on_result(result);
+        }
+        wave->results[index] = std::move(result);
+    }
+    if (--wave->running == 0) {
+        wave->done.expires_at(net::steady_timer::time_point::min());
+    }
+}
+
+auto PageFetcher::acquire_session()
+    -> awaitable<Result<std::shared_ptr<BrowserSession>>> {
+    co_return co_await pool_.acquire();
+}
+
+auto PageFetcher::fetch_one(std::string url, const FetchManyOptions& options)
+    -> awaitable<PageFetchResult> {
+    auto started = std::chrono::steady_clock::now();
+    PageFetchResult result;
+    result.url = url;
+
+    auto* cache = options.use_cache ? pool_.page_cache() : nullptr;
+    auto cache_key = PageCache::key(url, options.format);
+    if (cache && co_await from_cache(cache_key, result)) {
+        result.truncated = truncate_utf8(result.content, options.max_chars);
+        result.elapsed_ms = elapsed_ms(started);
+        co_return result;
+    }
+
+    // SSRF check before a browser context is spent on the URL
+    auto allowed = co_await guard_.validate_url(url, ioc_);
+    if (!allowed) {
+        result.error = allowed.error().what();
+        result.elapsed_ms = elapsed_ms(started);
+        co_return result;
+    }
+
+    auto session = co_await acquire_session();
+    if (!session) {
+        result.error = session.error().what();
+        result.elapsed_ms = elapsed_ms(started);
+        co_return result;
+    }
+
+    // The timeout covers loading and extraction, not queueing for a session
+    using namespace net::experimental::awaitable_operators;
+    net::steady_timer timeout(co_await net::this_coro::executor);
+    timeout.expires_after(std::chrono::milliseconds(options.timeout_ms));
+
+    DocumentResponse document;
+    auto outcome = co_await (
+        load_and_extract(**session, url, options, result, document) ||
+        timeout.async_wait(net::use_awaitable));
+    if (outcome.index() != 0) {
+        result.error = "Timed out after " + std::to_string(options.timeout_ms) + "ms";
+    } else if (auto& loaded = std::get<0>(outcome); !loaded) {
+        result.error = loaded.error().what();
+    }
+    pool_.release(*session);
+
+    if (!result.ok()) {
+        result.content.clear();
+    } else if (cache && document.status == 200) {
+        CachedPage page;
+        page.final_url = result.final_url;
+        page.title = result.title;
+        page.content = result.content;
+        page.etag = find_header(document.headers, "etag");
+        page.last_modified = find_header(document.headers, "last-modified");
+        cache->store(cache_key, std::move(page),
+                     parse_cache_control(find_header(document.headers, "cache-control")),
+                     now_ms());
+    }
+
+    result.truncated = truncate_utf8(result.content, options.max_chars);
+    result.elapsed_ms = elapsed_ms(started);
+    co_return result;
+}
+
+auto PageFetcher::from_cache(const std::string& key, PageFetchResult& result)
+    -> awaitable<bool> {
+    auto* cache = pool_.page_cache();
+    auto hit = cache->lookup(key, now_ms());
+    if (!hit) {
+        co_return false;
+    }
+
+    auto serve = [&](CachedPage& page) {
+        result.final_url = std::move(page.final_url);
+        result.title = std::move(page.title);
+        result.content = std::move(page.content);
+        result.cached = true;
+    };
+    if (hit->fresh) {
+        serve(hit->page);
+        co_return true;
+    }
+
+    // Stale: ask the origin whether the document changed
+    const auto& url = hit->page.final_url;
+    auto allowed = co_await guard_.validate_url(url, ioc_);
+    if (!allowed) {
+        cache->erase(key);
+        cache->record_miss();
+        co_return false;
+    }
+
+    std::map<std::string, std::string> headers;
+    if (!hit->page.etag.empty()) {
+        headers["If-None-Match"] = hit->page.etag;
+    }
+    if (!hit->page.last_modified.empty()) {
+        headers["If-Modified-Since"] = hit->page.last_modified;
+    }
+    auto origin = infra::FetchGuard::extract_origin(url);
+    auto path = url.substr(std::min(origin.size(), url.size()));
+    infra::HttpClient http(ioc_, {.base_url = origin, .timeout_seconds = 10});
+    auto response = co_await http.get(path.empty() ? "/" : path, headers);
+
+    if (!response || response->status != 304) {
+        cache->erase(key);
+        cache->record_miss();
+        co_return false;
+    }
+    cache->refresh(key, parse_cache_control(find_header(response->headers, "cache-control")),
+                   now_ms());
+    serve(hit->page);
+    co_return true;
+}
+
+auto PageFetcher::load_and_extract(BrowserSession& session, const std::string& url,
+                                   const FetchManyOptions& options,
+                                   PageFetchResult& result,
+                                   DocumentResponse& document)
+    -> awaitable<Result<void>> {
+    auto& cdp = *session.cdp;
+
+    // Validators for the page cache come from the main document response
+    std::optional<ScopedListener> response_listener;
+    if (options.use_cache && pool_.page_cache()) {
+        auto enabled = co_await cdp.send_command("Network.enable");
+        if (enabled) {
+            response_listener.emplace(cdp, cdp.listen("Network.responseReceived",
+                [&document, frame = session.target_id](const json& params) {
+                    if (params.value("type", "") != "Document" ||
+                        params.value("frameId", "") != frame) {
+                        return;
+                    }
+                    const auto& response = params["response"];
+                    document.status = response.value("status", 0);
+                    document.headers = response.value("headers", json::object());
+                }));
+        }
+    }
+
+    if (!options.profile.empty() && session.network) {
+        auto profile = pool_.network_profile(options.profile);
+        if (!profile) {
+            co_return make_fail(
+                make_error(ErrorCode::InvalidArgument,
+                           "Unknown network profile", options.profile));
+        }
+        auto applied = co_await session.network->apply(std::move(*profile));
+        if (!applied) {
+            co_return make_fail(applied.error());
+        }
+    }
+
+    BrowserAction action(cdp);
+    NavigateOptions navigate;
+    navigate.timeout_ms = options.timeout_ms;
+    navigate.wait_until = options.wait_until;
+    auto navigated = co_await action.navigate(url, navigate);
+    if (!navigated) {
+        co_return make_fail(navigated.error());
+    }
+
+    auto info = co_await action.evaluate(kPageInfoScript);
+    if (info && info->value.is_object()) {
+        result.final_url = info->value.value("url", url);
+        result.title = info->value.value("title", "");
+    }
+
+    if (options.format == "html") {
+        auto html = co_await action.page_source();
+        if (!html) {
+            co_return make_fail(html.error());
+        }
+        result.content = infra::FetchGuard::sanitize_html_content(*html);
+    } else {
+        Snapshot snapshot(cdp);
+        auto text = co_await snapshot.to_text_representation();
+        if (!text) {
+            co_return make_fail(text.error());
+        }
+        result.content = std::move(*text);
+    }
+    co_return ok_result();
+}
+
+} // namespace openclaw::browser
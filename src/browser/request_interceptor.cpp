@@ -0,0 +1,382 @@
+#include "openclaw/browser/request_interceptor.hpp"
+#include "openclaw/core/logger.hpp"
+
+#include <boost/asio.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+
+namespace openclaw::browser {
+
+namespace net = boost::asio;
+
+namespace {
+
+/// Well-known analytics, ad and tag-manager domains (matched with their
+/// subdomains). Kept short on purpose: it targets the scripts that show up
+/// on most pages, not a full blocklist.
+constexpr std::array<std::string_view, 24> kTrackerDomains = {
+    "google-analytics.com",  "googletagmanager.com", "googlesyndication.com",
+    "googleadservices.com",  "doubleclick.net",      "adservice.google.com",
+    "connect.facebook.net",  "amazon-adsystem.com",  "adnxs.com",
+    "criteo.com",            "taboola.com",          "outbrain.com",
+    "scorecardresearch.com", "quantserve.com",       "hotjar.com",
+    "mixpanel.com",          "segment.io",           "cdn.segment.com",
+    "nr-data.net",           "clarity.ms",           "chartbeat.com",
+    "adsrvr.org",            "moatads.com",          "pubmatic.com",
+};
+
+/// Hosts whose SSRF verdict is cached per session before the cache resets.
+constexpr size_t kMaxCachedHosts = 1024;
+
+/// How long a host's SSRF verdict stands before its name is resolved again.
+/// Long enough to cover one page's burst of subresources; a host that
+/// rebinds to a private address is caught on the next lookup.
+constexpr auto kSsrfVerdictTtl = std::chrono::seconds(2);
+
+auto host_matches(std::string_view host, std::string_view domain) -> bool {
+    if (host.size() < domain.size() || !host.ends_with(domain)) {
+        return false;
+    }
+    return host.size() == domain.size() ||
+           host[host.size() - domain.size() - 1] == '.';
+}
+
+auto elapsed_ms(std::chrono::steady_clock::time_point since) -> int64_t {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - since).count();
+}
+
+/// Content-Length from Fetch.requestPaused responseHeaders, if declared.
+auto content_length(const json& params) -> std::optional<uint64_t> {
+    if (!params.contains("responseHeaders")) return std::nullopt;
+    for (const auto& header : params["responseHeaders"]) {
+        auto name = header.value("name", "");
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        if (name != "content-length") continue;
+        try {
+            return std::stoull(header.value("value", ""));
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    }
+    return std::nullopt;
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// NetworkProfile
+// ---------------------------------------------------------------------------
+
+auto NetworkProfile::named(std::string_view name)
+    -> std::optional<NetworkProfile> {
+    NetworkProfile profile;
+    profile.name = std::string(name);
+    if (name == "full") {
+        return profile;
+    }
+    if (name == "text") {
+        profile.block_images = true;
+        profile.block_media = true;
+        profile.block_fonts = true;
+        profile.block_trackers = true;
+        return profile;
+    }
+    return std::nullopt;
+}
+
+auto NetworkProfile::is_passthrough() const -> bool {
+    return !block_images && !block_media && !block_fonts && !block_trackers &&
+           max_response_bytes == 0 && blocked_domains.empty();
+}
+
+auto url_host(std::string_view url) -> std::string {
+    auto scheme_end = url.find("://");
+    if (scheme_end == std::string_view::npos) {
+        return {};
+    }
+    auto authority = url.substr(scheme_end + 3);
+    authority = authority.substr(0, authority.find_first_of("/?#"));
+    if (auto at = authority.rfind('@'); at != std::string_view::npos) {
+        authority = authority.substr(at + 1);
+    }
+
+    std::string_view host;
+    if (authority.starts_with('[')) {
+        host = authority.substr(1, authority.find(']') - 1);  // IPv6 literal
+    } else {
+        host = authority.substr(0, authority.find(':'));
+    }
+
+    std::string out(host);
+    std::transform(out.begin(), out.end(), out.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return out;
+}
+
+auto is_local_scheme(std::string_view url) -> bool {
+    auto colon = url.find(':');
+    if (colon == std::string_view::npos) {
+        return false;
+    }
+    std::string scheme(url.substr(0, colon));
+    std::transform(scheme.begin(), scheme.end(), scheme.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return scheme == "data" || scheme == "blob";
+}
+
+auto is_tracker_host(std::string_view host, const std::vector<std::string>& extra)
+    -> bool {
+    return std::any_of(kTrackerDomains.begin(), kTrackerDomains.end(),
+                       [&](std::string_view d) { return host_matches(host, d); }) ||
+           std::any_of(extra.begin(), extra.end(),
+                       [&](const std::string& d) { return host_matches(host, d); });
+}
+
+auto classify_request(const NetworkProfile& profile,
+                      std::string_view resource_type,
+                      std::string_view url) -> BlockReason {
+    if ((profile.block_images && resource_type == "Image") ||
+        (profile.block_media && resource_type == "Media") ||
+        (profile.block_fonts && resource_type == "Font")) {
+        return BlockReason::ResourceType;
+    }
+
+    // The top-level document is never treated as a tracker
+    if (resource_type == "Document") {
+        return BlockReason::None;
+    }
+    if (!profile.block_trackers && profile.blocked_domains.empty()) {
+        return BlockReason::None;
+    }
+    auto host = url_host(url);
+    if (host.empty()) {
+        return BlockReason::None;
+    }
+    bool tracker =
+        profile.block_trackers
+            ? is_tracker_host(host, profile.blocked_domains)
+            : std::any_of(profile.blocked_domains.begin(),
+                          profile.blocked_domains.end(),
+                          [&](const std::string& d) { return host_matches(host, d); });
+    return tracker ? BlockReason::Tracker : BlockReason::None;
+}
+
+void to_json(json& j, const NetworkStats& s) {
+    j = json{
+        {"requests", s.requests},
+        {"blocked_type", s.blocked_type},
+        {"blocked_tracker", s.blocked_tracker},
+        {"blocked_ssrf", s.blocked_ssrf},
+        {"blocked_size", s.blocked_size},
+        {"bytes_received", s.bytes_received},
+        {"bytes_saved", s.bytes_saved},
+        {"page_loads", s.page_loads},
+        {"last_load_ms", s.last_load_ms},
+        {"total_load_ms", s.total_load_ms},
+    };
+}
+
+// ---------------------------------------------------------------------------
+// RequestInterceptor
+// ---------------------------------------------------------------------------
+
+/// Shared with in-flight request handlers. `cdp` is cleared when the
+/// interceptor is destroyed, so late handlers become no-ops.
+struct RequestInterceptor::State {
+    net::io_context& ioc;
+    CdpClient* cdp;
+    infra::FetchGuard guard;
+    NetworkProfile profile;
+    NetworkStats stats;
+    bool intercepting = false;
+    std::string main_frame_id;
+    std::optional<std::chrono::steady_clock::time_point> load_started;
+    struct Verdict {
+        bool allowed;
+        std::chrono::steady_clock::time_point expires;
+    };
+    std::unordered_map<std::string, Verdict> host_verdicts;
+    std::vector<ListenerId> listeners;
+
+    State(net::io_context& ctx, CdpClient& client, infra::FetchGuard g)
+        : ioc(ctx), cdp(&client), guard(std::move(g)) {}
+};
+
+RequestInterceptor::RequestInterceptor(net::io_context& ioc, CdpClient& cdp,
+                                       infra::FetchGuard guard)
+    : state_(std::make_shared<State>(ioc, cdp, std::move(guard))) {
+    // Listeners, not subscribe(): the page code and the snapshot tracker
+    // handle some of these events too
+    auto& listeners = state_->listeners;
+    listeners.push_back(cdp.listen("Fetch.requestPaused", [state = state_](json params) {
+        net::co_spawn(state->ioc, handle_paused(state, std::move(params)),
+                      net::detached);
+    }));
+    listeners.push_back(cdp.listen("Network.loadingFinished", [state = state_](const json& params) {
+        state->stats.bytes_received +=
+            static_cast<uint64_t>(params.value("encodedDataLength", 0.0));
+    }));
+    listeners.push_back(cdp.listen("Page.frameStartedLoading", [state = state_](const json& params) {
+        if (params.value("frameId", "") == state->main_frame_id) {
+            state->load_started = std::chrono::steady_clock::now();
+        }
+    }));
+    listeners.push_back(cdp.listen("Page.loadEventFired", [state = state_](const json&) {
+        if (!state->load_started) return;
+        auto ms = elapsed_ms(*state->load_started);
+        state->load_started.reset();
+        ++state->stats.page_loads;
+        state->stats.last_load_ms = ms;
+        state->stats.total_load_ms += ms;
+    }));
+}
+
+RequestInterceptor::~RequestInterceptor() {
+    if (auto* cdp = state_->cdp) {
+        for (auto id : state_->listeners) {
+            cdp->unlisten(id);
+        }
+    }
+    state_->listeners.clear();
+    state_->cdp = nullptr;
+}
+
+auto RequestInterceptor::apply(NetworkProfile profile) -> awaitable<Result<void>> {
+    auto state = state_;
+    auto& cdp = *state->cdp;
+
+    if (state->main_frame_id.empty()) {
+        auto tree = co_await cdp.send_command("Page.getFrameTree");
+        if (tree && tree->contains("frameTree")) {
+            state->main_frame_id =
+                (*tree)["frameTree"]["frame"].value("id", std::string{});
+        }
+    }
+
+    bool intercept = !profile.is_passthrough() || !state->guard.allows_private();
+    state->profile = std::move(profile);
+
+    if (intercept) {
+        json patterns = json::array({
+            {{"urlPattern", "*"}, {"requestStage", "Request"}},
+        });
+        if (state->profile.max_response_bytes > 0) {
+            patterns.push_back({{"urlPattern", "*"}, {"requestStage", "Response"}});
+        }
+        auto results = co_await cdp.send_many({
+            {"Network.enable"},
+            {"Fetch.enable", {{"patterns", patterns}}},
+        });
+        for (auto& result : results) {
+            if (!result) {
+                co_return make_fail(result.error());
+            }
+        }
+    } else if (state->intercepting) {
+        co_await cdp.send_many({{"Fetch.disable"}, {"Network.disable"}});
+    }
+
+    state->intercepting = intercept;
+    LOG_DEBUG("Network profile '{}' applied (interception {})",
+              state->profile.name, intercept ? "on" : "off");
+    co_return ok_result();
+}
+
+auto RequestInterceptor::profile() const -> const NetworkProfile& {
+    return state_->profile;
+}
+
+auto RequestInterceptor::stats() const -> NetworkStats {
+    return state_->stats;
+}
+
+auto RequestInterceptor::handle_paused(std::shared_ptr<State> state, json params)
+    -> awaitable<void> {
+    if (!state->cdp) co_return;
+
+    auto request_id = params.value("requestId", "");
+    auto url = params.contains("request")
+                   ? params["request"].value("url", "")
+                   : std::string{};
+    bool block = false;
+
+    if (params.contains("responseStatusCode") ||
+        params.contains("responseErrorReason")) {
+        // Response stage: enforce the size cap on declared lengths
+        auto length = content_length(params);
+        auto cap = state->profile.max_response_bytes;
+        if (cap > 0 && length && *length > cap) {
+            ++state->stats.blocked_size;
+            state->stats.bytes_saved += *length;
+            block = true;
+        }
+    } else {
+        ++state->stats.requests;
+        switch (classify_request(state->profile, params.value("resourceType", ""), url)) {
+            case BlockReason::ResourceType:
+                ++state->stats.blocked_type;
+                block = true;
+                break;
+            case BlockReason::Tracker:
+                ++state->stats.blocked_tracker;
+                block = true;
+                break;
+            case BlockReason::None:
+                break;
+        }
+
+        // SSRF checks for every subresource, not just the top-level URL.
+        // Verdicts expire quickly so a rebinding host is resolved again.
+        if (!block && !is_local_scheme(url) && !state->guard.allows_private()) {
+            auto host = url_host(url);
+            auto now = std::chrono::steady_clock::now();
+            auto cached = state->host_verdicts.find(host);
+            bool allowed;
+            if (host.empty()) {
+                allowed = false;  // file:, about: and the like
+            } else if (cached != state->host_verdicts.end() && cached->second.expires > now) {
+                allowed = cached->second.allowed;
+            } else {
+                allowed = (co_await state->guard.validate_url(url, state->ioc))
+                              .has_value();
+                if (state->host_verdicts.size() >= kMaxCachedHosts) {
+                    std::erase_if(state->host_verdicts, [now](const auto& entry) {
+                        return entry.second.expires <= now;
+                    });
+                    if (state->host_verdicts.size() >= kMaxCachedHosts) {
+                        state->host_verdicts.clear();
+                    }
+                }
+                state->host_verdicts.insert_or_assign(
+                    host, State::Verdict{allowed, now + kSsrfVerdictTtl});
+            }
+            if (!allowed) {
+                ++state->stats.blocked_ssrf;
+                LOG_WARN("Blocked request by SSRF policy: {}", host.empty() ? url : host);
+                block = true;
+            }
+        }
+    }
+
+    if (!state->cdp) co_return;
+    json resolution = {{"requestId", request_id}};
+    if (block) {
+        resolution["errorReason"] = "BlockedByClient";
+    }
+    auto result = co_await state->cdp->send_command(
+        block ? "Fetch.failRequest" : "Fetch.continueRequest",
+        std::move(resolution));
+    if (!result) {
+        LOG_DEBUG("Failed to resolve paused request {}: {}", request_id,
+                  result.error().what());
+    }
+}
+
+} // namespace openclaw::browser
@@ -0,0 +1,89 @@
+#include "openclaw/browser/screenshot.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace openclaw::browser {
+
+auto ImageBudget::from_config(const ImageConfig& config) -> ImageBudget {
+    ImageBudget budget;
+    if (config.max_dimension_px && *config.max_dimension_px > 0) {
+        budget.max_dimension_px = *config.max_dimension_px;
+    }
+    if (config.max_bytes && *config.max_bytes > 0) {
+        budget.max_bytes = static_cast<size_t>(*config.max_bytes);
+    }
+    return budget;
+}
+
+auto CapturePlan::output_width() const -> int {
+    return static_cast<int>(std::lround(region.width * scale * device_scale));
+}
+
+auto CapturePlan::output_height() const -> int {
+    return static_cast<int>(std::lround(region.height * scale * device_scale));
+}
+
+auto CapturePlan::to_params() const -> json {
+    json params = {
+        {"format", format},
+        {"clip", {
+            {"x", region.x},
+            {"y", region.y},
+            {"width", region.width},
+            {"height", region.height},
+            {"scale", scale},
+        }},
+    };
+    if (format != "png") {
+        params["quality"] = quality;
+    }
+    return params;
+}
+
+auto plan_capture(CaptureRegion region, double device_scale,
+                  std::string_view format, int quality,
+                  const ImageBudget& budget) -> CapturePlan {
+    CapturePlan plan;
+    plan.region = region;
+    plan.device_scale = device_scale > 0 ? device_scale : 1.0;
+    plan.format = (format.empty() || format == "auto") ? "webp" : std::string(format);
+    plan.quality = std::clamp(quality, 1, 100);
+
+    auto longest = std::max(region.width, region.height) * plan.device_scale;
+    if (longest > budget.max_dimension_px) {
+        plan.scale = budget.max_dimension_px / longest;
+    }
+    return plan;
+}
+
+auto refine_capture(const CapturePlan& plan, size_t bytes,
+                    const ImageBudget& budget) -> std::optional<CapturePlan> {
+    if (bytes <= budget.max_bytes) {
+        return std::nullopt;
+    }
+    auto ratio = static_cast<double>(budget.max_bytes) / static_cast<double>(bytes);
+    auto next = plan;
+
+    if (plan.format != "png" && plan.quality > kMinScreenshotQuality) {
+        next.quality = std::max(kMinScreenshotQuality,
+                                std::min(plan.quality - 10,
+                                         static_cast<int>(plan.quality * ratio)));
+        return next;
+    }
+
+    // Encoded size grows roughly with pixel count; aim a little under
+    next.scale = plan.scale * std::sqrt(ratio) * 0.9;
+    if (std::max(next.output_width(), next.output_height()) < kMinScreenshotDimension) {
+        return std::nullopt;
+    }
+    return next;
+}
+
+auto base64_decoded_size(std::string_view data) -> size_t {
+    auto padding = std::count(data.end() - std::min<size_t>(data.size(), 2),
+                              data.end(), '=');
+    return data.size() / 4 * 3 - static_cast<size_t>(padding);
+}
+
+} // namespace openclaw::browser
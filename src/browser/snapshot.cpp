@@ -1,4 +1,5 @@
 #include "openclaw/browser/snapshot.hpp"
+#include "openclaw/browser/dom_snapshot.hpp"
 #include "openclaw/core/logger.hpp"
 
 #include <sstream>
@@ -59,6 +60,85 @@ void from_json(const json& j, DomNode& n) {
     }
 }
 
+// ---------------------------------------------------------------------------
+// CDP requests shared by the individual and pipelined captures
+// ---------------------------------------------------------------------------
+
+static auto evaluate_params(std::string_view expression) -> json {
+    return {
+        {"expression", std::string(expression)},
+        {"returnByValue", true},
+        {"awaitPromise", false},
+    };
+}
+
+/// Returns `result.value` of a Runtime.evaluate response, or null.
+static auto evaluate_value(const json& response) -> json {
+    if (response.contains("result") && response["result"].contains("value")) {
+        return response["result"]["value"];
+    }
+    return nullptr;
+}
+
+static constexpr const char* kLinksScript = R"JS(
+        (() => {
+            const links = document.querySelectorAll('a[href]');
+            return Array.from(links).map(a => ({
+                text: a.textContent?.trim()?.substring(0, 200) || '',
+                href: a.href || ''
+            }));
+        })()
+    )JS";
+
+static constexpr const char* kFormFieldsScript = R"JS(
+        (() => {
+            const fields = [];
+            const inputs = document.querySelectorAll(
+                'input, textarea, select, [contenteditable]'
+            );
+            for (const el of inputs) {
+                const rect = el.getBoundingClientRect();
+                const field = {
+                    tag: el.tagName.toLowerCase(),
+                    type: el.type || '',
+                    name: el.name || '',
+                    id: el.id || '',
+                    value: el.value || '',
+                    placeholder: el.placeholder || '',
+                    label: '',
+                    required: el.required || false,
+                    disabled: el.disabled || false,
+                    bounding_box: {
+                        x: rect.x, y: rect.y,
+                        width: rect.width, height: rect.height
+                    }
+                };
+                // Try to find associated label
+                if (el.id) {
+                    const label = document.querySelector(`label[for="${el.id}"]`);
+                    if (label) field.label = label.textContent?.trim() || '';
+                }
+                if (!field.label && el.closest('label')) {
+                    field.label = el.closest('label').textContent?.trim() || '';
+                }
+                // For select elements, get options
+                if (el.tagName === 'SELECT') {
+                    field.options = Array.from(el.options).map(o => ({
+                        value: o.value,
+                        text: o.textContent?.trim() || '',
+                        selected: o.selected
+                    }));
+                }
+                fields.push(field);
+            }
+            return fields;
+        })()
+    )JS";
+
+/// URL and title in one evaluation.
+static constexpr const char* kPageInfoScript =
+    "({url: window.location.href, title: document.title})";
+
 // ---------------------------------------------------------------------------
 // Snapshot
 // ---------------------------------------------------------------------------
@@ -68,48 +148,33 @@ Snapshot::Snapshot(CdpClient& cdp) : cdp_(cdp) {}
 auto Snapshot::capture_dom(const SnapshotOptions& options)
     -> awaitable<Result<DomNode>> {
     // Use DOMSnapshot.captureSnapshot for a comprehensive view
-    auto result = co_await cdp_.send_command("DOMSnapshot.captureSnapshot", {
-        {"computedStyles", json::array()},
-        {"includeDOMRects", true},
-        {"includePaintOrder", false},
-    });
+    auto result = co_await cdp_.send_command("DOMSnapshot.captureSnapshot",
+                                             FlatDomSnapshot::capture_params());
 
     if (!result) {
-        // Fall back to DOM.getDocument for simpler tree
-        auto doc = co_await cdp_.send_command("DOM.getDocument", {
-            {"depth", options.max_depth >= 0 ? options.max_depth : -1},
-            {"pierce", true},
-        });
-        if (!doc) {
-            co_return make_fail(doc.error());
-        }
-
-        // Convert CDP document node to our DomNode
-        auto& root = (*doc)["root"];
-        DomNode node;
-        node.node_id = root.value("nodeId", 0);
-        node.node_type = "document";
-        node.tag_name = root.value("nodeName", "");
-        co_return node;
+        co_return co_await capture_document(options);
     }
+    co_return parse_dom_snapshot(std::move(*result), options);
+}
 
-    // Parse the DOMSnapshot format
-    if (!result->contains("documents") || (*result)["documents"].empty()) {
-        co_return make_fail(
-            make_error(ErrorCode::BrowserError,
-                       "DOM snapshot returned no documents"));
+auto Snapshot::capture_document(const SnapshotOptions& options)
+    -> awaitable<Result<DomNode>> {
+    // Fall back to DOM.getDocument for simpler tree
+    auto doc = co_await cdp_.send_command("DOM.getDocument", {
+        {"depth", options.max_depth >= 0 ? options.max_depth : -1},
+        {"pierce", true},
+    });
+    if (!doc) {
+        co_return make_fail(doc.error());
     }
 
-    auto& doc = (*result)["documents"][0];
-    auto& nodes = doc["nodes"];
-    auto& strings = (*result)["strings"];
-
-    // Build tree starting from root (index 0)
-    auto root = build_dom_tree(nodes, strings, 0, 0, options);
-
-    LOG_DEBUG("Captured DOM snapshot with {} string table entries",
-              strings.size());
-    co_return root;
+    // Convert CDP document node to our DomNode
+    auto& root = (*doc)["root"];
+    DomNode node;
+    node.node_id = root.value("nodeId", 0);
+    node.node_type = "document";
+    node.tag_name = root.value("nodeName", "");
+    co_return node;
 }
 
 auto Snapshot::capture_accessibility_tree()
@@ -119,15 +184,19 @@ auto Snapshot::capture_accessibility_tree()
     if (!result) {
         co_return make_fail(result.error());
     }
+    co_return parse_accessibility_tree(*result);
+}
 
-    if (!result->contains("nodes") || (*result)["nodes"].empty()) {
-        co_return make_fail(
+auto Snapshot::parse_accessibility_tree(const json& result)
+    -> Result<AccessibilityNode> {
+    if (!result.contains("nodes") || result["nodes"].empty()) {
+        return std::unexpected(
             make_error(ErrorCode::BrowserError,
                        "Accessibility tree is empty"));
     }
 
     // Build a lookup map: nodeId -> json node
-    auto& nodes = (*result)["nodes"];
+    auto& nodes = result["nodes"];
     std::unordered_map<std::string, json> node_map;
     for (const auto& node : nodes) {
         auto id = node["nodeId"].get<std::string>();
@@ -170,7 +239,7 @@ auto Snapshot::capture_accessibility_tree()
     attach_children(root, root_json);
 
     LOG_DEBUG("Captured accessibility tree with {} total nodes", nodes.size());
-    co_return root;
+    return root;
 }
 
 auto Snapshot::extract_text() -> awaitable<Result<std::string>> {
@@ -206,6 +275,21 @@ auto Snapshot::extract_text(std::string_view selector)
     co_return std::string{};
 }
 
+auto Snapshot::capture_dom_text(const SnapshotOptions& options)
+    -> awaitable<Result<std::string>> {
+    auto result = co_await cdp_.send_command("DOMSnapshot.captureSnapshot",
+                                             FlatDomSnapshot::capture_params());
+    if (!result) {
+        co_return make_fail(result.error());
+    }
+
+    auto flat = FlatDomSnapshot::decode(std::move(*result));
+    if (!flat) {
+        co_return make_fail(flat.error());
+    }
+    co_return flat->to_text(options);
+}
+
 auto Snapshot::to_text_representation(const SnapshotOptions& options)
     -> awaitable<Result<std::string>> {
     // Try accessibility tree first (most LLM-friendly)
@@ -215,6 +299,12 @@ auto Snapshot::to_text_representation(const SnapshotOptions& options)
         co_return text;
     }
 
+    // Then the page structure rendered from a DOM snapshot
+    auto snapshot_text = co_await capture_dom_text(options);
+    if (snapshot_text && !snapshot_text->empty()) {
+        co_return *snapshot_text;
+    }
+
     // Fall back to DOM text extraction
     auto dom_text = co_await extract_text();
     if (!dom_text) {
@@ -225,151 +315,102 @@ auto Snapshot::to_text_representation(const SnapshotOptions& options)
 
 auto Snapshot::extract_links()
     -> awaitable<Result<std::vector<std::pair<std::string, std::string>>>> {
-    auto js = R"JS(
-        (() => {
-            const links = document.querySelectorAll('a[href]');
-            return Array.from(links).map(a => ({
-                text: a.textContent?.trim()?.substring(0, 200) || '',
-                href: a.href || ''
-            }));
-        })()
-    )JS";
-
-    auto result = co_await cdp_.send_command("Runtime.evaluate", {
-        {"expression", js},
-        {"returnByValue", true},
-        {"awaitPromise", false},
-    });
+    auto result = co_await cdp_.send_command("Runtime.evaluate",
+                                             evaluate_params(kLinksScript));
     if (!result) {
         co_return make_fail(result.error());
     }
+    co_return parse_links(*result);
+}
 
+auto Snapshot::parse_links(const json& result)
+    -> std::vector<std::pair<std::string, std::string>> {
     std::vector<std::pair<std::string, std::string>> links;
 
-    if (result->contains("result") && (*result)["result"].contains("value")) {
-        auto& value = (*result)["result"]["value"];
-        if (value.is_array()) {
-            for (const auto& item : value) {
-                links.emplace_back(
-                    item.value("text", ""),
-                    item.value("href", ""));
-            }
+    auto value = evaluate_value(result);
+    if (value.is_array()) {
+        links.reserve(value.size());
+        for (const auto& item : value) {
+            links.emplace_back(
+                item.value("text", ""),
+                item.value("href", ""));
         }
     }
 
-    co_return links;
+    return links;
 }
 
 auto Snapshot::extract_form_fields() -> awaitable<Result<json>> {
-    auto js = R"JS(
-        (() => {
-            const fields = [];
-            const inputs = document.querySelectorAll(
-                'input, textarea, select, [contenteditable]'
-            );
-            for (const el of inputs) {
-                const rect = el.getBoundingClientRect();
-                const field = {
-                    tag: el.tagName.toLowerCase(),
-                    type: el.type || '',
-                    name: el.name || '',
-                    id: el.id || '',
-                    value: el.value || '',
-                    placeholder: el.placeholder || '',
-                    label: '',
-                    required: el.required || false,
-                    disabled: el.disabled || false,
-                    bounding_box: {
-                        x: rect.x, y: rect.y,
-                        width: rect.width, height: rect.height
-                    }
-                };
-                // Try to find associated label
-                if (el.id) {
-                    const label = document.querySelector(`label[for="${el.id}"]`);
-                    if (label) field.label = label.textContent?.trim() || '';
-                }
-                if (!field.label && el.closest('label')) {
-                    field.label = el.closest('label').textContent?.trim() || '';
-                }
-                // For select elements, get options
-                if (el.tagName === 'SELECT') {
-                    field.options = Array.from(el.options).map(o => ({
-                        value: o.value,
-                        text: o.textContent?.trim() || '',
-                        selected: o.selected
-                    }));
-                }
-                fields.push(field);
-            }
-            return fields;
-        })()
-    )JS";
-
-    auto result = co_await cdp_.send_command("Runtime.evaluate", {
-        {"expression", js},
-        {"returnByValue", true},
-        {"awaitPromise", false},
-    });
+    auto result = co_await cdp_.send_command("Runtime.evaluate",
+                                             evaluate_params(kFormFieldsScript));
     if (!result) {
         co_return make_fail(result.error());
     }
 
-    if (result->contains("result") && (*result)["result"].contains("value")) {
-        co_return (*result)["result"]["value"];
-    }
-    co_return json::array();
+    auto value = evaluate_value(*result);
+    co_return value.is_null() ? json::array() : value;
 }
 
 auto Snapshot::capture_full(const SnapshotOptions& options)
     -> awaitable<Result<json>> {
     json snapshot;
 
-    // Capture DOM
-    auto dom = co_await capture_dom(options);
+    // The captures are independent, so they are pipelined: one round trip
+    // instead of one per capture.
+    auto results = co_await cdp_.send_many({
+        {"DOMSnapshot.captureSnapshot", FlatDomSnapshot::capture_params()},
+        {"Accessibility.getFullAXTree"},
+        {"Runtime.evaluate", evaluate_params(kLinksScript)},
+        {"Runtime.evaluate", evaluate_params(kFormFieldsScript)},
+        {"Runtime.evaluate", evaluate_params(kPageInfoScript)},
+    });
+    auto& dom_result = results[0];
+    auto& a11y_result = results[1];
+    auto& links_result = results[2];
+    auto& forms_result = results[3];
+    auto& info_result = results[4];
+
+    // DOM
+    Result<DomNode> dom = dom_result
+        ? parse_dom_snapshot(std::move(*dom_result), options)
+        : Result<DomNode>(std::unexpected(dom_result.error()));
+    if (!dom_result) {
+        dom = co_await capture_document(options);
+    }
     if (dom) {
         snapshot["dom"] = *dom;
     }
 
-    // Capture accessibility tree
-    auto a11y = co_await capture_accessibility_tree();
-    if (a11y) {
-        snapshot["accessibility"] = *a11y;
+    // Accessibility tree
+    if (a11y_result) {
+        auto a11y = parse_accessibility_tree(*a11y_result);
+        if (a11y) {
+            snapshot["accessibility"] = *a11y;
+        }
     }
 
-    // Extract links
-    auto links = co_await extract_links();
-    if (links) {
+    // Links
+    if (links_result) {
         json links_json = json::array();
-        for (const auto& [text, href] : *links) {
+        for (const auto& [text, href] : parse_links(*links_result)) {
             links_json.push_back({{"text", text}, {"href", href}});
         }
         snapshot["links"] = links_json;
     }
 
-    // Extract form fields
-    auto forms = co_await extract_form_fields();
-    if (forms) {
-        snapshot["form_fields"] = *forms;
+    // Form fields
+    if (forms_result) {
+        auto value = evaluate_value(*forms_result);
+        snapshot["form_fields"] = value.is_null() ? json::array() : value;
     }
 
     // URL and title
-    auto url_result = co_await cdp_.send_command("Runtime.evaluate", {
-        {"expression", "window.location.href"},
-        {"returnByValue", true},
-    });
-    if (url_result && url_result->contains("result") &&
-        (*url_result)["result"].contains("value")) {
-        snapshot["url"] = (*url_result)["result"]["value"];
-    }
-
-    auto title_result = co_await cdp_.send_command("Runtime.evaluate", {
-        {"expression", "document.title"},
-        {"returnByValue", true},
-    });
-    if (title_result && title_result->contains("result") &&
-        (*title_result)["result"].contains("value")) {
-        snapshot["title"] = (*title_result)["result"]["value"];
+    if (info_result) {
+        auto info = evaluate_value(*info_result);
+        if (info.is_object()) {
+            if (info.contains("url")) snapshot["url"] = info["url"];
+            if (info.contains("title")) snapshot["title"] = info["title"];
+        }
     }
 
     co_return snapshot;
@@ -379,115 +420,15 @@ auto Snapshot::capture_full(const SnapshotOptions& options)
 // Private helpers
 // ---------------------------------------------------------------------------
 
-auto Snapshot::build_dom_tree(const json& nodes, const json& strings,
-                              int index, int depth,
-                              const SnapshotOptions& options)
-    -> DomNode {
-    DomNode node;
-
-    if (options.max_depth >= 0 && depth > options.max_depth) {
-        return node;
-    }
-
-    // DOMSnapshot format uses index-based arrays
-    if (!nodes.contains("nodeName") ||
-        index < 0 || index >= static_cast<int>(nodes["nodeName"].size())) {
-        return node;
-    }
-
-    // Node name from string table
-    int name_idx = nodes["nodeName"][index].get<int>();
-    if (name_idx >= 0 && name_idx < static_cast<int>(strings.size())) {
-        node.tag_name = strings[name_idx].get<std::string>();
-    }
-
-    // Node type
-    int node_type = nodes["nodeType"][index].get<int>();
-    switch (node_type) {
-        case 1: node.node_type = "element"; break;
-        case 3: node.node_type = "text"; break;
-        case 9: node.node_type = "document"; break;
-        case 10: node.node_type = "doctype"; break;
-        case 11: node.node_type = "fragment"; break;
-        default: node.node_type = "other"; break;
-    }
-
-    node.node_id = index;
-
-    // Text value from string table
-    if (nodes.contains("nodeValue")) {
-        int val_idx = nodes["nodeValue"][index].get<int>();
-        if (val_idx >= 0 && val_idx < static_cast<int>(strings.size())) {
-            node.text_content = strings[val_idx].get<std::string>();
-        }
-    }
-
-    // Skip whitespace-only text nodes if configured
-    if (!options.include_whitespace && node.node_type == "text") {
-        bool all_whitespace = true;
-        for (char c : node.text_content) {
-            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
-                all_whitespace = false;
-                break;
-            }
-        }
-        if (all_whitespace && !node.text_content.empty()) {
-            node.text_content.clear();
-        }
-    }
-
-    // Attributes
-    if (nodes.contains("attributes") && index < static_cast<int>(nodes["attributes"].size())) {
-        auto& attrs = nodes["attributes"][index];
-        if (attrs.is_array()) {
-            for (size_t i = 0; i + 1 < attrs.size(); i += 2) {
-                int key_idx = attrs[i].get<int>();
-                int val_idx = attrs[i + 1].get<int>();
-                std::string key, val;
-                if (key_idx >= 0 && key_idx < static_cast<int>(strings.size())) {
-                    key = strings[key_idx].get<std::string>();
-                }
-                if (val_idx >= 0 && val_idx < static_cast<int>(strings.size())) {
-                    val = strings[val_idx].get<std::string>();
-                }
-                if (!key.empty()) {
-                    node.attributes[key] = val;
-                }
-            }
-        }
-    }
-
-    // Layout / bounding box
-    if (nodes.contains("layout")) {
-        auto& layout = nodes["layout"];
-        if (layout.contains("bounds") && index < static_cast<int>(layout["bounds"].size())) {
-            auto& bounds = layout["bounds"][index];
-            if (bounds.is_array() && bounds.size() >= 4) {
-                node.bounding_box = {
-                    {"x", bounds[0]},
-                    {"y", bounds[1]},
-                    {"width", bounds[2]},
-                    {"height", bounds[3]},
-                };
-            }
-        }
-    }
-
-    // Children
-    if (nodes.contains("parentIndex")) {
-        auto& parent_indices = nodes["parentIndex"];
-        for (int i = 0; i < static_cast<int>(parent_indices.size()); ++i) {
-            if (parent_indices[i].get<int>() == index && i != index) {
-                auto child = build_dom_tree(nodes, strings, i, depth + 1, options);
-                if (!child.tag_name.empty() || !child.text_content.empty() ||
-                    !child.children.empty()) {
-                    node.children.push_back(std::move(child));
-                }
-            }
-        }
+auto Snapshot::parse_dom_snapshot(json result, const SnapshotOptions& options)
+    -> Result<DomNode> {
+    auto flat = FlatDomSnapshot::decode(std::move(result));
+    if (!flat) {
+        return std::unexpected(flat.error());
     }
 
-    return node;
+    LOG_DEBUG("Captured DOM snapshot with {} nodes", flat->size());
+    return flat->to_dom_node(options);
 }
 
 auto Snapshot::build_accessibility_tree(const json& node) -> AccessibilityNode {
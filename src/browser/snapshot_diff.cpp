@@ -0,0 +1,424 @@
+#include "openclaw/browser/snapshot_diff.hpp"
+#include "openclaw/core/logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <sstream>
+#include <string_view>
+
+namespace openclaw::browser {
+
+namespace {
+
+/// Attributes that carry meaning for an agent; layout and styling
+/// attributes (class, style, data-*) churn without changing content.
+constexpr std::array<std::string_view, 12> kSemanticAttributes = {
+    "href", "src", "alt", "title", "value", "placeholder", "aria-label",
+    "name", "type", "role", "checked", "disabled",
+};
+
+/// DOM domain events that signal a change to the tree.
+constexpr std::array<const char*, 6> kMutationEvents = {
+    "DOM.childNodeInserted",
+    "DOM.childNodeRemoved",
+    "DOM.childNodeCountUpdated",
+    "DOM.attributeModified",
+    "DOM.attributeRemoved",
+    "DOM.characterDataModified",
+};
+
+/// Ids for nodes without a backendNodeId, kept clear of real ids.
+constexpr int64_t kPositionalIdBase = int64_t{1} << 40;
+
+auto collapse_whitespace(std::string_view s) -> std::string {
+    std::string out;
+    out.reserve(s.size());
+    bool space = false;
+    for (char c : s) {
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f') {
+            space = !out.empty();
+            continue;
+        }
+        if (space) out += ' ';
+        space = false;
+        out += c;
+    }
+    return out;
+}
+
+auto ax_value(const json& node, const char* key) -> std::string {
+    if (node.contains(key) && node[key].contains("value") &&
+        node[key]["value"].is_string()) {
+        return node[key]["value"].get<std::string>();
+    }
+    return {};
+}
+
+auto ax_id(const json& node) -> int64_t {
+    auto id = node.value("nodeId", std::string{});
+    int64_t parsed = 0;
+    for (char c : id) {
+        if (c < '0' || c > '9') {
+            return static_cast<int64_t>(std::hash<std::string>{}(id) >> 2) + 1;
+        }
+        parsed = parsed * 10 + (c - '0');
+    }
+    return parsed;
+}
+
+auto entry(const DigestNode& node) -> json {
+    json j = {{"id", node.id}, {"node", node.label}};
+    if (!node.text.empty()) j["text"] = node.text;
+    if (!node.attrs.empty()) j["attrs"] = node.attrs;
+    return j;
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// PageDigest
+// ---------------------------------------------------------------------------
+
+void PageDigest::add(DigestNode node) {
+    index_.emplace(node.id, nodes_.size());
+    nodes_.push_back(std::move(node));
+}
+
+auto PageDigest::from_dom(const FlatDomSnapshot& snapshot,
+                          const SnapshotOptions& options) -> PageDigest {
+    PageDigest digest;
+    auto nodes = snapshot.nodes();
+    digest.nodes_.reserve(nodes.size());
+
+    // Nodes are in document order with parents first, so a subtree is
+    // skipped by marking each node whose parent was skipped.
+    std::vector<bool> skipped(nodes.size(), false);
+    auto stable_id = [&](size_t i) -> int64_t {
+        return nodes[i].backend_id > 0
+                   ? nodes[i].backend_id
+                   : kPositionalIdBase + static_cast<int64_t>(i);
+    };
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const auto& node = nodes[i];
+        if ((node.parent >= 0 && skipped[node.parent]) ||
+            !snapshot.is_content(node, options)) {
+            skipped[i] = true;
+            continue;
+        }
+
+        DigestNode d;
+        d.id = stable_id(i);
+        d.parent = node.parent >= 0 ? stable_id(node.parent) : 0;
+        d.depth = node.depth;
+        d.label = std::string(node.name);
+        if (node.type == 3) {
+            d.text = collapse_whitespace(node.value);
+        } else {
+            for (const auto& attr : snapshot.attributes(node)) {
+                if (std::find(kSemanticAttributes.begin(), kSemanticAttributes.end(),
+                              attr.name) == kSemanticAttributes.end()) {
+                    continue;
+                }
+                if (!d.attrs.empty()) d.attrs += "; ";
+                d.attrs += std::string(attr.name) + "=" + std::string(attr.value);
+            }
+        }
+        digest.add(std::move(d));
+    }
+    return digest;
+}
+
+auto PageDigest::from_accessibility(const json& result) -> PageDigest {
+    PageDigest digest;
+    if (!result.contains("nodes") || !result["nodes"].is_array() ||
+        result["nodes"].empty()) {
+        return digest;
+    }
+    const auto& nodes = result["nodes"];
+
+    std::unordered_map<std::string, const json*> by_id;
+    by_id.reserve(nodes.size());
+    const json* root = &nodes[0];
+    for (const auto& node : nodes) {
+        by_id.emplace(node.value("nodeId", std::string{}), &node);
+        auto role = ax_value(node, "role");
+        if (root == &nodes[0] && (role == "RootWebArea" || role == "WebArea")) {
+            root = &node;
+        }
+    }
+
+    // Pre-order walk; ignored nodes are dropped and their children lifted
+    struct Frame { const json* node; int64_t parent; int32_t depth; };
+    std::vector<Frame> stack{{root, 0, 0}};
+    while (!stack.empty()) {
+        auto [node, parent, depth] = stack.back();
+        stack.pop_back();
+        if (digest.index_.contains(ax_id(*node))) continue;  // cycle guard
+
+        int64_t id = ax_id(*node);
+        int64_t child_parent = parent;
+        int32_t child_depth = depth;
+        if (!node->value("ignored", false)) {
+            DigestNode d;
+            d.id = id;
+            d.parent = parent;
+            d.depth = depth;
+            d.label = "[" + ax_value(*node, "role") + "]";
+            d.text = ax_value(*node, "name");
+            auto value = ax_value(*node, "value");
+            if (!value.empty()) d.attrs = "value=" + value;
+            if (node->contains("properties")) {
+                for (const auto& prop : (*node)["properties"]) {
+                    auto name = prop.value("name", "");
+                    if (name != "checked" && name != "expanded" &&
+                        name != "selected" && name != "disabled") {
+                        continue;
+                    }
+                    if (!prop.contains("value") || !prop["value"].contains("value")) {
+                        continue;
+                    }
+                    if (!d.attrs.empty()) d.attrs += "; ";
+                    d.attrs += name + "=" + prop["value"]["value"].dump();
+                }
+            }
+            digest.add(std::move(d));
+            child_parent = id;
+            child_depth = depth + 1;
+        } else {
+            digest.index_.emplace(id, SIZE_MAX);  // visited, not recorded
+        }
+
+        if (node->contains("childIds")) {
+            const auto& children = (*node)["childIds"];
+            for (auto it = children.rbegin(); it != children.rend(); ++it) {
+                auto found = by_id.find(it->get<std::string>());
+                if (found != by_id.end()) {
+                    stack.push_back({found->second, child_parent, child_depth});
+                }
+            }
+        }
+    }
+
+    // Drop the visited-only markers of ignored nodes
+    std::erase_if(digest.index_, [](const auto& kv) { return kv.second == SIZE_MAX; });
+    return digest;
+}
+
+auto PageDigest::find(int64_t id) const -> const DigestNode* {
+    auto it = index_.find(id);
+    return it == index_.end() ? nullptr : &nodes_[it->second];
+}
+
+auto PageDigest::subtree_text(int64_t id) const -> std::string {
+    auto it = index_.find(id);
+    if (it == index_.end()) return {};
+
+    std::string out;
+    auto depth = nodes_[it->second].depth;
+    for (size_t i = it->second; i < nodes_.size(); ++i) {
+        if (i != it->second && nodes_[i].depth <= depth) break;
+        if (nodes_[i].text.empty()) continue;
+        if (!out.empty()) out += ' ';
+        out += nodes_[i].text;
+    }
+    return out;
+}
+
+auto PageDigest::render() const -> std::string {
+    std::ostringstream oss;
+    for (const auto& node : nodes_) {
+        oss << std::string(static_cast<size_t>(node.depth) * 2, ' ') << node.label;
+        if (!node.text.empty()) oss << " \"" << node.text << "\"";
+        if (!node.attrs.empty()) oss << " (" << node.attrs << ")";
+        oss << "\n";
+    }
+    return oss.str();
+}
+
+// ---------------------------------------------------------------------------
+// Diffing
+// ---------------------------------------------------------------------------
+
+void to_json(json& j, const SnapshotDiff& d) {
+    j = json{
+        {"added", d.added},
+        {"removed", d.removed},
+        {"changed", d.changed},
+    };
+}
+
+auto diff_digests(const PageDigest& before, const PageDigest& after)
+    -> SnapshotDiff {
+    SnapshotDiff diff;
+
+    for (const auto& node : before.nodes()) {
+        if (after.find(node.id)) continue;
+        ++diff.touched;
+        // Report only the top of a removed subtree
+        if (node.parent == 0 || after.find(node.parent)) {
+            json j = {{"id", node.id}, {"node", node.label}};
+            if (auto text = before.subtree_text(node.id); !text.empty()) {
+                j["text"] = std::move(text);
+            }
+            diff.removed.push_back(std::move(j));
+        }
+    }
+
+    for (const auto& node : after.nodes()) {
+        const auto* old = before.find(node.id);
+        if (!old) {
+            ++diff.touched;
+            // Report only the top of an added subtree, with all its text
+            if (node.parent == 0 || before.find(node.parent)) {
+                auto j = entry(node);
+                j["parent"] = node.parent;
+                if (auto text = after.subtree_text(node.id); !text.empty()) {
+                    j["text"] = std::move(text);
+                }
+                diff.added.push_back(std::move(j));
+            }
+            continue;
+        }
+        if (old->text != node.text || old->attrs != node.attrs ||
+            old->parent != node.parent) {
+            ++diff.touched;
+            auto j = entry(node);
+            if (old->parent != node.parent) j["parent"] = node.parent;
+            diff.changed.push_back(std::move(j));
+        }
+    }
+
+    return diff;
+}
+
+// ---------------------------------------------------------------------------
+// SnapshotTracker
+// ---------------------------------------------------------------------------
+
+SnapshotTracker::SnapshotTracker(CdpClient& cdp)
+    : cdp_(cdp), state_(std::make_shared<MutationState>()) {}
+
+SnapshotTracker::~SnapshotTracker() {
+    for (auto id : listeners_) {
+        cdp_.unlisten(id);
+    }
+}
+
+void SnapshotTracker::reset() {
+    baseline_.reset();
+}
+
+auto SnapshotTracker::watch_document() -> awaitable<Result<void>> {
+    // Mutation events are only sent for nodes the DOM agent has reported,
+    // so request the whole tree once per document.
+    state_->unwatched_nodes = false;
+    auto doc = co_await cdp_.send_command("DOM.getDocument", {
+        {"depth", -1},
+        {"pierce", true},
+    });
+    if (!doc) {
+        state_->unwatched_nodes = true;
+        co_return make_fail(doc.error());
+    }
+    co_return ok_result();
+}
+
+auto SnapshotTracker::capture(const SnapshotDiffOptions& options)
+    -> awaitable<Result<json>> {
+    if (listeners_.empty()) {
+        // Listeners sit alongside the page's own handlers for these events.
+        // They hold the state, not the tracker, so late events are safe
+        for (const auto* event : kMutationEvents) {
+            listeners_.push_back(cdp_.listen(event, [state = state_, event](const json&) {
+                state->mutations.fetch_add(1, std::memory_order_relaxed);
+                if (std::string_view(event) == "DOM.childNodeInserted") {
+                    state->unwatched_nodes = true;
+                }
+            }));
+        }
+        listeners_.push_back(cdp_.listen("DOM.documentUpdated", [state = state_](const json&) {
+            state->document_changed = true;
+        }));
+    }
+
+    bool navigated = state_->document_changed.exchange(false);
+    bool unwatched = state_->unwatched_nodes.load();
+    uint64_t mutations = state_->mutations.exchange(0);
+
+    bool full = !options.diff || !baseline_ ||
+                baseline_source_ != options.source || navigated ||
+                mutations > options.max_mutations;
+
+    if (!full && mutations == 0 && !unwatched) {
+        co_return json{
+            {"mode", "unchanged"},
+            {"nodes", baseline_->size()},
+            {"mutations", 0},
+        };
+    }
+
+    // Capture the current tree. The text is only rendered for a full
+    // answer; a diff is built from the digest alone
+    std::optional<FlatDomSnapshot> flat_snapshot;
+    PageDigest digest;
+    if (options.source == SnapshotSource::Dom) {
+        auto result = co_await cdp_.send_command("DOMSnapshot.captureSnapshot",
+                                                 FlatDomSnapshot::capture_params());
+        if (!result) {
+            co_return make_fail(result.error());
+        }
+        auto flat = FlatDomSnapshot::decode(std::move(*result));
+        if (!flat) {
+            co_return make_fail(flat.error());
+        }
+        digest = PageDigest::from_dom(*flat, options.snapshot);
+        flat_snapshot = std::move(*flat);
+    } else {
+        auto result = co_await cdp_.send_command("Accessibility.getFullAXTree");
+        if (!result) {
+            co_return make_fail(result.error());
+        }
+        digest = PageDigest::from_accessibility(*result);
+    }
+
+    json out;
+    if (!full) {
+        auto diff = diff_digests(*baseline_, digest);
+        auto limit = options.full_threshold *
+                     static_cast<double>(std::max({baseline_->size(),
+                                                   digest.size(), size_t{1}}));
+        if (static_cast<double>(diff.touched) > limit) {
+            full = true;
+        } else if (diff.empty()) {
+            out = {{"mode", "unchanged"}};
+        } else {
+            out = diff;
+            out["mode"] = "diff";
+        }
+    }
+
+    if (full) {
+        auto full_text = flat_snapshot ? flat_snapshot->to_text(options.snapshot)
+                                       : digest.render();
+        out = {{"mode", "full"}, {"text", std::move(full_text)}};
+
+        // A full capture is the point to start watching new content too
+        if (navigated || unwatched) {
+            auto watched = co_await watch_document();
+            if (!watched) {
+                LOG_DEBUG("DOM mutation tracking unavailable: {}",
+                          watched.error().what());
+            }
+        }
+    }
+
+    out["nodes"] = digest.size();
+    out["mutations"] = mutations;
+    baseline_ = std::move(digest);
+    baseline_source_ = options.source;
+    co_return out;
+}
+
+} // namespace openclaw::browser
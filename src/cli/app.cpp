@@ -77,6 +77,7 @@ void App::setup_commands() {
     register_config_command(cli_, config_);
     register_version_command(cli_);
     register_status_command(cli_, config_);
+    register_plugin_host_command(cli_, config_);
 }
 
 } // namespace openclaw::cli
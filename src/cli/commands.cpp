@@ -1,6 +1,7 @@
 #include "openclaw/cli/commands.hpp"
 #include "openclaw/core/logger.hpp"
 
+#include <cstdlib>
 #include <filesystem>
 #include <iostream>
 #include <regex>
@@ -35,10 +36,14 @@
 #include "openclaw/memory/manager.hpp"
 #include "openclaw/browser/browser_pool.hpp"
 #include "openclaw/plugins/loader.hpp"
+#include "openclaw/plugins/plugin_host.hpp"
+#include "openclaw/plugins/watcher.hpp"
 #include "openclaw/cron/scheduler.hpp"
+#include "openclaw/infra/sandbox_pool.hpp"
 
 // Provider factory.
 #include "openclaw/providers/anthropic.hpp"
+#include "openclaw/providers/usage_ledger.hpp"
 
 // Version string; typically injected by CMake via -D, fallback to a default.
 #ifndef OPENCLAW_VERSION_STRING
@@ -105,6 +110,7 @@ void register_gateway_command(CLI::App& app, Config& config) {
 
     sub->callback([&config, &port, &bind]() {
         Logger::init("mylobsterpp", config.log_level);
+        Logger::configure(config.logging);
 
         // Apply CLI overrides.
         if (port != 0) {
@@ -156,6 +162,13 @@ void register_gateway_command(CLI::App& app, Config& config) {
         auto session_store = std::make_unique<sessions::SqliteSessionStore>(session_db);
         sessions::SessionManager session_mgr(std::move(session_store));
 
+        // Usage ledger: per-run token and cost rollups behind provider.usage.
+        std::unique_ptr<providers::UsageLedger> usage_ledger;
+        if (config.usage.enabled) {
+            auto usage_db = config.usage.db_path.value_or((data_dir / "usage.db").string());
+            usage_ledger = std::make_unique<providers::UsageLedger>(config.usage, usage_db);
+        }
+
         // Agent runtime with config.
         agent::AgentRuntime runtime(ioc, config);
 
@@ -176,6 +189,27 @@ void register_gateway_command(CLI::App& app, Config& config) {
         gateway::RuntimeConfig runtime_config(config);
         auto config_persist = data_dir / "config.json";
         runtime_config.set_persist_path(config_persist);
+        // Rotated JWT keys take effect without a restart. Values may hold
+        // ${VAR} references; unresolved or empty ones are refused.
+        runtime_config.on_change([&server](const gateway::ConfigSnapshot& snapshot) {
+            const auto* secrets = snapshot.find("auth.jwt_secrets");
+            if (!secrets || !secrets->is_array() ||
+                server.authenticator().active_method() != gateway::AuthMethod::Jwt) {
+                return;
+            }
+            std::vector<std::string> keys;
+            for (const auto& secret : *secrets) {
+                keys.push_back(secret.is_string() ? resolve_env_refs(secret.get<std::string>())
+                                                  : std::string{});
+            }
+            if (auto applied = server.authenticator().set_jwt_secrets(std::move(keys)); !applied) {
+                LOG_ERROR("Ignoring auth.jwt_secrets change: {}", applied.error().what());
+            }
+        });
+        gateway::ConfigWatcher config_watcher(ioc, runtime_config, config_persist);
+        if (auto watching = config_watcher.start(); !watching) {
+            LOG_WARN("Config hot reload disabled: {}", watching.error().what());
+        }
 
         // Memory manager.
         std::string openai_key;
@@ -190,12 +224,36 @@ void register_gateway_command(CLI::App& app, Config& config) {
 
         // Browser pool.
         browser::BrowserPool browser_pool(ioc, config.browser);
+        if (config.browser.enabled) {
+            browser_pool.prewarm();
+        }
 
         // Channel registry.
         channels::ChannelRegistry channel_registry;
 
-        // Plugin loader.
-        plugins::PluginLoader plugin_loader;
+        // Plugin loader. Plugin tools are published into the agent's tool
+        // registry and follow every reload.
+        plugins::PluginLoader plugin_loader(config, data_dir / "plugins");
+        plugin_loader.publish_tools(runtime.tool_registry());
+        std::vector<std::unique_ptr<plugins::PluginWatcher>> plugin_watchers;
+
+        // Code sandbox. Workers are forked now so the first code_run does
+        // not pay for interpreter startup.
+        std::shared_ptr<infra::SandboxPool> sandbox_pool;
+        if (config.sandbox.code.enabled) {
+            auto work_dir = config.sandbox.code.work_dir
+                ? std::filesystem::path(*config.sandbox.code.work_dir)
+                : data_dir / "sandbox";
+            sandbox_pool = std::make_shared<infra::SandboxPool>(
+                ioc, config.sandbox.code, work_dir);
+            if (auto started = sandbox_pool->start(); !started) {
+                LOG_ERROR("Code sandbox disabled: {}", started.error().what());
+                sandbox_pool.reset();
+            } else {
+                runtime.tool_registry().register_tool(
+                    std::make_shared<infra::CodeRunTool>(sandbox_pool));
+            }
+        }
 
         // Cron scheduler.
         cron::CronScheduler cron_scheduler(ioc);
@@ -203,19 +261,72 @@ void register_gateway_command(CLI::App& app, Config& config) {
         // --- Wire real handlers (overwrites stubs) ---
         auto& protocol = *server.protocol();
 
-        gateway::register_chat_handlers(protocol, server, session_mgr, runtime);
+        gateway::register_chat_handlers(protocol, server, session_mgr, runtime,
+                                        usage_ledger.get());
         gateway::register_config_handlers(protocol, runtime_config);
         gateway::register_gateway_handlers(protocol, server);
         gateway::register_agent_handlers(protocol, server, session_mgr, runtime);
         gateway::register_session_handlers(protocol, session_mgr);
-        gateway::register_provider_handlers(protocol, server, provider_registry);
+        gateway::register_provider_handlers(protocol, server, provider_registry,
+                                            usage_ledger.get());
         gateway::register_memory_handlers(protocol, memory_mgr);
         gateway::register_tool_handlers(protocol, server, runtime.tool_registry());
-        gateway::register_browser_handlers(protocol, browser_pool);
+        gateway::register_browser_handlers(protocol, server, browser_pool,
+                                           config.image.value_or(ImageConfig{}));
         gateway::register_channel_handlers(protocol, channel_registry);
         gateway::register_plugin_handlers(protocol, plugin_loader);
         gateway::register_cron_handlers(protocol, cron_scheduler);
 
+        // Load configured plugins once their methods have somewhere to go.
+        // A directory is loaded as a whole and watched for changes; isolated
+        // plugins each run in a host process of their own.
+        std::vector<std::shared_ptr<plugins::PluginHost>> plugin_hosts;
+        for (const auto& pc : config.plugins) {
+            if (!pc.enabled || pc.path.empty()) {
+                continue;
+            }
+            std::filesystem::path path(pc.path);
+            if (pc.isolated) {
+                std::vector<std::filesystem::path> libraries{path};
+                if (std::filesystem::is_directory(path)) {
+                    libraries.clear();
+                    for (const auto& entry : std::filesystem::directory_iterator(path)) {
+                        if (plugins::is_plugin_library(entry.path())) {
+                            libraries.push_back(entry.path());
+                        }
+                    }
+                }
+                for (const auto& library : libraries) {
+                    auto host = std::make_shared<plugins::PluginHost>(
+                        ioc, plugins::PluginHostOptions{.library = library});
+                    host->publish_tools(runtime.tool_registry());
+                    if (auto started = host->start(); !started) {
+                        LOG_ERROR("Plugin host for {} failed to start: {}",
+                                  library.string(), started.error().what());
+                        continue;
+                    }
+                    plugin_hosts.push_back(std::move(host));
+                }
+                continue;
+            }
+            if (!std::filesystem::is_directory(path)) {
+                if (auto loaded = plugin_loader.load(path); !loaded) {
+                    LOG_ERROR("Plugin '{}' failed to load: {}", pc.name,
+                              loaded.error().what());
+                }
+                continue;
+            }
+            (void)plugin_loader.load_all(path);
+            auto watcher = std::make_unique<plugins::PluginWatcher>(
+                ioc, plugin_loader, path);
+            if (auto watching = watcher->start(); !watching) {
+                LOG_WARN("Plugin hot reload disabled for {}: {}", path.string(),
+                         watching.error().what());
+                continue;
+            }
+            plugin_watchers.push_back(std::move(watcher));
+        }
+
         LOG_INFO("All {} RPC handlers registered", protocol.methods().size());
 
         // --- Start the gateway ---
@@ -223,6 +334,12 @@ void register_gateway_command(CLI::App& app, Config& config) {
             server.start(config.gateway),
             boost::asio::detached);
 
+        if (usage_ledger) {
+            boost::asio::co_spawn(ioc,
+                usage_ledger->flush_loop(),
+                boost::asio::detached);
+        }
+
         // Start cron scheduler if enabled.
         if (config.cron.enabled) {
             boost::asio::co_spawn(ioc,
@@ -241,7 +358,18 @@ void register_gateway_command(CLI::App& app, Config& config) {
         LOG_INFO("Gateway running. Press Ctrl+C to stop.");
         ioc.run();
 
+        for (auto& host : plugin_hosts) {
+            host->stop();
+        }
+        if (sandbox_pool) {
+            sandbox_pool->stop();
+        }
+        if (usage_ledger) {
+            usage_ledger->stop();  // Flushed again when destroyed
+        }
+
         LOG_INFO("Gateway stopped.");
+        Logger::flush();
     });
 }
 
@@ -344,4 +472,32 @@ void register_status_command(CLI::App& app, Config& config) {
     });
 }
 
+// ---------------------------------------------------------------------------
+// plugin-host command (internal)
+// ---------------------------------------------------------------------------
+
+void register_plugin_host_command(CLI::App& app, Config& config) {
+    auto* sub = app.add_subcommand("plugin-host",
+                                   "Serve an isolated plugin to its gateway");
+    sub->group("");  // Spawned by the gateway, not run by hand
+
+    static plugins::PluginHostEndpoint endpoint;
+    static std::string library;
+    sub->add_option("--memfd", endpoint.memfd)->required();
+    sub->add_option("--request-fd", endpoint.request_fd)->required();
+    sub->add_option("--response-fd", endpoint.response_fd)->required();
+    sub->add_option("--ring-bytes", endpoint.ring_bytes)->required();
+    sub->add_option("--library", library)->required();
+
+    sub->callback([&config]() {
+        Logger::init("plugin-host", config.log_level);
+        auto data_dir = config.data_dir
+            ? std::filesystem::path(*config.data_dir)
+            : default_data_dir();
+        auto rc = plugins::run_plugin_host(endpoint, library, config,
+                                           data_dir / "plugins");
+        std::exit(rc);
+    });
+}
+
 } // namespace openclaw::cli
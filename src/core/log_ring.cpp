@@ -0,0 +1,192 @@
+#include "openclaw/core/log_ring.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+
+#include <spdlog/common.h>
+
+namespace openclaw {
+
+namespace {
+
+// Stamps: 2*pos+1 while position `pos` is being written, 2*pos+2 once
+// published. Zero means never written.
+constexpr auto writing_stamp(uint64_t pos) -> uint64_t { return 2 * pos + 1; }
+constexpr auto published_stamp(uint64_t pos) -> uint64_t { return 2 * pos + 2; }
+
+} // anonymous namespace
+
+LogRing::LogRing(size_t capacity, LogOverflow overflow)
+    : slots_(std::make_unique<Slot[]>(std::bit_ceil(std::max<size_t>(capacity, 16))))
+    , mask_(std::bit_ceil(std::max<size_t>(capacity, 16)) - 1)
+    , overflow_(overflow) {}
+
+auto LogRing::claim() -> std::optional<uint64_t> {
+    auto pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+        if (pos - tail_.load(std::memory_order_acquire) > mask_) {
+            bool can_wait = overflow_ == LogOverflow::Block &&
+                            sink_running_.load(std::memory_order_acquire);
+            if (overflow_ == LogOverflow::Drop ||
+                (overflow_ == LogOverflow::Block && !can_wait)) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+            if (can_wait) {
+                std::this_thread::yield();
+                pos = head_.load(std::memory_order_relaxed);
+                continue;
+            }
+        }
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    // In Overwrite mode a writer from the previous lap may still be filling
+    // this slot, or (if we were descheduled) a later lap may already own it.
+    auto& slot = slots_[pos & mask_];
+    auto stamp = slot.stamp.load(std::memory_order_relaxed);
+    for (;;) {
+        if (stamp > writing_stamp(pos)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        if (stamp & 1) {
+            std::this_thread::yield();
+            stamp = slot.stamp.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (slot.stamp.compare_exchange_weak(stamp, writing_stamp(pos),
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    return pos;
+}
+
+void LogRing::publish(Slot& slot, uint64_t pos) {
+    slot.stamp.store(published_stamp(pos), std::memory_order_release);
+    published_.fetch_add(1, std::memory_order_release);
+    published_.notify_one();
+}
+
+void LogRing::wake() {
+    published_.fetch_add(1, std::memory_order_release);
+    published_.notify_all();
+}
+
+auto LogRing::read_slot(uint64_t pos, LogRecord& out) const -> ReadStatus {
+    const auto& slot = slots_[pos & mask_];
+    auto expected = published_stamp(pos);
+    auto before = slot.stamp.load(std::memory_order_acquire);
+    if (before != expected) {
+        return before < expected ? ReadStatus::NotReady : ReadStatus::Lost;
+    }
+
+    // Seqlock read: copy, then confirm no writer reclaimed the slot meanwhile.
+    std::memcpy(static_cast<void*>(&out), &slot.record, offsetof(LogRecord, message));
+    auto length = std::min<size_t>(out.length, LogRecord::kMessageBytes);
+    std::memcpy(out.message, slot.record.message, length);
+    out.length = static_cast<uint16_t>(length);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.stamp.load(std::memory_order_relaxed) != expected) {
+        return ReadStatus::Lost;
+    }
+    return ReadStatus::Ok;
+}
+
+auto LogRing::pop(LogRecord& out) -> bool {
+    auto pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+        auto head = head_.load(std::memory_order_acquire);
+        if (pos == head) {
+            return false;
+        }
+        if (head - pos > capacity()) {
+            // Overwrite mode lapped the sink.
+            lost_.fetch_add(head - capacity() - pos, std::memory_order_relaxed);
+            pos = head - capacity();
+        }
+        switch (read_slot(pos, out)) {
+            case ReadStatus::Ok:
+                tail_.store(pos + 1, std::memory_order_release);
+                return true;
+            case ReadStatus::NotReady:
+                tail_.store(pos, std::memory_order_release);
+                return false;
+            case ReadStatus::Lost:
+                lost_.fetch_add(1, std::memory_order_relaxed);
+                ++pos;
+                break;
+        }
+    }
+}
+
+auto LogRing::read(uint64_t since, size_t limit, std::vector<LogRecord>& out) const -> uint64_t {
+    auto head = head_.load(std::memory_order_acquire);
+    auto oldest = head > capacity() ? head - capacity() : 0;
+    auto pos = std::clamp(since, oldest, head);
+
+    LogRecord record;
+    for (size_t copied = 0; pos < head && copied < limit; ++pos) {
+        auto status = read_slot(pos, record);
+        if (status == ReadStatus::NotReady) {
+            break;
+        }
+        if (status == ReadStatus::Ok) {
+            out.push_back(record);
+            ++copied;
+        }
+    }
+    return pos;
+}
+
+void to_json(nlohmann::json& j, const LogRecord& record) {
+    auto level = spdlog::level::to_string_view(
+        static_cast<spdlog::level::level_enum>(record.level));
+    j = nlohmann::json{
+        {"timestamp", record.time_ns / 1'000'000},
+        {"level", std::string_view(level.data(), level.size())},
+        {"category", record.category},
+        {"file", record.file},
+        {"line", record.line},
+        {"thread", record.thread_id},
+        {"message", record.text()},
+    };
+    if (record.truncated) {
+        j["truncated"] = true;
+    }
+}
+
+auto log_category(std::string_view file) -> std::string_view {
+    // Whichever module root appears last in the path wins.
+    size_t best = std::string_view::npos;
+    size_t skip = 0;
+    for (std::string_view root : {std::string_view("src/"), std::string_view("openclaw/")}) {
+        auto at = file.rfind(root);
+        if (at == std::string_view::npos || (at > 0 && file[at - 1] != '/')) {
+            continue;
+        }
+        if (best == std::string_view::npos || at > best) {
+            best = at;
+            skip = root.size();
+        }
+    }
+    if (best == std::string_view::npos) {
+        return {};
+    }
+    auto rest = file.substr(best + skip);
+    auto slash = rest.find('/');
+    if (slash == std::string_view::npos) {
+        return {};
+    }
+    return rest.substr(0, slash);
+}
+
+} // namespace openclaw
@@ -1,17 +1,372 @@
 #include "openclaw/core/logger.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+#include "openclaw/core/config.hpp"
+
 namespace openclaw {
 
 namespace {
-    std::shared_ptr<spdlog::logger> g_logger;
+
+constexpr const char* kPattern = "[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [%s:%#] %v";
+
+auto parse_level(std::string_view level) -> spdlog::level::level_enum {
+    if (level == "trace") return spdlog::level::trace;
+    if (level == "debug") return spdlog::level::debug;
+    if (level == "info") return spdlog::level::info;
+    if (level == "warn") return spdlog::level::warn;
+    if (level == "error") return spdlog::level::err;
+    if (level == "critical") return spdlog::level::critical;
+    if (level == "off") return spdlog::level::off;
+    return spdlog::level::info;
+}
+
+auto parse_overflow(std::string_view overflow) -> LogOverflow {
+    if (overflow == "block") return LogOverflow::Block;
+    if (overflow == "overwrite") return LogOverflow::Overwrite;
+    return LogOverflow::Drop;
+}
+
+/// Copies `text` into a fixed field, keeping the head (or the tail, for
+/// paths) when it does not fit.
+template <size_t N>
+void copy_field(char (&field)[N], std::string_view text, bool keep_tail = false) {
+    if (text.size() >= N) {
+        text = keep_tail ? text.substr(text.size() - (N - 1)) : text.substr(0, N - 1);
+    }
+    std::memcpy(field, text.data(), text.size());
+    field[text.size()] = '\0';
 }
 
+/// Longest prefix of `text` within `max` bytes that does not split a
+/// UTF-8 sequence.
+auto utf8_prefix(std::string_view text, size_t max) -> size_t {
+    if (text.size() <= max) {
+        return text.size();
+    }
+    auto n = max;
+    while (n > 0 && (static_cast<unsigned char>(text[n]) & 0xC0) == 0x80) {
+        --n;
+    }
+    return n;
+}
+
+/// Per-call-site token bucket, one message budget per second. Call sites
+/// hash into a fixed table, so two hot sites may share a budget.
+class CallSiteSampler {
+public:
+    explicit CallSiteSampler(int per_second) : per_second_(per_second) {}
+
+    auto allow(const spdlog::source_loc& loc) -> bool {
+        if (per_second_ <= 0) {
+            return true;
+        }
+        auto hash = reinterpret_cast<uintptr_t>(loc.filename) * 31 +
+                    static_cast<uintptr_t>(loc.line);
+        hash ^= hash >> 17;
+        auto& bucket = buckets_[hash % buckets_.size()];
+
+        auto second = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+        auto value = bucket.load(std::memory_order_relaxed);
+        for (;;) {
+            uint64_t next;
+            if ((value >> 32) != second) {
+                next = (uint64_t{second} << 32) | 1;
+            } else if ((value & 0xFFFFFFFFu) < static_cast<uint64_t>(per_second_)) {
+                next = value + 1;
+            } else {
+                return false;
+            }
+            if (bucket.compare_exchange_weak(value, next, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+private:
+    int per_second_;
+    std::array<std::atomic<uint64_t>, 256> buckets_{};
+};
+
+/// The spdlog sink behind LOG_*: filters by category level and sampling,
+/// then writes the formatted message into the ring. Never locks.
+class RingSink final : public spdlog::sinks::sink {
+public:
+    RingSink(std::shared_ptr<LogRing> ring,
+             std::vector<std::pair<std::string, spdlog::level::level_enum>> levels,
+             int sample_per_second)
+        : ring_(std::move(ring))
+        , levels_(std::move(levels))
+        , sampler_(sample_per_second) {}
+
+    void log(const spdlog::details::log_msg& msg) override {
+        std::string_view file = msg.source.filename ? msg.source.filename : "";
+        auto category = log_category(file);
+
+        auto threshold = default_level_.load(std::memory_order_relaxed);
+        for (const auto& [name, level] : levels_) {
+            if (name == category) {
+                threshold = level;
+                break;
+            }
+        }
+        if (msg.level < threshold) {
+            return;
+        }
+        if (msg.level < spdlog::level::warn && !sampler_.allow(msg.source)) {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        std::string_view text(msg.payload.data(), msg.payload.size());
+        bool pushed = ring_->push([&](LogRecord& record) {
+            record.time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                msg.time.time_since_epoch()).count();
+            record.thread_id = msg.thread_id;
+            record.line = msg.source.line;
+            record.level = static_cast<uint8_t>(msg.level);
+            copy_field(record.category, category);
+            copy_field(record.file, file, true);
+            auto length = utf8_prefix(text, LogRecord::kMessageBytes);
+            std::memcpy(record.message, text.data(), length);
+            record.length = static_cast<uint16_t>(length);
+            record.truncated = length < text.size();
+        });
+        if (pushed) {
+            written_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void flush() override {}
+    void set_pattern(const std::string&) override {}
+    void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+
+    void set_default_level(spdlog::level::level_enum level) {
+        default_level_.store(level, std::memory_order_relaxed);
+    }
+
+    /// Lowest level any category lets through; the spdlog logger must not
+    /// filter above it.
+    [[nodiscard]] auto lowest_level() const -> spdlog::level::level_enum {
+        auto lowest = default_level_.load(std::memory_order_relaxed);
+        for (const auto& [name, level] : levels_) {
+            lowest = std::min(lowest, level);
+        }
+        return lowest;
+    }
+
+    [[nodiscard]] auto written() const -> uint64_t { return written_.load(std::memory_order_relaxed); }
+    [[nodiscard]] auto suppressed() const -> uint64_t { return suppressed_.load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<LogRing> ring_;
+    std::vector<std::pair<std::string, spdlog::level::level_enum>> levels_;
+    std::atomic<spdlog::level::level_enum> default_level_{spdlog::level::info};
+    CallSiteSampler sampler_;
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> suppressed_{0};
+};
+
+/// One ring, its sink thread and the outputs that thread writes to.
+class Pipeline {
+public:
+    Pipeline(std::string name, const LoggingConfig& config)
+        : name_(std::move(name))
+        , ring_(std::make_shared<LogRing>(config.ring_size, parse_overflow(config.overflow))) {
+        std::vector<std::pair<std::string, spdlog::level::level_enum>> levels;
+        for (const auto& [category, level] : config.levels) {
+            levels.emplace_back(category, parse_level(level));
+        }
+        sink_ = std::make_shared<RingSink>(ring_, std::move(levels), config.sample_per_second);
+        logger_ = std::make_shared<spdlog::logger>(name_, sink_);
+
+        if (config.console) {
+            auto console = std::make_shared<spdlog::sinks::stdout_color_sink_st>();
+            console->set_pattern(kPattern);
+            outputs_.push_back(std::move(console));
+        }
+        if (config.file) {
+            try {
+                auto file = std::make_shared<spdlog::sinks::basic_file_sink_st>(*config.file);
+                file->set_pattern(kPattern);
+                outputs_.push_back(std::move(file));
+            } catch (const spdlog::spdlog_ex& e) {
+                errors_.push_back(e.what());
+            }
+        }
+        if (config.json_file) {
+            json_file_ = std::fopen(config.json_file->c_str(), "a");
+            if (!json_file_) {
+                errors_.push_back("Cannot open log file " + *config.json_file + ": " +
+                                  std::strerror(errno));
+            }
+        }
+
+        ring_->set_sink_running(true);
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ~Pipeline() {
+        stop();
+        if (json_file_) {
+            std::fclose(json_file_);
+        }
+    }
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    void stop() {
+        if (!thread_.joinable()) {
+            return;
+        }
+        stopping_.store(true, std::memory_order_release);
+        ring_->wake();
+        thread_.join();
+    }
+
+    void flush() {
+        if (!thread_.joinable()) {
+            return;
+        }
+        auto request = flush_requests_.fetch_add(1, std::memory_order_acq_rel) + 1;
+        ring_->wake();
+        auto done = flushed_.load(std::memory_order_acquire);
+        while (done < request) {
+            flushed_.wait(done, std::memory_order_acquire);
+            done = flushed_.load(std::memory_order_acquire);
+        }
+    }
+
+    void set_level(spdlog::level::level_enum level) {
+        sink_->set_default_level(level);
+        logger_->set_level(sink_->lowest_level());
+    }
+
+    [[nodiscard]] auto logger() -> std::shared_ptr<spdlog::logger>& { return logger_; }
+    [[nodiscard]] auto ring() const -> const LogRing& { return *ring_; }
+    [[nodiscard]] auto errors() const -> const std::vector<std::string>& { return errors_; }
+
+    [[nodiscard]] auto stats() const -> LogStats {
+        return LogStats{
+            .written = sink_->written(),
+            .dropped = ring_->dropped(),
+            .lost = ring_->lost(),
+            .suppressed = sink_->suppressed(),
+            .capacity = ring_->capacity(),
+        };
+    }
+
+private:
+    void run() {
+        LogRecord record;
+        for (;;) {
+            auto seen = ring_->published();
+            auto requested = flush_requests_.load(std::memory_order_acquire);
+            bool wrote = false;
+            while (ring_->pop(record)) {
+                write(record);
+                wrote = true;
+            }
+            bool flush_requested = requested != flushed_.load(std::memory_order_relaxed);
+            if (wrote || flush_requested) {
+                for (auto& output : outputs_) {
+                    output->flush();
+                }
+                if (json_file_) {
+                    std::fflush(json_file_);
+                }
+            }
+            if (flush_requested) {
+                flushed_.store(requested, std::memory_order_release);
+                flushed_.notify_all();
+            }
+            if (stopping_.load(std::memory_order_acquire)) {
+                break;
+            }
+            ring_->wait(seen);
+        }
+        ring_->set_sink_running(false);
+        // Release flush() callers that raced with shutdown.
+        flushed_.store(flush_requests_.load(std::memory_order_acquire), std::memory_order_release);
+        flushed_.notify_all();
+    }
+
+    void write(const LogRecord& record) {
+        auto level = static_cast<spdlog::level::level_enum>(record.level);
+        if (!outputs_.empty()) {
+            spdlog::details::log_msg msg(
+                spdlog::log_clock::time_point(std::chrono::duration_cast<spdlog::log_clock::duration>(
+                    std::chrono::nanoseconds(record.time_ns))),
+                spdlog::source_loc{record.file, record.line, ""},
+                name_, level, spdlog::string_view_t(record.message, record.length));
+            msg.thread_id = record.thread_id;
+            for (auto& output : outputs_) {
+                output->log(msg);
+            }
+        }
+        if (json_file_) {
+            auto line = nlohmann::json(record).dump(-1, ' ', false,
+                                                    nlohmann::json::error_handler_t::replace);
+            line += '\n';
+            std::fwrite(line.data(), 1, line.size(), json_file_);
+        }
+    }
+
+    std::string name_;
+    std::shared_ptr<LogRing> ring_;
+    std::shared_ptr<RingSink> sink_;
+    std::shared_ptr<spdlog::logger> logger_;
+    std::vector<spdlog::sink_ptr> outputs_;  // Touched only by the sink thread
+    std::FILE* json_file_ = nullptr;
+    std::vector<std::string> errors_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<uint64_t> flush_requests_{0};
+    std::atomic<uint64_t> flushed_{0};
+    std::thread thread_;
+};
+
+std::string g_name = "openclaw";
+LoggingConfig g_config;
+spdlog::level::level_enum g_level = spdlog::level::info;
+std::unique_ptr<Pipeline> g_pipeline;
+std::shared_ptr<spdlog::logger> g_logger;
+
+void rebuild() {
+    auto next = std::make_unique<Pipeline>(g_name, g_config);
+    next->set_level(g_level);
+    g_logger = next->logger();
+    if (g_pipeline) {
+        g_pipeline->stop();
+    }
+    g_pipeline = std::move(next);
+    for (const auto& error : g_pipeline->errors()) {
+        LOG_ERROR("{}", error);
+    }
+}
+
+} // anonymous namespace
+
 void Logger::init(std::string_view name, std::string_view level) {
-    g_logger = spdlog::stdout_color_mt(std::string(name));
-    g_logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [%s:%#] %v");
-    set_level(level);
+    g_name = std::string(name);
+    g_level = parse_level(level);
+    rebuild();
+}
+
+void Logger::configure(const LoggingConfig& config) {
+    g_config = config;
+    rebuild();
 }
 
 auto Logger::get() -> std::shared_ptr<spdlog::logger>& {
@@ -22,17 +377,29 @@ auto Logger::get() -> std::shared_ptr<spdlog::logger>& {
 }
 
 void Logger::set_level(std::string_view level) {
-    if (level == "trace") g_logger->set_level(spdlog::level::trace);
-    else if (level == "debug") g_logger->set_level(spdlog::level::debug);
-    else if (level == "info") g_logger->set_level(spdlog::level::info);
-    else if (level == "warn") g_logger->set_level(spdlog::level::warn);
-    else if (level == "error") g_logger->set_level(spdlog::level::err);
-    else if (level == "critical") g_logger->set_level(spdlog::level::critical);
-    else g_logger->set_level(spdlog::level::info);
+    g_level = parse_level(level);
+    if (g_pipeline) g_pipeline->set_level(g_level);
 }
 
 void Logger::flush() {
-    if (g_logger) g_logger->flush();
+    if (g_pipeline) g_pipeline->flush();
+}
+
+void Logger::shutdown() {
+    if (g_pipeline) g_pipeline->stop();
+}
+
+auto Logger::read(uint64_t since, size_t limit, std::vector<LogRecord>& out) -> uint64_t {
+    if (!g_pipeline) return since;
+    return g_pipeline->ring().read(since, limit, out);
+}
+
+auto Logger::position() -> uint64_t {
+    return g_pipeline ? g_pipeline->ring().head() : 0;
+}
+
+auto Logger::stats() -> LogStats {
+    return g_pipeline ? g_pipeline->stats() : LogStats{};
 }
 
 } // namespace openclaw
@@ -1,39 +1,333 @@
 #include "openclaw/core/secrets.hpp"
 #include "openclaw/core/logger.hpp"
 
+#include <algorithm>
 #include <array>
-#include <cstdio>
+#include <cerrno>
+#include <csignal>
 #include <fstream>
+#include <thread>
 
 #ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
 #include <sys/stat.h>
+#include <sys/wait.h>
 #include <unistd.h>
+
+extern char** environ;
 #endif
 
 namespace openclaw {
 
+namespace {
+
+/// Retry delay after `failures` consecutive failed refreshes.
+auto refresh_backoff(int failures) -> std::chrono::milliseconds {
+    return std::chrono::milliseconds(1000 << std::min(failures - 1, 6));  // 1 s .. 64 s
+}
+
+/// Reaps `pid`, killing it if it is still running at `deadline` (e.g. a
+/// command that closed stdout but keeps going). Returns false if killed.
+auto reap_until(pid_t pid, int& status, std::chrono::steady_clock::time_point deadline) -> bool {
+    while (true) {
+        auto reaped = ::waitpid(pid, &status, WNOHANG);
+        if (reaped == pid || (reaped < 0 && errno != EINTR)) {
+            return true;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            ::kill(pid, SIGKILL);
+            while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+} // anonymous namespace
+
+auto split_command_line(std::string_view line) -> Result<std::vector<std::string>> {
+    auto invalid = [&line](const char* message) -> Result<std::vector<std::string>> {
+        return std::unexpected(make_error(ErrorCode::InvalidArgument, message,
+                                          std::string(line)));
+    };
+
+    std::vector<std::string> words;
+    std::string word;
+    bool in_word = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (c == ' ' || c == '\t' || c == '\n') {
+            if (in_word) {
+                words.push_back(std::move(word));
+                word.clear();
+                in_word = false;
+            }
+            continue;
+        }
+        in_word = true;
+        if (c == '\'') {
+            auto end = line.find('\'', i + 1);
+            if (end == std::string_view::npos) {
+                return invalid("Unterminated single quote in secret command");
+            }
+            word.append(line.substr(i + 1, end - i - 1));
+            i = end;
+        } else if (c == '"') {
+            for (++i; i < line.size() && line[i] != '"'; ++i) {
+                if (line[i] == '\\' && i + 1 < line.size() &&
+                    (line[i + 1] == '"' || line[i + 1] == '\\')) {
+                    ++i;
+                }
+                word.push_back(line[i]);
+            }
+            if (i == line.size()) {
+                return invalid("Unterminated double quote in secret command");
+            }
+        } else if (c == '\\') {
+            if (++i == line.size()) {
+                return invalid("Trailing backslash in secret command");
+            }
+            word.push_back(line[i]);
+        } else {
+            word.push_back(c);
+        }
+    }
+    if (in_word) {
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
 SecretResolver::SecretResolver(SecretsConfig config)
     : config_(std::move(config)) {}
 
+SecretResolver::~SecretResolver() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Cache
+// ---------------------------------------------------------------------------
+
+auto SecretResolver::cache_key(const SecretRef& ref) -> std::string {
+    return ref.source + '\0' + ref.provider + '\0' + ref.id;
+}
+
+auto SecretResolver::ttl(const SecretRef& ref) const -> std::chrono::milliseconds {
+    return std::chrono::milliseconds(ref.ttl_ms > 0 ? ref.ttl_ms : config_.cache_ttl_ms);
+}
+
 auto SecretResolver::resolve(const SecretRef& ref) -> Result<std::string> {
     if (ref.source == "env") {
         return resolve_env(ref.id);
     }
+    if (ref.source != "file" && ref.source != "exec") {
+        return std::unexpected(make_error(
+            ErrorCode::InvalidArgument,
+            "Unknown secret source",
+            ref.source));
+    }
+
+    auto key = cache_key(ref);
+    std::unique_lock lock(mutex_);
+    auto [it, inserted] = entries_.try_emplace(key);
+    auto& entry = it->second;
+    if (inserted) {
+        entry.ref = ref;
+    }
+
+    if (entry.value) {
+        entry.used = true;
+        if (Clock::now() < entry.fetched_at + ttl(ref)) {
+            ++stats_.hits;
+            return *entry.value;
+        }
+        // Expired: serve it while the worker fetches a new one
+        ++stats_.stale_served;
+        if (!entry.inflight.valid() && !entry.refresh_requested) {
+            entry.refresh_requested = true;
+            ensure_worker();
+            cv_.notify_all();
+        }
+        return *entry.value;
+    }
+
+    if (entry.inflight.valid()) {
+        ++stats_.coalesced;
+        auto inflight = entry.inflight;
+        lock.unlock();
+        return inflight.get();
+    }
+
+    ++stats_.misses;
+    std::promise<Result<std::string>> promise;
+    entry.inflight = promise.get_future().share();
+    lock.unlock();
+
+    auto result = fetch(ref);
+
+    lock.lock();
+    store(key, result, false);
+    lock.unlock();
+    promise.set_value(result);
+    return result;
+}
+
+void SecretResolver::prefetch(const std::vector<SecretRef>& refs) {
+    std::lock_guard lock(mutex_);
+    for (const auto& ref : refs) {
+        if (ref.source != "file" && ref.source != "exec") {
+            continue;
+        }
+        auto [it, inserted] = entries_.try_emplace(cache_key(ref));
+        if (inserted) {
+            it->second.ref = ref;
+            it->second.refresh_requested = true;
+        }
+    }
+    ensure_worker();
+    cv_.notify_all();
+}
+
+void SecretResolver::invalidate(const SecretRef& ref) {
+    std::lock_guard lock(mutex_);
+    entries_.erase(cache_key(ref));
+}
+
+void SecretResolver::clear() {
+    std::lock_guard lock(mutex_);
+    entries_.clear();
+}
+
+auto SecretResolver::stats() const -> SecretCacheStats {
+    std::lock_guard lock(mutex_);
+    auto stats = stats_;
+    stats.entries = entries_.size();
+    return stats;
+}
+
+auto SecretResolver::fetch(const SecretRef& ref) -> Result<std::string> {
     if (ref.source == "file") {
         return resolve_file(ref.id);
     }
-    if (ref.source == "exec") {
-        std::vector<std::string> args;
-        // The ref.id is the command; args can come from the config
-        if (config_.exec) {
-            args = config_.exec->args;
+    // The ref.id is a command line, split into words without a shell;
+    // args from the config follow its own
+    auto words = split_command_line(ref.id);
+    if (!words) {
+        return std::unexpected(words.error());
+    }
+    if (words->empty()) {
+        return resolve_exec("", {});
+    }
+    std::vector<std::string> args(words->begin() + 1, words->end());
+    if (config_.exec) {
+        args.insert(args.end(), config_.exec->args.begin(), config_.exec->args.end());
+    }
+    return resolve_exec(words->front(), args);
+}
+
+void SecretResolver::store(const std::string& key, const Result<std::string>& result,
+                           bool background) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return;  // Invalidated while fetching
+    }
+    auto& entry = it->second;
+    auto now = Clock::now();
+    auto lifetime = ttl(entry.ref);
+    entry.inflight = {};
+    entry.refresh_requested = false;
+
+    if (result) {
+        if (background) {
+            ++stats_.refreshes;
         }
-        return resolve_exec(ref.id, args);
+        entry.value = *result;
+        entry.fetched_at = now;
+        entry.refresh_at = now + lifetime * 4 / 5;  // Refresh ahead of expiry
+        entry.used = false;
+        entry.failures = 0;
+        ensure_worker();
+        cv_.notify_all();
+        return;
+    }
+
+    if (background) {
+        ++stats_.refresh_failures;
+    }
+    if (!entry.value) {
+        // Nothing to fall back on; the next resolve() tries again
+        entries_.erase(it);
+        return;
+    }
+    ++entry.failures;
+    entry.refresh_at = now + refresh_backoff(entry.failures);
+    LOG_WARN("Secret refresh failed for {} {} ({}); serving the last good value",
+             entry.ref.source, entry.ref.id, result.error().what());
+}
+
+void SecretResolver::ensure_worker() {
+    if (!worker_.joinable()) {
+        worker_ = std::thread([this] { refresh_loop(); });
+    }
+}
+
+void SecretResolver::refresh_loop() {
+    std::unique_lock lock(mutex_);
+    while (!stopping_) {
+        auto now = Clock::now();
+        auto next = Clock::time_point::max();
+        std::string due;
+        for (const auto& [key, entry] : entries_) {
+            if (entry.inflight.valid()) {
+                continue;
+            }
+            if (entry.refresh_requested) {
+                due = key;
+                break;
+            }
+            // Only secrets still in use are refreshed ahead of expiry
+            if (!entry.value || !entry.used) {
+                continue;
+            }
+            if (entry.refresh_at <= now) {
+                due = key;
+                break;
+            }
+            next = std::min(next, entry.refresh_at);
+        }
+
+        if (due.empty()) {
+            if (next == Clock::time_point::max()) {
+                cv_.wait(lock);
+            } else {
+                cv_.wait_until(lock, next);
+            }
+            continue;
+        }
+
+        auto& entry = entries_[due];
+        entry.refresh_requested = false;
+        std::promise<Result<std::string>> promise;
+        entry.inflight = promise.get_future().share();
+        auto ref = entry.ref;
+        lock.unlock();
+
+        auto result = fetch(ref);
+
+        lock.lock();
+        store(due, result, true);
+        promise.set_value(std::move(result));
     }
-    return std::unexpected(make_error(
-        ErrorCode::InvalidArgument,
-        "Unknown secret source",
-        ref.source));
 }
 
 auto SecretResolver::resolve_env(std::string_view key) -> Result<std::string> {
@@ -146,42 +440,112 @@ auto SecretResolver::resolve_exec(std::string_view cmd, const std::vector<std::s
             "Empty command for exec secret resolution"));
     }
 
-    // Build the command string
-    std::string full_cmd(cmd);
-    for (const auto& arg : args) {
-        full_cmd += " ";
-        // Basic quoting for safety
-        full_cmd += "'" + arg + "'";
-    }
-
+    std::string command(cmd);
     int max_output = 65536;
+    int timeout_ms = 5000;
     if (config_.exec) {
         max_output = config_.exec->max_output_bytes;
+        timeout_ms = config_.exec->timeout_ms;
+    }
+
+    // Spawn the command directly (no shell), so arguments are never
+    // reinterpreted and the timeout applies to the command itself.
+    std::vector<std::string> argv_storage;
+    argv_storage.reserve(args.size() + 1);
+    argv_storage.push_back(command);
+    argv_storage.insert(argv_storage.end(), args.begin(), args.end());
+    std::vector<char*> argv;
+    for (auto& arg : argv_storage) {
+        argv.push_back(arg.data());
     }
+    argv.push_back(nullptr);
 
-    // Execute with popen
-    auto* pipe = ::popen(full_cmd.c_str(), "r");
-    if (!pipe) {
+    int pipe_fds[2];
+    if (::pipe2(pipe_fds, O_CLOEXEC) != 0) {
+        return std::unexpected(make_error(
+            ErrorCode::IoError,
+            "Failed to create pipe for secret command",
+            std::string(strerror(errno))));
+    }
+
+    posix_spawn_file_actions_t actions;
+    ::posix_spawn_file_actions_init(&actions);
+    ::posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    ::posix_spawn_file_actions_adddup2(&actions, pipe_fds[1], STDOUT_FILENO);
+
+    pid_t pid = -1;
+    int rc = ::posix_spawnp(&pid, command.c_str(), &actions, nullptr, argv.data(), environ);
+    ::posix_spawn_file_actions_destroy(&actions);
+    ::close(pipe_fds[1]);
+    if (rc != 0) {
+        ::close(pipe_fds[0]);
         return std::unexpected(make_error(
             ErrorCode::IoError,
             "Failed to execute secret command",
-            full_cmd));
+            command + ": " + std::string(strerror(rc))));
     }
 
     std::string output;
     std::array<char, 4096> buffer{};
-    while (static_cast<int>(output.size()) < max_output) {
-        auto n = std::fread(buffer.data(), 1, buffer.size(), pipe);
-        if (n == 0) break;
-        output.append(buffer.data(), n);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    bool timed_out = false;
+    bool too_large = false;
+    while (true) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            timed_out = true;
+            break;
+        }
+        pollfd pfd{pipe_fds[0], POLLIN, 0};
+        int ready = ::poll(&pfd, 1, static_cast<int>(remaining.count()));
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready <= 0) {
+            timed_out = ready == 0;
+            break;
+        }
+        auto n = ::read(pipe_fds[0], buffer.data(), buffer.size());
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;  // EOF
+        }
+        output.append(buffer.data(), static_cast<size_t>(n));
+        if (static_cast<int>(output.size()) > max_output) {
+            too_large = true;
+            break;
+        }
     }
+    ::close(pipe_fds[0]);
 
-    int status = ::pclose(pipe);
-    if (status != 0) {
+    if (timed_out || too_large) {
+        ::kill(pid, SIGKILL);
+    }
+    int status = 0;
+    if (!reap_until(pid, status, deadline)) {
+        timed_out = true;
+    }
+
+    if (timed_out) {
+        return std::unexpected(make_error(
+            ErrorCode::Timeout,
+            "Secret command timed out",
+            command + " (" + std::to_string(timeout_ms) + " ms)"));
+    }
+    if (too_large) {
+        return std::unexpected(make_error(
+            ErrorCode::IoError,
+            "Secret command output exceeds max_output_bytes",
+            command));
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
         return std::unexpected(make_error(
             ErrorCode::IoError,
             "Secret command exited with non-zero status",
-            full_cmd + " (status " + std::to_string(status) + ")"));
+            command + " (status " + std::to_string(status) + ")"));
     }
 
     // Trim trailing newline
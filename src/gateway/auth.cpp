@@ -95,6 +95,37 @@ auto TailscaleAuthVerifier::verify(std::string_view peer_addr)
     };
 }
 
+// -- JwtAuthVerifier --
+
+JwtAuthVerifier::JwtAuthVerifier(std::vector<std::string> secrets)
+    : verifier_(std::move(secrets)) {}
+
+auto JwtAuthVerifier::verify(std::string_view credential)
+    -> awaitable<Result<AuthInfo>> {
+    auto claims = verifier_.verify(credential);
+    if (!claims) {
+        co_return make_fail(
+            make_error(ErrorCode::Unauthorized, "Invalid authentication token",
+                       claims.error().what()));
+    }
+
+    std::string identity = "jwt-user";
+    if (auto it = claims->find("sub"); it != claims->end() && it->is_string()) {
+        identity = it->get<std::string>();
+    }
+    std::optional<std::string> device;
+    if (auto it = claims->find("device"); it != claims->end() && it->is_string()) {
+        device = it->get<std::string>();
+    }
+
+    co_return AuthInfo{
+        .identity = std::move(identity),
+        .method = AuthMethod::Jwt,
+        .device = std::move(device),
+        .metadata = std::move(*claims),
+    };
+}
+
 // -- Authenticator --
 
 Authenticator::Authenticator() = default;
@@ -120,6 +151,22 @@ void Authenticator::configure(const AuthConfig& config) {
         if (config.tailscale_authkey) sock = *config.tailscale_authkey;
         verifier_ = std::make_unique<TailscaleAuthVerifier>(std::move(sock));
         LOG_INFO("Gateway auth: tailscale authentication enabled");
+    } else if (config.method == "jwt") {
+        auto secrets = config.jwt_secrets;
+        if (secrets.empty() && config.token && !config.token->empty()) {
+            secrets.push_back(*config.token);
+        }
+        // Fail closed: a missing, empty or unresolved secret leaves JWT
+        // auth on with no keys, so every connection is refused
+        if (auto valid = infra::validate_jwt_secrets(secrets); !valid) {
+            LOG_ERROR("JWT auth misconfigured ({}); refusing all connections",
+                      valid.error().what());
+            secrets.clear();
+        }
+        method_ = AuthMethod::Jwt;
+        jwt_secrets_ = secrets;
+        verifier_ = std::make_unique<JwtAuthVerifier>(std::move(secrets));
+        LOG_INFO("Gateway auth: JWT authentication enabled");
     } else {
         method_ = AuthMethod::None;
         verifier_.reset();
@@ -207,6 +254,27 @@ auto Authenticator::active_method() const noexcept -> AuthMethod {
     return method_;
 }
 
+auto Authenticator::jwt_verifier() noexcept -> infra::JwtVerifier* {
+    if (method_ != AuthMethod::Jwt || !verifier_) return nullptr;
+    return &static_cast<JwtAuthVerifier&>(*verifier_).verifier();
+}
+
+auto Authenticator::set_jwt_secrets(std::vector<std::string> secrets) -> Result<void> {
+    auto* verifier = jwt_verifier();
+    if (!verifier) {
+        return std::unexpected(make_error(
+            ErrorCode::InvalidArgument, "JWT authentication is not enabled"));
+    }
+    if (secrets == jwt_secrets_) {
+        return {};  // Keep the cache
+    }
+    if (auto replaced = verifier->set_keys(secrets); !replaced) {
+        return replaced;
+    }
+    jwt_secrets_ = std::move(secrets);
+    return {};
+}
+
 // -- BrowserAuthPolicy helpers (v2026.2.25) --
 
 auto validate_browser_ws_origin(
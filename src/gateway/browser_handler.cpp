@@ -1,28 +1,63 @@
 #include "openclaw/gateway/browser_handler.hpp"
 
+#include <boost/asio/post.hpp>
 #include <boost/asio/use_awaitable.hpp>
 
+#include <algorithm>
+#include <vector>
+
+#include "openclaw/browser/browser_action.hpp"
+#include "openclaw/browser/page_fetcher.hpp"
 #include "openclaw/core/logger.hpp"
+#include "openclaw/core/utils.hpp"
 
 namespace openclaw::gateway {
 
 using json = nlohmann::json;
 using boost::asio::awaitable;
 
+namespace {
+
+// Smallest image side a caller may ask browser.screenshot for
+constexpr int64_t kMinScreenshotDimension = 16;
+
+} // anonymous namespace
+
 void register_browser_handlers(Protocol& protocol,
-                               browser::BrowserPool& pool) {
-    // browser.open
+                               GatewayServer& server,
+                               browser::BrowserPool& pool,
+                               const ImageConfig& image) {
+    // browser.open — the session belongs to the calling connection
     protocol.register_method("browser.open",
-        [&pool]([[maybe_unused]] json params) -> awaitable<json> {
+        [&pool](json params, RequestContext context) -> awaitable<json> {
             auto url = params.value("url", "about:blank");
-            auto result = co_await pool.acquire();
+            auto profile_name = params.value("profile", "");
+            auto profile = pool.network_profile(profile_name);
+            if (!profile) {
+                co_return json{{"ok", false},
+                               {"error", "Unknown network profile: " + profile_name}};
+            }
+
+            auto result = co_await pool.acquire(context.connection_id);
             if (!result.has_value()) {
                 co_return json{{"ok", false}, {"error", result.error().what()}};
             }
-            auto* instance = result.value();
+            auto session = std::move(*result);
+
+            if (!profile_name.empty() && session->network) {
+                auto applied = co_await session->network->apply(std::move(*profile));
+                if (!applied) {
+                    pool.release(session);
+                    co_return json{{"ok", false}, {"error", applied.error().what()}};
+                }
+            }
+
             co_return json{
                 {"ok", true},
-                {"instanceId", instance->id},
+                {"sessionId", session->id},
+                {"instanceId", session->instance_id},
+                {"profile", session->network ? session->network->profile().name
+                                             : std::string("full")},
                 {"url", url},
             };
         },
@@ -30,12 +65,12 @@ void register_browser_handlers(Protocol& protocol,
 
     // browser.close
     protocol.register_method("browser.close",
-        [&pool]([[maybe_unused]] json params) -> awaitable<json> {
-            auto id = params.value("instanceId", "");
+        [&pool](json params, RequestContext context) -> awaitable<json> {
+            auto id = params.value("sessionId", "");
             if (id.empty()) {
-                co_return json{{"ok", false}, {"error", "instanceId is required"}};
+                co_return json{{"ok", false}, {"error", "sessionId is required"}};
             }
-            auto result = co_await pool.close(id);
+            auto result = co_await pool.close(id, context.connection_id);
             if (!result.has_value()) {
                 co_return json{{"ok", false}, {"error", result.error().what()}};
             }
@@ -57,20 +92,204 @@ void register_browser_handlers(Protocol& protocol,
 
     // browser.screenshot
     protocol.register_method("browser.screenshot",
-        []([[maybe_unused]] json params) -> awaitable<json> {
-            // TODO: CDP Page.captureScreenshot.
-            co_return json{{"ok", false}, {"error", "Not yet implemented"}};
+        [&pool, budget = browser::ImageBudget::from_config(image)](
+            json params, RequestContext context) -> awaitable<json> {
+            auto id = params.value("sessionId", "");
+            auto session = id.empty() ? nullptr : pool.find(id, context.connection_id);
+            if (!session || !session->cdp) {
+                co_return json{{"ok", false}, {"error", "Unknown session: " + id}};
+            }
+            session->last_used = utils::timestamp_ms();
+
+            browser::ScreenshotOptions options;
+            options.format = params.value("format", "auto");
+            options.quality = params.value("quality", options.quality);
+            options.full_page = params.value("fullPage", false);
+            if (params.contains("clip") && params["clip"].is_object()) {
+                options.clip = params["clip"];
+            }
+            // Callers may ask for smaller images, never larger ones
+            options.budget = budget;
+            if (params.contains("maxDimension")) {
+                const auto& requested = params["maxDimension"];
+                if (!requested.is_number_integer() || requested.get<int64_t>() <= 0) {
+                    co_return json{{"ok", false},
+                                   {"error", "maxDimension must be a positive integer"}};
+                }
+                options.budget->max_dimension_px = static_cast<int>(std::clamp<int64_t>(
+                    requested.get<int64_t>(),
+                    std::min<int64_t>(kMinScreenshotDimension, budget.max_dimension_px),
+                    budget.max_dimension_px));
+            }
+
+            browser::BrowserAction action(*session->cdp);
+            auto shot = co_await action.screenshot(options);
+            if (!shot) {
+                co_return json{{"ok", false}, {"error", shot.error().what()}};
+            }
+
+            json response = {
+                {"ok", true},
+                {"format", shot->format},
+                {"mimeType", "image/" + shot->format},
+                {"width", shot->width},
+                {"height", shot->height},
+                {"bytes", shot->bytes},
+            };
+            // Binary-capable clients get the image as its own WebSocket frame
+            if (params.value("binary", false)) {
+                auto raw = utils::base64_decode(shot->data);
+                response["data"] = json::binary(
+                    std::vector<uint8_t>(raw.begin(), raw.end()));
+            } else {
+                response["data"] = std::move(shot->data);
+            }
+            co_return response;
         },
         "Take a screenshot", "browser");
 
     // browser.content
     protocol.register_method("browser.content",
-        []([[maybe_unused]] json params) -> awaitable<json> {
-            // TODO: CDP Runtime.evaluate to get document content.
-            co_return json{{"ok", false}, {"error", "Not yet implemented"}};
+        [&pool](json params, RequestContext context) -> awaitable<json> {
+            auto id = params.value("sessionId", "");
+            if (id.empty()) {
+                co_return json{{"ok", false}, {"error", "sessionId is required"}};
+            }
+            auto session = pool.find(id, context.connection_id);
+            if (!session || !session->cdp) {
+                co_return json{{"ok", false}, {"error", "Unknown session: " + id}};
+            }
+            session->last_used = utils::timestamp_ms();
+
+            if (params.value("format", "text") == "html") {
+                auto html = co_await session->cdp->send_command("Runtime.evaluate", {
+                    {"expression", "document.documentElement.outerHTML"},
+                    {"returnByValue", true},
+                });
+                if (!html) {
+                    co_return json{{"ok", false}, {"error", html.error().what()}};
+                }
+                co_return json{
+                    {"ok", true},
+                    {"html", (*html)["result"].value("value", "")},
+                };
+            }
+
+            // Text, optionally as a diff against this session's last capture
+            browser::SnapshotDiffOptions options;
+            options.diff = params.value("diff", false);
+            options.full_threshold =
+                params.value("fullThreshold", options.full_threshold);
+            if (params.value("source", "dom") == "accessibility") {
+                options.source = browser::SnapshotSource::Accessibility;
+            }
+            if (!session->snapshots) {
+                session->snapshots =
+                    std::make_unique<browser::SnapshotTracker>(*session->cdp);
+            }
+
+            auto result = co_await session->snapshots->capture(options);
+            if (!result) {
+                co_return json{{"ok", false}, {"error", result.error().what()}};
+            }
+            auto response = std::move(*result);
+            response["ok"] = true;
+            co_return response;
         },
         "Get page content as text/html", "browser");
 
+    // browser.fetch_many — load a list of URLs in parallel and extract text
+    protocol.register_method("browser.fetch_many",
+        [&pool, &server](json params, RequestContext context) -> awaitable<json> {
+            if (!params.contains("urls") || !params["urls"].is_array() ||
+                params["urls"].empty()) {
+                co_return json{{"ok", false}, {"error", "urls is required"}};
+            }
+            constexpr size_t kMaxUrls = 50;
+            if (params["urls"].size() > kMaxUrls) {
+                co_return json{{"ok", false},
+                               {"error", "At most " + std::to_string(kMaxUrls) +
+                                         " urls per call"}};
+            }
+            std::vector<std::string> urls;
+            for (const auto& url : params["urls"]) {
+                if (!url.is_string()) {
+                    co_return json{{"ok", false}, {"error", "urls must be strings"}};
+                }
+                urls.push_back(url.get<std::string>());
+            }
+
+            browser::FetchManyOptions options;
+            options.concurrency = params.value("concurrency", options.concurrency);
+            options.timeout_ms = params.value("timeoutMs", options.timeout_ms);
+            options.wait_until = params.value("waitUntil", options.wait_until);
+            options.profile = params.value("profile", options.profile);
+            options.format = params.value("format", options.format);
+            options.max_chars = params.value("maxChars", options.max_chars);
+            options.use_cache = params.value("cache", options.use_cache);
+            if (!options.profile.empty() && !pool.network_profile(options.profile)) {
+                co_return json{{"ok", false},
+                               {"error", "Unknown network profile: " + options.profile}};
+            }
+
+            // With "stream", each page is pushed to the caller as a
+            // browser.fetch event as soon as it completes and the response
+            // only carries the summary. Pages never go to other clients.
+            bool stream = params.value("stream", false);
+            if (stream && context.connection_id.empty()) {
+                co_return json{{"ok", false}, {"error", "Streaming needs a connection"}};
+            }
+            auto run_id = "fetch-" + utils::generate_id(12);
+            browser::PageFetcher::ResultCallback on_result;
+            if (stream) {
+                on_result = [&server, &pool, run_id,
+                             connection_id = context.connection_id](const browser::PageFetchResult& r) {
+                    json data = r;
+                    data["runId"] = run_id;
+                    boost::asio::post(pool.io_context(),
+                        [&server, connection_id, event = make_event("browser.fetch", std::move(data))] {
+                            if (auto connection = server.find_connection(connection_id)) {
+                                connection->post(event);
+                            }
+                        });
+                };
+            }
+
+            browser::PageFetcher fetcher(pool);
+            auto results = co_await fetcher.fetch_many(std::move(urls), options,
+                                                       std::move(on_result));
+            auto failed = std::count_if(results.begin(), results.end(),
+                                        [](const auto& r) { return !r.ok(); });
+
+            json response = {
+                {"ok", true},
+                {"runId", run_id},
+                {"count", results.size()},
+                {"failed", failed},
+            };
+            if (!stream) {
+                response["results"] = results;
+            }
+            co_return response;
+        },
+        "Fetch several URLs in parallel and extract their text", "browser");
+
+    // browser.network.stats
+    protocol.register_method("browser.network.stats",
+        [&pool](json params, RequestContext context) -> awaitable<json> {
+            auto id = params.value("sessionId", "");
+            auto session = id.empty() ? nullptr : pool.find(id, context.connection_id);
+            if (!session || !session->network) {
+                co_return json{{"ok", false}, {"error", "Unknown session: " + id}};
+            }
+            co_return json{
+                {"ok", true},
+                {"profile", session->network->profile().name},
+                {"stats", session->network->stats()},
+            };
+        },
+        "Get request blocking, bytes and page-load stats for a session", "browser");
+
     // browser.click
     protocol.register_method("browser.click",
         []([[maybe_unused]] json params) -> awaitable<json> {
@@ -147,6 +366,17 @@ void register_browser_handlers(Protocol& protocol,
         },
         "Set browser cookies", "browser");
 
+    // browser.pool.stats
+    protocol.register_method("browser.pool.stats",
+        [&pool]([[maybe_unused]] json params) -> awaitable<json> {
+            json response = {{"ok", true}, {"stats", pool.stats()}};
+            if (auto* cache = pool.page_cache()) {
+                response["pageCache"] = cache->stats();
+            }
+            co_return response;
+        },
+        "Browser pool occupancy, acquire-wait and launch metrics", "browser");
+
     LOG_INFO("Registered browser handlers");
 }
 
@@ -2,20 +2,17 @@
 
 #include <atomic>
 #include <chrono>
-#include <deque>
 #include <iomanip>
-#include <mutex>
 #include <sstream>
 
 #include <boost/asio/co_spawn.hpp>
 #include <boost/asio/detached.hpp>
-#include <boost/asio/post.hpp>
-#include <boost/asio/redirect_error.hpp>
-#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/this_coro.hpp>
 #include <boost/asio/use_awaitable.hpp>
 
 #include "openclaw/core/logger.hpp"
+#include "openclaw/gateway/provider_handler.hpp"
+#include "openclaw/gateway/stream_buffer.hpp"
 
 namespace openclaw::gateway {
 
@@ -42,65 +39,32 @@ auto generate_run_id() -> std::string {
     return "run-" + std::to_string(ms) + "-" + std::to_string(count);
 }
 
-/// Thread-safe chunk queue shared between the StreamCallback (background
-/// thread) and the consumer coroutine (asio thread).
-struct ChunkQueue {
-    std::mutex mtx;
-    std::deque<providers::CompletionChunk> chunks;
-    bool done = false;
-};
-
-/// Consumer coroutine: drains chunks from the queue and broadcasts each
-/// one in real-time over WebSocket. Runs on the asio thread.
-auto consume_chunks(std::shared_ptr<ChunkQueue> queue,
-                    std::shared_ptr<boost::asio::steady_timer> timer,
-                    std::string run_id,
-                    GatewayServer& server) -> awaitable<void> {
-    for (;;) {
-        // Wait for notification (timer cancel) from the producer.
-        boost::system::error_code ec;
-        co_await timer->async_wait(
-            boost::asio::redirect_error(boost::asio::use_awaitable, ec));
-
-        // Drain all available chunks.
-        std::deque<providers::CompletionChunk> batch;
-        bool finished = false;
-        {
-            std::lock_guard lock(queue->mtx);
-            batch.swap(queue->chunks);
-            finished = queue->done;
-        }
-
-        for (const auto& chunk : batch) {
-            if (chunk.type == "text") {
-                co_await server.broadcast(make_event("chat", json{
-                    {"runId", run_id},
-                    {"state", "delta"},
-                    {"stream", "assistant"},
-                    {"text", chunk.text},
-                }));
-            } else if (chunk.type == "tool_use") {
-                co_await server.broadcast(make_event("agent", json{
-                    {"runId", run_id},
-                    {"stream", "tool"},
-                    {"toolName", chunk.tool_name.value_or("")},
-                    {"toolInput", chunk.tool_input.value_or(json::object())},
-                }));
-            } else if (chunk.type == "thinking") {
-                co_await server.broadcast(make_event("agent", json{
-                    {"runId", run_id},
-                    {"stream", "thinking"},
-                    {"text", chunk.text},
-                }));
-            }
-        }
-
-        if (finished) {
-            co_return;
-        }
-
-        // Reset timer for next notification.
-        timer->expires_at(boost::asio::steady_timer::time_point::max());
+/// Fans one chunk of a run out to the connections. Text and thinking
+/// deltas go through broadcast_delta(), so each connection's StreamPolicy
+/// applies; a Pause connection holds the run's consumer, which leaves the
+/// buffer full and stalls the provider thread in turn.
+auto broadcast_chunk(GatewayServer& server, const std::string& run_id,
+                     const providers::CompletionChunk& chunk) -> awaitable<void> {
+    if (chunk.type == "text") {
+        co_await server.broadcast_delta(make_event("chat", json{
+            {"runId", run_id},
+            {"state", "delta"},
+            {"stream", "assistant"},
+            {"text", chunk.text},
+        }));
+    } else if (chunk.type == "tool_use") {
+        co_await server.broadcast(make_event("agent", json{
+            {"runId", run_id},
+            {"stream", "tool"},
+            {"toolName", chunk.tool_name.value_or("")},
+            {"toolInput", chunk.tool_input.value_or(json::object())},
+        }));
+    } else if (chunk.type == "thinking") {
+        co_await server.broadcast_delta(make_event("agent", json{
+            {"runId", run_id},
+            {"stream", "thinking"},
+            {"text", chunk.text},
+        }));
     }
 }
 
@@ -109,20 +73,9 @@ auto consume_chunks(std::shared_ptr<ChunkQueue> queue,
 auto run_chat_completion(std::string run_id,
                          std::string message_text,
                          GatewayServer& server,
-                         agent::AgentRuntime& runtime) -> awaitable<void> {
-    auto executor = co_await boost::asio::this_coro::executor;
-
-    // Set up thread-safe queue and timer for real-time streaming.
-    // Created outside try/catch so cleanup always happens.
-    auto queue = std::make_shared<ChunkQueue>();
-    auto timer = std::make_shared<boost::asio::steady_timer>(
-        executor, boost::asio::steady_timer::time_point::max());
-
-    // Spawn consumer coroutine that broadcasts chunks as they arrive.
-    auto consumer = boost::asio::co_spawn(executor,
-        consume_chunks(queue, timer, run_id, server),
-        boost::asio::use_awaitable);
-
+                         agent::AgentRuntime& runtime,
+                         providers::UsageLedger* usage,
+                         providers::UsageLabels labels) -> awaitable<void> {
     std::string error_msg;
     try {
         providers::CompletionRequest req;
@@ -149,32 +102,28 @@ auto run_chat_completion(std::string run_id,
         // Include tool definitions from the runtime's tool registry.
         req.tools = runtime.tool_registry().to_anthropic_json();
 
-        // StreamCallback: pushes each chunk to the queue and notifies
-        // the consumer. Runs on the background thread (from post_stream).
-        auto stream_cb = [queue, timer](const providers::CompletionChunk& chunk) {
-            {
-                std::lock_guard lock(queue->mtx);
-                queue->chunks.push_back(chunk);
-            }
-            // Post cancel to the timer's executor for thread safety.
-            boost::asio::post(timer->get_executor(),
-                              [timer] { timer->cancel(); });
-        };
-
-        auto result = co_await runtime.process_with_tools_stream(
-            std::move(req), stream_cb);
-
-        // Signal consumer that streaming is done, then wait for it.
-        {
-            std::lock_guard lock(queue->mtx);
-            queue->done = true;
-        }
-        timer->cancel();
-        co_await std::move(consumer);
+        // Chunks stream to the connections while the provider generates;
+        // every delta is out before the final event
+        auto result = co_await stream_run(
+            runtime.config().gateway.stream.run_buffer_bytes,
+            [&runtime, &req](providers::StreamCallback on_chunk) {
+                return runtime.process_with_tools_stream(std::move(req), std::move(on_chunk));
+            },
+            [&server, run_id](const providers::CompletionChunk& chunk) {
+                return broadcast_chunk(server, run_id, chunk);
+            });
 
         // Send final or error event.
         if (result.has_value()) {
             auto& resp = result.value();
+            if (usage) {
+                if (!resp.model.empty()) labels.model = resp.model;
+                usage->record(providers::UsageEvent{
+                    .labels = std::move(labels),
+                    .input_tokens = resp.input_tokens,
+                    .output_tokens = resp.output_tokens,
+                });
+            }
             std::string final_text;
             for (const auto& block : resp.message.content) {
                 if (block.type == "text") {
@@ -211,14 +160,7 @@ auto run_chat_completion(std::string run_id,
         error_msg = "Internal error (unknown)";
     }
 
-    // Exception path: shut down consumer and broadcast error.
-    {
-        std::lock_guard lock(queue->mtx);
-        queue->done = true;
-    }
-    timer->cancel();
-    co_await std::move(consumer);
-
+    // Exception path: stream_run() has already stopped the consumer
     co_await server.broadcast(make_event("chat", json{
         {"runId", run_id},
         {"state", "error"},
@@ -228,21 +170,38 @@ auto run_chat_completion(std::string run_id,
 
 /// Core chat handler: returns ack immediately, spawns streaming work.
 auto handle_chat_send(json params,
+                      RequestContext context,
                       GatewayServer& server,
                       [[maybe_unused]] sessions::SessionManager& sessions,
-                      agent::AgentRuntime& runtime) -> awaitable<json> {
+                      agent::AgentRuntime& runtime,
+                      providers::UsageLedger* usage) -> awaitable<json> {
     auto message_text = params.value("message", "");
     if (message_text.empty()) {
         co_return json{{"ok", false}, {"error", "message is required"}};
     }
 
+    std::string provider_name;
+    std::string model;
+    if (auto provider = runtime.provider(); provider) {
+        provider_name = provider->name();
+        if (auto models = provider->models(); !models.empty()) {
+            model = models.front();
+        }
+    }
+    auto labels = usage_labels(params, std::move(provider_name), std::move(model),
+                               usage_caller(server, context));
+    if (auto refusal = usage_budget_refusal(usage, labels)) {
+        co_return *refusal;
+    }
+
     auto run_id = generate_run_id();
     auto executor = co_await boost::asio::this_coro::executor;
 
     // Spawn the completion work as a detached coroutine so the ack
     // returns to the client immediately.
     boost::asio::co_spawn(executor,
-        run_chat_completion(run_id, std::move(message_text), server, runtime),
+        run_chat_completion(run_id, std::move(message_text), server, runtime,
+                            usage, std::move(labels)),
         boost::asio::detached);
 
     co_return json{{"runId", run_id}};
@@ -253,28 +212,32 @@ auto handle_chat_send(json params,
 void register_chat_handlers(Protocol& protocol,
                             GatewayServer& server,
                             sessions::SessionManager& sessions,
-                            agent::AgentRuntime& runtime) {
+                            agent::AgentRuntime& runtime,
+                            providers::UsageLedger* usage) {
     // chat.send — primary method called by bridge for every user message.
     protocol.register_method("chat.send",
-        [&server, &sessions, &runtime](json params) -> awaitable<json> {
+        [&server, &sessions, &runtime, usage](json params, RequestContext context)
+            -> awaitable<json> {
             co_return co_await handle_chat_send(
-                std::move(params), server, sessions, runtime);
+                std::move(params), std::move(context), server, sessions, runtime, usage);
         },
         "Send a chat message and receive streaming response", "chat");
 
     // agent.chat — alias for chat.send.
     protocol.register_method("agent.chat",
-        [&server, &sessions, &runtime](json params) -> awaitable<json> {
+        [&server, &sessions, &runtime, usage](json params, RequestContext context)
+            -> awaitable<json> {
             co_return co_await handle_chat_send(
-                std::move(params), server, sessions, runtime);
+                std::move(params), std::move(context), server, sessions, runtime, usage);
         },
         "Send a message to the agent and get a response", "agent");
 
     // agent.chat.stream — explicit streaming variant (same behavior).
     protocol.register_method("agent.chat.stream",
-        [&server, &sessions, &runtime](json params) -> awaitable<json> {
+        [&server, &sessions, &runtime, usage](json params, RequestContext context)
+            -> awaitable<json> {
             co_return co_await handle_chat_send(
-                std::move(params), server, sessions, runtime);
+                std::move(params), std::move(context), server, sessions, runtime, usage);
         },
         "Stream agent chat response", "agent");
 
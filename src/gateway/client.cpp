@@ -5,18 +5,35 @@
 
 #include <boost/asio/co_spawn.hpp>
 #include <boost/asio/detached.hpp>
+#include <boost/asio/experimental/awaitable_operators.hpp>
+#include <boost/asio/experimental/concurrent_channel.hpp>
 #include <boost/asio/steady_timer.hpp>
-#include <boost/asio/as_tuple.hpp>
 #include <boost/asio/use_awaitable.hpp>
 #include <boost/beast/core/buffers_to_string.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
 
+#include <optional>
+#include <variant>
+
 namespace openclaw::gateway {
 
 // ===========================================================================
 // GatewayClient
 // ===========================================================================
 
+/// One-shot completion: the read loop (or the writer, on failure) sends
+/// the result and the waiting coroutine resumes immediately.
+struct GatewayClient::PendingCall {
+    explicit PendingCall(net::io_context& ioc) : channel(ioc, 1) {}
+
+    net::experimental::concurrent_channel<void(boost::system::error_code, Result<json>)>
+        channel;
+
+    void complete(Result<json> result) {
+        channel.try_send(boost::system::error_code{}, std::move(result));
+    }
+};
+
 GatewayClient::GatewayClient(net::io_context& ioc)
     : ioc_(ioc) {}
 
@@ -34,6 +51,8 @@ GatewayClient::GatewayClient(GatewayClient&& other) noexcept
     , frame_callbacks_(std::move(other.frame_callbacks_))
     , state_callbacks_(std::move(other.state_callbacks_))
     , pending_calls_(std::move(other.pending_calls_))
+    , write_queue_(std::move(other.write_queue_))
+    , writing_(other.writing_)
     , connected_(other.connected_.load(std::memory_order_relaxed))
     , auto_reconnect_(other.auto_reconnect_)
     , reconnect_delay_ms_(other.reconnect_delay_ms_)
@@ -52,6 +71,8 @@ GatewayClient& GatewayClient::operator=(GatewayClient&& other) noexcept {
         frame_callbacks_ = std::move(other.frame_callbacks_);
         state_callbacks_ = std::move(other.state_callbacks_);
         pending_calls_ = std::move(other.pending_calls_);
+        write_queue_ = std::move(other.write_queue_);
+        writing_ = other.writing_;
         connected_.store(other.connected_.load(std::memory_order_relaxed),
                          std::memory_order_relaxed);
         other.connected_.store(false, std::memory_order_relaxed);
@@ -147,14 +168,17 @@ auto GatewayClient::connect(std::string_view host, std::string_view port,
 
 auto GatewayClient::disconnect() -> awaitable<void> {
     if (!connected_ || !ws_) co_return;
-    connected_ = false;
 
-    try {
-        co_await ws_->async_close(
-            websocket::close_code::normal, net::use_awaitable);
-    } catch (const boost::system::system_error& e) {
-        LOG_DEBUG("Client disconnect error (expected): {}", e.what());
-    }
+    // The close frame is a write too, so it goes through the writer
+    // rather than racing a write in flight.
+    auto closed = std::make_shared<PendingCall>(ioc_);
+    enqueue_write(Outgoing{
+        .text = {},
+        .call_id = {},
+        .written = closed,
+        .close = true,
+    });
+    co_await closed->channel.async_receive(net::use_awaitable);
 
     notify_state(false);
     LOG_INFO("Disconnected from gateway");
@@ -166,26 +190,40 @@ auto GatewayClient::send(const Frame& frame) -> awaitable<Result<void>> {
             make_error(ErrorCode::ConnectionClosed, "Not connected"));
     }
 
-    try {
-        auto text = serialize_frame(frame);
-        ws_->text(true);
-        co_await ws_->async_write(
-            net::buffer(text), net::use_awaitable);
-        co_return ok_result();
-    } catch (const boost::system::system_error& e) {
-        LOG_WARN("Client send error: {}", e.what());
-        co_return make_fail(
-            make_error(ErrorCode::IoError, "WebSocket write failed", e.what()));
+    auto written = std::make_shared<PendingCall>(ioc_);
+    enqueue_write(Outgoing{
+        .text = serialize_frame(frame),
+        .call_id = {},
+        .written = written,
+    });
+
+    auto result = co_await written->channel.async_receive(net::use_awaitable);
+    if (!result) {
+        co_return make_fail(result.error());
     }
+    co_return ok_result();
 }
 
 auto GatewayClient::call(std::string_view method, json params,
                           uint32_t timeout_ms)
     -> awaitable<Result<json>> {
+    co_return co_await call(method, std::move(params),
+                            std::chrono::steady_clock::now() +
+                                std::chrono::milliseconds(timeout_ms));
+}
+
+auto GatewayClient::call(std::string_view method, json params,
+                          Deadline deadline)
+    -> awaitable<Result<json>> {
     if (!connected_ || !ws_) {
         co_return make_fail(
             make_error(ErrorCode::ConnectionClosed, "Not connected"));
     }
+    if (std::chrono::steady_clock::now() >= deadline) {
+        co_return make_fail(
+            make_error(ErrorCode::Timeout,
+                       "RPC deadline already passed: " + std::string(method)));
+    }
 
     auto request_id = utils::generate_id(16);
 
@@ -196,65 +234,143 @@ auto GatewayClient::call(std::string_view method, json params,
         .params = std::move(params),
     };
 
-    // Set up a promise/future mechanism using a timer + callback.
-    struct CallState {
-        std::optional<Result<json>> result;
-        bool completed = false;
-    };
-    auto state = std::make_shared<CallState>();
-
-    // Register the pending call.
-    pending_calls_[request_id] = PendingCall{
-        .resolver = [state](Result<json> r) {
-            state->result = std::move(r);
-            state->completed = true;
-        },
-    };
+    // Register before writing so a fast response cannot be missed.
+    auto pending = std::make_shared<PendingCall>(ioc_);
+    {
+        std::lock_guard lock(mutex_);
+        pending_calls_.emplace(request_id, pending);
+    }
+    enqueue_write(Outgoing{
+        .text = serialize_frame(Frame{std::move(req)}),
+        .call_id = request_id,
+        .written = nullptr,
+    });
+
+    // Wait for the response or the deadline, whichever comes first.
+    using namespace net::experimental::awaitable_operators;
+    net::steady_timer timer(ioc_, deadline);
+    std::variant<Result<json>, std::monostate> outcome;
+    try {
+        outcome = co_await (
+            pending->channel.async_receive(net::use_awaitable) ||
+            timer.async_wait(net::use_awaitable));
+    } catch (const boost::system::system_error&) {
+        // Cancelled by the caller; a late response is simply dropped.
+        std::lock_guard lock(mutex_);
+        pending_calls_.erase(request_id);
+        throw;
+    }
 
-    // Send the request.
-    auto send_result = co_await send(Frame{req});
-    if (!send_result) {
+    if (outcome.index() != 0) {
+        std::lock_guard lock(mutex_);
         pending_calls_.erase(request_id);
-        co_return make_fail(send_result.error());
+        co_return make_fail(
+            make_error(ErrorCode::Timeout,
+                       "RPC call timed out: " + std::string(method)));
     }
+    co_return std::move(std::get<0>(outcome));
+}
+
+auto GatewayClient::pending_calls() const -> size_t {
+    std::lock_guard lock(mutex_);
+    return pending_calls_.size();
+}
 
-    // Wait for the response with timeout.
-    net::steady_timer timer(ioc_);
-    timer.expires_after(std::chrono::milliseconds(timeout_ms));
-
-    // Poll until completed or timeout.
-    while (!state->completed) {
-        timer.expires_after(std::chrono::milliseconds(10));
-        auto [ec] = co_await timer.async_wait(
-            net::as_tuple(net::use_awaitable));
-
-        if (!connected_) {
-            pending_calls_.erase(request_id);
-            co_return make_fail(
-                make_error(ErrorCode::ConnectionClosed,
-                           "Connection lost while waiting for response"));
+void GatewayClient::enqueue_write(Outgoing outgoing) {
+    std::lock_guard lock(mutex_);
+    write_queue_.push_back(std::move(outgoing));
+    if (!writing_) {
+        writing_ = true;
+        boost::asio::co_spawn(ioc_, write_loop(), boost::asio::detached);
+    }
+}
+
+auto GatewayClient::write_loop() -> awaitable<void> {
+    // The only writer: beast allows one outstanding write per stream, so
+    // concurrent send() and call() requests are queued here in order.
+    for (;;) {
+        Outgoing next;
+        {
+            std::lock_guard lock(mutex_);
+            if (write_queue_.empty()) {
+                writing_ = false;
+                co_return;
+            }
+            next = std::move(write_queue_.front());
+            write_queue_.pop_front();
         }
 
-        // Check timeout: if we've been waiting too long.
-        // Simple approach: decrement remaining time.
-        // A production implementation would use a proper deadline timer.
-        timeout_ms -= 10;
-        if (timeout_ms == 0) {
-            pending_calls_.erase(request_id);
-            co_return make_fail(
-                make_error(ErrorCode::Timeout,
-                           "RPC call timed out: " + std::string(method)));
+        std::optional<Error> error;
+        if (!connected_ || !ws_) {
+            error = make_error(ErrorCode::ConnectionClosed, "Not connected");
+        } else if (next.close) {
+            // Refuse new writes; anything queued behind the close fails below
+            connected_ = false;
+            try {
+                co_await ws_->async_close(
+                    websocket::close_code::normal, net::use_awaitable);
+            } catch (const boost::system::system_error& e) {
+                LOG_DEBUG("Client disconnect error (expected): {}", e.what());
+            }
+        } else {
+            try {
+                ws_->text(true);
+                co_await ws_->async_write(net::buffer(next.text), net::use_awaitable);
+            } catch (const boost::system::system_error& e) {
+                LOG_WARN("Client send error: {}", e.what());
+                error = make_error(ErrorCode::IoError, "WebSocket write failed", e.what());
+            }
         }
-    }
 
-    pending_calls_.erase(request_id);
+        if (!error) {
+            if (next.written) {
+                next.written->complete(json{});
+            }
+            continue;
+        }
 
-    if (state->result) {
-        co_return std::move(*state->result);
+        // Nothing queued behind a failed write can go out either.
+        std::deque<Outgoing> unsent;
+        {
+            std::lock_guard lock(mutex_);
+            unsent.swap(write_queue_);
+            writing_ = false;
+        }
+        unsent.push_front(std::move(next));
+        for (auto& outgoing : unsent) {
+            if (outgoing.written) {
+                outgoing.written->complete(std::unexpected(*error));
+            } else {
+                resolve(outgoing.call_id, std::unexpected(*error));
+            }
+        }
+        co_return;
     }
+}
 
-    co_return make_fail(
-        make_error(ErrorCode::InternalError, "No result received"));
+void GatewayClient::resolve(const std::string& id, Result<json> result) {
+    std::shared_ptr<PendingCall> pending;
+    {
+        std::lock_guard lock(mutex_);
+        auto it = pending_calls_.find(id);
+        if (it == pending_calls_.end()) {
+            return;  // Timed out or cancelled already
+        }
+        pending = std::move(it->second);
+        pending_calls_.erase(it);
+    }
+    pending->complete(std::move(result));
+}
+
+void GatewayClient::fail_pending(const Error& error) {
+    std::unordered_map<std::string, std::shared_ptr<PendingCall>> pending;
+    {
+        std::lock_guard lock(mutex_);
+        pending.swap(pending_calls_);
+    }
+    for (auto& [id, call] : pending) {
+        call->complete(std::unexpected(error));
+    }
 }
 
 void GatewayClient::on_frame(FrameCallback cb) {
@@ -298,20 +414,16 @@ auto GatewayClient::read_loop() -> awaitable<void> {
                 continue;
             }
 
-            // If this is a response, check for pending calls.
+            // If this is a response, wake the call waiting for it.
             if (auto* resp = std::get_if<ResponseFrame>(&*frame_result)) {
-                auto it = pending_calls_.find(resp->id);
-                if (it != pending_calls_.end()) {
-                    if (resp->is_error()) {
-                        auto msg = resp->error->value("message", "RPC error");
-                        auto code_val = resp->error->value("code",
-                            static_cast<int>(ErrorCode::InternalError));
-                        it->second.resolver(std::unexpected(
-                            make_error(static_cast<ErrorCode>(code_val), msg)));
-                    } else {
-                        it->second.resolver(resp->result.value_or(json::object()));
-                    }
-                    // Don't erase here; the caller will erase.
+                if (resp->is_error()) {
+                    auto msg = resp->error->value("message", "RPC error");
+                    auto code_val = resp->error->value("code",
+                        static_cast<int>(ErrorCode::InternalError));
+                    resolve(resp->id, std::unexpected(
+                        make_error(static_cast<ErrorCode>(code_val), msg)));
+                } else {
+                    resolve(resp->id, resp->result.value_or(json::object()));
                 }
             }
 
@@ -331,12 +443,8 @@ auto GatewayClient::read_loop() -> awaitable<void> {
     notify_state(false);
 
     // Resolve any pending calls with connection error.
-    for (auto& [id, pending] : pending_calls_) {
-        pending.resolver(std::unexpected(
-            make_error(ErrorCode::ConnectionClosed,
-                       "Connection closed while waiting for response")));
-    }
-    pending_calls_.clear();
+    fail_pending(make_error(ErrorCode::ConnectionClosed,
+                            "Connection closed while waiting for response"));
 
     // Auto-reconnect if enabled.
     if (auto_reconnect_) {
@@ -1,14 +1,28 @@
 #include "openclaw/gateway/config_handler.hpp"
 
+#include <array>
+#include <cerrno>
+#include <cstring>
 #include <fstream>
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
 #include <boost/asio/use_awaitable.hpp>
 #include <openssl/sha.h>
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
 #include "openclaw/core/logger.hpp"
 
 namespace openclaw::gateway {
 
+namespace net = boost::asio;
 using json = nlohmann::json;
 using boost::asio::awaitable;
 
@@ -16,91 +30,257 @@ using boost::asio::awaitable;
 // RuntimeConfig
 // ---------------------------------------------------------------------------
 
+auto ConfigSnapshot::find(std::string_view path) const -> const json* {
+    const json* current = &document;
+    size_t pos = 0;
+
+    while (pos < path.size()) {
+        auto dot = path.find('.', pos);
+        auto segment = std::string(path.substr(pos, dot - pos));
+        pos = (dot == std::string_view::npos) ? path.size() : dot + 1;
+
+        if (!current->is_object() || !current->contains(segment)) {
+            return nullptr;
+        }
+
+        current = &(*current).at(segment);
+    }
+
+    return current;
+}
+
 RuntimeConfig::RuntimeConfig(const Config& initial_config)
-    : config_(initial_config)
-    , default_config_(initial_config) {}
-
-auto RuntimeConfig::get(std::string_view path) const -> json {
-    std::lock_guard lock(mutex_);
-    auto* node = navigate(config_, path);
-    if (!node) return json(nullptr);
-    return *node;
+    : default_config_(initial_config) {
+    json document = default_config_;
+    auto hash = compute_hash(document);
+    current_.store(std::make_shared<const ConfigSnapshot>(ConfigSnapshot{
+        .document = std::move(document),
+        .version = 1,
+        .hash = std::move(hash),
+    }));
+}
+
+RuntimeConfig::~RuntimeConfig() {
+    {
+        std::lock_guard lock(persist_mutex_);
+        stopping_ = true;
+    }
+    persist_cv_.notify_all();
+    if (persist_thread_.joinable()) {
+        persist_thread_.join();
+    }
+}
+
+auto RuntimeConfig::snapshot() const -> std::shared_ptr<const ConfigSnapshot> {
+    return current_.load(std::memory_order_acquire);
+}
+
+auto RuntimeConfig::get(std::string_view path) const -> std::shared_ptr<const json> {
+    auto current = snapshot();
+    const auto* node = current->find(path);
+    if (!node) return nullptr;
+    return std::shared_ptr<const json>(std::move(current), node);
 }
 
 void RuntimeConfig::set(std::string_view path, const json& value) {
-    std::lock_guard lock(mutex_);
-    auto* node = navigate(config_, path, /*create=*/true);
+    std::lock_guard lock(write_mutex_);
+    auto next = snapshot()->document;
+    auto* node = navigate(next, path, /*create=*/true);
     if (node) {
         *node = value;
-        persist();
+        publish(std::move(next), /*persist=*/true);
     }
 }
 
 auto RuntimeConfig::patch(
     const std::vector<std::pair<std::string, json>>& patches,
     const std::string& base_hash) -> bool {
-    std::lock_guard lock(mutex_);
+    std::lock_guard lock(write_mutex_);
+    auto current = snapshot();
 
     // Optimistic concurrency check.
-    if (!base_hash.empty() && compute_hash(config_) != base_hash) {
+    if (!base_hash.empty() && current->hash != base_hash) {
         return false;
     }
 
+    auto next = current->document;
     for (const auto& [path, value] : patches) {
-        auto* node = navigate(config_, path, /*create=*/true);
+        auto* node = navigate(next, path, /*create=*/true);
         if (node) {
             *node = value;
         }
     }
 
-    persist();
+    publish(std::move(next), /*persist=*/true);
     return true;
 }
 
 auto RuntimeConfig::hash() const -> std::string {
-    std::lock_guard lock(mutex_);
-    return compute_hash(config_);
-}
-
-auto RuntimeConfig::to_json() const -> json {
-    std::lock_guard lock(mutex_);
-    return config_;
+    return snapshot()->hash;
 }
 
 void RuntimeConfig::reset() {
-    std::lock_guard lock(mutex_);
-    config_ = default_config_;
-    persist();
+    std::lock_guard lock(write_mutex_);
+    publish(default_config_, /*persist=*/true);
 }
 
-void RuntimeConfig::set_persist_path(const std::filesystem::path& path) {
-    std::lock_guard lock(mutex_);
+void RuntimeConfig::set_persist_path(const std::filesystem::path& path,
+                                     std::chrono::milliseconds debounce) {
+    std::lock_guard lock(persist_mutex_);
     persist_path_ = path;
+    debounce_ = debounce;
+    if (!persist_thread_.joinable()) {
+        persist_thread_ = std::thread([this] { persist_loop(); });
+    }
+}
+
+auto RuntimeConfig::persist_path() const -> std::filesystem::path {
+    std::lock_guard lock(persist_mutex_);
+    return persist_path_;
+}
+
+void RuntimeConfig::flush() {
+    std::unique_lock lock(persist_mutex_);
+    if (!persist_thread_.joinable()) return;
+    flush_requested_ = true;
+    persist_cv_.notify_all();
+    persist_cv_.wait(lock, [this] { return !dirty_ && !writing_; });
+    flush_requested_ = false;
+}
+
+auto RuntimeConfig::reload(const std::filesystem::path& path) -> Result<bool> {
+    json document;
+    try {
+        std::ifstream in(path);
+        if (!in.is_open()) {
+            return std::unexpected(make_error(
+                ErrorCode::IoError, "Cannot open config file", path.string()));
+        }
+        document = json::parse(in);
+    } catch (const json::exception& e) {
+        return std::unexpected(make_error(
+            ErrorCode::InvalidConfig, "Config file is not valid JSON", e.what()));
+    }
+    if (!document.is_object()) {
+        return std::unexpected(make_error(
+            ErrorCode::InvalidConfig, "Config file must hold a JSON object", path.string()));
+    }
+
+    auto hash = compute_hash(document);
+    {
+        std::lock_guard lock(persist_mutex_);
+        if (hash == written_hash_) {
+            return false;  // Our own write
+        }
+    }
+    std::lock_guard lock(write_mutex_);
+    if (hash == snapshot()->hash) {
+        return false;
+    }
+    publish(std::move(document), /*persist=*/false);
+    return true;
 }
 
 auto RuntimeConfig::list_keys() const -> std::vector<std::string> {
-    std::lock_guard lock(mutex_);
+    auto current = snapshot();
     std::vector<std::string> keys;
-    if (config_.is_object()) {
-        for (auto it = config_.begin(); it != config_.end(); ++it) {
+    if (current->document.is_object()) {
+        for (auto it = current->document.begin(); it != current->document.end(); ++it) {
             keys.push_back(it.key());
         }
     }
     return keys;
 }
 
-void RuntimeConfig::persist() const {
-    if (persist_path_.empty()) return;
-    try {
-        std::ofstream ofs(persist_path_);
-        if (ofs.is_open()) {
-            ofs << config_.dump(2);
+void RuntimeConfig::on_change(ChangeHandler handler) {
+    std::lock_guard lock(write_mutex_);
+    change_handlers_.push_back(std::move(handler));
+}
+
+void RuntimeConfig::publish(json document, bool persist) {
+    // Caller holds write_mutex_
+    auto hash = compute_hash(document);
+    auto next = std::make_shared<const ConfigSnapshot>(ConfigSnapshot{
+        .document = std::move(document),
+        .version = snapshot()->version + 1,
+        .hash = std::move(hash),
+    });
+    current_.store(next, std::memory_order_release);
+    for (const auto& handler : change_handlers_) {
+        handler(*next);
+    }
+
+    if (persist) {
+        std::lock_guard lock(persist_mutex_);
+        if (!persist_path_.empty()) {
+            dirty_ = std::move(next);
+            persist_cv_.notify_all();
         }
-    } catch (const std::exception& e) {
-        LOG_WARN("Failed to persist config: {}", e.what());
     }
 }
 
+void RuntimeConfig::persist_loop() {
+    std::unique_lock lock(persist_mutex_);
+    for (;;) {
+        persist_cv_.wait(lock, [this] { return dirty_ || stopping_; });
+        if (!dirty_) {
+            break;
+        }
+
+        // Let a burst of writes settle into one file write
+        persist_cv_.wait_for(lock, debounce_, [this] { return stopping_ || flush_requested_; });
+
+        auto pending = std::exchange(dirty_, nullptr);
+        auto path = persist_path_;
+        writing_ = true;
+        lock.unlock();
+        auto written = write_file(path, *pending);
+        lock.lock();
+        writing_ = false;
+        if (written) {
+            written_hash_ = pending->hash;
+        } else {
+            LOG_WARN("Failed to persist config: {}", written.error().what());
+        }
+        persist_cv_.notify_all();
+    }
+}
+
+auto RuntimeConfig::write_file(const std::filesystem::path& path,
+                               const ConfigSnapshot& snapshot) -> Result<void> {
+    auto tmp_path = std::filesystem::path(path.string() + ".tmp");
+    auto data = snapshot.document.dump(2);
+
+    int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return std::unexpected(make_error(
+            ErrorCode::IoError, "Failed to open temp config file",
+            tmp_path.string() + ": " + std::strerror(errno)));
+    }
+    size_t offset = 0;
+    while (offset < data.size()) {
+        auto n = ::write(fd, data.data() + offset, data.size() - offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            auto err = std::string(std::strerror(errno));
+            ::close(fd);
+            ::unlink(tmp_path.c_str());
+            return std::unexpected(make_error(
+                ErrorCode::IoError, "Failed to write config", err));
+        }
+        offset += static_cast<size_t>(n);
+    }
+    // Readers of `path` see either the old file or the complete new one
+    if (::fsync(fd) != 0 || ::close(fd) != 0 ||
+        ::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        auto err = std::string(std::strerror(errno));
+        ::unlink(tmp_path.c_str());
+        return std::unexpected(make_error(
+            ErrorCode::IoError, "Failed to replace config file", err));
+    }
+    return {};
+}
+
 auto RuntimeConfig::navigate(json& root, std::string_view path, bool create)
     -> json* {
     json* current = &root;
@@ -133,26 +313,6 @@ auto RuntimeConfig::navigate(json& root, std::string_view path, bool create)
     return current;
 }
 
-auto RuntimeConfig::navigate(const json& root, std::string_view path)
-    -> const json* {
-    const json* current = &root;
-    size_t pos = 0;
-
-    while (pos < path.size()) {
-        auto dot = path.find('.', pos);
-        auto segment = std::string(path.substr(pos, dot - pos));
-        pos = (dot == std::string_view::npos) ? path.size() : dot + 1;
-
-        if (!current->is_object() || !current->contains(segment)) {
-            return nullptr;
-        }
-
-        current = &(*current).at(segment);
-    }
-
-    return current;
-}
-
 auto RuntimeConfig::compute_hash(const json& j) -> std::string {
     auto serialized = j.dump();
     unsigned char hash[SHA256_DIGEST_LENGTH];
@@ -169,6 +329,120 @@ auto RuntimeConfig::compute_hash(const json& j) -> std::string {
     return hex;
 }
 
+// ---------------------------------------------------------------------------
+// ConfigWatcher
+// ---------------------------------------------------------------------------
+
+ConfigWatcher::ConfigWatcher(net::io_context& ioc, RuntimeConfig& config,
+                             std::filesystem::path path,
+                             std::chrono::milliseconds debounce)
+    : ioc_(ioc)
+    , config_(config)
+    , path_(std::move(path))
+    , debounce_(debounce)
+    , stream_(ioc)
+    , timer_(ioc, net::steady_timer::time_point::max()) {}
+
+ConfigWatcher::~ConfigWatcher() {
+    stop();
+}
+
+auto ConfigWatcher::start() -> Result<void> {
+#ifdef __linux__
+    if (running_) {
+        return {};
+    }
+    int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        return std::unexpected(make_error(
+            ErrorCode::IoError, "inotify_init1 failed", std::strerror(errno)));
+    }
+    // Watch the directory: editors and our own persist replace the file
+    // by rename, which a watch on the file itself would not survive
+    auto dir = path_.parent_path().empty() ? std::filesystem::path(".") : path_.parent_path();
+    if (::inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_ONLYDIR) < 0) {
+        auto err = std::string(std::strerror(errno));
+        ::close(fd);
+        return std::unexpected(make_error(
+            ErrorCode::IoError, "Cannot watch config directory",
+            dir.string() + ": " + err));
+    }
+    stream_.assign(fd);
+    running_ = true;
+
+    net::co_spawn(ioc_, read_loop(), net::detached);
+    net::co_spawn(ioc_, debounce_loop(), net::detached);
+    LOG_INFO("Watching {} for config changes", path_.string());
+    return {};
+#else
+    return std::unexpected(make_error(
+        ErrorCode::InvalidConfig, "Config watching requires inotify (Linux)",
+        path_.string()));
+#endif
+}
+
+void ConfigWatcher::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    boost::system::error_code ec;
+    stream_.close(ec);
+    timer_.cancel();
+}
+
+auto ConfigWatcher::read_loop() -> awaitable<void> {
+#ifdef __linux__
+    alignas(inotify_event) std::array<char, 4096> buffer;
+    auto name = path_.filename().string();
+    while (running_) {
+        boost::system::error_code ec;
+        auto n = co_await stream_.async_read_some(
+            net::buffer(buffer), net::redirect_error(net::use_awaitable, ec));
+        if (ec) {
+            if (running_) {
+                LOG_ERROR("Config watcher read failed: {}", ec.message());
+            }
+            co_return;
+        }
+
+        bool changed = false;
+        for (size_t offset = 0; offset < n;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+            offset += sizeof(inotify_event) + event->len;
+            changed = changed || (event->len > 0 && name == event->name);
+        }
+        if (changed) {
+            // Re-arming cancels the pending wait, restarting the quiet period
+            timer_.expires_after(debounce_);
+        }
+    }
+#endif
+    co_return;
+}
+
+auto ConfigWatcher::debounce_loop() -> awaitable<void> {
+    while (running_) {
+        boost::system::error_code ec;
+        co_await timer_.async_wait(net::redirect_error(net::use_awaitable, ec));
+        if (!running_) {
+            co_return;
+        }
+        if (ec == net::error::operation_aborted) {
+            continue;
+        }
+        timer_.expires_at(net::steady_timer::time_point::max());
+
+        auto reloaded = config_.reload(path_);
+        if (!reloaded) {
+            LOG_WARN("Ignoring edit to {}: {}", path_.string(), reloaded.error().what());
+        } else if (*reloaded) {
+            LOG_INFO("Reloaded config from {} (version {})",
+                     path_.string(), config_.snapshot()->version);
+        }
+    }
+}
+
 // ---------------------------------------------------------------------------
 // Handler registration
 // ---------------------------------------------------------------------------
@@ -182,9 +456,14 @@ void register_config_handlers(Protocol& protocol,
             if (path.empty()) {
                 co_return json{{"ok", false}, {"error", "path is required"}};
             }
-            auto value = runtime_config.get(path);
-            auto hash = runtime_config.hash();
-            co_return json{{"value", value}, {"hash", hash}};
+            // Value and hash from the same version
+            auto snapshot = runtime_config.snapshot();
+            const auto* value = snapshot->find(path);
+            co_return json{
+                {"value", value ? *value : json(nullptr)},
+                {"hash", snapshot->hash},
+                {"version", snapshot->version},
+            };
         },
         "Get configuration value by key", "config");
 
@@ -244,7 +523,7 @@ void register_config_handlers(Protocol& protocol,
     // config.export
     protocol.register_method("config.export",
         [&runtime_config](json /*params*/) -> awaitable<json> {
-            co_return runtime_config.to_json();
+            co_return runtime_config.snapshot()->document;
         },
         "Export full configuration as JSON", "config");
 
@@ -255,10 +534,12 @@ void register_config_handlers(Protocol& protocol,
             if (!config_data.is_object()) {
                 co_return json{{"ok", false}, {"error", "config must be a JSON object"}};
             }
-            // Apply all top-level keys from the imported config.
+            // Apply all top-level keys from the imported config as one version.
+            std::vector<std::pair<std::string, json>> patches;
             for (auto it = config_data.begin(); it != config_data.end(); ++it) {
-                runtime_config.set(it.key(), it.value());
+                patches.emplace_back(it.key(), it.value());
             }
+            runtime_config.patch(patches, "");
             co_return json{{"ok", true}};
         },
         "Import configuration from JSON", "config");
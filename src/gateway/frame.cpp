@@ -173,4 +173,39 @@ auto make_event(std::string event, json data) -> EventFrame {
     };
 }
 
+// -- Binary payloads --
+
+namespace {
+
+void detach_binary_into(json& value, std::vector<json::binary_t>& out) {
+    if (value.is_binary()) {
+        auto size = value.get_binary().size();
+        out.push_back(std::move(value.get_binary()));
+        value = json{{"$binary", {{"index", out.size() - 1}, {"size", size}}}};
+    } else if (value.is_structured()) {
+        for (auto& child : value) {
+            detach_binary_into(child, out);
+        }
+    }
+}
+
+} // anonymous namespace
+
+auto detach_binary(json& payload) -> std::vector<json::binary_t> {
+    std::vector<json::binary_t> out;
+    detach_binary_into(payload, out);
+    return out;
+}
+
+auto make_binary_frame(std::string_view request_id, size_t index,
+                       const json::binary_t& bytes) -> std::string {
+    auto header = json{{"id", std::string(request_id)}, {"index", index}}.dump();
+    std::string frame;
+    frame.reserve(header.size() + 1 + bytes.size());
+    frame += header;
+    frame += '\n';
+    frame.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    return frame;
+}
+
 } // namespace openclaw::gateway
@@ -1,13 +1,14 @@
 #include "openclaw/gateway/gateway_handler.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
-#include <deque>
-#include <mutex>
+#include <vector>
 
 #include <boost/asio/use_awaitable.hpp>
 
 #include "openclaw/core/logger.hpp"
+#include "openclaw/gateway/log_tail.hpp"
 
 #ifndef OPENCLAW_VERSION_STRING
 #define OPENCLAW_VERSION_STRING "2026.2.25"
@@ -28,40 +29,7 @@ struct Metrics {
         std::chrono::steady_clock::now();
 };
 
-/// Ring buffer for recent log entries.
-struct LogBuffer {
-    static constexpr size_t MAX_ENTRIES = 1000;
-    std::mutex mutex;
-    std::deque<json> entries;
-
-    void add(const std::string& level, const std::string& message) {
-        std::lock_guard lock(mutex);
-        auto now = std::chrono::system_clock::now();
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()).count();
-        entries.push_back(json{
-            {"timestamp", ms},
-            {"level", level},
-            {"message", message},
-        });
-        while (entries.size() > MAX_ENTRIES) {
-            entries.pop_front();
-        }
-    }
-
-    auto recent(size_t n) -> json {
-        std::lock_guard lock(mutex);
-        json result = json::array();
-        size_t start = entries.size() > n ? entries.size() - n : 0;
-        for (size_t i = start; i < entries.size(); ++i) {
-            result.push_back(entries[i]);
-        }
-        return result;
-    }
-};
-
 static Metrics g_metrics;
-static LogBuffer g_logs;
 
 } // anonymous namespace
 
@@ -174,6 +142,7 @@ void register_gateway_handlers(Protocol& protocol, GatewayServer& server) {
                 {"total_requests", g_metrics.total_requests.load()},
                 {"total_errors", g_metrics.total_errors.load()},
                 {"connection_count", server.connection_count()},
+                {"streams", server.stream_stats()},
             };
         },
         "Return gateway metrics", "gateway");
@@ -181,11 +150,51 @@ void register_gateway_handlers(Protocol& protocol, GatewayServer& server) {
     // gateway.logs
     protocol.register_method("gateway.logs",
         []([[maybe_unused]] json params) -> awaitable<json> {
-            size_t limit = params.value("limit", 100);
-            co_return json{{"logs", g_logs.recent(limit)}};
+            size_t limit = std::min<size_t>(params.value("limit", 100), 1000);
+            // Without a cursor, return the newest `limit` records.
+            auto head = Logger::position();
+            uint64_t since = params.value("since", head - std::min<uint64_t>(head, limit));
+
+            std::vector<LogRecord> records;
+            auto next = Logger::read(since, limit, records);
+            auto stats = Logger::stats();
+            co_return json{
+                {"logs", records},
+                {"cursor", next},
+                {"dropped", stats.dropped + stats.lost},
+                {"suppressed", stats.suppressed},
+            };
         },
         "Stream or query recent gateway logs", "gateway");
 
+    // gateway.logs.subscribe / gateway.logs.unsubscribe
+    auto tail = std::make_shared<LogTail>(server);
+    protocol.register_method("gateway.logs.subscribe",
+        [tail](json params, RequestContext context) -> awaitable<json> {
+            if (context.connection_id.empty()) {
+                co_return json{{"ok", false}, {"error", "Log tails need a connection"}};
+            }
+            auto filter = LogFilter::parse(params);
+            if (!filter) {
+                co_return json{{"ok", false}, {"error", filter.error().what()}};
+            }
+            LogTail::Options options;
+            options.interval = std::chrono::milliseconds(
+                std::clamp(params.value("interval_ms", 1000), 100, 60000));
+            options.max_buffered = std::clamp<size_t>(
+                params.value("max_buffered", size_t{500}), 1, 5000);
+            auto id = co_await tail->subscribe(context.connection_id, std::move(*filter), options);
+            co_return json{{"ok", true}, {"subscription", id}};
+        },
+        "Stream new log records matching a filter as gateway.logs events", "gateway");
+
+    protocol.register_method("gateway.logs.unsubscribe",
+        [tail](json params, RequestContext context) -> awaitable<json> {
+            auto id = params.value("subscription", "");
+            co_return json{{"ok", tail->unsubscribe(id, context.connection_id)}};
+        },
+        "Stop a log tail started by gateway.logs.subscribe", "gateway");
+
     LOG_INFO("Registered gateway handlers");
 }
 
@@ -0,0 +1,265 @@
+#include "openclaw/gateway/log_tail.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include "openclaw/core/utils.hpp"
+#include "openclaw/gateway/server.hpp"
+
+namespace openclaw::gateway {
+
+namespace {
+
+/// How often the pump reads the ring; bounds the latency of a tail.
+constexpr auto kPumpInterval = std::chrono::milliseconds(100);
+constexpr size_t kMaxPatternLength = 256;
+
+auto invalid(std::string message) -> Result<LogFilter> {
+    return std::unexpected(make_error(ErrorCode::InvalidArgument, std::move(message)));
+}
+
+/// Whether `segment`, in which '?' matches any character, occurs in
+/// `text` at `pos`.
+auto segment_at(std::string_view text, size_t pos, std::string_view segment) -> bool {
+    for (size_t i = 0; i < segment.size(); ++i) {
+        if (segment[i] != '?' && segment[i] != text[pos + i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Searches `text` for the glob `pattern`. Each '*'-separated segment is
+/// taken at its leftmost match after the previous one, which is exact for
+/// an unanchored glob and never backtracks.
+auto glob_search(std::string_view text, std::string_view pattern) -> bool {
+    size_t pos = 0;
+    while (true) {
+        auto star = pattern.find('*');
+        auto segment = pattern.substr(0, star);
+        if (!segment.empty()) {
+            while (pos + segment.size() <= text.size() && !segment_at(text, pos, segment)) {
+                ++pos;
+            }
+            if (pos + segment.size() > text.size()) {
+                return false;
+            }
+            pos += segment.size();
+        }
+        if (star == std::string_view::npos) {
+            return true;
+        }
+        pattern.remove_prefix(star + 1);
+    }
+}
+
+} // anonymous namespace
+
+auto LogFilter::parse(const json& params) -> Result<LogFilter> {
+    LogFilter filter;
+
+    if (params.contains("level")) {
+        if (!params["level"].is_string()) {
+            return invalid("level must be a string");
+        }
+        auto name = params["level"].get<std::string>();
+        filter.level = spdlog::level::from_str(name);
+        if (filter.level == spdlog::level::off && name != "off") {
+            return invalid("Unknown level: " + name);
+        }
+    }
+
+    if (params.contains("category")) {
+        const auto& category = params["category"];
+        if (category.is_string()) {
+            filter.categories.push_back(category.get<std::string>());
+        } else if (category.is_array()) {
+            for (const auto& c : category) {
+                if (!c.is_string()) {
+                    return invalid("category must be a string or an array of strings");
+                }
+                filter.categories.push_back(c.get<std::string>());
+            }
+        } else {
+            return invalid("category must be a string or an array of strings");
+        }
+    }
+
+    for (const char* key : {"session", "run", "contains"}) {
+        if (!params.contains(key)) {
+            continue;
+        }
+        if (!params[key].is_string() || params[key].get_ref<const std::string&>().empty()) {
+            return invalid(std::string(key) + " must be a non-empty string");
+        }
+        filter.needles.push_back(params[key].get<std::string>());
+    }
+
+    if (params.contains("regex")) {
+        return invalid("regex is not supported; use pattern, a glob with * and ?");
+    }
+    if (params.contains("pattern")) {
+        if (!params["pattern"].is_string()) {
+            return invalid("pattern must be a string");
+        }
+        filter.pattern = params["pattern"].get<std::string>();
+        if (filter.pattern.size() > kMaxPatternLength) {
+            return invalid("pattern is too long");
+        }
+    }
+
+    if (params.contains("sample")) {
+        if (!params["sample"].is_number()) {
+            return invalid("sample must be a number");
+        }
+        auto rate = params["sample"].get<double>();
+        if (!(rate > 0.0 && rate <= 1.0)) {
+            return invalid("sample must be in (0, 1]");
+        }
+        filter.sample_every = static_cast<uint32_t>(std::lround(1.0 / rate));
+    }
+
+    return filter;
+}
+
+auto LogFilter::matches(const LogRecord& record) const -> bool {
+    if (record.level < level) {
+        return false;
+    }
+    if (!categories.empty() &&
+        std::find(categories.begin(), categories.end(), record.category) == categories.end()) {
+        return false;
+    }
+    auto text = record.text();
+    for (const auto& needle : needles) {
+        if (text.find(needle) == std::string_view::npos) {
+            return false;
+        }
+    }
+    return pattern.empty() || glob_search(text, pattern);
+}
+
+LogTail::LogTail(GatewayServer& server)
+    : server_(server) {}
+
+auto LogTail::subscribe(std::string connection_id, LogFilter filter, Options options)
+    -> awaitable<std::string> {
+    auto subscription = std::make_shared<Subscription>();
+    subscription->id = utils::generate_id(12);
+    subscription->connection_id = std::move(connection_id);
+    subscription->filter = std::move(filter);
+    subscription->options = options;
+    subscription->next_flush = std::chrono::steady_clock::now() + options.interval;
+
+    if (!pumping_) {
+        cursor_ = Logger::position();
+    }
+    subscriptions_[subscription->id] = subscription;
+    LOG_INFO("Log tail {} started for connection {}",
+             subscription->id, subscription->connection_id);
+
+    if (!pumping_) {
+        pumping_ = true;
+        boost::asio::co_spawn(co_await boost::asio::this_coro::executor,
+                              pump(), boost::asio::detached);
+    }
+    co_return subscription->id;
+}
+
+auto LogTail::unsubscribe(const std::string& id, const std::string& connection_id) -> bool {
+    auto it = subscriptions_.find(id);
+    if (it == subscriptions_.end() || it->second->connection_id != connection_id) {
+        return false;
+    }
+    subscriptions_.erase(it);
+    return true;
+}
+
+auto LogTail::pump() -> awaitable<void> {
+    auto self = shared_from_this();
+    auto executor = co_await boost::asio::this_coro::executor;
+    boost::asio::steady_timer timer(executor);
+    std::vector<LogRecord> records;
+
+    while (!subscriptions_.empty()) {
+        timer.expires_after(kPumpInterval);
+        boost::system::error_code ec;
+        co_await timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+        // Records the ring overwrote before we got to them
+        auto head = Logger::position();
+        auto capacity = Logger::stats().capacity;
+        uint64_t missed = head - cursor_ > capacity ? head - capacity - cursor_ : 0;
+
+        records.clear();
+        cursor_ = Logger::read(cursor_, capacity, records);
+        collect(records, missed);
+
+        auto now = std::chrono::steady_clock::now();
+        for (auto it = subscriptions_.begin(); it != subscriptions_.end();) {
+            auto& subscription = it->second;
+            if (!server_.find_connection(subscription->connection_id)) {
+                it = subscriptions_.erase(it);
+                continue;
+            }
+            if (!subscription->sending && now >= subscription->next_flush &&
+                (!subscription->pending.empty() || subscription->dropped > 0)) {
+                subscription->next_flush = now + subscription->options.interval;
+                boost::asio::co_spawn(executor, deliver(subscription), boost::asio::detached);
+            }
+            ++it;
+        }
+    }
+    pumping_ = false;
+}
+
+void LogTail::collect(const std::vector<LogRecord>& records, uint64_t missed) {
+    for (auto& [_, subscription] : subscriptions_) {
+        subscription->dropped += missed;
+        for (const auto& record : records) {
+            if (!subscription->filter.matches(record)) {
+                continue;
+            }
+            if (++subscription->matched % subscription->filter.sample_every != 0) {
+                continue;
+            }
+            if (subscription->pending.size() >= subscription->options.max_buffered) {
+                ++subscription->dropped;
+                continue;
+            }
+            subscription->pending.push_back(record);
+        }
+    }
+}
+
+auto LogTail::deliver(std::shared_ptr<Subscription> subscription) -> awaitable<void> {
+    auto self = shared_from_this();
+    auto connection = server_.find_connection(subscription->connection_id);
+    if (!connection || !connection->is_open()) {
+        subscriptions_.erase(subscription->id);
+        co_return;
+    }
+
+    subscription->sending = true;
+    json data = {
+        {"subscription", subscription->id},
+        {"records", subscription->pending},
+        {"dropped", std::exchange(subscription->dropped, 0)},
+    };
+    subscription->pending.clear();
+
+    auto sent = co_await connection->send(Frame{make_event("gateway.logs", std::move(data))});
+    subscription->sending = false;
+    if (!sent) {
+        subscriptions_.erase(subscription->id);
+    }
+}
+
+} // namespace openclaw::gateway
@@ -0,0 +1,140 @@
+#include "openclaw/gateway/outbox.hpp"
+
+#include <algorithm>
+
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+namespace openclaw::gateway {
+
+namespace net = boost::asio;
+
+namespace {
+
+// Fixed cost of a queued delta beyond its text
+constexpr size_t kDeltaOverhead = 128;
+
+} // anonymous namespace
+
+auto run_id_of(const EventFrame& event) -> std::string {
+    if (!event.data.is_object()) return {};
+    return event.data.value("runId", "");
+}
+
+Outbox::Outbox(net::any_io_executor executor)
+    : executor_(std::move(executor)) {}
+
+void Outbox::set_policy(StreamPolicy policy, size_t limit_bytes,
+                        std::chrono::milliseconds pause_limit) {
+    policy_ = policy;
+    limit_ = limit_bytes;
+    pause_limit_ = pause_limit;
+}
+
+void Outbox::push(Item item) {
+    bytes_ += item.bytes;
+    peak_bytes_ = std::max(peak_bytes_, bytes_);
+    items_.push_back(std::move(item));
+}
+
+auto Outbox::push_delta(EventFrame event) -> awaitable<bool> {
+    if (closed_) co_return false;
+
+    if (bytes_ < limit_) {
+        if (policy_ == StreamPolicy::Coalesce && merge(event)) {
+            co_return true;
+        }
+    } else if (policy_ != StreamPolicy::Pause) {
+        ++dropped_;
+        co_return false;
+    } else {
+        ++pauses_;
+        if (!co_await wait_for_room()) {
+            ++dropped_;
+            co_return false;
+        }
+    }
+
+    auto bytes = kDeltaOverhead + event.data.value("text", "").size();
+    auto run_id = run_id_of(event);
+    push(Item{.delta = std::move(event), .bytes = bytes, .run_id = std::move(run_id)});
+    co_return true;
+}
+
+auto Outbox::merge(const EventFrame& event) -> bool {
+    auto run_id = run_id_of(event);
+    auto stream = event.data.value("stream", "");
+    // Only the run's latest queued frame can take more text without
+    // reordering it against the run's other events
+    for (auto it = items_.rbegin(); it != items_.rend(); ++it) {
+        if (it->run_id != run_id) continue;
+        if (!it->delta || it->delta->event != event.event ||
+            it->delta->data.value("stream", "") != stream) {
+            return false;
+        }
+        auto more = event.data.value("text", "");
+        it->delta->data["text"].get_ref<std::string&>() += more;
+        it->bytes += more.size();
+        bytes_ += more.size();
+        peak_bytes_ = std::max(peak_bytes_, bytes_);
+        ++coalesced_;
+        return true;
+    }
+    return false;
+}
+
+auto Outbox::wait_for_room() -> awaitable<bool> {
+    auto deadline = std::chrono::steady_clock::now() + pause_limit_;
+    while (!closed_ && bytes_ >= limit_) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            co_return false;
+        }
+        net::steady_timer timer(executor_, deadline);
+        room_waiters_.push_back(&timer);
+        boost::system::error_code ec;
+        co_await timer.async_wait(net::redirect_error(net::use_awaitable, ec));
+        std::erase(room_waiters_, &timer);
+    }
+    co_return !closed_;
+}
+
+void Outbox::wake_room_waiters() {
+    for (auto* timer : room_waiters_) {
+        timer->cancel();
+    }
+    room_waiters_.clear();
+}
+
+auto Outbox::pop() -> Item {
+    auto item = std::move(items_.front());
+    items_.pop_front();
+    return item;
+}
+
+void Outbox::done(const Item& item) {
+    bytes_ -= item.bytes;
+    if (bytes_ < limit_) {
+        wake_room_waiters();
+    }
+}
+
+void Outbox::close() {
+    closed_ = true;
+    wake_room_waiters();
+}
+
+auto Outbox::stats() const -> nlohmann::json {
+    return nlohmann::json{
+        {"policy", stream_policy_name(policy_)},
+        {"limit_bytes", limit_},
+        {"queued_frames", items_.size()},
+        {"queued_bytes", bytes_},
+        {"peak_bytes", peak_bytes_},
+        {"paused_runs", room_waiters_.size()},
+        {"pauses", pauses_},
+        {"coalesced", coalesced_},
+        {"dropped", dropped_},
+    };
+}
+
+} // namespace openclaw::gateway
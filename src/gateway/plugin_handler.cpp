@@ -1,5 +1,7 @@
 #include "openclaw/gateway/plugin_handler.hpp"
 
+#include <algorithm>
+
 #include <boost/asio/use_awaitable.hpp>
 
 #include "openclaw/core/logger.hpp"
@@ -9,18 +11,62 @@ namespace openclaw::gateway {
 using json = nlohmann::json;
 using boost::asio::awaitable;
 
+void swap_plugin_methods(Protocol& protocol,
+                         const std::shared_ptr<plugins::LoadedPlugin>& retired,
+                         const std::shared_ptr<plugins::LoadedPlugin>& published) {
+    // Only names the retired instance actually published are its to
+    // withdraw or hand on; a name it was refused still belongs to the
+    // built-in (or other plugin) that held it.
+    std::vector<std::string> remove;
+    if (retired) {
+        remove = retired->published_methods;
+    }
+    std::vector<std::pair<MethodInfo, MethodHandler>> add;
+    if (published) {
+        published->published_methods.clear();
+        for (const auto& method : published->methods) {
+            bool own = std::find(remove.begin(), remove.end(), method.name) != remove.end();
+            if (!own && protocol.has_method(method.name)) {
+                LOG_WARN("Plugin '{}' cannot override method {}",
+                         published->name, method.name);
+                continue;
+            }
+            published->published_methods.push_back(method.name);
+            add.emplace_back(
+                MethodInfo{
+                    .name = method.name,
+                    .description = method.description,
+                    .group = "plugin",
+                },
+                [owner = published, handler = &method.handler](json params) {
+                    return (*handler)(std::move(params));
+                });
+        }
+    }
+    protocol.replace_methods(remove, std::move(add));
+}
+
 void register_plugin_handlers(Protocol& protocol,
                               plugins::PluginLoader& plugins) {
+    // Mirror plugin-provided methods into the protocol. Each handler holds
+    // its plugin instance, so a reload lets calls already dispatched finish
+    // against the old library.
+    plugins.on_swap([&protocol](const std::shared_ptr<plugins::LoadedPlugin>& retired,
+                                const std::shared_ptr<plugins::LoadedPlugin>& published) {
+        swap_plugin_methods(protocol, retired, published);
+    });
+
     // plugin.list
     protocol.register_method("plugin.list",
         [&plugins]([[maybe_unused]] json params) -> awaitable<json> {
             auto names = plugins.loaded_names();
             json result = json::array();
-            for (auto name : names) {
-                auto* p = plugins.get(name);
+            for (const auto& name : names) {
+                auto p = plugins.find(name);
                 result.push_back(json{
-                    {"name", std::string(name)},
+                    {"name", name},
                     {"loaded", p != nullptr},
+                    {"version", p ? p->version : ""},
                 });
             }
             co_return json{{"plugins", result}, {"count", result.size()}};
@@ -108,15 +154,53 @@ void register_plugin_handlers(Protocol& protocol,
             if (name.empty()) {
                 co_return json{{"ok", false}, {"error", "name is required"}};
             }
-            auto* p = plugins.get(name);
-            co_return json{
+            auto p = plugins.find(name);
+            json status{
                 {"ok", true},
                 {"name", name},
                 {"loaded", p != nullptr},
+                {"draining", plugins.draining()},
             };
+            if (p) {
+                json tools = json::array();
+                for (const auto& tool : p->tools) {
+                    tools.push_back(tool->definition().name);
+                }
+                json methods = json::array();
+                for (const auto& method : p->methods) {
+                    methods.push_back(method.name);
+                }
+                status["version"] = p->version;
+                status["path"] = p->path.string();
+                status["generation"] = p->generation;
+                status["tools"] = std::move(tools);
+                status["methods"] = std::move(methods);
+            }
+            co_return status;
         },
         "Get plugin runtime status", "plugin");
 
+    // plugin.reload
+    protocol.register_method("plugin.reload",
+        [&plugins](json params) -> awaitable<json> {
+            auto name = params.value("name", "");
+            if (name.empty()) {
+                co_return json{{"ok", false}, {"error", "name is required"}};
+            }
+            auto result = plugins.reload(name);
+            if (!result.has_value()) {
+                co_return json{{"ok", false}, {"error", result.error().what()}};
+            }
+            auto p = plugins.find(name);
+            co_return json{
+                {"ok", true},
+                {"name", name},
+                {"generation", p ? p->generation : 0},
+            };
+        },
+        "Reload a plugin from its library without dropping calls in flight",
+        "plugin");
+
     LOG_INFO("Registered plugin handlers");
 }
 
@@ -7,30 +7,75 @@
 
 namespace openclaw::gateway {
 
-Protocol::Protocol() = default;
+Protocol::Protocol()
+    : methods_(std::make_shared<const MethodMap>()) {}
+
+namespace {
+
+auto with_context(MethodHandler handler) -> ContextMethodHandler {
+    return [handler = std::move(handler)](json params, RequestContext) {
+        return handler(std::move(params));
+    };
+}
+
+} // anonymous namespace
 
 void Protocol::register_method(std::string name, MethodHandler handler,
                                std::string description, std::string group) {
+    register_method(std::move(name), with_context(std::move(handler)),
+                    std::move(description), std::move(group));
+}
+
+void Protocol::register_method(std::string name, ContextMethodHandler handler,
+                               std::string description, std::string group) {
     LOG_DEBUG("Registering method: {}", name);
-    methods_[name] = Entry{
+    auto entry = std::make_shared<const Entry>(Entry{
         .handler = std::move(handler),
         .info = MethodInfo{
             .name = name,
             .description = std::move(description),
             .group = std::move(group),
         },
-    };
+    });
+
+    std::lock_guard lock(write_mutex_);
+    auto next = std::make_shared<MethodMap>(*snapshot());
+    (*next)[std::move(name)] = std::move(entry);
+    methods_.store(std::move(next), std::memory_order_release);
+}
+
+void Protocol::replace_methods(const std::vector<std::string>& remove,
+                               std::vector<std::pair<MethodInfo, MethodHandler>> add) {
+    std::lock_guard lock(write_mutex_);
+    auto next = std::make_shared<MethodMap>(*snapshot());
+    for (const auto& name : remove) {
+        next->erase(name);
+    }
+    for (auto& [info, handler] : add) {
+        auto name = info.name;
+        (*next)[std::move(name)] = std::make_shared<const Entry>(Entry{
+            .handler = with_context(std::move(handler)),
+            .info = std::move(info),
+        });
+    }
+    methods_.store(std::move(next), std::memory_order_release);
+    LOG_DEBUG("Replaced methods: {} removed, {} added", remove.size(), add.size());
+}
+
+auto Protocol::snapshot() const -> std::shared_ptr<const MethodMap> {
+    return methods_.load(std::memory_order_acquire);
 }
 
 auto Protocol::has_method(std::string_view name) const -> bool {
-    return methods_.contains(std::string(name));
+    return snapshot()->contains(std::string(name));
 }
 
 auto Protocol::methods() const -> std::vector<MethodInfo> {
+    auto methods = snapshot();
     std::vector<MethodInfo> result;
-    result.reserve(methods_.size());
-    for (const auto& [_, entry] : methods_) {
-        result.push_back(entry.info);
+    result.reserve(methods->size());
+    for (const auto& [_, entry] : *methods) {
+        result.push_back(entry->info);
     }
     return result;
 }
@@ -38,24 +83,34 @@ auto Protocol::methods() const -> std::vector<MethodInfo> {
 auto Protocol::methods_in_group(std::string_view group) const
     -> std::vector<MethodInfo> {
     std::vector<MethodInfo> result;
-    for (const auto& [_, entry] : methods_) {
-        if (entry.info.group == group) {
-            result.push_back(entry.info);
+    for (const auto& [_, entry] : *snapshot()) {
+        if (entry->info.group == group) {
+            result.push_back(entry->info);
         }
     }
     return result;
 }
 
-auto Protocol::dispatch(const RequestFrame& request) -> awaitable<Result<json>> {
-    auto it = methods_.find(request.method);
-    if (it == methods_.end()) {
+auto Protocol::dispatch(const RequestFrame& request, RequestContext context)
+    -> awaitable<Result<json>> {
+    // Pin the entry: the handler must outlive the call even if the method
+    // is replaced while it is suspended
+    std::shared_ptr<const Entry> entry;
+    {
+        auto methods = snapshot();
+        auto it = methods->find(request.method);
+        if (it != methods->end()) {
+            entry = it->second;
+        }
+    }
+    if (!entry) {
         co_return make_fail(
             make_error(ErrorCode::NotFound,
                        "Method not found: " + request.method));
     }
 
     try {
-        auto result = co_await it->second.handler(request.params);
+        auto result = co_await entry->handler(request.params, std::move(context));
         co_return result;
     } catch (const std::exception& e) {
         LOG_ERROR("Method {} threw exception: {}", request.method, e.what());
@@ -99,7 +154,7 @@ void Protocol::register_builtins() {
     register_cron_methods();
     register_config_methods();
 
-    LOG_INFO("Registered {} built-in method stubs", methods_.size());
+    LOG_INFO("Registered {} built-in method stubs", snapshot()->size());
 }
 
 void Protocol::register_gateway_methods() {
@@ -125,6 +180,10 @@ void Protocol::register_gateway_methods() {
         "Return gateway metrics (requests, latencies, errors)", std::string(g));
     register_method("gateway.logs", make_stub("gateway.logs"),
         "Stream or query recent gateway logs", std::string(g));
+    register_method("gateway.logs.subscribe", make_stub("gateway.logs.subscribe"),
+        "Stream new log records matching a filter", std::string(g));
+    register_method("gateway.logs.unsubscribe", make_stub("gateway.logs.unsubscribe"),
+        "Stop a log tail", std::string(g));
 }
 
 void Protocol::register_session_methods() {
@@ -254,6 +313,10 @@ void Protocol::register_browser_methods() {
         "Take a screenshot", std::string(g));
     register_method("browser.content", make_stub("browser.content"),
         "Get page content as text/html", std::string(g));
+    register_method("browser.fetch_many", make_stub("browser.fetch_many"),
+        "Fetch several URLs in parallel and extract their text", std::string(g));
+    register_method("browser.network.stats", make_stub("browser.network.stats"),
+        "Get request blocking, bytes and page-load stats for a session", std::string(g));
     register_method("browser.click", make_stub("browser.click"),
         "Click an element on the page", std::string(g));
     register_method("browser.type", make_stub("browser.type"),
@@ -270,6 +333,8 @@ void Protocol::register_browser_methods() {
         "Get browser cookies", std::string(g));
     register_method("browser.cookies.set", make_stub("browser.cookies.set"),
         "Set browser cookies", std::string(g));
+    register_method("browser.pool.stats", make_stub("browser.pool.stats"),
+        "Browser pool occupancy, acquire-wait and launch metrics", std::string(g));
 }
 
 void Protocol::register_provider_methods() {
@@ -312,6 +377,9 @@ void Protocol::register_plugin_methods() {
         "Call an exported plugin function", std::string(g));
     register_method("plugin.status", make_stub("plugin.status"),
         "Get plugin runtime status", std::string(g));
+    register_method("plugin.reload", make_stub("plugin.reload"),
+        "Reload a plugin from its library without dropping calls in flight",
+        std::string(g));
 }
 
 void Protocol::register_agent_methods() {
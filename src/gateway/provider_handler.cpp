@@ -1,5 +1,8 @@
 #include "openclaw/gateway/provider_handler.hpp"
 
+#include <chrono>
+#include <map>
+
 #include <boost/asio/use_awaitable.hpp>
 
 #include "openclaw/core/logger.hpp"
@@ -45,13 +48,79 @@ void ProviderRegistry::set_primary(std::string_view name) {
     primary_name_ = std::string(name);
 }
 
+// ---------------------------------------------------------------------------
+// Usage metering
+// ---------------------------------------------------------------------------
+
+auto usage_caller(GatewayServer& server, const RequestContext& context) -> std::string {
+    if (context.connection_id.empty()) return {};
+    auto connection = server.find_connection(context.connection_id);
+    if (!connection || !connection->auth()) return {};
+    return connection->auth()->identity;
+}
+
+auto usage_labels(const json& params, std::string provider, std::string model,
+                  std::string caller) -> providers::UsageLabels {
+    return providers::UsageLabels{
+        .provider = std::move(provider),
+        .model = std::move(model),
+        .session = params.value("sessionKey", ""),
+        .agent = params.value("agentId", ""),
+        .channel = params.value("channel", ""),
+        .caller = std::move(caller),
+    };
+}
+
+auto usage_budget_refusal(providers::UsageLedger* usage,
+                          const providers::UsageLabels& labels)
+    -> std::optional<json> {
+    if (!usage) return std::nullopt;
+    auto status = usage->check_budget(labels);
+    if (status.state != providers::BudgetState::Hard) return std::nullopt;
+    LOG_WARN("Refusing run for {}: usage budget ${:.2f} reached",
+             status.tenant, status.limit_usd);
+    return json{
+        {"ok", false},
+        {"error", "Usage budget exceeded for " + status.tenant},
+    };
+}
+
+namespace {
+
+auto default_model(providers::Provider& p, const std::string& requested) -> std::string {
+    if (!requested.empty()) return requested;
+    auto models = p.models();
+    return models.empty() ? std::string{} : models.front();
+}
+
+auto usage_query_from(const json& params) -> providers::UsageQuery {
+    providers::UsageQuery query;
+    if (params.contains("from")) {
+        query.from = Timestamp{std::chrono::milliseconds{params["from"].get<int64_t>()}};
+    }
+    if (params.contains("to")) {
+        query.to = Timestamp{std::chrono::milliseconds{params["to"].get<int64_t>()}};
+    }
+    if (params.contains("group_by")) {
+        query.group_by = params["group_by"].get<std::vector<std::string>>();
+    }
+    if (params.contains("where")) {
+        query.where = params["where"].get<std::map<std::string, std::string>>();
+    }
+    query.limit = params.value("limit", query.limit);
+    return query;
+}
+
+} // anonymous namespace
+
 // ---------------------------------------------------------------------------
 // Handler registration
 // ---------------------------------------------------------------------------
 
 void register_provider_handlers(Protocol& protocol,
-                                [[maybe_unused]] GatewayServer& server,
-                                ProviderRegistry& providers) {
+                                GatewayServer& server,
+                                ProviderRegistry& providers,
+                                providers::UsageLedger* usage) {
     // provider.list
     protocol.register_method("provider.list",
         [&providers]([[maybe_unused]] json params) -> awaitable<json> {
@@ -70,7 +139,7 @@ void register_provider_handlers(Protocol& protocol,
 
     // provider.chat
     protocol.register_method("provider.chat",
-        [&providers]([[maybe_unused]] json params) -> awaitable<json> {
+        [&server, &providers, usage](json params, RequestContext context) -> awaitable<json> {
             auto provider_name = params.value("provider", "");
             auto p = provider_name.empty()
                 ? providers.primary()
@@ -81,6 +150,12 @@ void register_provider_handlers(Protocol& protocol,
 
             providers::CompletionRequest req;
             req.model = params.value("model", "");
+            auto labels = usage_labels(params, std::string(p->name()),
+                                       default_model(*p, req.model),
+                                       usage_caller(server, context));
+            if (auto refusal = usage_budget_refusal(usage, labels)) {
+                co_return *refusal;
+            }
             if (params.contains("messages")) {
                 for (const auto& msg : params["messages"]) {
                     Message m;
@@ -107,6 +182,14 @@ void register_provider_handlers(Protocol& protocol,
                 co_return json{{"ok", false}, {"error", result.error().what()}};
             }
             auto& resp = result.value();
+            if (usage) {
+                if (!resp.model.empty()) labels.model = resp.model;
+                usage->record(providers::UsageEvent{
+                    .labels = std::move(labels),
+                    .input_tokens = resp.input_tokens,
+                    .output_tokens = resp.output_tokens,
+                });
+            }
             std::string text;
             for (const auto& block : resp.message.content) {
                 if (block.type == "text") text += block.text;
@@ -124,7 +207,7 @@ void register_provider_handlers(Protocol& protocol,
 
     // provider.chat.stream
     protocol.register_method("provider.chat.stream",
-        [&providers]([[maybe_unused]] json params) -> awaitable<json> {
+        [&server, &providers, usage](json params, RequestContext context) -> awaitable<json> {
             auto provider_name = params.value("provider", "");
             auto p = provider_name.empty()
                 ? providers.primary()
@@ -135,6 +218,12 @@ void register_provider_handlers(Protocol& protocol,
 
             providers::CompletionRequest req;
             req.model = params.value("model", "");
+            auto labels = usage_labels(params, std::string(p->name()),
+                                       default_model(*p, req.model),
+                                       usage_caller(server, context));
+            if (auto refusal = usage_budget_refusal(usage, labels)) {
+                co_return *refusal;
+            }
             if (params.contains("messages")) {
                 for (const auto& msg : params["messages"]) {
                     Message m;
@@ -155,6 +244,14 @@ void register_provider_handlers(Protocol& protocol,
                 co_return json{{"ok", false}, {"error", result.error().what()}};
             }
             auto& resp = result.value();
+            if (usage) {
+                if (!resp.model.empty()) labels.model = resp.model;
+                usage->record(providers::UsageEvent{
+                    .labels = std::move(labels),
+                    .input_tokens = resp.input_tokens,
+                    .output_tokens = resp.output_tokens,
+                });
+            }
             std::string text;
             for (const auto& block : resp.message.content) {
                 if (block.type == "text") text += block.text;
@@ -219,12 +316,51 @@ void register_provider_handlers(Protocol& protocol,
 
     // provider.usage
     protocol.register_method("provider.usage",
-        []([[maybe_unused]] json params) -> awaitable<json> {
-            // TODO: track token usage statistics.
+        [usage](json params) -> awaitable<json> {
+            if (!usage) {
+                co_return json{{"ok", false}, {"error", "Usage metering is disabled"}};
+            }
+            providers::UsageQuery query;
+            try {
+                query = usage_query_from(params);
+            } catch (const json::exception& e) {
+                co_return json{{"ok", false}, {"error", std::string("Invalid usage query: ") + e.what()}};
+            }
+
+            // Grand total over the same range and filters, then the breakdown
+            auto total_query = query;
+            total_query.group_by.clear();
+            auto totals = co_await usage->async_query(std::move(total_query));
+            if (!totals) {
+                co_return json{{"ok", false}, {"error", totals.error().what()}};
+            }
+            providers::UsageTotals total;
+            if (!totals->empty()) total = totals->front().totals;
+
+            json rows = json::array();
+            if (!query.group_by.empty()) {
+                auto grouped = co_await usage->async_query(query);
+                if (!grouped) {
+                    co_return json{{"ok", false}, {"error", grouped.error().what()}};
+                }
+                for (const auto& row : *grouped) {
+                    auto entry = row.keys;
+                    entry["runs"] = row.totals.runs;
+                    entry["input_tokens"] = row.totals.input_tokens;
+                    entry["output_tokens"] = row.totals.output_tokens;
+                    entry["cost_usd"] = row.totals.cost_usd();
+                    rows.push_back(std::move(entry));
+                }
+            }
+
             co_return json{
                 {"ok", true},
-                {"total_input_tokens", 0},
-                {"total_output_tokens", 0},
+                {"runs", total.runs},
+                {"total_input_tokens", total.input_tokens},
+                {"total_output_tokens", total.output_tokens},
+                {"total_cost_usd", total.cost_usd()},
+                {"rows", rows},
+                {"budgets", usage->budgets()},
             };
         },
         "Get token/cost usage statistics", "provider");
@@ -18,6 +18,7 @@
 #include <boost/asio/as_tuple.hpp>
 #include <boost/asio/co_spawn.hpp>
 #include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
 #include <boost/asio/signal_set.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/asio/use_awaitable.hpp>
@@ -26,7 +27,6 @@
 
 namespace openclaw::gateway {
 
-namespace {
 auto sanitize_outbound_text(std::string& text) -> void {
     // Strip script tags
     static const std::regex script_re(R"(<script[^>]*>.*?</script>)", std::regex::icase);
@@ -38,7 +38,6 @@ auto sanitize_outbound_text(std::string& text) -> void {
     static const std::regex js_uri_re(R"(javascript\s*:)", std::regex::icase);
     text = std::regex_replace(text, js_uri_re, "");
 }
-} // anonymous namespace
 
 // ===========================================================================
 // Connection
@@ -50,7 +49,9 @@ Connection::Connection(WsStream ws, std::string id,
     : ws_(std::move(ws))
     , id_(std::move(id))
     , protocol_(std::move(protocol))
-    , hooks_(std::move(hooks)) {}
+    , hooks_(std::move(hooks))
+    , outbox_(ws_.get_executor())
+    , writer_done_(ws_.get_executor(), net::steady_timer::time_point::max()) {}
 
 auto Connection::run() -> awaitable<void> {
     co_await read_loop();
@@ -67,28 +68,132 @@ auto Connection::send(const Frame& frame) -> awaitable<Result<void>> {
 }
 
 auto Connection::send_text(std::string message) -> awaitable<Result<void>> {
+    sanitize_outbound_text(message);
+    co_return co_await write(std::move(message), false);
+}
+
+auto Connection::send_binary(std::string message) -> awaitable<Result<void>> {
+    co_return co_await write(std::move(message), true);
+}
+
+auto Connection::write(std::string data, bool binary) -> awaitable<Result<void>> {
     if (!open_) {
         co_return make_fail(
             make_error(ErrorCode::ConnectionClosed, "Connection is closed"));
     }
 
-    try {
-        sanitize_outbound_text(message);
-        ws_.text(true);
-        co_await ws_.async_write(
-            net::buffer(message), net::use_awaitable);
-        co_return ok_result();
-    } catch (const boost::system::system_error& e) {
-        LOG_WARN("Connection {}: write error: {}", id_, e.what());
-        open_ = false;
-        co_return make_fail(
-            make_error(ErrorCode::IoError, "WebSocket write failed", e.what()));
+    auto waiter = std::make_shared<Outbox::Waiter>(ws_.get_executor());
+    auto bytes = data.size();
+    enqueue(Outbox::Item{.data = std::move(data), .binary = binary,
+                     .bytes = bytes, .waiter = waiter});
+    while (!waiter->result) {
+        boost::system::error_code ec;
+        co_await waiter->timer.async_wait(
+            net::redirect_error(net::use_awaitable, ec));
     }
+    co_return std::move(*waiter->result);
 }
 
-auto Connection::close() -> awaitable<void> {
+void Connection::post(const Frame& frame) {
+    if (!open_) return;
+    auto text = serialize_frame(frame);
+    sanitize_outbound_text(text);
+    auto bytes = text.size();
+    Outbox::Item item{.data = std::move(text), .bytes = bytes};
+    if (auto* event = std::get_if<EventFrame>(&frame)) {
+        item.run_id = run_id_of(*event);
+    }
+    enqueue(std::move(item));
+}
+
+auto Connection::send_delta(const EventFrame& event) -> awaitable<void> {
     if (!open_) co_return;
+    if (co_await outbox_.push_delta(event)) {
+        start_writer();
+    }
+}
+
+void Connection::enqueue(Outbox::Item item) {
+    outbox_.push(std::move(item));
+    start_writer();
+}
+
+void Connection::start_writer() {
+    if (outbox_.bytes() > static_cast<size_t>(GatewayServer::MAX_BUFFERED_BYTES) && open_) {
+        // The client stopped reading; queued frames fail in write_loop()
+        LOG_WARN("Connection {}: {} bytes queued, closing slow client",
+                 id_, outbox_.bytes());
+        mark_closed();
+        boost::system::error_code ec;
+        beast::get_lowest_layer(ws_).socket().close(ec);
+    }
+
+    if (!writing_) {
+        writing_ = true;
+        boost::asio::co_spawn(ws_.get_executor(),
+            [self = shared_from_this()] { return self->write_loop(); },
+            boost::asio::detached);
+    }
+}
+
+auto Connection::write_loop() -> awaitable<void> {
+    while (!outbox_.empty()) {
+        auto item = outbox_.pop();
+
+        Result<void> result = ok_result();
+        if (!open_) {
+            result = std::unexpected(
+                make_error(ErrorCode::ConnectionClosed, "Connection is closed"));
+        } else {
+            if (item.delta) {
+                item.data = serialize_frame(Frame{*item.delta});
+                sanitize_outbound_text(item.data);
+            }
+            try {
+                ws_.binary(item.binary);
+                co_await ws_.async_write(net::buffer(item.data), net::use_awaitable);
+            } catch (const boost::system::system_error& e) {
+                LOG_WARN("Connection {}: write error: {}", id_, e.what());
+                mark_closed();
+                result = std::unexpected(
+                    make_error(ErrorCode::IoError, "WebSocket write failed", e.what()));
+            }
+        }
+
+        outbox_.done(item);
+        if (item.waiter) {
+            item.waiter->result = std::move(result);
+            item.waiter->timer.cancel();
+        }
+    }
+    writing_ = false;
+    writer_done_.cancel();
+}
+
+void Connection::set_stream_policy(StreamPolicy policy, size_t limit_bytes) {
+    outbox_.set_policy(policy, limit_bytes);
+}
+
+auto Connection::stream_stats() const -> nlohmann::json {
+    auto stats = outbox_.stats();
+    stats["id"] = id_;
+    return stats;
+}
+
+void Connection::mark_closed() {
     open_ = false;
+    outbox_.close();
+}
+
+auto Connection::close() -> awaitable<void> {
+    if (!open_) co_return;
+    mark_closed();
+
+    // async_close must not overlap a write; the rest of the outbox fails fast
+    while (writing_) {
+        boost::system::error_code ec;
+        co_await writer_done_.async_wait(net::redirect_error(net::use_awaitable, ec));
+    }
 
     try {
         co_await ws_.async_close(
@@ -162,7 +267,7 @@ auto Connection::read_loop() -> awaitable<void> {
             } else {
                 LOG_WARN("Connection {}: read error: {}", id_, e.what());
             }
-            open_ = false;
+            mark_closed();
             break;
         }
     }
@@ -191,12 +296,14 @@ auto Connection::handle_request(const RequestFrame& req) -> awaitable<void> {
     RequestFrame hooked_req{req.id, req.method, std::move(hooked_params)};
 
     // Dispatch to protocol handler.
-    auto result = co_await protocol_->dispatch(hooked_req);
+    auto result = co_await protocol_->dispatch(hooked_req, RequestContext{id_});
 
     Frame response_frame;
+    std::vector<json::binary_t> payloads;
     if (result) {
         // Run after hooks on the result.
         json hooked_result = co_await hooks_->run_after(req.method, *result);
+        payloads = detach_binary(hooked_result);
         response_frame = Frame{make_response(req.id, std::move(hooked_result))};
     } else {
         response_frame = Frame{make_error_response(
@@ -204,6 +311,11 @@ auto Connection::handle_request(const RequestFrame& req) -> awaitable<void> {
     }
 
     co_await send(response_frame);
+
+    // Binary payloads follow their response, in index order
+    for (size_t i = 0; i < payloads.size(); ++i) {
+        co_await send_binary(make_binary_frame(req.id, i, payloads[i]));
+    }
 }
 
 // ===========================================================================
@@ -298,13 +410,45 @@ auto GatewayServer::broadcast(const EventFrame& event) -> awaitable<void> {
     auto frame = Frame{event};
     for (auto& [id, conn] : connections_) {
         if (conn->is_open()) {
-            auto result = co_await conn->send(frame);
-            if (!result) {
-                LOG_DEBUG("Broadcast: failed to send to {}: {}",
-                          id, result.error().what());
-            }
+            conn->post(frame);
         }
     }
+    co_return;
+}
+
+auto GatewayServer::broadcast_delta(const EventFrame& event) -> awaitable<void> {
+    // Pause connections suspend; the map may change meanwhile
+    std::vector<std::shared_ptr<Connection>> targets;
+    targets.reserve(connections_.size());
+    for (auto& [id, conn] : connections_) {
+        if (conn->is_open()) {
+            targets.push_back(conn);
+        }
+    }
+    for (auto& conn : targets) {
+        co_await conn->send_delta(event);
+    }
+}
+
+auto GatewayServer::stream_stats() const -> nlohmann::json {
+    nlohmann::json connections = nlohmann::json::array();
+    uint64_t queued_bytes = 0;
+    for (const auto& [id, conn] : connections_) {
+        auto stats = conn->stream_stats();
+        queued_bytes += stats["queued_bytes"].get<uint64_t>();
+        connections.push_back(std::move(stats));
+    }
+    return nlohmann::json{
+        {"queued_bytes", queued_bytes},
+        {"connections", std::move(connections)},
+        {"runs", run_buffer_metrics().to_json()},
+    };
+}
+
+auto GatewayServer::find_connection(const std::string& id) const
+    -> std::shared_ptr<Connection> {
+    auto it = connections_.find(id);
+    return it != connections_.end() ? it->second : nullptr;
 }
 
 auto GatewayServer::connection_count() const noexcept -> size_t {
@@ -655,6 +799,23 @@ auto GatewayServer::handle_connection(tcp::socket socket) -> awaitable<void> {
     conn->set_auth(std::move(auth_info));
     conn->set_scopes(std::move(granted_scopes));
     conn->set_nonce(challenge_nonce);
+    {
+        // Subscriber class: the client mode picks the stream policy
+        const auto& stream = config_.stream;
+        auto policy_name = stream.policy;
+        auto client_mode = params.value("clientMode", "");
+        if (auto it = stream.client_policies.find(client_mode);
+            it != stream.client_policies.end()) {
+            policy_name = it->second;
+        }
+        auto policy = parse_stream_policy(policy_name);
+        if (!policy) {
+            LOG_WARN("Connection {}: unknown stream policy '{}', using coalesce",
+                     conn_id, policy_name);
+        }
+        conn->set_stream_policy(policy.value_or(StreamPolicy::Coalesce),
+                                stream.connection_buffer_bytes);
+    }
     if (!device_pub_key.empty()) {
         conn->set_device_public_key(std::move(device_pub_key));
     }
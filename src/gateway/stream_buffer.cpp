@@ -0,0 +1,218 @@
+#include "openclaw/gateway/stream_buffer.hpp"
+
+#include <exception>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+namespace openclaw::gateway {
+
+namespace net = boost::asio;
+
+namespace {
+
+// Fixed cost of a chunk beyond its text: the deque node and strings
+constexpr size_t kChunkOverhead = 64;
+
+/// A timer used as a flag: set() moves it into the past, which also
+/// completes a wait that has not started yet, so no wake-up is lost.
+struct Signal {
+    explicit Signal(const net::any_io_executor& executor)
+        : timer(executor, net::steady_timer::time_point::max()) {}
+
+    void set() { timer.expires_at(net::steady_timer::time_point::min()); }
+    void reset() { timer.expires_at(net::steady_timer::time_point::max()); }
+
+    auto wait() -> net::awaitable<void> {
+        boost::system::error_code ec;
+        co_await timer.async_wait(net::redirect_error(net::use_awaitable, ec));
+    }
+
+    net::steady_timer timer;
+};
+
+/// Hands the buffer's chunks to `sink` until the buffer is closed and empty.
+auto drain_run(std::shared_ptr<RunStreamBuffer> buffer, std::shared_ptr<Signal> pushed,
+               RunChunkSink sink) -> net::awaitable<void> {
+    for (;;) {
+        co_await pushed->wait();
+        pushed->reset();
+
+        // Check for the end first: nothing is pushed after close()
+        bool finished = buffer->closed();
+        for (const auto& chunk : buffer->take()) {
+            co_await sink(chunk);
+        }
+        if (finished) {
+            co_return;
+        }
+    }
+}
+
+} // anonymous namespace
+
+auto parse_stream_policy(std::string_view name) -> std::optional<StreamPolicy> {
+    if (name == "pause")    return StreamPolicy::Pause;
+    if (name == "coalesce") return StreamPolicy::Coalesce;
+    if (name == "drop")     return StreamPolicy::Drop;
+    return std::nullopt;
+}
+
+auto stream_policy_name(StreamPolicy policy) -> std::string_view {
+    switch (policy) {
+        case StreamPolicy::Pause:    return "pause";
+        case StreamPolicy::Coalesce: return "coalesce";
+        case StreamPolicy::Drop:     return "drop";
+    }
+    return "coalesce";
+}
+
+auto RunBufferMetrics::to_json() const -> nlohmann::json {
+    return nlohmann::json{
+        {"active_runs", active_runs.load()},
+        {"buffered_bytes", buffered_bytes.load()},
+        {"paused_producers", paused_producers.load()},
+        {"pauses", pauses.load()},
+        {"coalesced", coalesced.load()},
+        {"dropped", dropped.load()},
+    };
+}
+
+auto run_buffer_metrics() -> RunBufferMetrics& {
+    static RunBufferMetrics metrics;
+    return metrics;
+}
+
+RunStreamBuffer::RunStreamBuffer(size_t capacity, std::chrono::milliseconds pause_limit)
+    : capacity_(capacity)
+    , pause_limit_(pause_limit) {
+    ++run_buffer_metrics().active_runs;
+}
+
+RunStreamBuffer::~RunStreamBuffer() {
+    auto& metrics = run_buffer_metrics();
+    --metrics.active_runs;
+    metrics.buffered_bytes -= static_cast<int64_t>(bytes_);
+}
+
+auto RunStreamBuffer::size_of(const providers::CompletionChunk& chunk) -> size_t {
+    size_t size = kChunkOverhead + chunk.type.size() + chunk.text.size();
+    if (chunk.tool_name) size += chunk.tool_name->size();
+    if (chunk.tool_input) size += chunk.tool_input->dump().size();
+    return size;
+}
+
+auto RunStreamBuffer::push(const providers::CompletionChunk& chunk) -> bool {
+    auto& metrics = run_buffer_metrics();
+    std::unique_lock lock(mutex_);
+
+    if (!closed_ && bytes_ >= capacity_) {
+        ++metrics.pauses;
+        ++metrics.paused_producers;
+        room_.wait_for(lock, pause_limit_,
+                       [this] { return closed_ || bytes_ < capacity_; });
+        --metrics.paused_producers;
+    }
+    if (closed_ || bytes_ >= capacity_) {
+        ++metrics.dropped;
+        return false;
+    }
+
+    bool mergeable = chunk.type == "text" || chunk.type == "thinking";
+    if (mergeable && !chunks_.empty() && chunks_.back().type == chunk.type) {
+        chunks_.back().text += chunk.text;
+        bytes_ += chunk.text.size();
+        metrics.buffered_bytes += static_cast<int64_t>(chunk.text.size());
+        ++metrics.coalesced;
+        return true;
+    }
+
+    auto size = size_of(chunk);
+    chunks_.push_back(chunk);
+    bytes_ += size;
+    metrics.buffered_bytes += static_cast<int64_t>(size);
+    return true;
+}
+
+auto RunStreamBuffer::take() -> std::deque<providers::CompletionChunk> {
+    std::deque<providers::CompletionChunk> batch;
+    {
+        std::lock_guard lock(mutex_);
+        batch.swap(chunks_);
+        run_buffer_metrics().buffered_bytes -= static_cast<int64_t>(bytes_);
+        bytes_ = 0;
+    }
+    room_.notify_all();
+    return batch;
+}
+
+void RunStreamBuffer::close() {
+    {
+        std::lock_guard lock(mutex_);
+        closed_ = true;
+    }
+    room_.notify_all();
+}
+
+auto RunStreamBuffer::closed() const -> bool {
+    std::lock_guard lock(mutex_);
+    return closed_;
+}
+
+auto RunStreamBuffer::bytes() const -> size_t {
+    std::lock_guard lock(mutex_);
+    return bytes_;
+}
+
+auto stream_run(size_t capacity, RunProducer produce, RunChunkSink sink,
+                std::chrono::milliseconds pause_limit)
+    -> net::awaitable<Result<providers::CompletionResponse>> {
+    auto executor = co_await net::this_coro::executor;
+    auto buffer = std::make_shared<RunStreamBuffer>(capacity, pause_limit);
+    auto pushed = std::make_shared<Signal>(executor);
+    auto drained = std::make_shared<Signal>(executor);
+    auto consumer_error = std::make_shared<std::exception_ptr>();
+
+    // Started eagerly: it has to drain while the provider is generating,
+    // or a full buffer stalls the provider for the pause limit
+    net::co_spawn(executor, drain_run(buffer, pushed, std::move(sink)),
+        [buffer, drained, consumer_error](std::exception_ptr e) {
+            *consumer_error = e;
+            buffer->close();  // A producer still pushing must not wait on it
+            drained->set();
+        });
+
+    // Runs on the provider's stream thread, which blocks here while the
+    // buffer is full
+    auto on_chunk = [buffer, pushed](const providers::CompletionChunk& chunk) {
+        if (buffer->push(chunk)) {
+            net::post(pushed->timer.get_executor(), [pushed] { pushed->set(); });
+        }
+    };
+
+    std::optional<Result<providers::CompletionResponse>> result;
+    std::exception_ptr producer_error;
+    try {
+        result = co_await produce(on_chunk);
+    } catch (...) {
+        producer_error = std::current_exception();
+    }
+
+    buffer->close();
+    pushed->set();
+    co_await drained->wait();
+
+    if (producer_error) {
+        std::rethrow_exception(producer_error);
+    }
+    if (*consumer_error) {
+        std::rethrow_exception(*consumer_error);
+    }
+    co_return std::move(*result);
+}
+
+} // namespace openclaw::gateway
@@ -30,7 +30,9 @@ auto ToolPolicy::expand_group(std::string_view group_name) -> std::vector<std::s
     return {};
 }
 
-auto ToolPolicy::profile_tools(ToolProfile profile) -> std::unordered_set<std::string> {
+namespace {
+
+auto build_profile(ToolProfile profile) -> std::unordered_set<std::string> {
     std::unordered_set<std::string> tools;
 
     // Minimal: only safe read-only tools
@@ -55,7 +57,7 @@ auto ToolPolicy::profile_tools(ToolProfile profile) -> std::unordered_set<std::s
     }
 
     // Messaging adds channel/communication tools
-    for (const auto& t : expand_group("group:sessions")) tools.insert(t);
+    for (const auto& t : ToolPolicy::expand_group("group:sessions")) tools.insert(t);
     tools.insert("send_message");
     tools.insert("broadcast");
 
@@ -67,15 +69,31 @@ auto ToolPolicy::profile_tools(ToolProfile profile) -> std::unordered_set<std::s
     for (const auto& [group_name, group_tools] : kToolGroups) {
         for (const auto& t : group_tools) tools.insert(t);
     }
-    for (const auto& t : owner_only_tools()) tools.insert(t);
+    for (const auto& t : ToolPolicy::owner_only_tools()) tools.insert(t);
 
     return tools;
 }
 
+} // anonymous namespace
+
+auto ToolPolicy::profile_tools(ToolProfile profile) -> const std::unordered_set<std::string>& {
+    static const std::unordered_set<std::string> profiles[] = {
+        build_profile(ToolProfile::Minimal),
+        build_profile(ToolProfile::Coding),
+        build_profile(ToolProfile::Messaging),
+        build_profile(ToolProfile::Full),
+    };
+    return profiles[static_cast<size_t>(profile)];
+}
+
 // ---------------------------------------------------------------------------
 // Configuration
 // ---------------------------------------------------------------------------
 
+ToolPolicy::ToolPolicy() {
+    compile();
+}
+
 void ToolPolicy::configure(const json& settings) {
     // Profile
     if (settings.contains("tools.profile") || settings.contains("profile")) {
@@ -109,6 +127,7 @@ void ToolPolicy::configure(const json& settings) {
 
     load_list("tools.allow", allow_list_);
     load_list("tools.deny", deny_list_);
+    compile();
 
     LOG_DEBUG("ToolPolicy configured: profile={}, allow={}, deny={}",
               static_cast<int>(profile_), allow_list_.size(), deny_list_.size());
@@ -128,38 +147,84 @@ auto ToolPolicy::is_owner(std::string_view identity) const -> bool {
 
 void ToolPolicy::allow(std::string_view tool_name) {
     allow_list_.insert(std::string(tool_name));
+    compile();
 }
 
 void ToolPolicy::deny(std::string_view tool_name) {
     deny_list_.insert(std::string(tool_name));
+    compile();
 }
 
 void ToolPolicy::set_profile(ToolProfile profile) {
     profile_ = profile;
+    compile();
+}
+
+auto ToolPolicy::tool_id(std::string_view tool_name) const -> std::optional<ToolId> {
+    auto it = ids_.find(tool_name);
+    if (it == ids_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
 }
 
 auto ToolPolicy::is_allowed(std::string_view tool_name,
                               std::string_view identity) const -> bool {
-    std::string name(tool_name);
+    auto id = tool_id(tool_name);
+    return id && is_allowed(*id, identity);
+}
 
-    // 1. Explicit deny always wins
-    if (deny_list_.contains(name)) {
+auto ToolPolicy::is_allowed(ToolId id, std::string_view identity) const -> bool {
+    if (id >= table_.size()) {
         return false;
     }
-
-    // 2. Owner-only tools require owner identity
-    if (owner_only_tools().contains(name)) {
-        return is_owner(identity);
+    switch (table_[id]) {
+        case Decision::Allow: return true;
+        case Decision::OwnerOnly: return is_owner(identity);
+        case Decision::Deny: break;
     }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// Decision table
+// ---------------------------------------------------------------------------
 
-    // 3. Explicit allow overrides profile restrictions
-    if (allow_list_.contains(name)) {
-        return true;
+auto ToolPolicy::intern(std::string_view tool_name) -> ToolId {
+    auto it = ids_.find(tool_name);
+    if (it != ids_.end()) {
+        return it->second;
     }
+    auto id = static_cast<ToolId>(ids_.size());
+    ids_.emplace(std::string(tool_name), id);
+    return id;
+}
 
-    // 4. Check against active profile
-    auto allowed = profile_tools(profile_);
-    return allowed.contains(name);
+void ToolPolicy::compile() {
+    // Every name any rule mentions gets an id; ids are never reused, so
+    // ones handed out earlier keep pointing at the same tool.
+    for (const auto& name : profile_tools(ToolProfile::Full)) intern(name);
+    for (const auto& name : allow_list_) intern(name);
+    for (const auto& name : deny_list_) intern(name);
+
+    const auto& profile = profile_tools(profile_);
+    const auto& owner_only = owner_only_tools();
+
+    table_.assign(ids_.size(), Decision::Deny);
+    for (const auto& [name, id] : ids_) {
+        // Same precedence as the rules are documented in:
+        // 1. Explicit deny always wins
+        // 2. Owner-only tools require owner identity
+        // 3. Explicit allow overrides profile restrictions
+        // 4. Otherwise the active profile decides
+        if (deny_list_.contains(name)) {
+            table_[id] = Decision::Deny;
+        } else if (owner_only.contains(name)) {
+            table_[id] = Decision::OwnerOnly;
+        } else if (allow_list_.contains(name) || profile.contains(name)) {
+            table_[id] = Decision::Allow;
+        }
+    }
 }
 
 } // namespace openclaw::gateway
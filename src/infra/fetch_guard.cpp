@@ -1,9 +1,9 @@
 #include "openclaw/infra/fetch_guard.hpp"
 
 #include "openclaw/core/logger.hpp"
+#include "openclaw/infra/html_sanitizer.hpp"
 
 #include <algorithm>
-#include <regex>
 #include <set>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/use_awaitable.hpp>
@@ -171,24 +171,7 @@ void FetchGuard::strip_cross_origin_headers(
 // ---------------------------------------------------------------------------
 
 auto FetchGuard::sanitize_html_content(std::string_view html) -> std::string {
-    std::string result(html);
-
-    // Remove elements with hidden styles/attributes
-    // Pattern: tags containing display:none, visibility:hidden, etc.
-    static const std::regex hidden_patterns[] = {
-        std::regex(R"(<[^>]*\bstyle\s*=\s*"[^"]*display\s*:\s*none[^"]*"[^>]*>.*?</[^>]+>)", std::regex::icase),
-        std::regex(R"(<[^>]*\bstyle\s*=\s*"[^"]*visibility\s*:\s*hidden[^"]*"[^>]*>.*?</[^>]+>)", std::regex::icase),
-        std::regex(R"(<[^>]*\bclass\s*=\s*"[^"]*\bsr-only\b[^"]*"[^>]*>.*?</[^>]+>)", std::regex::icase),
-        std::regex(R"(<[^>]*\baria-hidden\s*=\s*"true"[^>]*>.*?</[^>]+>)", std::regex::icase),
-        std::regex(R"(<[^>]*\bstyle\s*=\s*"[^"]*opacity\s*:\s*0[^"]*"[^>]*>.*?</[^>]+>)", std::regex::icase),
-        std::regex(R"(<[^>]*\bstyle\s*=\s*"[^"]*font-size\s*:\s*0[^"]*"[^>]*>.*?</[^>]+>)", std::regex::icase),
-    };
-
-    for (const auto& pattern : hidden_patterns) {
-        result = std::regex_replace(result, pattern, "");
-    }
-
-    return result;
+    return HtmlSanitizer::sanitize(html, {.output = HtmlSanitizer::Output::Html});
 }
 
 // ---------------------------------------------------------------------------
@@ -246,6 +229,37 @@ auto FetchGuard::validate_url(std::string_view url, boost::asio::io_context& ioc
     co_return ok_result();
 }
 
+auto FetchGuard::follow_redirect(const HttpResponse& response, std::string& current_url) -> bool {
+    // Check for redirect (3xx)
+    if (response.status < 300 || response.status >= 400) {
+        return false;
+    }
+    // Extract Location header
+    auto it = response.headers.find("location");
+    if (it == response.headers.end()) {
+        it = response.headers.find("Location");
+    }
+    if (it == response.headers.end() || it->second.empty()) {
+        return false;
+    }
+
+    std::string previous_url = current_url;
+    current_url = it->second;
+
+    // Check for cross-origin redirect and warn about header stripping
+    auto from_origin = extract_origin(previous_url);
+    auto to_origin = extract_origin(current_url);
+    if (from_origin != to_origin) {
+        LOG_WARN("FetchGuard: cross-origin redirect detected from {} to {}, "
+                 "sensitive headers (Authorization, Cookie, Proxy-Authorization) "
+                 "would be stripped",
+                 from_origin, to_origin);
+    }
+
+    LOG_DEBUG("FetchGuard: following redirect to {}", current_url);
+    return true;
+}
+
 auto FetchGuard::safe_fetch(std::string_view url,
                              HttpClient& http,
                              boost::asio::io_context& ioc,
@@ -277,30 +291,8 @@ auto FetchGuard::safe_fetch(std::string_view url,
             co_return make_fail(response.error());
         }
 
-        // Check for redirect (3xx)
-        if (response->status >= 300 && response->status < 400) {
-            // Extract Location header
-            auto it = response->headers.find("location");
-            if (it == response->headers.end()) {
-                it = response->headers.find("Location");
-            }
-            if (it != response->headers.end() && !it->second.empty()) {
-                std::string previous_url = current_url;
-                current_url = it->second;
-
-                // Check for cross-origin redirect and warn about header stripping
-                auto from_origin = extract_origin(previous_url);
-                auto to_origin = extract_origin(current_url);
-                if (from_origin != to_origin) {
-                    LOG_WARN("FetchGuard: cross-origin redirect detected from {} to {}, "
-                             "sensitive headers (Authorization, Cookie, Proxy-Authorization) "
-                             "would be stripped",
-                             from_origin, to_origin);
-                }
-
-                LOG_DEBUG("FetchGuard: following redirect to {}", current_url);
-                continue;
-            }
+        if (follow_redirect(*response, current_url)) {
+            continue;
         }
 
         co_return *response;
@@ -312,4 +304,56 @@ auto FetchGuard::safe_fetch(std::string_view url,
                    "max=" + std::to_string(max_redirects)));
 }
 
+auto FetchGuard::safe_fetch_text(std::string_view url,
+                                  HttpClient& http,
+                                  boost::asio::io_context& ioc,
+                                  size_t max_bytes,
+                                  int max_redirects)
+    -> boost::asio::awaitable<openclaw::Result<FetchedText>>
+{
+    std::string current_url(url);
+    std::set<std::string> visited;
+    HtmlSanitizer sanitizer({.output = HtmlSanitizer::Output::Text, .max_bytes = max_bytes});
+
+    for (int i = 0; i <= max_redirects; ++i) {
+        auto valid = co_await validate_url(current_url, ioc);
+        if (!valid) {
+            co_return make_fail(valid.error());
+        }
+        if (visited.contains(current_url)) {
+            co_return make_fail(
+                make_error(ErrorCode::InvalidArgument,
+                           "Redirect loop detected",
+                           current_url));
+        }
+        visited.insert(current_url);
+
+        // Only 2xx bodies reach the callback (on the client's thread);
+        // returning false once the cap is hit stops the download.
+        auto response = co_await http.get_stream(current_url, {},
+            [&sanitizer](const char* data, size_t length) {
+                return sanitizer.feed(std::string_view(data, length));
+            });
+        if (!response) {
+            co_return make_fail(response.error());
+        }
+
+        if (follow_redirect(*response, current_url)) {
+            continue;
+        }
+
+        FetchedText result;
+        result.status = response->status;
+        result.bytes_read = sanitizer.bytes_in();
+        result.text = sanitizer.finish();
+        result.truncated = sanitizer.truncated();
+        co_return result;
+    }
+
+    co_return make_fail(
+        make_error(ErrorCode::InvalidArgument,
+                   "Too many redirects",
+                   "max=" + std::to_string(max_redirects)));
+}
+
 } // namespace openclaw::infra
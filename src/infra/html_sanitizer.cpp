@@ -0,0 +1,659 @@
+#include "openclaw/infra/html_sanitizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+namespace openclaw::infra {
+
+namespace {
+
+constexpr size_t kMaxTagBytes = 16 * 1024;
+constexpr size_t kMaxEntityBytes = 32;
+
+auto is_space(char c) -> bool {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+auto is_alpha(char c) -> bool {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+auto is_alnum(char c) -> bool {
+    return is_alpha(c) || (c >= '0' && c <= '9');
+}
+
+auto lower(char c) -> char {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+auto lowered(std::string_view s) -> std::string {
+    std::string result(s);
+    std::transform(result.begin(), result.end(), result.begin(), lower);
+    return result;
+}
+
+auto one_of(std::string_view name, std::initializer_list<std::string_view> names) -> bool {
+    return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+auto is_void(std::string_view name) -> bool {
+    return one_of(name, {"area", "base", "br", "col", "embed", "hr", "img", "input",
+                         "link", "meta", "param", "source", "track", "wbr"});
+}
+
+/// Elements whose content is not markup.
+auto is_raw_text(std::string_view name) -> bool {
+    return one_of(name, {"script", "style", "textarea", "title", "xmp", "iframe",
+                         "noembed", "noframes"});
+}
+
+/// Elements without readable text, dropped in text mode.
+auto is_non_text(std::string_view name) -> bool {
+    return one_of(name, {"script", "style", "noscript", "template", "svg", "iframe",
+                         "noembed", "noframes", "head"});
+}
+
+/// Elements whose end tag may be left out; a start tag of the same name
+/// closes an open one.
+auto has_optional_end(std::string_view name) -> bool {
+    return one_of(name, {"p", "li", "dt", "dd", "option", "optgroup", "tr", "td", "th",
+                         "thead", "tbody", "tfoot", "rb", "rt", "rp", "colgroup"});
+}
+
+/// Elements that start a new scope for the ones above, e.g. a nested list
+/// whose <li> does not close the outer one.
+auto is_list_scope(std::string_view name) -> bool {
+    return one_of(name, {"ul", "ol", "dl", "table", "select", "datalist", "menu"});
+}
+
+/// Most open elements tracked; deeper ones are not.
+constexpr size_t kMaxOpenDepth = 256;
+
+/// Closes the innermost element named `name` in `stack` and everything
+/// opened inside it. Returns false if none is open.
+auto close_open(std::vector<std::string>& stack, std::string_view name) -> bool {
+    auto open = std::find(stack.rbegin(), stack.rend(), name);
+    if (open == stack.rend()) {
+        return false;
+    }
+    stack.erase(std::prev(open.base()), stack.end());
+    return true;
+}
+
+/// Line breaks a tag stands for in text mode.
+auto breaks_for(std::string_view name) -> int {
+    if (one_of(name, {"p", "h1", "h2", "h3", "h4", "h5", "h6", "table", "ul", "ol",
+                      "blockquote", "pre", "section", "article", "header", "footer",
+                      "nav", "aside", "main", "figure", "form", "dl", "hr"})) {
+        return 2;
+    }
+    if (one_of(name, {"br", "div", "li", "tr", "dt", "dd", "figcaption", "address",
+                      "title", "caption", "option", "body"})) {
+        return 1;
+    }
+    return 0;
+}
+
+/// Whether a CSS length or number is zero ("0", "0px", "0.0em").
+auto is_zero(std::string_view value) -> bool {
+    std::string copy(value);
+    char* end = nullptr;
+    double number = std::strtod(copy.c_str(), &end);
+    return end != copy.c_str() && number == 0.0;
+}
+
+auto style_hides(std::string_view style) -> bool {
+    std::string compact;
+    compact.reserve(style.size());
+    for (char c : style) {
+        if (!is_space(c)) {
+            compact += lower(c);
+        }
+    }
+    std::string_view rest(compact);
+    while (!rest.empty()) {
+        auto semicolon = rest.find(';');
+        auto declaration = rest.substr(0, semicolon);
+        rest = semicolon == std::string_view::npos ? std::string_view{} : rest.substr(semicolon + 1);
+
+        auto colon = declaration.find(':');
+        if (colon == std::string_view::npos) {
+            continue;
+        }
+        auto property = declaration.substr(0, colon);
+        auto value = declaration.substr(colon + 1);
+        if (auto bang = value.find('!'); bang != std::string_view::npos) {
+            value = value.substr(0, bang);
+        }
+        if ((property == "display" && value == "none") ||
+            (property == "visibility" && value == "hidden") ||
+            (property == "opacity" && is_zero(value)) ||
+            (property == "font-size" && is_zero(value))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto class_hides(std::string_view classes) -> bool {
+    size_t i = 0;
+    while (i < classes.size()) {
+        while (i < classes.size() && is_space(classes[i])) ++i;
+        auto start = i;
+        while (i < classes.size() && !is_space(classes[i])) ++i;
+        auto token = lowered(classes.substr(start, i - start));
+        if (token == "sr-only" || token == "visually-hidden") {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Checks the attributes of a start tag (`attrs` excludes the name).
+auto attributes_hide(std::string_view attrs) -> bool {
+    size_t i = 0;
+    while (i < attrs.size()) {
+        while (i < attrs.size() && (is_space(attrs[i]) || attrs[i] == '/')) ++i;
+        auto name_start = i;
+        while (i < attrs.size() && !is_space(attrs[i]) && attrs[i] != '=' && attrs[i] != '/') ++i;
+        auto name = lowered(attrs.substr(name_start, i - name_start));
+        if (name.empty()) {
+            ++i;
+            continue;
+        }
+
+        while (i < attrs.size() && is_space(attrs[i])) ++i;
+        std::string_view value;
+        if (i < attrs.size() && attrs[i] == '=') {
+            ++i;
+            while (i < attrs.size() && is_space(attrs[i])) ++i;
+            if (i < attrs.size() && (attrs[i] == '"' || attrs[i] == '\'')) {
+                char quote = attrs[i++];
+                auto end = attrs.find(quote, i);
+                if (end == std::string_view::npos) end = attrs.size();
+                value = attrs.substr(i, end - i);
+                i = end + 1;
+            } else {
+                auto start = i;
+                while (i < attrs.size() && !is_space(attrs[i])) ++i;
+                value = attrs.substr(start, i - start);
+            }
+        }
+
+        if (name == "hidden" ||
+            (name == "aria-hidden" && lowered(value) == "true") ||
+            (name == "class" && class_hides(value)) ||
+            (name == "style" && style_hides(value))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void append_utf8(std::string& out, uint32_t cp) {
+    if (cp == 0 || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+        cp = 0xFFFD;
+    }
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+constexpr std::array<std::pair<std::string_view, uint32_t>, 28> kEntities = {{
+    {"amp", '&'}, {"lt", '<'}, {"gt", '>'}, {"quot", '"'}, {"apos", '\''},
+    {"nbsp", ' '}, {"copy", 0xA9}, {"reg", 0xAE}, {"trade", 0x2122},
+    {"hellip", 0x2026}, {"mdash", 0x2014}, {"ndash", 0x2013},
+    {"lsquo", 0x2018}, {"rsquo", 0x2019}, {"ldquo", 0x201C}, {"rdquo", 0x201D},
+    {"laquo", 0xAB}, {"raquo", 0xBB}, {"bull", 0x2022}, {"middot", 0xB7},
+    {"euro", 0x20AC}, {"pound", 0xA3}, {"yen", 0xA5}, {"cent", 0xA2},
+    {"times", 0xD7}, {"divide", 0xF7}, {"deg", 0xB0}, {"sect", 0xA7},
+}};
+
+/// Decodes "&name;" or "&#NN;" (without '&' and ';'). Empty if unknown.
+auto decode_entity(std::string_view name) -> std::string {
+    std::string out;
+    if (name.size() > 1 && name[0] == '#') {
+        bool hex = name[1] == 'x' || name[1] == 'X';
+        auto digits = name.substr(hex ? 2 : 1);
+        if (digits.empty() || digits.size() > 8) {
+            return out;
+        }
+        uint32_t cp = 0;
+        for (char c : digits) {
+            int v = (c >= '0' && c <= '9') ? c - '0'
+                  : (hex && lower(c) >= 'a' && lower(c) <= 'f') ? lower(c) - 'a' + 10
+                  : -1;
+            if (v < 0) {
+                return out;
+            }
+            cp = cp * (hex ? 16 : 10) + static_cast<uint32_t>(v);
+        }
+        append_utf8(out, cp);
+        return out;
+    }
+    for (const auto& [entity, cp] : kEntities) {
+        if (entity == name) {
+            append_utf8(out, cp);
+            break;
+        }
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+HtmlSanitizer::HtmlSanitizer(Options options)
+    : options_(options) {}
+
+auto HtmlSanitizer::sanitize(std::string_view html, Options options) -> std::string {
+    HtmlSanitizer sanitizer(options);
+    sanitizer.feed(html);
+    return sanitizer.finish();
+}
+
+auto HtmlSanitizer::feed(std::string_view chunk) -> bool {
+    if (truncated_) {
+        return false;
+    }
+    bytes_in_ += chunk.size();
+
+    size_t i = 0;
+    while (i < chunk.size() && !truncated_) {
+        // Fast path: handle markup-free runs in one go
+        if (state_ == State::Data) {
+            auto end = chunk.find_first_of(text_mode() ? "<&" : "<", i);
+            if (end == std::string_view::npos) {
+                end = chunk.size();
+            }
+            if (end > i) {
+                if (!skipping()) {
+                    if (text_mode()) {
+                        text_run(chunk.substr(i, end - i));
+                    } else {
+                        emit(chunk.substr(i, end - i));
+                    }
+                }
+                i = end;
+                continue;
+            }
+        }
+        step(chunk[i++]);
+    }
+    return !truncated_;
+}
+
+auto HtmlSanitizer::finish() -> std::string {
+    if (!truncated_) {
+        switch (state_) {
+            case State::Entity:
+                text(std::string_view(entity_));
+                break;
+            case State::RawText:
+                if (!raw_match_.empty()) {
+                    auto pending = std::exchange(raw_match_, {});
+                    for (char c : pending) end_raw_candidate(c);
+                }
+                break;
+            default:
+                break;  // An unterminated tag or comment is dropped
+        }
+    }
+    state_ = State::Data;
+    return take();
+}
+
+auto HtmlSanitizer::take() -> std::string {
+    return std::exchange(out_, {});
+}
+
+// ---------------------------------------------------------------------------
+// Tokenizer
+// ---------------------------------------------------------------------------
+
+void HtmlSanitizer::step(char c) {
+    switch (state_) {
+        case State::Data: data(c); break;
+        case State::Tag: tag(c); break;
+        case State::Comment: comment(c); break;
+        case State::RawText: raw_text(c); break;
+        case State::Entity: entity(c); break;
+    }
+}
+
+void HtmlSanitizer::data(char c) {
+    if (c == '<') {
+        state_ = State::Tag;
+        tag_.assign(1, '<');
+        quote_ = 0;
+        after_equals_ = false;
+        tag_overflow_ = false;
+    } else if (c == '&' && text_mode()) {
+        state_ = State::Entity;
+        entity_.assign(1, '&');
+    } else if (text_mode()) {
+        text(c);
+    } else if (!skipping()) {
+        emit(std::string_view(&c, 1));
+    }
+}
+
+void HtmlSanitizer::tag(char c) {
+    if (tag_.size() == 1 && !is_alpha(c) && c != '/' && c != '!' && c != '?') {
+        // A lone '<' is text
+        state_ = State::Data;
+        if (text_mode()) {
+            text('<');
+        } else if (!skipping()) {
+            emit("<");
+        }
+        data(c);
+        return;
+    }
+
+    if (quote_) {
+        if (c == quote_) quote_ = 0;
+    } else if (c == '>') {
+        state_ = State::Data;
+        handle_tag();
+        return;
+    } else if (after_equals_ && (c == '"' || c == '\'')) {
+        quote_ = c;
+        after_equals_ = false;
+    } else if (c == '=') {
+        after_equals_ = true;
+    } else if (!is_space(c)) {
+        after_equals_ = false;
+    }
+
+    if (tag_.size() < kMaxTagBytes) {
+        tag_ += c;
+    } else {
+        tag_overflow_ = true;
+    }
+
+    if (tag_ == "<!--") {
+        state_ = State::Comment;
+        dashes_ = 0;
+    }
+}
+
+void HtmlSanitizer::comment(char c) {
+    if (c == '>' && dashes_ >= 2) {
+        state_ = State::Data;
+        return;
+    }
+    dashes_ = c == '-' ? dashes_ + 1 : 0;
+}
+
+void HtmlSanitizer::raw_text(char c) {
+    if (raw_match_.empty()) {
+        if (c == '<') {
+            raw_match_ = "<";
+        } else {
+            end_raw_candidate(c);
+        }
+        return;
+    }
+
+    // Looking for "</name" followed by whitespace, '/' or '>'
+    auto target_size = raw_name_.size() + 2;
+    if (raw_match_.size() == target_size) {
+        if (is_space(c) || c == '/' || c == '>') {
+            state_ = State::Tag;
+            tag_ = std::exchange(raw_match_, {});
+            quote_ = 0;
+            after_equals_ = false;
+            tag_overflow_ = false;
+            tag(c);
+            return;
+        }
+    } else {
+        auto expected = raw_match_.size() == 1 ? '/' : raw_name_[raw_match_.size() - 2];
+        if (lower(c) == expected) {
+            raw_match_ += c;
+            return;
+        }
+    }
+
+    // Not the end tag: the candidate was content
+    auto pending = std::exchange(raw_match_, {});
+    for (char p : pending) end_raw_candidate(p);
+    raw_text(c);
+}
+
+void HtmlSanitizer::end_raw_candidate(char c) {
+    if (skipping()) {
+        return;
+    }
+    if (!text_mode()) {
+        emit(std::string_view(&c, 1));
+    } else if (raw_name_ == "title" || raw_name_ == "textarea") {
+        text(c);
+    }
+}
+
+void HtmlSanitizer::entity(char c) {
+    if ((is_alnum(c) || (c == '#' && entity_.size() == 1)) && entity_.size() < kMaxEntityBytes) {
+        entity_ += c;
+        return;
+    }
+    state_ = State::Data;
+    if (c == ';') {
+        auto decoded = decode_entity(std::string_view(entity_).substr(1));
+        if (!decoded.empty()) {
+            text(std::string_view(decoded));
+            return;
+        }
+        entity_ += ';';
+        text(std::string_view(entity_));
+        return;
+    }
+    text(std::string_view(entity_));
+    data(c);
+}
+
+void HtmlSanitizer::handle_tag() {
+    std::string_view t(tag_);
+    if (t.size() < 2) {
+        return;
+    }
+    if (t[1] == '!' || t[1] == '?') {
+        // Doctype, CDATA or processing instruction; only a doctype survives
+        if (!text_mode() && !skipping() && lowered(t.substr(0, 9)) == "<!doctype") {
+            emit(t);
+            emit(">");
+        }
+        return;
+    }
+
+    bool end = t[1] == '/';
+    size_t name_start = end ? 2 : 1;
+    size_t name_end = name_start;
+    while (name_end < t.size() && !is_space(t[name_end]) && t[name_end] != '/') {
+        ++name_end;
+    }
+    auto name = lowered(t.substr(name_start, name_end - name_start));
+    if (name.empty()) {
+        return;
+    }
+    bool self_closing = !tag_overflow_ && t.back() == '/';
+    bool opens = !end && !self_closing && !is_void(name);
+
+    if (end && skipping()) {
+        // An end tag closes the innermost open element of its name. One
+        // for an element open around the hidden one closes that too, as
+        // when a hidden <li> or <p> leaves out its own end tag.
+        if (close_open(skip_stack_, name) ||
+            std::find(open_.begin(), open_.end(), name) == open_.end()) {
+            return;
+        }
+        skip_stack_.clear();
+    }
+
+    if (end) {
+        close_open(open_, name);
+        if (text_mode()) {
+            line_break(breaks_for(name));
+        } else {
+            emit(t);
+            emit(">");
+        }
+        return;
+    }
+
+    if (opens && is_raw_text(name)) {
+        state_ = State::RawText;
+        raw_name_ = name;
+        raw_match_.clear();
+    }
+
+    if (skipping() && opens && name == skip_stack_.front() && has_optional_end(name) &&
+        std::none_of(skip_stack_.begin() + 1, skip_stack_.end(),
+                     [](const std::string& inner) { return is_list_scope(inner); })) {
+        // A sibling of a hidden <li>, <p>, ... whose end tag was left out
+        skip_stack_.clear();
+    }
+    if (skipping()) {
+        if (opens && skip_stack_.size() < kMaxOpenDepth) {
+            skip_stack_.push_back(name);
+        }
+        return;
+    }
+
+    bool hide = tag_overflow_ || attributes_hide(t.substr(name_end)) ||
+                (text_mode() && is_non_text(name));
+    if (hide) {
+        if (opens) {
+            skip_stack_.push_back(name);
+        }
+        return;
+    }
+    if (opens) {
+        if (has_optional_end(name) && !open_.empty() && open_.back() == name) {
+            open_.pop_back();
+        }
+        if (open_.size() < kMaxOpenDepth) {
+            open_.push_back(name);
+        }
+    }
+
+    if (text_mode()) {
+        if (name == "td" || name == "th") {
+            pending_space_ = has_text_;
+        } else if (name == "img") {
+            // Images have no text of their own
+        } else {
+            line_break(breaks_for(name));
+        }
+    } else {
+        emit(t);
+        emit(">");
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Output
+// ---------------------------------------------------------------------------
+
+void HtmlSanitizer::emit(std::string_view s) {
+    append(s);
+}
+
+void HtmlSanitizer::text(char c) {
+    if (skipping()) {
+        return;
+    }
+    if (is_space(c)) {
+        pending_space_ = has_text_;
+        return;
+    }
+    flush_spacing();
+    append(std::string_view(&c, 1));
+    has_text_ = true;
+}
+
+void HtmlSanitizer::text(std::string_view s) {
+    for (char c : s) {
+        text(c);
+    }
+}
+
+void HtmlSanitizer::text_run(std::string_view s) {
+    size_t i = 0;
+    while (i < s.size()) {
+        if (is_space(s[i])) {
+            pending_space_ = has_text_;
+            ++i;
+            continue;
+        }
+        auto start = i;
+        while (i < s.size() && !is_space(s[i])) ++i;
+        flush_spacing();
+        append(s.substr(start, i - start));
+        has_text_ = true;
+    }
+}
+
+void HtmlSanitizer::line_break(int count) {
+    if (count > 0 && has_text_) {
+        pending_breaks_ = std::max(pending_breaks_, count);
+        pending_space_ = false;
+    }
+}
+
+void HtmlSanitizer::flush_spacing() {
+    if (pending_breaks_ > 0) {
+        append(std::string(static_cast<size_t>(pending_breaks_), '\n'));
+    } else if (pending_space_) {
+        append(" ");
+    }
+    pending_breaks_ = 0;
+    pending_space_ = false;
+}
+
+void HtmlSanitizer::append(std::string_view s) {
+    if (truncated_) {
+        return;
+    }
+    if (options_.max_bytes > 0 && bytes_out_ + s.size() > options_.max_bytes) {
+        s = s.substr(0, options_.max_bytes - bytes_out_);
+        truncated_ = true;
+    }
+    out_.append(s);
+    bytes_out_ += s.size();
+
+    if (truncated_) {
+        // Drop a UTF-8 sequence the cap cut in half
+        size_t lead = out_.size();
+        while (lead > 0 && out_.size() - lead < 4 &&
+               (static_cast<unsigned char>(out_[lead - 1]) & 0xC0) == 0x80) {
+            --lead;
+        }
+        if (lead > 0) {
+            auto byte = static_cast<unsigned char>(out_[lead - 1]);
+            size_t length = byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : byte >= 0xC0 ? 2 : 1;
+            if (out_.size() - (lead - 1) < length) {
+                bytes_out_ -= out_.size() - (lead - 1);
+                out_.resize(lead - 1);
+            }
+        }
+    }
+}
+
+} // namespace openclaw::infra
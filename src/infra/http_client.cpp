@@ -206,6 +206,24 @@ auto HttpClient::post_stream(std::string_view path,
                              const std::map<std::string, std::string>& headers,
                              HttpChunkCallback chunk_cb)
     -> boost::asio::awaitable<openclaw::Result<HttpResponse>> {
+    co_return co_await stream_request("POST", path, body, content_type, headers,
+                                      std::move(chunk_cb));
+}
+
+auto HttpClient::get_stream(std::string_view path,
+                            const std::map<std::string, std::string>& headers,
+                            HttpChunkCallback chunk_cb)
+    -> boost::asio::awaitable<openclaw::Result<HttpResponse>> {
+    co_return co_await stream_request("GET", path, {}, {}, headers, std::move(chunk_cb));
+}
+
+auto HttpClient::stream_request(std::string method,
+                                std::string_view path,
+                                std::string_view body,
+                                std::string_view content_type,
+                                const std::map<std::string, std::string>& headers,
+                                HttpChunkCallback chunk_cb)
+    -> boost::asio::awaitable<openclaw::Result<HttpResponse>> {
 
     // Shared state between background thread and coroutine.
     struct StreamState {
@@ -226,6 +244,7 @@ auto HttpClient::post_stream(std::string_view path,
     std::thread([
         state, timer,
         chunk_cb = std::move(chunk_cb),
+        method = std::move(method),
         p = std::string(path),
         b = std::string(body),
         ct = std::string(content_type),
@@ -234,7 +253,7 @@ auto HttpClient::post_stream(std::string_view path,
         timeout, verify_ssl,
         default_headers = std::move(default_headers)
     ]() mutable {
-        LOG_DEBUG("post_stream: background thread started for {}{}", base_url, p);
+        LOG_DEBUG("stream_request: background thread started for {} {}{}", method, base_url, p);
 
         // Create fresh client (httplib::Client is not thread-safe).
         httplib::Client client(base_url);
@@ -253,11 +272,13 @@ auto HttpClient::post_stream(std::string_view path,
 
         // Build request with content_receiver for streaming.
         httplib::Request req;
-        req.method = "POST";
+        req.method = method;
         req.path = p;
         req.headers = extra_hdrs;
         req.body = b;
-        req.set_header("Content-Type", ct);
+        if (!ct.empty()) {
+            req.set_header("Content-Type", ct);
+        }
 
         // Track status to distinguish success (stream) vs error (buffer).
         int status_code = 0;
@@ -268,12 +289,14 @@ auto HttpClient::post_stream(std::string_view path,
             return true;
         };
 
+        bool stopped = false;  // The callback ended the transfer
         req.content_receiver =
-            [&chunk_cb, &error_body, &status_code](
+            [&chunk_cb, &error_body, &status_code, &stopped](
                 const char* data, size_t data_length,
                 uint64_t /*offset*/, uint64_t /*total_length*/) -> bool {
                 if (status_code >= 200 && status_code < 300) {
-                    return chunk_cb(data, data_length);
+                    stopped = !chunk_cb(data, data_length);
+                    return !stopped;
                 } else {
                     // Buffer error response body for caller.
                     error_body.append(data, data_length);
@@ -287,7 +310,12 @@ auto HttpClient::post_stream(std::string_view path,
 
         // Build result.
         openclaw::Result<HttpResponse> result;
-        if (!ok) {
+        if (!ok && stopped) {
+            // Not a failure: the caller has what it wanted
+            HttpResponse http_resp;
+            http_resp.status = status_code;
+            result = std::move(http_resp);
+        } else if (!ok) {
             if (error == httplib::Error::ConnectionTimeout) {
                 result = std::unexpected(
                     openclaw::make_error(ErrorCode::Timeout,
@@ -318,7 +346,7 @@ auto HttpClient::post_stream(std::string_view path,
         boost::asio::post(timer->get_executor(),
                           [timer] { timer->cancel(); });
 
-        LOG_DEBUG("post_stream: background thread finished, status={}",
+        LOG_DEBUG("stream_request: background thread finished, status={}",
                   status_code);
     }).detach();
 
@@ -7,12 +7,116 @@
 
 #include <jwt-cpp/jwt.h>
 #include <jwt-cpp/traits/nlohmann-json/traits.h>
+#include <openssl/sha.h>
+
+#include <optional>
 
 namespace openclaw::infra {
 
 // Type aliases for the nlohmann_json traits
 using nl_traits = jwt::traits::nlohmann_json;
 using nl_claim = jwt::basic_claim<nl_traits>;
+using nl_verifier = decltype(jwt::verify<nl_traits>());
+
+namespace {
+
+auto make_verifier(const std::string& secret, std::chrono::seconds leeway) -> nl_verifier {
+    return jwt::verify<nl_traits>()
+        .allow_algorithm(jwt::algorithm::hs256{secret})
+        .leeway(static_cast<size_t>(leeway.count()));
+}
+
+/// A token that passed one of the verifiers.
+struct Verified {
+    json claims;
+    std::optional<std::chrono::system_clock::time_point> expires;
+};
+
+/// Decodes `token` once and checks it against each verifier in turn; only
+/// a bad signature moves on to the next one.
+auto verify_with(const std::vector<nl_verifier>& verifiers, std::string_view token)
+    -> openclaw::Result<Verified> {
+    if (verifiers.empty()) {
+        return std::unexpected(
+            openclaw::make_error(ErrorCode::Unauthorized, "No JWT keys configured"));
+    }
+    try {
+        auto decoded = jwt::decode<nl_traits>(std::string(token));
+        for (size_t i = 0; i < verifiers.size(); ++i) {
+            try {
+                verifiers[i].verify(decoded);
+                break;
+            } catch (const jwt::error::signature_verification_exception&) {
+                if (i + 1 == verifiers.size()) {
+                    throw;
+                }
+            }
+        }
+
+        // get_payload_json() returns the claims as a json object
+        Verified verified{decoded.get_payload_json(), std::nullopt};
+        if (decoded.has_expires_at()) {
+            verified.expires = decoded.get_expires_at();
+        }
+
+        LOG_DEBUG("JWT token verified successfully");
+        return verified;
+
+    } catch (const jwt::error::signature_verification_exception& e) {
+        LOG_WARN("JWT signature verification failed: {}", e.what());
+        return std::unexpected(
+            openclaw::make_error(ErrorCode::Unauthorized,
+                                "JWT signature verification failed", e.what()));
+    } catch (const jwt::error::token_verification_exception& e) {
+        LOG_WARN("JWT verification failed: {}", e.what());
+        return std::unexpected(
+            openclaw::make_error(ErrorCode::Unauthorized,
+                                "JWT verification failed", e.what()));
+    } catch (const std::exception& e) {
+        LOG_ERROR("JWT decode error: {}", e.what());
+        return std::unexpected(
+            openclaw::make_error(ErrorCode::InvalidArgument,
+                                "Invalid JWT token", e.what()));
+    }
+}
+
+auto revoked_error() -> Error {
+    return openclaw::make_error(ErrorCode::Unauthorized, "JWT has been revoked");
+}
+
+/// `secrets` if they are usable, otherwise none, so nothing verifies.
+auto usable_secrets(std::vector<std::string> secrets) -> std::vector<std::string> {
+    if (auto valid = validate_jwt_secrets(secrets); !valid) {
+        LOG_ERROR("JWT keys rejected, refusing every token: {}", valid.error().what());
+        return {};
+    }
+    return secrets;
+}
+
+} // anonymous namespace
+
+auto validate_jwt_secrets(const std::vector<std::string>& secrets) -> openclaw::Result<void> {
+    if (secrets.empty()) {
+        return std::unexpected(openclaw::make_error(
+            ErrorCode::InvalidArgument, "No JWT secret configured"));
+    }
+    for (size_t i = 0; i < secrets.size(); ++i) {
+        const auto& secret = secrets[i];
+        if (secret.empty()) {
+            return std::unexpected(openclaw::make_error(
+                ErrorCode::InvalidArgument, "JWT secret is empty",
+                "jwt_secrets[" + std::to_string(i) + "]"));
+        }
+        auto ref = secret.find("${");
+        if (ref != std::string::npos && secret.find('}', ref) != std::string::npos) {
+            return std::unexpected(openclaw::make_error(
+                ErrorCode::InvalidArgument,
+                "JWT secret holds an unresolved environment reference",
+                "jwt_secrets[" + std::to_string(i) + "]"));
+        }
+    }
+    return {};
+}
 
 auto create_token(const json& claims,
                   std::string_view secret,
@@ -41,36 +145,13 @@ auto create_token(const json& claims,
 
 auto verify_token(std::string_view token,
                   std::string_view secret) -> openclaw::Result<json> {
-    try {
-        auto verifier = jwt::verify<nl_traits>()
-            .allow_algorithm(jwt::algorithm::hs256{std::string(secret)})
-            .leeway(5);       // 5 second leeway for clock skew
-
-        auto decoded = jwt::decode<nl_traits>(std::string(token));
-        verifier.verify(decoded);
-
-        // get_payload_json() returns the claims as a json object
-        json payload = decoded.get_payload_json();
-
-        LOG_DEBUG("JWT token verified successfully");
-        return payload;
-
-    } catch (const jwt::error::signature_verification_exception& e) {
-        LOG_WARN("JWT signature verification failed: {}", e.what());
-        return std::unexpected(
-            openclaw::make_error(ErrorCode::Unauthorized,
-                                "JWT signature verification failed", e.what()));
-    } catch (const jwt::error::token_verification_exception& e) {
-        LOG_WARN("JWT verification failed: {}", e.what());
-        return std::unexpected(
-            openclaw::make_error(ErrorCode::Unauthorized,
-                                "JWT verification failed", e.what()));
-    } catch (const std::exception& e) {
-        LOG_ERROR("JWT decode error: {}", e.what());
-        return std::unexpected(
-            openclaw::make_error(ErrorCode::InvalidArgument,
-                                "Invalid JWT token", e.what()));
+    std::vector<nl_verifier> verifiers;
+    verifiers.push_back(make_verifier(std::string(secret), std::chrono::seconds{5}));
+    auto verified = verify_with(verifiers, token);
+    if (!verified) {
+        return std::unexpected(verified.error());
     }
+    return std::move(verified->claims);
 }
 
 auto decode_token_unverified(std::string_view token) -> openclaw::Result<json> {
@@ -88,4 +169,154 @@ auto decode_token_unverified(std::string_view token) -> openclaw::Result<json> {
     }
 }
 
+// ---------------------------------------------------------------------------
+// JwtVerifier
+// ---------------------------------------------------------------------------
+
+struct JwtVerifier::Keys {
+    Keys(const std::vector<std::string>& secrets, std::chrono::seconds leeway) {
+        verifiers.reserve(secrets.size());
+        for (const auto& secret : secrets) {
+            verifiers.push_back(make_verifier(secret, leeway));
+        }
+    }
+
+    std::vector<nl_verifier> verifiers;
+};
+
+JwtVerifier::JwtVerifier(std::vector<std::string> secrets, Options options)
+    : options_(options),
+      keys_(std::make_shared<const Keys>(usable_secrets(std::move(secrets)), options.leeway)) {}
+
+JwtVerifier::~JwtVerifier() = default;
+
+auto JwtVerifier::digest(std::string_view token) -> std::string {
+    std::string hash(SHA256_DIGEST_LENGTH, '\0');
+    SHA256(reinterpret_cast<const unsigned char*>(token.data()), token.size(),
+           reinterpret_cast<unsigned char*>(hash.data()));
+    return hash;
+}
+
+auto JwtVerifier::verify(std::string_view token) -> openclaw::Result<json> {
+    auto now = Clock::now();
+    auto key = digest(token);
+
+    std::shared_ptr<const json> claims;
+    std::shared_ptr<const Keys> keys;
+    std::shared_ptr<const RevocationHook> hook;
+    uint64_t generation = 0;
+    {
+        std::lock_guard lock(mutex_);
+        if (auto it = revoked_.find(key); it != revoked_.end()) {
+            if (now < it->second) {
+                ++stats_.revoked;
+                return std::unexpected(revoked_error());
+            }
+            revoked_.erase(it);
+        }
+        if (auto it = cache_.find(key); it != cache_.end()) {
+            if (now < it->second.expires) {
+                ++stats_.hits;
+                claims = it->second.claims;
+            } else {
+                by_expiry_.erase({it->second.expires, key});
+                cache_.erase(it);
+            }
+        }
+        if (!claims) {
+            ++stats_.misses;
+            keys = keys_;
+            generation = generation_;
+        }
+        hook = revocation_hook_;
+    }
+
+    if (!claims) {
+        auto verified = verify_with(keys->verifiers, token);
+        if (!verified) {
+            std::lock_guard lock(mutex_);
+            ++stats_.rejected;
+            return std::unexpected(verified.error());
+        }
+        claims = std::make_shared<const json>(std::move(verified->claims));
+
+        // Only tokens with a lifetime are cached, and never across a rotation
+        if (verified->expires && *verified->expires > now) {
+            std::lock_guard lock(mutex_);
+            if (generation == generation_ && !cache_.contains(key)) {
+                make_room(now);
+                cache_.emplace(key, Entry{claims, *verified->expires});
+                by_expiry_.emplace(*verified->expires, key);
+            }
+        }
+    }
+
+    if (hook && (*hook)(*claims)) {
+        std::lock_guard lock(mutex_);
+        ++stats_.revoked;
+        if (auto it = cache_.find(key); it != cache_.end()) {
+            by_expiry_.erase({it->second.expires, key});
+            cache_.erase(it);
+        }
+        return std::unexpected(revoked_error());
+    }
+    return *claims;
+}
+
+void JwtVerifier::make_room(Clock::time_point now) {
+    while (!by_expiry_.empty() &&
+           (by_expiry_.begin()->first <= now || cache_.size() >= options_.max_entries)) {
+        cache_.erase(by_expiry_.begin()->second);
+        by_expiry_.erase(by_expiry_.begin());
+    }
+}
+
+auto JwtVerifier::set_keys(std::vector<std::string> secrets) -> openclaw::Result<void> {
+    if (auto valid = validate_jwt_secrets(secrets); !valid) {
+        return valid;
+    }
+    auto keys = std::make_shared<const Keys>(secrets, options_.leeway);
+    std::lock_guard lock(mutex_);
+    keys_ = std::move(keys);
+    ++generation_;
+    cache_.clear();
+    by_expiry_.clear();
+    LOG_INFO("JWT verifier keys replaced ({} active)", secrets.size());
+    return {};
+}
+
+void JwtVerifier::revoke(std::string_view token) {
+    auto key = digest(token);
+    auto expires = Clock::time_point::max();
+    if (auto payload = decode_token_unverified(token);
+        payload && payload->contains("exp") && (*payload)["exp"].is_number_integer()) {
+        expires = Clock::time_point(std::chrono::seconds((*payload)["exp"].get<int64_t>())) +
+                  options_.leeway;
+    }
+
+    std::lock_guard lock(mutex_);
+    if (auto it = cache_.find(key); it != cache_.end()) {
+        by_expiry_.erase({it->second.expires, key});
+        cache_.erase(it);
+    }
+    if (revoked_.size() >= options_.max_entries) {
+        auto now = Clock::now();
+        std::erase_if(revoked_, [now](const auto& entry) { return entry.second <= now; });
+    }
+    revoked_[key] = expires;
+}
+
+void JwtVerifier::set_revocation_hook(RevocationHook hook) {
+    auto shared = hook ? std::make_shared<const RevocationHook>(std::move(hook)) : nullptr;
+    std::lock_guard lock(mutex_);
+    revocation_hook_ = std::move(shared);
+}
+
+auto JwtVerifier::stats() const -> JwtVerifierStats {
+    std::lock_guard lock(mutex_);
+    auto stats = stats_;
+    stats.cached = cache_.size();
+    return stats;
+}
+
 } // namespace openclaw::infra
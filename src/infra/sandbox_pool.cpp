@@ -0,0 +1,940 @@
+#include "openclaw/infra/sandbox_pool.hpp"
+
+#include "openclaw/core/logger.hpp"
+#include "openclaw/infra/sandbox_network.hpp"
+#include "openclaw/infra/sandbox_paths.hpp"
+
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace openclaw::infra {
+
+namespace fs = std::filesystem;
+namespace net = boost::asio;
+
+namespace {
+
+constexpr size_t kMaxCodeBytes = 1 << 20;
+constexpr int kExitSetupFailed = 126;  // Child could not isolate itself
+constexpr int kExitExecFailed = 127;
+
+// Job loops. Each reads "<size>\n<code>" from stdin, runs the code with
+// its output captured and writes "<exit> <out size> <err size>\n<out><err>"
+// to fd 3. stdout and stderr are /dev/null, so a snippet that writes to
+// them directly cannot break the framing.
+
+constexpr const char* kShellRunner = R"sh(
+while IFS= read -r n; do
+  case $n in ''|*[!0-9]*) exit 2 ;; esac
+  head -c "$n" > .openclaw-job
+  ( . ./.openclaw-job ) < /dev/null > .openclaw-out 2> .openclaw-err 3>&-
+  rc=$?
+  printf '%s %s %s\n' "$rc" $(wc -c < .openclaw-out) $(wc -c < .openclaw-err) >&3
+  cat .openclaw-out .openclaw-err >&3
+  rm -f .openclaw-job .openclaw-out .openclaw-err
+done
+)sh";
+
+constexpr const char* kPythonRunner = R"py(
+import contextlib, io, os, sys, traceback
+home = os.getcwd()
+src = sys.stdin.buffer
+dst = os.fdopen(3, 'wb')
+while True:
+    line = src.readline()
+    if not line:
+        break
+    code = src.read(int(line)).decode('utf-8', 'replace')
+    os.chdir(home)
+    sys.stdin = io.StringIO()
+    out, err, rc = io.StringIO(), io.StringIO(), 0
+    with contextlib.redirect_stdout(out), contextlib.redirect_stderr(err):
+        try:
+            exec(compile(code, '<code_run>', 'exec'), {'__name__': '__main__'})
+        except SystemExit as e:
+            rc = e.code if isinstance(e.code, int) else int(e.code is not None)
+        except BaseException as e:
+            traceback.print_exception(type(e), e, e.__traceback__.tb_next)
+            rc = 1
+    o, e = out.getvalue().encode(), err.getvalue().encode()
+    dst.write(b'%d %d %d\n' % (rc, len(o), len(e)) + o + e)
+    dst.flush()
+)py";
+
+constexpr const char* kNodeRunner = R"js(
+const fs = require('fs'), util = require('util'), vm = require('vm');
+const home = process.cwd();
+let pending = Buffer.alloc(0);
+function writeAll(buf) {
+  let off = 0;
+  while (off < buf.length) {
+    try { off += fs.writeSync(3, buf, off); } catch (e) { if (e.code !== 'EAGAIN') throw e; }
+  }
+}
+function run(code) {
+  process.chdir(home);
+  let out = '', err = '', rc = 0;
+  const sink = (append) => (...args) => append(util.format(...args) + '\n');
+  const toOut = sink((s) => { out += s; }), toErr = sink((s) => { err += s; });
+  const exit = (c) => { throw { exitCode: c === undefined ? 0 : c }; };
+  const context = {
+    console: { log: toOut, info: toOut, debug: toOut, error: toErr, warn: toErr },
+    process: { env: process.env, argv: [], cwd: process.cwd, exit },
+    require,
+  };
+  try {
+    vm.runInNewContext(code, context, { filename: 'code_run' });
+  } catch (e) {
+    if (e && e.exitCode !== undefined) { rc = e.exitCode; }
+    else {
+      const stack = e && e.stack ? e.stack.split('\n') : [String(e)];
+      err += stack.filter((l) => !/\(node:|\[eval\]/.test(l)).join('\n') + '\n';
+      rc = 1;
+    }
+  }
+  const o = Buffer.from(out), e = Buffer.from(err);
+  writeAll(Buffer.concat([Buffer.from(`${rc} ${o.length} ${e.length}\n`), o, e]));
+}
+process.stdin.on('data', (chunk) => {
+  pending = Buffer.concat([pending, chunk]);
+  for (;;) {
+    const nl = pending.indexOf(10);
+    if (nl < 0) return;
+    const size = parseInt(pending.subarray(0, nl).toString(), 10);
+    if (pending.length < nl + 1 + size) return;
+    const code = pending.subarray(nl + 1, nl + 1 + size).toString();
+    pending = pending.subarray(nl + 1 + size);
+    run(code);
+  }
+});
+)js";
+
+struct Runner {
+    std::string_view name;
+    std::string_view interpreter;
+    std::string_view script_flag;
+    const char* script;
+    bool job_in_child;  // Jobs run in a subshell; the loop's own children are helpers
+};
+
+constexpr Runner kRunners[] = {
+    {"python", "python3", "-c", kPythonRunner, false},
+    {"node", "node", "-e", kNodeRunner, false},
+    {"shell", "/bin/sh", "-c", kShellRunner, true},
+};
+
+auto find_runner(std::string_view name) -> const Runner* {
+    for (const auto& runner : kRunners) {
+        if (runner.name == name) {
+            return &runner;
+        }
+    }
+    return nullptr;
+}
+
+/// Runtimes when none are configured. V8 reserves gigabytes of address
+/// space up front, so node needs a looser RLIMIT_AS than the default.
+auto default_runtimes() -> std::vector<CodeRuntimeConfig> {
+    return {
+        {.name = "python"},
+        {.name = "node", .memory_mb = 4096},
+        {.name = "shell"},
+    };
+}
+
+auto valid_runtime_name(std::string_view name) -> bool {
+    return !name.empty() && name.size() <= 32 &&
+           std::all_of(name.begin(), name.end(), [](char c) {
+               return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+           });
+}
+
+/// Looks `program` up on PATH unless it already names a file.
+auto find_executable(const std::string& program) -> std::optional<std::string> {
+    if (program.find('/') != std::string::npos) {
+        return ::access(program.c_str(), X_OK) == 0 ? std::optional(program) : std::nullopt;
+    }
+    const char* path = std::getenv("PATH");
+    std::string_view dirs = path ? path : "/usr/local/bin:/usr/bin:/bin";
+    while (!dirs.empty()) {
+        auto end = dirs.find(':');
+        auto dir = dirs.substr(0, end);
+        dirs = end == std::string_view::npos ? std::string_view{} : dirs.substr(end + 1);
+        if (dir.empty()) {
+            continue;
+        }
+        auto candidate = std::string(dir) + "/" + program;
+        if (::access(candidate.c_str(), X_OK) == 0) {
+            return candidate;
+        }
+    }
+    return std::nullopt;
+}
+
+/// Checks in a throwaway child whether this process may create a
+/// network namespace, directly or inside a user namespace.
+auto can_isolate_network() -> bool {
+    pid_t pid = ::fork();
+    if (pid == 0) {
+        bool ok = ::unshare(CLONE_NEWNET) == 0 || ::unshare(CLONE_NEWUSER | CLONE_NEWNET) == 0;
+        ::_exit(ok ? 0 : 1);
+    }
+    if (pid < 0) {
+        return false;
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+auto write_file(const fs::path& path, const std::string& value) -> bool {
+    std::ofstream file(path);
+    file << value;
+    file.flush();
+    return static_cast<bool>(file);
+}
+
+/// Reads the parent of a live process from /proc/<pid>/stat.
+auto read_process(pid_t pid, pid_t& parent) -> bool {
+    std::ifstream file("/proc/" + std::to_string(pid) + "/stat");
+    std::string stat;
+    std::getline(file, stat);
+    auto name_end = stat.rfind(')');  // The command name may hold anything
+    char state = 0;
+    if (name_end == std::string::npos ||
+        std::sscanf(stat.c_str() + name_end + 1, " %c %d", &state, &parent) != 2) {
+        return false;
+    }
+    return state != 'Z';
+}
+
+/// Children of `pid`, from the /proc children list of each of its threads.
+auto child_processes(pid_t pid) -> std::vector<pid_t> {
+    std::vector<pid_t> children;
+    std::error_code ec;
+    for (const auto& task : fs::directory_iterator("/proc/" + std::to_string(pid) + "/task", ec)) {
+        std::ifstream list(task.path() / "children");
+        for (pid_t child = 0; list >> child;) {
+            children.push_back(child);
+        }
+    }
+    return children;
+}
+
+/// Processes a worker's job left behind: the members of its cgroup when it
+/// has one, else the orphans the reaper adopted and the interpreter's own
+/// children. The reaper is a child subreaper, so whatever the job starts
+/// stays below it, even in a session of its own. With `skip_children` the
+/// interpreter's children are left out.
+auto stray_processes(pid_t reaper, pid_t interpreter, const fs::path& cgroup,
+                     bool skip_children) -> std::vector<pid_t> {
+    std::vector<pid_t> candidates;
+    if (!cgroup.empty()) {
+        std::ifstream procs(cgroup / "cgroup.procs");
+        for (pid_t pid = 0; procs >> pid;) {
+            candidates.push_back(pid);
+        }
+    } else {
+        candidates = child_processes(reaper);
+        if (!skip_children && interpreter > 0) {
+            std::ranges::copy(child_processes(interpreter), std::back_inserter(candidates));
+        }
+    }
+
+    std::vector<pid_t> stray;
+    for (pid_t pid : candidates) {
+        pid_t parent = 0;
+        if (pid == reaper || pid == interpreter || !read_process(pid, parent)) {
+            continue;
+        }
+        if (skip_children && parent == interpreter) {
+            continue;
+        }
+        stray.push_back(pid);
+    }
+    return stray;
+}
+
+/// Runs in the forked reaper until the interpreter exits, reaping the
+/// orphans it adopts, then exits the way the interpreter did. Only makes
+/// async-signal-safe calls.
+[[noreturn]] void reap_until_exit(pid_t interpreter) {
+    for (;;) {
+        int status = 0;
+        pid_t pid = ::waitpid(-1, &status, 0);
+        if (pid < 0 && errno != EINTR) {
+            ::_exit(kExitSetupFailed);
+        }
+        if (pid != interpreter) {
+            continue;
+        }
+        if (WIFSIGNALED(status)) {
+            ::signal(WTERMSIG(status), SIG_DFL);
+            ::kill(::getpid(), WTERMSIG(status));
+        }
+        ::_exit(WIFEXITED(status) ? WEXITSTATUS(status) : kExitSetupFailed);
+    }
+}
+
+auto elapsed_since(std::chrono::steady_clock::time_point start) -> std::chrono::milliseconds {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+}
+
+} // anonymous namespace
+
+auto CodeRunResult::to_json() const -> json {
+    return json{
+        {"exit_code", exit_code},
+        {"stdout", out},
+        {"stderr", err},
+        {"truncated", truncated},
+        {"reused", reused},
+        {"duration_ms", duration.count()},
+    };
+}
+
+// ---------------------------------------------------------------------------
+// SandboxPool
+// ---------------------------------------------------------------------------
+
+/// One interpreter process and the gateway's end of its job channel.
+struct SandboxPool::Worker {
+    pid_t pid = -1;          // The reaper: session and process group leader
+    pid_t interpreter = -1;  // Its child running the job loop
+    size_t slot = 0;
+    fs::path dir;
+    fs::path cgroup;  // Empty without one
+    net::local::stream_protocol::socket channel;
+    uint64_t jobs = 0;
+    bool busy = false;
+    bool killed = false;  // By the job timeout
+
+    explicit Worker(net::io_context& ioc) : channel(ioc) {}
+};
+
+SandboxPool::SandboxPool(net::io_context& ioc, CodeSandboxConfig config, fs::path work_dir)
+    : ioc_(ioc)
+    , config_(std::move(config))
+    , work_dir_(std::move(work_dir)) {
+    if (config_.runtimes.empty()) {
+        config_.runtimes = default_runtimes();
+    }
+}
+
+SandboxPool::~SandboxPool() {
+    stop();
+}
+
+auto SandboxPool::start() -> Result<void> {
+    auto mode = normalize_network_mode(config_.network_mode);
+    if (!validate_sandbox_network_mode(mode)) {
+        return std::unexpected(make_error(ErrorCode::Forbidden,
+            "Network mode not allowed for code sandbox", mode));
+    }
+    // A bare process has no bridge to attach to: every mode other than
+    // "none" shares the gateway's network
+    isolate_network_ = mode.empty() || mode == "none";
+    if (isolate_network_ && !can_isolate_network()) {
+        return std::unexpected(make_error(ErrorCode::Forbidden,
+            "Cannot create a network namespace for sandbox workers",
+            "set sandbox.code.network_mode to allow network access"));
+    }
+
+    std::error_code ec;
+    fs::create_directories(work_dir_, ec);
+    auto root = canonicalize_bind_mount_source(work_dir_);
+    if (!root) {
+        return std::unexpected(root.error());
+    }
+    work_dir_ = *root;
+
+    for (const auto& rc : config_.runtimes) {
+        if (!valid_runtime_name(rc.name)) {
+            return std::unexpected(make_error(ErrorCode::InvalidConfig,
+                "Invalid code runtime name", rc.name));
+        }
+        const auto* runner = find_runner(rc.runner.value_or(rc.name));
+        if (!runner) {
+            return std::unexpected(make_error(ErrorCode::InvalidConfig,
+                "Unknown code runner", rc.runner.value_or(rc.name)));
+        }
+        auto argv = rc.command;
+        if (argv.empty()) {
+            argv.emplace_back(runner->interpreter);
+        }
+        auto interpreter = find_executable(argv.front());
+        if (!interpreter) {
+            LOG_WARN("Code runtime {} disabled: {} not found", rc.name, argv.front());
+            continue;
+        }
+        argv.front() = *interpreter;
+        argv.emplace_back(runner->script_flag);
+        argv.emplace_back(runner->script);
+
+        Runtime runtime{
+            .name = rc.name,
+            .argv = std::move(argv),
+            .memory_mb = rc.memory_mb.value_or(config_.memory_mb),
+            .job_in_child = runner->job_in_child,
+        };
+        runtime.slots.resize(static_cast<size_t>(std::max(rc.workers, 1)));
+        runtimes_.insert_or_assign(rc.name, std::move(runtime));
+    }
+    if (runtimes_.empty()) {
+        return std::unexpected(make_error(ErrorCode::NotFound,
+            "No code runtime available", work_dir_.string()));
+    }
+
+    stopped_ = false;
+    for (auto& [name, runtime] : runtimes_) {
+        for (size_t slot = 0; slot < runtime.slots.size(); ++slot) {
+            auto worker = spawn(runtime, slot);
+            if (!worker) {
+                stop();
+                return std::unexpected(worker.error());
+            }
+            runtime.slots[slot] = std::move(*worker);
+        }
+        LOG_INFO("Code runtime {} ready with {} workers", name, runtime.slots.size());
+    }
+    return {};
+}
+
+void SandboxPool::stop() {
+    if (stopped_) {
+        return;
+    }
+    stopped_ = true;
+    for (auto& [name, runtime] : runtimes_) {
+        for (auto& waiter : runtime.waiters) {
+            waiter->cancel();
+        }
+        runtime.waiters.clear();
+        for (auto& worker : runtime.slots) {
+            if (worker) {
+                retire(*worker);
+                worker.reset();
+            }
+        }
+    }
+    if (config_.cgroup_parent) {
+        std::error_code ec;
+        for (const auto& [name, runtime] : runtimes_) {
+            for (size_t slot = 0; slot < runtime.slots.size(); ++slot) {
+                fs::remove(fs::path(*config_.cgroup_parent) /
+                           ("openclaw-" + name + "-" + std::to_string(slot)), ec);
+            }
+        }
+    }
+}
+
+auto SandboxPool::runtimes() const -> std::vector<std::string> {
+    std::vector<std::string> names;
+    for (const auto& [name, runtime] : runtimes_) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+auto SandboxPool::stats() const -> json {
+    json out = json::object();
+    for (const auto& [name, runtime] : runtimes_) {
+        size_t idle = 0;
+        size_t busy = 0;
+        for (const auto& worker : runtime.slots) {
+            if (worker) {
+                ++(worker->busy ? busy : idle);
+            }
+        }
+        out[name] = json{
+            {"workers", runtime.slots.size()},
+            {"idle", idle},
+            {"busy", busy},
+            {"waiting", runtime.waiters.size()},
+            {"jobs", runtime.jobs},
+            {"spawned", runtime.spawned},
+            {"recycled", runtime.recycled},
+            {"timeouts", runtime.timeouts},
+        };
+    }
+    return out;
+}
+
+auto SandboxPool::prepare_dir(const std::string& name) -> Result<fs::path> {
+    std::error_code ec;
+    if (fs::is_symlink(fs::symlink_status(work_dir_ / name, ec))) {
+        fs::remove(work_dir_ / name, ec);  // Left behind by a job; never follow it
+    }
+    auto dir = resolve_allowed_tmp_media_path(work_dir_, name);
+    if (!dir) {
+        return std::unexpected(dir.error());
+    }
+    fs::create_directories(*dir, ec);
+    if (ec || !fs::is_directory(fs::symlink_status(*dir, ec))) {
+        return std::unexpected(make_error(ErrorCode::IoError,
+            "Cannot create sandbox directory", dir->string()));
+    }
+    return canonicalize_bind_mount_source(*dir);
+}
+
+/// Sets up a cgroup for a worker of `runtime` and opens its cgroup.procs
+/// for the child to join. Returns -1 when there is no cgroup to join.
+auto SandboxPool::join_cgroup(const Runtime& runtime, const std::string& name) -> int {
+    if (!config_.cgroup_parent) {
+        return -1;
+    }
+    auto dir = fs::path(*config_.cgroup_parent) / ("openclaw-" + name);
+    std::error_code ec;
+    fs::create_directory(dir, ec);
+    bool ok = !ec || fs::is_directory(dir);
+    if (ok && runtime.memory_mb > 0) {
+        ok = write_file(dir / "memory.max",
+                        std::to_string(int64_t{runtime.memory_mb} << 20));
+    }
+    if (ok && config_.max_processes > 0) {
+        ok = write_file(dir / "pids.max", std::to_string(config_.max_processes));
+    }
+    int fd = ok ? ::open((dir / "cgroup.procs").c_str(), O_WRONLY | O_CLOEXEC) : -1;
+    if (fd < 0 && !cgroup_warned_) {
+        cgroup_warned_ = true;
+        LOG_WARN("Sandbox workers run without a cgroup: cannot set up {}", dir.string());
+    }
+    return fd;
+}
+
+auto SandboxPool::spawn(Runtime& runtime, size_t slot) -> Result<std::shared_ptr<Worker>> {
+    auto name = runtime.name + "-" + std::to_string(slot);
+    auto dir = prepare_dir(name);
+    if (!dir) {
+        return std::unexpected(dir.error());
+    }
+
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+        return std::unexpected(make_error(ErrorCode::IoError,
+            "socketpair failed", std::strerror(errno)));
+    }
+    int report[2];  // The reaper writes the interpreter's pid here
+    if (::pipe2(report, O_CLOEXEC) != 0) {
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return std::unexpected(make_error(ErrorCode::IoError,
+            "pipe failed", std::strerror(errno)));
+    }
+    int devnull = ::open("/dev/null", O_RDWR | O_CLOEXEC);
+    int cgroup_fd = join_cgroup(runtime, name);
+
+    // Build everything before forking; the child may only make
+    // async-signal-safe calls
+    std::vector<std::string> args = runtime.argv;
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    std::vector<std::string> env = {
+        "PATH=/usr/local/bin:/usr/bin:/bin",
+        "HOME=" + dir->string(),
+        "TMPDIR=" + dir->string(),
+        "LANG=C.UTF-8",
+        "PYTHONDONTWRITEBYTECODE=1",
+    };
+    std::vector<char*> envp;
+    for (auto& var : env) {
+        envp.push_back(var.data());
+    }
+    envp.push_back(nullptr);
+
+    auto mib = [](int mb) { return static_cast<rlim_t>(mb) << 20; };
+    std::vector<std::pair<int, rlim_t>> limits;
+    if (runtime.memory_mb > 0)       limits.emplace_back(RLIMIT_AS, mib(runtime.memory_mb));
+    if (config_.cpu_seconds > 0)     limits.emplace_back(RLIMIT_CPU, config_.cpu_seconds);
+    if (config_.max_file_mb > 0)     limits.emplace_back(RLIMIT_FSIZE, mib(config_.max_file_mb));
+    if (config_.max_open_files > 0)  limits.emplace_back(RLIMIT_NOFILE, config_.max_open_files);
+    if (config_.max_processes > 0)   limits.emplace_back(RLIMIT_NPROC, config_.max_processes);
+    limits.emplace_back(RLIMIT_CORE, 0);
+
+    auto dir_string = dir->string();
+    bool isolate = isolate_network_;
+
+    // The forked reaper sets the worker up and forks the interpreter.
+    // As a child subreaper it adopts whatever a job leaves running, so
+    // reset() finds those in its children list
+    pid_t pid = ::fork();
+    if (pid == 0) {
+        ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+        ::setsid();  // Own process group, killed as one
+        if (::prctl(PR_SET_CHILD_SUBREAPER, 1) != 0) {
+            ::_exit(kExitSetupFailed);
+        }
+        if (cgroup_fd >= 0 && ::write(cgroup_fd, "0", 1) != 1) {
+            ::_exit(kExitSetupFailed);
+        }
+        if (isolate && ::unshare(CLONE_NEWNET) != 0 &&
+            ::unshare(CLONE_NEWUSER | CLONE_NEWNET) != 0) {
+            ::_exit(kExitSetupFailed);
+        }
+        for (const auto& [resource, value] : limits) {
+            struct rlimit limit{value, value};
+            if (::setrlimit(resource, &limit) != 0) {
+                ::_exit(kExitSetupFailed);
+            }
+        }
+        if (::chdir(dir_string.c_str()) != 0) {
+            ::_exit(kExitSetupFailed);
+        }
+        pid_t interpreter = ::fork();
+        if (interpreter > 0) {
+            (void)::write(report[1], &interpreter, sizeof(interpreter));
+            ::syscall(SYS_close_range, 0U, ~0U, 0U);
+            reap_until_exit(interpreter);
+        }
+        if (interpreter < 0) {
+            ::_exit(kExitSetupFailed);
+        }
+        ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+        // Park both descriptors above the targets before wiring stdio
+        int channel = ::fcntl(fds[1], F_DUPFD, 10);
+        int null = ::fcntl(devnull, F_DUPFD, 10);
+        if (channel < 0 || null < 0) {
+            ::_exit(kExitSetupFailed);
+        }
+        ::dup2(channel, 0);
+        ::dup2(null, 1);
+        ::dup2(null, 2);
+        ::dup2(channel, 3);
+        ::syscall(SYS_close_range, 4U, ~0U, 0U);
+        ::execve(argv[0], argv.data(), envp.data());
+        ::_exit(kExitExecFailed);
+    }
+
+    ::close(fds[1]);
+    ::close(report[1]);
+    ::close(devnull);
+    if (cgroup_fd >= 0) {
+        ::close(cgroup_fd);
+    }
+    if (pid < 0) {
+        ::close(fds[0]);
+        ::close(report[0]);
+        return std::unexpected(make_error(ErrorCode::IoError,
+            "fork failed", std::strerror(errno)));
+    }
+
+    // Written right after the second fork; nothing if setup failed, which
+    // the first exchange reports
+    pid_t interpreter = -1;
+    ssize_t got = 0;
+    do {
+        got = ::read(report[0], &interpreter, sizeof(interpreter));
+    } while (got < 0 && errno == EINTR);
+    ::close(report[0]);
+
+    auto worker = std::make_shared<Worker>(ioc_);
+    worker->pid = pid;
+    worker->interpreter = got == sizeof(interpreter) ? interpreter : -1;
+    worker->slot = slot;
+    worker->dir = std::move(*dir);
+    if (cgroup_fd >= 0) {
+        worker->cgroup = fs::path(*config_.cgroup_parent) / ("openclaw-" + name);
+    }
+    worker->channel.assign(net::local::stream_protocol(), fds[0]);
+    ++runtime.spawned;
+    return worker;
+}
+
+void SandboxPool::retire(Worker& worker) {
+    boost::system::error_code ec;
+    worker.channel.close(ec);
+    if (worker.pid > 0) {
+        if (!worker.cgroup.empty()) {
+            write_file(worker.cgroup / "cgroup.kill", "1");  // Linux 5.14 and later
+        }
+        for (pid_t pid : stray_processes(worker.pid, worker.interpreter, worker.cgroup, false)) {
+            ::kill(pid, SIGKILL);
+        }
+        ::kill(-worker.pid, SIGKILL);  // With anything the job left running
+        ::kill(worker.pid, SIGKILL);   // In case it had not called setsid yet
+        ::waitpid(worker.pid, nullptr, 0);
+        worker.pid = -1;
+    }
+}
+
+auto SandboxPool::acquire(Runtime& runtime, std::chrono::steady_clock::time_point deadline)
+    -> awaitable<std::shared_ptr<Worker>> {
+    while (!stopped_) {
+        for (size_t slot = 0; slot < runtime.slots.size(); ++slot) {
+            auto& worker = runtime.slots[slot];
+            if (!worker) {
+                auto spawned = spawn(runtime, slot);  // Replacement failed earlier
+                if (!spawned) {
+                    continue;
+                }
+                worker = std::move(*spawned);
+            }
+            if (!worker->busy) {
+                worker->busy = true;
+                co_return worker;
+            }
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+        auto waiter = std::make_shared<net::steady_timer>(ioc_);
+        waiter->expires_at(deadline);
+        runtime.waiters.push_back(waiter);
+        boost::system::error_code ec;
+        co_await waiter->async_wait(net::redirect_error(net::use_awaitable, ec));
+        std::erase(runtime.waiters, waiter);
+    }
+    co_return nullptr;
+}
+
+auto SandboxPool::exchange(Worker& worker, const std::string& code)
+    -> awaitable<Result<CodeRunResult>> {
+    auto request = std::to_string(code.size()) + "\n" + code;
+    boost::system::error_code ec;
+    co_await net::async_write(worker.channel, net::buffer(request),
+                              net::redirect_error(net::use_awaitable, ec));
+
+    std::string buffer;
+    size_t header_size = 0;
+    if (!ec) {
+        header_size = co_await net::async_read_until(worker.channel, net::dynamic_buffer(buffer),
+                                                     '\n', net::redirect_error(net::use_awaitable, ec));
+    }
+    if (ec) {
+        int status = 0;
+        std::string detail = ec.message();
+        if (worker.pid > 0 && ::waitpid(worker.pid, &status, WNOHANG) == worker.pid) {
+            worker.pid = -1;  // Reaped
+            if (WIFEXITED(status)) {
+                detail = "exited with status " + std::to_string(WEXITSTATUS(status));
+            } else if (WIFSIGNALED(status)) {
+                detail = "killed by signal " + std::to_string(WTERMSIG(status));
+            }
+        }
+        co_return make_fail(make_error(ErrorCode::InternalError,
+                                       "Sandbox worker failed", detail));
+    }
+
+    CodeRunResult result;
+    long long out_size = -1;
+    long long err_size = -1;
+    auto header = buffer.substr(0, header_size - 1);
+    if (std::sscanf(header.c_str(), "%d %lld %lld", &result.exit_code, &out_size, &err_size) != 3 ||
+        out_size < 0 || err_size < 0) {
+        co_return make_fail(make_error(ErrorCode::ProtocolError,
+                                       "Malformed reply from sandbox worker", header));
+    }
+    buffer.erase(0, header_size);
+
+    auto total = static_cast<size_t>(out_size + err_size);
+    auto wanted = std::min(total, config_.max_output_bytes);
+    if (buffer.size() < wanted) {
+        co_await net::async_read(worker.channel, net::dynamic_buffer(buffer),
+                                 net::transfer_exactly(wanted - buffer.size()),
+                                 net::redirect_error(net::use_awaitable, ec));
+        if (ec) {
+            co_return make_fail(make_error(ErrorCode::InternalError,
+                                           "Sandbox worker failed", ec.message()));
+        }
+    }
+    buffer.resize(wanted);
+
+    auto out_taken = std::min(static_cast<size_t>(out_size), wanted);
+    result.out = buffer.substr(0, out_taken);
+    result.err = buffer.substr(out_taken);
+    result.truncated = wanted < total;  // The rest is still unread: recycle
+    co_return result;
+}
+
+/// Empties a worker's directory for the next job. Returns false if the
+/// worker should be recycled instead: the directory was swapped out, or
+/// the job left processes running, which are killed here.
+auto SandboxPool::reset(const Runtime& runtime, Worker& worker) -> bool {
+    auto stray = stray_processes(worker.pid, worker.interpreter, worker.cgroup,
+                                 runtime.job_in_child);
+    if (!stray.empty()) {
+        for (pid_t pid : stray) {
+            ::kill(pid, SIGKILL);
+        }
+        LOG_DEBUG("{} sandbox job left {} processes running; recycling its worker",
+                  runtime.name, stray.size());
+        return false;
+    }
+
+    std::error_code ec;
+    auto status = fs::symlink_status(worker.dir, ec);
+    auto canonical = canonicalize_bind_mount_source(worker.dir);
+    if (ec || !fs::is_directory(status) || !canonical || *canonical != worker.dir) {
+        LOG_WARN("Sandbox directory {} was replaced; recycling its worker", worker.dir.string());
+        return false;
+    }
+    for (const auto& entry : fs::directory_iterator(worker.dir, ec)) {
+        fs::remove_all(entry.path(), ec);  // Does not follow symlinks
+        if (ec) {
+            return false;
+        }
+    }
+    return !ec;
+}
+
+void SandboxPool::release(Runtime& runtime, const std::shared_ptr<Worker>& worker,
+                          bool recycle) {
+    auto& slot = runtime.slots[worker->slot];
+    if (stopped_ || slot != worker) {
+        retire(*worker);
+        return;
+    }
+    if (recycle) {
+        retire(*worker);
+        ++runtime.recycled;
+        auto spawned = spawn(runtime, worker->slot);
+        if (spawned) {
+            slot = std::move(*spawned);
+        } else {
+            LOG_ERROR("Cannot replace {} sandbox worker: {}", runtime.name,
+                      spawned.error().what());
+            slot.reset();  // The next acquire retries
+        }
+    } else {
+        worker->busy = false;
+    }
+    if (!runtime.waiters.empty()) {
+        runtime.waiters.front()->cancel();
+        runtime.waiters.pop_front();
+    }
+}
+
+auto SandboxPool::run(std::string name, std::string code) -> awaitable<Result<CodeRunResult>> {
+    auto self = shared_from_this();
+    auto it = runtimes_.find(name);
+    if (it == runtimes_.end()) {
+        co_return make_fail(make_error(ErrorCode::InvalidArgument,
+                                       "Unknown code runtime", name));
+    }
+    if (code.size() > kMaxCodeBytes) {
+        co_return make_fail(make_error(ErrorCode::InvalidArgument,
+                                       "Code exceeds the sandbox limit",
+                                       std::to_string(code.size()) + " bytes"));
+    }
+    auto& runtime = it->second;
+    auto timeout = std::chrono::seconds(std::max(config_.timeout_seconds, 1));
+    auto started = std::chrono::steady_clock::now();
+    auto deadline = started + timeout;
+
+    auto worker = co_await acquire(runtime, deadline);
+    if (!worker) {
+        co_return make_fail(make_error(stopped_ ? ErrorCode::InternalError : ErrorCode::Timeout,
+                                       stopped_ ? "Code sandbox stopped"
+                                                : "No sandbox worker came free",
+                                       name));
+    }
+
+    // Killing the worker ends the exchange with EOF. The handler may
+    // already be queued when the job finishes, so it checks that the
+    // worker is still on this job
+    net::steady_timer watchdog(ioc_);
+    watchdog.expires_at(deadline);
+    watchdog.async_wait([worker, job = worker->jobs](boost::system::error_code ec) {
+        if (!ec && worker->jobs == job && worker->pid > 0) {
+            worker->killed = true;
+            ::kill(-worker->pid, SIGKILL);
+        }
+    });
+
+    bool reused = worker->jobs > 0;
+    auto result = co_await exchange(*worker, code);
+    watchdog.cancel();
+    ++worker->jobs;
+    ++runtime.jobs;
+
+    if (worker->killed) {
+        ++runtime.timeouts;
+        result = make_fail(make_error(ErrorCode::Timeout, "Code run timed out",
+                                      std::to_string(timeout.count()) + "s"));
+    }
+    bool recycle = !result || result->truncated || worker->killed || worker->pid <= 0 ||
+                   worker->jobs >= static_cast<uint64_t>(std::max(config_.max_jobs_per_worker, 1));
+    if (!recycle) {
+        recycle = !reset(runtime, *worker);
+    }
+    release(runtime, worker, recycle);
+
+    if (result) {
+        result->reused = reused;
+        result->duration = elapsed_since(started);
+    }
+    co_return result;
+}
+
+// ---------------------------------------------------------------------------
+// CodeRunTool
+// ---------------------------------------------------------------------------
+
+auto CodeRunTool::definition() const -> agent::ToolDefinition {
+    return agent::ToolDefinition{
+        .name = "code_run",
+        .description = "Run a short code snippet in a sandboxed interpreter and "
+                       "return its exit code, stdout and stderr. Each run starts "
+                       "with an empty working directory and fresh top-level "
+                       "variables, but may share an interpreter with earlier "
+                       "runs: imported modules and their changes persist.",
+        .parameters = {
+            agent::ToolParameter{
+                .name = "code",
+                .type = "string",
+                .description = "Source code to run",
+                .required = true,
+            },
+            agent::ToolParameter{
+                .name = "language",
+                .type = "string",
+                .description = "Runtime to run the code in",
+                .required = false,
+                .default_value = "python",
+                .enum_values = pool_->runtimes(),
+            },
+        },
+    };
+}
+
+auto CodeRunTool::execute(json params) -> awaitable<Result<json>> {
+    auto code = params.value("code", "");
+    auto language = params.value("language", "python");
+    if (code.empty()) {
+        co_return make_fail(make_error(ErrorCode::InvalidArgument, "code is required"));
+    }
+    auto result = co_await pool_->run(std::move(language), std::move(code));
+    if (!result) {
+        co_return make_fail(result.error());
+    }
+    co_return result->to_json();
+}
+
+} // namespace openclaw::infra
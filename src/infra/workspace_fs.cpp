@@ -0,0 +1,334 @@
+#include "openclaw/infra/workspace_fs.hpp"
+
+#include <linux/openat2.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <deque>
+#include <optional>
+
+#include "openclaw/core/logger.hpp"
+#include "openclaw/infra/path_alias_guards.hpp"
+
+namespace openclaw::infra {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint64_t kResolveFlags = RESOLVE_BENEATH | RESOLVE_NO_MAGICLINKS;
+constexpr int kMaxSymlinks = 40;  // Same limit as the kernel's
+
+auto sys_openat2(int dirfd, const char* path, int flags, mode_t mode, uint64_t resolve) -> int {
+    open_how how{};
+    how.flags = static_cast<uint64_t>(flags);
+    how.mode = (flags & (O_CREAT | O_TMPFILE)) ? mode : 0;
+    how.resolve = resolve;
+    return static_cast<int>(::syscall(SYS_openat2, dirfd, path, &how, sizeof(how)));
+}
+
+auto errno_error(const fs::path& path, std::string message) -> Error {
+    auto code = errno == ENOENT ? ErrorCode::NotFound : ErrorCode::IoError;
+    return make_error(code, std::move(message), path.string() + ": " + std::strerror(errno));
+}
+
+/// The components of `path` below `base`, or nullopt if `path` does not
+/// start with every component of `base`. Purely lexical: ".." is left for
+/// the kernel to resolve.
+auto strip_prefix(const fs::path& path, const fs::path& base) -> std::optional<fs::path> {
+    auto it = path.begin();
+    for (const auto& component : base) {
+        if (component.empty()) {
+            continue;  // Trailing separator
+        }
+        if (it == path.end() || *it != component) {
+            return std::nullopt;
+        }
+        ++it;
+    }
+    fs::path rest;
+    for (; it != path.end(); ++it) {
+        if (!it->empty()) {
+            rest /= *it;
+        }
+    }
+    return rest;
+}
+
+/// Rejects hardlinked regular files and applies a deferred O_TRUNC.
+auto finish(FileHandle fd, int flags, const fs::path& path) -> Result<FileHandle> {
+    struct stat st{};
+    if (::fstat(fd.get(), &st) != 0) {
+        return std::unexpected(errno_error(path, "fstat failed"));
+    }
+    if (S_ISREG(st.st_mode) && st.st_nlink > 1) {
+        LOG_WARN("Hardlinked file detected: {} has {} links", path.string(), st.st_nlink);
+        return std::unexpected(make_error(
+            ErrorCode::Forbidden,
+            "Hardlinked file rejected (nlink > 1)",
+            path.string() + " has " + std::to_string(st.st_nlink) + " links"));
+    }
+    if ((flags & O_TRUNC) && S_ISREG(st.st_mode) && ::ftruncate(fd.get(), 0) != 0) {
+        return std::unexpected(errno_error(path, "ftruncate failed"));
+    }
+    return fd;
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// FileHandle
+// ---------------------------------------------------------------------------
+
+FileHandle::~FileHandle() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+auto FileHandle::operator=(FileHandle&& other) noexcept -> FileHandle& {
+    if (this != &other) {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        fd_ = other.release();
+    }
+    return *this;
+}
+
+auto FileHandle::release() noexcept -> int {
+    return std::exchange(fd_, -1);
+}
+
+// ---------------------------------------------------------------------------
+// WorkspaceFs
+// ---------------------------------------------------------------------------
+
+WorkspaceFs::WorkspaceFs(std::vector<fs::path> roots)
+    : roots_(std::move(roots)), cache_(roots_.size()) {}
+
+auto WorkspaceFs::beneath_supported() -> bool {
+    static const bool supported = [] {
+        int fd = sys_openat2(AT_FDCWD, ".", O_PATH | O_CLOEXEC, 0, kResolveFlags);
+        if (fd < 0) {
+            LOG_INFO("openat2 unavailable ({}), using checked path resolution",
+                     std::strerror(errno));
+            return false;
+        }
+        ::close(fd);
+        return true;
+    }();
+    return supported;
+}
+
+void WorkspaceFs::invalidate() {
+    std::lock_guard lock(mutex_);
+    for (auto& root : cache_) {
+        root.reset();
+    }
+}
+
+auto WorkspaceFs::root(size_t index) -> Result<std::shared_ptr<const Root>> {
+    std::lock_guard lock(mutex_);
+    if (cache_[index]) {
+        return cache_[index];
+    }
+
+    const auto& path = roots_[index];
+    FileHandle fd(::open(path.c_str(), O_PATH | O_DIRECTORY | O_CLOEXEC));
+    if (!fd) {
+        return std::unexpected(errno_error(path, "Failed to open workspace root"));
+    }
+    // Resolve through the descriptor so the name matches what was opened
+    std::error_code ec;
+    auto canonical = fs::read_symlink("/proc/self/fd/" + std::to_string(fd.get()), ec);
+    if (ec) {
+        canonical = fs::canonical(path, ec);
+        if (ec) {
+            return std::unexpected(make_error(ErrorCode::IoError,
+                "Failed to canonicalize workspace root", path.string() + ": " + ec.message()));
+        }
+    }
+
+    auto root = std::make_shared<Root>();
+    root->canonical = std::move(canonical);
+    root->fd = std::move(fd);
+    cache_[index] = root;
+    return root;
+}
+
+auto WorkspaceFs::locate(const fs::path& path) -> Result<std::pair<size_t, fs::path>> {
+    if (roots_.empty()) {
+        return std::unexpected(make_error(
+            ErrorCode::InvalidArgument, "No workspace roots configured"));
+    }
+    if (path.is_relative()) {
+        return std::pair{size_t{0}, path};
+    }
+    for (size_t i = 0; i < roots_.size(); ++i) {
+        if (auto rest = strip_prefix(path, roots_[i].lexically_normal())) {
+            return std::pair{i, std::move(*rest)};
+        }
+        auto root = this->root(i);
+        if (!root) {
+            continue;
+        }
+        if (auto rest = strip_prefix(path, (*root)->canonical)) {
+            return std::pair{i, std::move(*rest)};
+        }
+    }
+    return std::unexpected(make_error(
+        ErrorCode::Forbidden, "Path escapes workspace boundary", path.string()));
+}
+
+auto WorkspaceFs::open(const fs::path& path, int flags, mode_t mode) -> Result<FileHandle> {
+    // Same decoding rules as assert_no_path_alias_escape()
+    auto path_str = path.string();
+    if (has_malformed_percent_encoding(path_str)) {
+        LOG_WARN("Path contains malformed percent-encoding: {}", path_str);
+        return std::unexpected(make_error(
+            ErrorCode::Forbidden, "Path contains malformed percent-encoding", path_str));
+    }
+    auto decoded_str = iterative_uri_decode(path_str);
+    if (decoded_str.find('%') != std::string::npos && decoded_str != path_str) {
+        return std::unexpected(make_error(
+            ErrorCode::Forbidden, "Path contains unresolvable percent-encoding", decoded_str));
+    }
+    fs::path decoded(decoded_str);
+
+    auto located = locate(decoded);
+    if (!located) {
+        return std::unexpected(located.error());
+    }
+    auto& [index, relative] = *located;
+    auto root = this->root(index);
+    if (!root) {
+        return std::unexpected(root.error());
+    }
+
+    if (beneath_supported()) {
+        auto result = open_beneath((*root)->fd.get(), relative, flags, mode);
+        if (result || result.error().code() != ErrorCode::Forbidden) {
+            return result;
+        }
+        // RESOLVE_BENEATH also refuses absolute symlinks that point back
+        // into the workspace; those are walked again below, still
+        // beneath the root descriptor.
+    }
+    return open_walk(index, **root, relative, flags, mode);
+}
+
+auto WorkspaceFs::open_beneath(int root_fd, const fs::path& relative, int flags, mode_t mode)
+    -> Result<FileHandle> {
+    const char* name = relative.empty() ? "." : relative.c_str();
+    FileHandle fd(sys_openat2(root_fd, name, (flags & ~O_TRUNC) | O_CLOEXEC, mode, kResolveFlags));
+    if (!fd) {
+        if (errno == EXDEV || errno == ELOOP) {
+            return std::unexpected(make_error(
+                ErrorCode::Forbidden, "Path escapes workspace boundary", relative.string()));
+        }
+        return std::unexpected(errno_error(relative, "Failed to open"));
+    }
+    return finish(std::move(fd), flags, relative);
+}
+
+auto WorkspaceFs::open_walk(size_t index, const Root& root, const fs::path& relative,
+                            int flags, mode_t mode) -> Result<FileHandle> {
+    auto escape = [&relative] {
+        return std::unexpected(make_error(
+            ErrorCode::Forbidden, "Path escapes workspace boundary", relative.string()));
+    };
+
+    std::deque<std::string> pending;
+    for (const auto& component : relative) {
+        if (!component.empty()) {
+            pending.push_back(component.string());
+        }
+    }
+    std::vector<FileHandle> dirs;  // Directories walked into below the root
+    auto dir_fd = [&] { return dirs.empty() ? root.fd.get() : dirs.back().get(); };
+    int links = 0;
+
+    while (!pending.empty()) {
+        auto name = std::move(pending.front());
+        pending.pop_front();
+        if (name == ".") {
+            continue;
+        }
+        if (name == "..") {
+            if (dirs.empty()) {
+                return escape();
+            }
+            dirs.pop_back();
+            continue;
+        }
+
+        bool last = pending.empty();
+        if (!last || !(flags & (O_NOFOLLOW | O_EXCL))) {
+            std::string target(PATH_MAX, '\0');
+            auto n = ::readlinkat(dir_fd(), name.c_str(), target.data(), target.size());
+            if (n >= 0) {
+                if (++links > kMaxSymlinks) {
+                    return std::unexpected(make_error(
+                        ErrorCode::Forbidden, "Too many symbolic links", relative.string()));
+                }
+                target.resize(static_cast<size_t>(n));
+                fs::path link(target);
+                if (link.is_absolute()) {
+                    auto rest = strip_prefix(link, roots_[index].lexically_normal());
+                    if (!rest) {
+                        rest = strip_prefix(link, root.canonical);
+                    }
+                    if (!rest) {
+                        return escape();
+                    }
+                    dirs.clear();
+                    link = std::move(*rest);
+                }
+                std::vector<std::string> components;
+                for (const auto& component : link) {
+                    if (!component.empty()) {
+                        components.push_back(component.string());
+                    }
+                }
+                pending.insert(pending.begin(), components.begin(), components.end());
+                continue;
+            }
+            // Not a link, or missing: the open below decides
+        }
+
+        // One component at a time and never through a link, so a swap
+        // after the readlinkat above fails instead of escaping
+        if (!last) {
+            FileHandle next(::openat(dir_fd(), name.c_str(),
+                                     O_PATH | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC));
+            if (!next) {
+                return std::unexpected(errno_error(relative, "Failed to open"));
+            }
+            dirs.push_back(std::move(next));
+            continue;
+        }
+        FileHandle fd(::openat(dir_fd(), name.c_str(),
+                               (flags & ~O_TRUNC) | O_NOFOLLOW | O_CLOEXEC, mode));
+        if (!fd) {
+            if (errno == ELOOP) {
+                return escape();
+            }
+            return std::unexpected(errno_error(relative, "Failed to open"));
+        }
+        return finish(std::move(fd), flags, relative);
+    }
+
+    // The path ended in a directory already walked into
+    FileHandle fd(::openat(dir_fd(), ".", (flags & ~O_TRUNC) | O_CLOEXEC, mode));
+    if (!fd) {
+        return std::unexpected(errno_error(relative, "Failed to open"));
+    }
+    return finish(std::move(fd), flags, relative);
+}
+
+} // namespace openclaw::infra
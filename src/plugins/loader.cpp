@@ -3,9 +3,11 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <string>
 
 #if defined(__unix__) || defined(__APPLE__)
 #include <dlfcn.h>
+#include <unistd.h>
 #elif defined(_WIN32)
 #include <windows.h>
 #else
@@ -18,8 +20,24 @@ namespace fs = std::filesystem;
 
 namespace {
 
-/// Returns true if the path has a platform-appropriate shared library extension.
-auto is_shared_library(const fs::path& path) -> bool {
+/// Closes a library handle; used as the deleter of LoadedPlugin::library.
+void close_library(void* handle, const std::string& label) {
+#ifdef _WIN32
+    ::FreeLibrary(static_cast<HMODULE>(handle));
+#else
+    if (dlclose(handle) != 0) {
+        const char* err = dlerror();
+        LOG_WARN("dlclose warning for '{}': {}", label,
+                 err ? err : "unknown");
+        return;
+    }
+#endif
+    LOG_INFO("Closed plugin library {}", label);
+}
+
+} // anonymous namespace
+
+auto is_plugin_library(const fs::path& path) -> bool {
 #if defined(__APPLE__)
     auto ext = path.extension().string();
     return ext == ".dylib" || ext == ".so";
@@ -30,13 +48,63 @@ auto is_shared_library(const fs::path& path) -> bool {
 #endif
 }
 
-} // anonymous namespace
+auto LoadedPlugin::shared_tools(const std::shared_ptr<LoadedPlugin>& self)
+    -> std::vector<std::shared_ptr<agent::Tool>> {
+    std::vector<std::shared_ptr<agent::Tool>> shared;
+    shared.reserve(self->tools.size());
+    for (const auto& tool : self->tools) {
+        // Aliasing: the tool pointer shares ownership of the whole instance
+        shared.emplace_back(self, tool.get());
+    }
+    return shared;
+}
+
+PluginLoader::PluginLoader()
+    : PluginLoader(Config{}, fs::temp_directory_path() / "openclaw-plugin-data") {}
+
+PluginLoader::PluginLoader(const Config& config, fs::path data_dir)
+    : config_(config)
+    , data_dir_(std::move(data_dir))
+    , plugins_(std::make_shared<const PluginMap>()) {
+#ifndef _WIN32
+    shadow_dir_ = fs::temp_directory_path() /
+                  ("openclaw-plugins-" + std::to_string(::getpid()));
+#endif
+}
 
 PluginLoader::~PluginLoader() {
     unload_all();
+    if (!shadow_dir_.empty()) {
+        std::error_code ec;
+        fs::remove_all(shadow_dir_, ec);
+    }
 }
 
-auto PluginLoader::load(const fs::path& path) -> Result<Plugin*> {
+void PluginLoader::on_swap(SwapHandler handler) {
+    std::lock_guard lock(write_mutex_);
+    swap_handlers_.push_back(std::move(handler));
+}
+
+void PluginLoader::publish_tools(agent::ToolRegistry& tools) {
+    on_swap([&tools](const std::shared_ptr<LoadedPlugin>& retired,
+                     const std::shared_ptr<LoadedPlugin>& published) {
+        // Only withdraw names still bound to the retired instance, so a
+        // tool another plugin has since taken over is left alone
+        std::vector<std::string> remove;
+        if (retired) {
+            for (const auto& tool : retired->tools) {
+                auto name = tool->definition().name;
+                if (tools.get(name) == tool.get()) {
+                    remove.push_back(std::move(name));
+                }
+            }
+        }
+        tools.replace(remove, published ? LoadedPlugin::shared_tools(published)
+                                        : std::vector<std::shared_ptr<agent::Tool>>{});
+    });
+}
+
+auto PluginLoader::open(const fs::path& path) -> Result<std::shared_ptr<LoadedPlugin>> {
     if (!fs::exists(path)) {
         return std::unexpected(make_error(
             ErrorCode::NotFound,
@@ -44,14 +112,15 @@ auto PluginLoader::load(const fs::path& path) -> Result<Plugin*> {
             path.string()));
     }
 
-    if (!is_shared_library(path)) {
+    if (!is_plugin_library(path)) {
         return std::unexpected(make_error(
             ErrorCode::InvalidArgument,
             "Not a shared library",
             path.string()));
     }
 
-    LOG_INFO("Loading plugin from: {}", path.string());
+    auto generation = ++generation_;
+    LOG_INFO("Loading plugin from: {} (generation {})", path.string(), generation);
 
 #ifdef _WIN32
     // Load the DLL.
@@ -74,10 +143,28 @@ auto PluginLoader::load(const fs::path& path) -> Result<Plugin*> {
                 path.filename().string()));
     }
 #else
+    // The dynamic linker hands back the already-mapped object when a path
+    // is opened twice, which would turn a reload into a no-op while the
+    // old instance drains. Open a private copy instead; it can be removed
+    // as soon as it is mapped.
+    std::error_code ec;
+    fs::create_directories(shadow_dir_, ec);
+    auto shadow = shadow_dir_ / (path.stem().string() + "." +
+                                 std::to_string(generation) +
+                                 path.extension().string());
+    fs::copy_file(path, shadow, fs::copy_options::overwrite_existing, ec);
+    if (ec) {
+        return std::unexpected(make_error(
+            ErrorCode::IoError,
+            "Failed to stage plugin library",
+            shadow.string() + ": " + ec.message()));
+    }
+
     // Open the shared library.
     // RTLD_NOW: resolve all symbols immediately (fail fast on missing deps).
     // RTLD_LOCAL: do not export symbols to other loaded libraries.
-    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    void* handle = dlopen(shadow.c_str(), RTLD_NOW | RTLD_LOCAL);
+    fs::remove(shadow, ec);
     if (!handle) {
         const char* err = dlerror();
         return std::unexpected(make_error(
@@ -103,47 +190,58 @@ auto PluginLoader::load(const fs::path& path) -> Result<Plugin*> {
     }
 #endif
 
+    auto loaded = std::make_shared<LoadedPlugin>();
+    loaded->library = std::shared_ptr<void>(handle,
+        [label = path.filename().string() + "#" + std::to_string(generation)](void* h) {
+            close_library(h, label);
+        });
+    loaded->path = path;
+    loaded->generation = generation;
+
     // Cast to the factory function pointer and invoke it.
     auto factory = reinterpret_cast<PluginFactory>(sym);
-    std::unique_ptr<Plugin> plugin = factory();
-    if (!plugin) {
-#ifdef _WIN32
-        ::FreeLibrary(static_cast<HMODULE>(handle));
-#else
-        dlclose(handle);
-#endif
+    loaded->plugin = factory();
+    if (!loaded->plugin) {
         return std::unexpected(make_error(
             ErrorCode::PluginError,
             "Plugin factory returned nullptr",
             path.filename().string()));
     }
-
-    auto name = std::string(plugin->name());
-    LOG_INFO("Loaded plugin '{}' v{} from {}",
-             name, plugin->version(), path.filename().string());
-
-    // If a plugin with the same name is already loaded, unload it first.
-    if (loaded_.contains(name)) {
-        LOG_WARN("Replacing already-loaded plugin '{}'", name);
-        auto& existing = loaded_[name];
-        existing.plugin.reset();  // destroy plugin before closing handle
-        if (existing.handle) {
-#ifdef _WIN32
-            ::FreeLibrary(static_cast<HMODULE>(existing.handle));
-#else
-            dlclose(existing.handle);
-#endif
-        }
-        loaded_.erase(name);
+    loaded->name = std::string(loaded->plugin->name());
+    loaded->version = std::string(loaded->plugin->version());
+
+    // Let the plugin register its tools and methods before anything can
+    // see it; a failure here leaves the published instance untouched.
+    // Declared after `loaded` so registrations from a failed init are
+    // destroyed while the library is still open.
+    PluginSDK sdk(config_, data_dir_ / loaded->name);
+    auto initialized = loaded->plugin->init(sdk);
+    if (!initialized) {
+        return std::unexpected(make_error(
+            ErrorCode::PluginError,
+            "Plugin init failed",
+            loaded->name + ": " + initialized.error().what()));
     }
+    loaded->tools = std::move(sdk.tools());
+    loaded->channels = std::move(sdk.channels());
+    loaded->methods = std::move(sdk.methods());
+
+    LOG_INFO("Loaded plugin '{}' v{} from {} ({} tools, {} methods)",
+             loaded->name, loaded->version, path.filename().string(),
+             loaded->tools.size(), loaded->methods.size());
+    return loaded;
+}
 
-    Plugin* raw_ptr = plugin.get();
-    loaded_.emplace(name, LoadedPlugin{
-        .handle = handle,
-        .plugin = std::move(plugin),
-        .path = path,
-    });
+auto PluginLoader::load(const fs::path& path) -> Result<Plugin*> {
+    auto opened = open(path);
+    if (!opened) {
+        return std::unexpected(opened.error());
+    }
+    auto loaded = std::move(*opened);
+    auto* raw_ptr = loaded->plugin.get();
 
+    std::lock_guard lock(write_mutex_);
+    swap_locked(loaded->name, std::move(loaded));
     return raw_ptr;
 }
 
@@ -162,7 +260,7 @@ auto PluginLoader::load_all(const fs::path& dir)
 
     // Collect all shared library files in the directory (non-recursive).
     for (const auto& entry : fs::directory_iterator(dir)) {
-        if (entry.is_regular_file() && is_shared_library(entry.path())) {
+        if (entry.is_regular_file() && is_plugin_library(entry.path())) {
             candidates.push_back(entry.path());
         }
     }
@@ -185,48 +283,33 @@ auto PluginLoader::load_all(const fs::path& dir)
     return plugins;
 }
 
-auto PluginLoader::unload(std::string_view name) -> Result<void> {
-    auto it = loaded_.find(std::string(name));
-    if (it == loaded_.end()) {
+auto PluginLoader::reload(std::string_view name) -> Result<Plugin*> {
+    auto current = find(name);
+    if (!current) {
         return std::unexpected(make_error(
             ErrorCode::NotFound,
             "Plugin not loaded",
             std::string(name)));
     }
+    return load(current->path);
+}
 
-    LOG_INFO("Unloading plugin '{}'", name);
-
-    auto& entry = it->second;
-
-    // Destroy the plugin instance first (calls ~Plugin before closing handle).
-    entry.plugin.reset();
-
-    // Close the shared library handle.
-    if (entry.handle) {
-#ifdef _WIN32
-        ::FreeLibrary(static_cast<HMODULE>(entry.handle));
-#else
-        if (dlclose(entry.handle) != 0) {
-            const char* err = dlerror();
-            LOG_WARN("dlclose warning for '{}': {}", name,
-                     err ? err : "unknown");
-        }
-#endif
+auto PluginLoader::unload(std::string_view name) -> Result<void> {
+    std::lock_guard lock(write_mutex_);
+    if (!snapshot()->contains(std::string(name))) {
+        return std::unexpected(make_error(
+            ErrorCode::NotFound,
+            "Plugin not loaded",
+            std::string(name)));
     }
 
-    loaded_.erase(it);
+    LOG_INFO("Unloading plugin '{}'", name);
+    swap_locked(std::string(name), nullptr);
     return {};
 }
 
 auto PluginLoader::unload_all() -> void {
-    // Collect names first to avoid iterator invalidation.
-    std::vector<std::string> names;
-    names.reserve(loaded_.size());
-    for (const auto& [name, _] : loaded_) {
-        names.push_back(name);
-    }
-
-    for (const auto& name : names) {
+    for (const auto& name : loaded_names()) {
         auto result = unload(name);
         if (!result.has_value()) {
             LOG_WARN("Failed to unload plugin '{}': {}",
@@ -235,25 +318,67 @@ auto PluginLoader::unload_all() -> void {
     }
 }
 
+void PluginLoader::swap_locked(const std::string& name,
+                               std::shared_ptr<LoadedPlugin> next) {
+    auto map = std::make_shared<PluginMap>(*snapshot());
+    std::shared_ptr<LoadedPlugin> retired;
+    if (auto it = map->find(name); it != map->end()) {
+        retired = std::move(it->second);
+        map->erase(it);
+    }
+    if (next) {
+        if (retired) {
+            LOG_INFO("Replacing plugin '{}' generation {} with {}",
+                     name, retired->generation, next->generation);
+        }
+        map->emplace(name, next);
+    }
+    plugins_.store(std::move(map), std::memory_order_release);
+
+    for (const auto& handler : swap_handlers_) {
+        handler(retired, next);
+    }
+    if (retired) {
+        retired_.push_back(retired);
+    }
+}
+
 auto PluginLoader::get(std::string_view name) const -> Plugin* {
-    auto it = loaded_.find(std::string(name));
-    if (it == loaded_.end()) {
+    auto loaded = find(name);
+    return loaded ? loaded->plugin.get() : nullptr;
+}
+
+auto PluginLoader::find(std::string_view name) const -> std::shared_ptr<LoadedPlugin> {
+    auto plugins = snapshot();
+    auto it = plugins->find(std::string(name));
+    if (it == plugins->end()) {
         return nullptr;
     }
-    return it->second.plugin.get();
+    return it->second;
 }
 
-auto PluginLoader::loaded_names() const -> std::vector<std::string_view> {
-    std::vector<std::string_view> names;
-    names.reserve(loaded_.size());
-    for (const auto& [name, _] : loaded_) {
+auto PluginLoader::snapshot() const -> std::shared_ptr<const PluginMap> {
+    return plugins_.load(std::memory_order_acquire);
+}
+
+auto PluginLoader::loaded_names() const -> std::vector<std::string> {
+    auto plugins = snapshot();
+    std::vector<std::string> names;
+    names.reserve(plugins->size());
+    for (const auto& [name, _] : *plugins) {
         names.push_back(name);
     }
     return names;
 }
 
 auto PluginLoader::size() const noexcept -> size_t {
-    return loaded_.size();
+    return snapshot()->size();
+}
+
+auto PluginLoader::draining() -> size_t {
+    std::lock_guard lock(write_mutex_);
+    std::erase_if(retired_, [](const auto& weak) { return weak.expired(); });
+    return retired_.size();
 }
 
 } // namespace openclaw::plugins
@@ -0,0 +1,656 @@
+#include "openclaw/plugins/plugin_host.hpp"
+
+#include "openclaw/core/logger.hpp"
+#include "openclaw/plugins/loader.hpp"
+#include "openclaw/plugins/shm_ring.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace openclaw::plugins {
+
+namespace net = boost::asio;
+using namespace std::chrono_literals;
+
+namespace {
+
+auto errno_error(std::string message) -> Error {
+    return make_error(ErrorCode::PluginError, std::move(message), std::strerror(errno));
+}
+
+/// Rings a doorbell; the reader wakes once however many were rung.
+void ring(int eventfd) {
+    uint64_t one = 1;
+    [[maybe_unused]] auto n = ::write(eventfd, &one, sizeof(one));
+}
+
+/// Resets a doorbell after a wakeup.
+void drain(int eventfd) {
+    uint64_t count = 0;
+    [[maybe_unused]] auto n = ::read(eventfd, &count, sizeof(count));
+}
+
+/// Maps both rings of an endpoint's region.
+struct Mapping {
+    void* base = MAP_FAILED;
+    size_t size = 0;
+
+    Mapping(int memfd, size_t ring_bytes)
+        : size(ShmRing::region_size(ring_bytes) * 2) {
+        base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+    }
+    ~Mapping() {
+        if (base != MAP_FAILED) {
+            ::munmap(base, size);
+        }
+    }
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    [[nodiscard]] auto ok() const -> bool { return base != MAP_FAILED; }
+    [[nodiscard]] auto requests() const -> void* { return base; }
+    [[nodiscard]] auto responses() const -> void* {
+        return static_cast<char*>(base) + size / 2;
+    }
+};
+
+auto definition_to_wire(const agent::ToolDefinition& def) -> json {
+    json params = json::array();
+    for (const auto& p : def.parameters) {
+        json param{
+            {"name", p.name},
+            {"type", p.type},
+            {"description", p.description},
+            {"required", p.required},
+        };
+        if (p.default_value) param["default"] = *p.default_value;
+        if (p.enum_values) param["enum"] = *p.enum_values;
+        params.push_back(std::move(param));
+    }
+    return json{
+        {"name", def.name},
+        {"description", def.description},
+        {"parameters", std::move(params)},
+    };
+}
+
+auto definition_from_wire(const json& j) -> agent::ToolDefinition {
+    agent::ToolDefinition def;
+    def.name = j.value("name", "");
+    def.description = j.value("description", "");
+    for (const auto& p : j.value("parameters", json::array())) {
+        agent::ToolParameter param{
+            .name = p.value("name", ""),
+            .type = p.value("type", "string"),
+            .description = p.value("description", ""),
+            .required = p.value("required", true),
+        };
+        if (p.contains("default")) param.default_value = p["default"];
+        if (p.contains("enum")) {
+            param.enum_values = p["enum"].get<std::vector<std::string>>();
+        }
+        def.parameters.push_back(std::move(param));
+    }
+    return def;
+}
+
+auto failed(Error error) -> Result<json> {
+    return std::unexpected(std::move(error));
+}
+
+auto error_to_wire(const Error& error) -> json {
+    return json{
+        {"code", static_cast<int>(error.code())},
+        {"message", error.message()},
+        {"detail", error.detail()},
+    };
+}
+
+auto error_from_wire(const json& j) -> Error {
+    return Error(static_cast<ErrorCode>(j.value("code", static_cast<int>(ErrorCode::PluginError))),
+                 j.value("message", "Plugin call failed"), j.value("detail", ""));
+}
+
+/// Gateway-side stand-in for a tool that lives in a host process.
+class RemoteTool : public agent::Tool {
+public:
+    RemoteTool(std::weak_ptr<PluginHost> host, agent::ToolDefinition definition)
+        : host_(std::move(host)), definition_(std::move(definition)) {}
+
+    [[nodiscard]] auto definition() const -> agent::ToolDefinition override {
+        return definition_;
+    }
+
+    auto execute(json params) -> awaitable<Result<json>> override {
+        auto host = host_.lock();
+        if (!host) {
+            co_return make_fail(make_error(ErrorCode::PluginError,
+                                           "Plugin host is gone", definition_.name));
+        }
+        co_return co_await host->call(definition_.name, std::move(params));
+    }
+
+private:
+    std::weak_ptr<PluginHost> host_;
+    agent::ToolDefinition definition_;
+};
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// PluginHost (gateway side)
+// ---------------------------------------------------------------------------
+
+/// One generation of the host process and the gateway's ends of its
+/// channel. Closed when the process exits or the host stops.
+struct PluginHost::Process {
+    pid_t pid = -1;
+    std::unique_ptr<Mapping> mapping;
+    std::optional<ShmRing> requests;
+    std::optional<ShmRing> responses;
+    int request_fd = -1;
+    net::posix::stream_descriptor response_doorbell;
+    net::posix::stream_descriptor exit_watch;  // pidfd, readable on exit
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+
+    explicit Process(net::io_context& ioc) : response_doorbell(ioc), exit_watch(ioc) {}
+    ~Process() {
+        close();
+        if (request_fd >= 0) {
+            ::close(request_fd);
+        }
+    }
+
+    void close() {
+        boost::system::error_code ec;
+        response_doorbell.close(ec);
+        exit_watch.close(ec);
+    }
+};
+
+PluginHost::PluginHost(net::io_context& ioc, PluginHostOptions options)
+    : ioc_(ioc)
+    , options_(std::move(options))
+    , name_(options_.library.stem().string())
+    , next_delay_(options_.restart_delay) {
+    if (options_.command.empty()) {
+        options_.command = {"/proc/self/exe", "plugin-host"};
+    }
+}
+
+PluginHost::~PluginHost() {
+    stop();
+}
+
+auto PluginHost::pid() const -> int {
+    return process_ ? process_->pid : -1;
+}
+
+void PluginHost::on_tools(ToolsHandler handler) {
+    tools_handlers_.push_back(std::move(handler));
+}
+
+void PluginHost::publish_tools(agent::ToolRegistry& tools) {
+    auto published = std::make_shared<std::vector<std::string>>();
+    on_tools([&tools, published](std::vector<std::shared_ptr<agent::Tool>> next) {
+        auto removed = std::move(*published);
+        published->clear();
+        for (const auto& tool : next) {
+            published->push_back(tool->definition().name);
+        }
+        tools.replace(removed, std::move(next));
+    });
+}
+
+auto PluginHost::start() -> Result<void> {
+    stopped_ = false;
+    return spawn();
+}
+
+void PluginHost::stop() {
+    if (stopped_) {
+        return;
+    }
+    stopped_ = true;
+    ready_ = false;
+    fail_pending(make_error(ErrorCode::PluginError, "Plugin host stopped", name_));
+
+    auto process = std::move(process_);
+    if (!process) {
+        return;
+    }
+    process->close();
+    ::kill(process->pid, SIGTERM);
+    for (int i = 0; i < 100; ++i) {
+        if (::waitpid(process->pid, nullptr, WNOHANG) != 0) {
+            return;
+        }
+        std::this_thread::sleep_for(10ms);
+    }
+    ::kill(process->pid, SIGKILL);
+    ::waitpid(process->pid, nullptr, 0);
+}
+
+auto PluginHost::spawn() -> Result<void> {
+    auto process = std::make_shared<Process>(ioc_);
+
+    int memfd = ::memfd_create("openclaw-plugin", MFD_CLOEXEC);
+    if (memfd < 0) {
+        return std::unexpected(errno_error("memfd_create failed"));
+    }
+    auto region_size = ShmRing::region_size(options_.ring_bytes) * 2;
+    if (::ftruncate(memfd, static_cast<off_t>(region_size)) != 0) {
+        auto error = errno_error("Cannot size plugin ring");
+        ::close(memfd);
+        return std::unexpected(error);
+    }
+    process->mapping = std::make_unique<Mapping>(memfd, options_.ring_bytes);
+    if (!process->mapping->ok()) {
+        auto error = errno_error("Cannot map plugin ring");
+        ::close(memfd);
+        return std::unexpected(error);
+    }
+    process->requests = ShmRing::create(process->mapping->requests(), options_.ring_bytes);
+    process->responses = ShmRing::create(process->mapping->responses(), options_.ring_bytes);
+
+    int request_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    int response_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (request_fd < 0 || response_fd < 0) {
+        auto error = errno_error("eventfd failed");
+        for (int fd : {memfd, request_fd, response_fd}) {
+            if (fd >= 0) ::close(fd);
+        }
+        return std::unexpected(error);
+    }
+
+    // Build argv before forking; the child may only make async-signal-safe calls
+    std::vector<std::string> args = options_.command;
+    args.insert(args.end(), {
+        "--memfd", std::to_string(memfd),
+        "--request-fd", std::to_string(request_fd),
+        "--response-fd", std::to_string(response_fd),
+        "--ring-bytes", std::to_string(options_.ring_bytes),
+        "--library", options_.library.string(),
+    });
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid = ::fork();
+    if (pid == 0) {
+        ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+        for (int fd : {memfd, request_fd, response_fd}) {
+            ::fcntl(fd, F_SETFD, 0);  // Inherit across exec
+        }
+        ::execv(argv[0], argv.data());
+        ::_exit(127);
+    }
+    ::close(memfd);  // The mapping keeps the region alive
+    if (pid < 0) {
+        auto error = errno_error("fork failed");
+        ::close(request_fd);
+        ::close(response_fd);
+        return std::unexpected(error);
+    }
+
+    process->pid = pid;
+    process->request_fd = request_fd;
+    process->response_doorbell.assign(response_fd);
+    int pidfd = static_cast<int>(::syscall(SYS_pidfd_open, pid, 0));
+    if (pidfd < 0) {
+        auto error = errno_error("pidfd_open failed");
+        ::kill(pid, SIGKILL);
+        ::waitpid(pid, nullptr, 0);
+        return std::unexpected(error);
+    }
+    process->exit_watch.assign(pidfd);
+
+    process_ = process;
+    net::co_spawn(ioc_, read_responses(process), net::detached);
+    net::co_spawn(ioc_, watch_exit(process), net::detached);
+    LOG_INFO("Started plugin host for {} (pid {})", options_.library.filename().string(), pid);
+    return {};
+}
+
+auto PluginHost::call(std::string tool, json params) -> awaitable<Result<json>> {
+    auto process = process_;
+    if (!process || !ready_) {
+        co_return make_fail(make_error(ErrorCode::PluginError,
+                                       "Plugin host not running", name_));
+    }
+
+    auto id = next_id_++;
+    auto message = json{
+        {"op", "call"},
+        {"id", id},
+        {"tool", tool},
+        {"params", std::move(params)},
+    }.dump();
+    if (message.size() > process->requests->max_message_size()) {
+        co_return make_fail(make_error(ErrorCode::InvalidArgument,
+                                       "Tool call exceeds the plugin ring", tool));
+    }
+
+    auto self = shared_from_this();
+    auto pending = std::make_shared<PendingCall>(ioc_);
+    pending->timer.expires_after(options_.call_timeout);
+    pending_[id] = pending;
+
+    // The host drains requests as it reads them; a full ring only lasts
+    // while it is busy, so back off briefly instead of failing
+    net::steady_timer backoff(ioc_);
+    while (!pending->result && !process->requests->try_push(message)) {
+        if (std::chrono::steady_clock::now() >= pending->timer.expiry()) {
+            break;
+        }
+        backoff.expires_after(1ms);
+        boost::system::error_code ec;
+        co_await backoff.async_wait(net::redirect_error(net::use_awaitable, ec));
+    }
+    ring(process->request_fd);
+
+    if (!pending->result) {
+        boost::system::error_code ec;
+        co_await pending->timer.async_wait(net::redirect_error(net::use_awaitable, ec));
+    }
+    pending_.erase(id);
+
+    if (!pending->result) {
+        co_return make_fail(make_error(ErrorCode::Timeout, "Plugin call timed out", tool));
+    }
+    co_return std::move(*pending->result);
+}
+
+auto PluginHost::read_responses(std::shared_ptr<Process> process) -> awaitable<void> {
+    auto self = shared_from_this();
+    int fd = process->response_doorbell.native_handle();
+    std::string message;
+    while (true) {
+        boost::system::error_code ec;
+        co_await process->response_doorbell.async_wait(
+            net::posix::stream_descriptor::wait_read,
+            net::redirect_error(net::use_awaitable, ec));
+        if (ec || process != process_) {
+            co_return;
+        }
+        drain(fd);
+        while (process->responses->try_pop(message)) {
+            handle_message(message);
+        }
+        if (process->responses->corrupt()) {
+            // Nothing more from this process can be believed; watch_exit
+            // fails its calls and restarts it like any other crash
+            LOG_ERROR("Plugin host {} (pid {}) corrupted its response ring, killing it",
+                      name_, process->pid);
+            ::kill(process->pid, SIGKILL);
+            co_return;
+        }
+    }
+}
+
+void PluginHost::handle_message(const std::string& message) {
+    auto j = json::parse(message, nullptr, false);
+    if (j.is_discarded()) {
+        LOG_WARN("Plugin host {} sent malformed message", name_);
+        return;
+    }
+
+    auto op = j.value("op", "");
+    if (op == "result") {
+        auto it = pending_.find(j.value("id", uint64_t{0}));
+        if (it == pending_.end()) {
+            return;  // Timed out already
+        }
+        auto& pending = *it->second;
+        if (j.value("ok", false)) {
+            pending.result = j.contains("result") ? j["result"] : json{};
+        } else {
+            pending.result = failed(error_from_wire(j.value("error", json::object())));
+        }
+        pending.timer.cancel();
+    } else if (op == "ready") {
+        name_ = j.value("name", name_);
+        version_ = j.value("version", "");
+        ready_ = true;
+
+        std::vector<std::shared_ptr<agent::Tool>> tools;
+        for (const auto& def : j.value("tools", json::array())) {
+            tools.push_back(std::make_shared<RemoteTool>(weak_from_this(),
+                                                         definition_from_wire(def)));
+        }
+        LOG_INFO("Plugin host {} v{} ready with {} tools", name_, version_, tools.size());
+        for (const auto& handler : tools_handlers_) {
+            handler(tools);
+        }
+    }
+}
+
+auto PluginHost::watch_exit(std::shared_ptr<Process> process) -> awaitable<void> {
+    auto self = shared_from_this();
+    boost::system::error_code ec;
+    co_await process->exit_watch.async_wait(
+        net::posix::stream_descriptor::wait_read,
+        net::redirect_error(net::use_awaitable, ec));
+    if (ec || process != process_) {
+        co_return;  // Stopped
+    }
+
+    int status = 0;
+    ::waitpid(process->pid, &status, 0);
+    if (WIFSIGNALED(status)) {
+        LOG_ERROR("Plugin host {} (pid {}) killed by signal {}", name_, process->pid,
+                  WTERMSIG(status));
+    } else {
+        LOG_ERROR("Plugin host {} (pid {}) exited with status {}", name_, process->pid,
+                  WEXITSTATUS(status));
+    }
+
+    process->close();
+    process_.reset();
+    ready_ = false;
+    fail_pending(make_error(ErrorCode::PluginError, "Plugin host exited", name_));
+
+    if (std::chrono::steady_clock::now() - process->started >= options_.stable_after) {
+        next_delay_ = options_.restart_delay;
+    }
+    auto delay = next_delay_;
+    next_delay_ = std::min(next_delay_ * 2, options_.max_restart_delay);
+    net::co_spawn(ioc_, restart_later(delay), net::detached);
+}
+
+auto PluginHost::restart_later(std::chrono::milliseconds delay) -> awaitable<void> {
+    auto self = shared_from_this();
+    net::steady_timer timer(ioc_);
+    timer.expires_after(delay);
+    boost::system::error_code ec;
+    co_await timer.async_wait(net::redirect_error(net::use_awaitable, ec));
+    if (stopped_ || process_) {
+        co_return;
+    }
+
+    ++restarts_;
+    LOG_INFO("Restarting plugin host {} (restart {})", name_, restarts_);
+    if (auto spawned = spawn(); !spawned) {
+        LOG_ERROR("Plugin host {} restart failed: {}", name_, spawned.error().what());
+        auto next = next_delay_;
+        next_delay_ = std::min(next_delay_ * 2, options_.max_restart_delay);
+        net::co_spawn(ioc_, restart_later(next), net::detached);
+    }
+}
+
+void PluginHost::fail_pending(const Error& error) {
+    for (auto& [id, pending] : pending_) {
+        if (!pending->result) {
+            pending->result = failed(error);
+            pending->timer.cancel();
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Host process side
+// ---------------------------------------------------------------------------
+
+namespace {
+
+/// Host process end of the channel: executes calls as they arrive and
+/// answers each one when its tool completes. Single-threaded, so it is
+/// the only producer on the response ring.
+class HostServer {
+public:
+    HostServer(net::io_context& ioc, const PluginHostEndpoint& endpoint,
+               const Mapping& mapping)
+        : ioc_(ioc)
+        , endpoint_(endpoint)
+        , requests_(ShmRing::attach(mapping.requests(), endpoint.ring_bytes))
+        , responses_(ShmRing::attach(mapping.responses(), endpoint.ring_bytes))
+        , doorbell_(ioc, endpoint.request_fd) {}
+
+    void add(std::shared_ptr<agent::Tool> tool) {
+        auto def = tool->definition();
+        definitions_.push_back(definition_to_wire(def));
+        tools_[def.name] = std::move(tool);
+    }
+
+    auto serve(std::string name, std::string version) -> awaitable<void> {
+        json ready{{"op", "ready"}, {"name", name}, {"version", version}};
+        ready["tools"] = definitions_;
+        co_await send(std::move(ready));
+
+        std::string message;
+        while (true) {
+            boost::system::error_code ec;
+            co_await doorbell_.async_wait(net::posix::stream_descriptor::wait_read,
+                                          net::redirect_error(net::use_awaitable, ec));
+            if (ec) {
+                co_return;
+            }
+            drain(endpoint_.request_fd);
+            while (requests_.try_pop(message)) {
+                auto request = json::parse(message, nullptr, false);
+                if (request.is_discarded() || request.value("op", "") != "call") {
+                    continue;
+                }
+                net::co_spawn(ioc_, handle(std::move(request)), net::detached);
+            }
+            if (requests_.corrupt()) {
+                LOG_ERROR("Plugin host request ring is corrupt, exiting");
+                ioc_.stop();
+                co_return;
+            }
+        }
+    }
+
+private:
+    auto handle(json request) -> awaitable<void> {
+        auto tool_name = request.value("tool", "");
+        json response{{"op", "result"}, {"id", request.value("id", uint64_t{0})}};
+
+        auto result = failed(make_error(ErrorCode::NotFound, "Tool not found", tool_name));
+        if (auto it = tools_.find(tool_name); it != tools_.end()) {
+            try {
+                result = co_await it->second->execute(request.value("params", json::object()));
+            } catch (const std::exception& e) {
+                result = failed(make_error(ErrorCode::PluginError,
+                                           "Tool threw an exception", e.what()));
+            }
+        }
+        if (result) {
+            response["ok"] = true;
+            response["result"] = std::move(*result);
+        } else {
+            response["ok"] = false;
+            response["error"] = error_to_wire(result.error());
+        }
+        co_await send(std::move(response));
+    }
+
+    auto send(json message) -> awaitable<void> {
+        auto text = message.dump();
+        if (text.size() > responses_.max_message_size()) {
+            message.erase("result");
+            message["ok"] = false;
+            message["error"] = error_to_wire(make_error(
+                ErrorCode::PluginError, "Tool result exceeds the plugin ring"));
+            text = message.dump();
+        }
+        // The gateway drains responses as they arrive; wait out a full ring
+        net::steady_timer backoff(ioc_);
+        while (!responses_.try_push(text)) {
+            backoff.expires_after(1ms);
+            boost::system::error_code ec;
+            co_await backoff.async_wait(net::redirect_error(net::use_awaitable, ec));
+        }
+        ring(endpoint_.response_fd);
+    }
+
+    net::io_context& ioc_;
+    PluginHostEndpoint endpoint_;
+    ShmRing requests_;
+    ShmRing responses_;
+    net::posix::stream_descriptor doorbell_;
+    std::unordered_map<std::string, std::shared_ptr<agent::Tool>> tools_;
+    json definitions_ = json::array();
+};
+
+} // anonymous namespace
+
+auto serve_plugin_host(const PluginHostEndpoint& endpoint,
+                       std::string name, std::string version,
+                       std::vector<std::shared_ptr<agent::Tool>> tools) -> int {
+    Mapping mapping(endpoint.memfd, endpoint.ring_bytes);
+    if (!mapping.ok()) {
+        LOG_ERROR("Plugin host cannot map its ring: {}", std::strerror(errno));
+        return 1;
+    }
+
+    net::io_context ioc;
+    HostServer server(ioc, endpoint, mapping);
+    for (auto& tool : tools) {
+        server.add(std::move(tool));
+    }
+    net::co_spawn(ioc, server.serve(std::move(name), std::move(version)), net::detached);
+    ioc.run();
+    return 0;
+}
+
+auto run_plugin_host(const PluginHostEndpoint& endpoint,
+                     const std::filesystem::path& library,
+                     const Config& config,
+                     const std::filesystem::path& data_dir) -> int {
+    PluginLoader loader(config, data_dir);
+    auto loaded = loader.load(library);
+    if (!loaded) {
+        LOG_ERROR("Plugin host cannot load {}: {}", library.string(),
+                  loaded.error().what());
+        return 1;
+    }
+    auto plugin = loader.find((*loaded)->name());
+    if (!plugin->methods.empty()) {
+        LOG_WARN("Plugin {} registers methods; only tools are served out of process",
+                 plugin->name);
+    }
+    return serve_plugin_host(endpoint, plugin->name, plugin->version,
+                             LoadedPlugin::shared_tools(plugin));
+}
+
+} // namespace openclaw::plugins
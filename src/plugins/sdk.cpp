@@ -45,6 +45,21 @@ auto PluginSDK::register_channel(std::unique_ptr<openclaw::channels::Channel> ch
     channels_.push_back(std::move(channel));
 }
 
+auto PluginSDK::register_method(
+    std::string name, std::string description,
+    std::function<boost::asio::awaitable<json>(json params)> handler) -> void {
+    if (name.empty() || !handler) {
+        LOG_WARN("Attempted to register an unnamed or empty method");
+        return;
+    }
+    LOG_INFO("Plugin registered method: {}", name);
+    methods_.push_back(PluginMethod{
+        .name = std::move(name),
+        .description = std::move(description),
+        .handler = std::move(handler),
+    });
+}
+
 auto PluginSDK::log(std::string_view level, std::string_view message) -> void {
     if (level == "trace") {
         LOG_TRACE("[plugin] {}", message);
@@ -79,4 +94,8 @@ auto PluginSDK::channels() -> std::vector<std::unique_ptr<openclaw::channels::Ch
     return channels_;
 }
 
+auto PluginSDK::methods() -> std::vector<PluginMethod>& {
+    return methods_;
+}
+
 } // namespace openclaw::plugins
@@ -0,0 +1,131 @@
+#include "openclaw/plugins/shm_ring.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <new>
+
+namespace openclaw::plugins {
+
+namespace {
+
+constexpr uint32_t kWrapMarker = 0xFFFFFFFFu;
+constexpr size_t kLengthSize = sizeof(uint32_t);
+
+constexpr auto align8(size_t n) -> size_t {
+    return (n + 7) & ~size_t{7};
+}
+
+constexpr auto ring_capacity(size_t capacity) -> size_t {
+    return std::bit_ceil(std::max<size_t>(capacity, 64));
+}
+
+} // anonymous namespace
+
+auto ShmRing::region_size(size_t capacity) -> size_t {
+    return sizeof(Header) + ring_capacity(capacity);
+}
+
+auto ShmRing::create(void* region, size_t capacity) -> ShmRing {
+    auto* header = new (region) Header{};
+    header->head.store(0, std::memory_order_relaxed);
+    header->tail.store(0, std::memory_order_relaxed);
+    header->capacity = ring_capacity(capacity);
+    std::atomic_thread_fence(std::memory_order_release);
+    return ShmRing(header, static_cast<char*>(region) + sizeof(Header), header->capacity);
+}
+
+auto ShmRing::attach(void* region, size_t capacity) -> ShmRing {
+    auto* header = std::launder(static_cast<Header*>(region));
+    return ShmRing(header, static_cast<char*>(region) + sizeof(Header),
+                   ring_capacity(capacity));
+}
+
+auto ShmRing::max_message_size() const -> size_t {
+    // Half the buffer always has a contiguous run once the ring drains
+    return capacity_ / 2 - kLengthSize;
+}
+
+auto ShmRing::try_push(std::string_view message) -> bool {
+    if (message.size() > max_message_size()) {
+        return false;
+    }
+    auto capacity = capacity_;
+    auto head = header_->head.load(std::memory_order_relaxed);
+    auto tail = header_->tail.load(std::memory_order_acquire);
+    if (head - tail > capacity) {
+        return false;  // The consumer moved tail somewhere it cannot be
+    }
+
+    auto record = align8(kLengthSize + message.size());
+    auto offset = head & (capacity - 1);
+    auto to_end = capacity - offset;
+    auto needed = record > to_end ? to_end + record : record;
+    if (needed > capacity - (head - tail)) {
+        return false;
+    }
+
+    if (record > to_end) {
+        std::memcpy(data_ + offset, &kWrapMarker, kLengthSize);
+        head += to_end;
+        offset = 0;
+    }
+    auto length = static_cast<uint32_t>(message.size());
+    std::memcpy(data_ + offset, &length, kLengthSize);
+    std::memcpy(data_ + offset + kLengthSize, message.data(), message.size());
+    header_->head.store(head + record, std::memory_order_release);
+    return true;
+}
+
+auto ShmRing::try_pop(std::string& out) -> bool {
+    if (corrupt_) {
+        return false;
+    }
+    auto capacity = capacity_;
+    auto tail = header_->tail.load(std::memory_order_relaxed);
+    auto head = header_->head.load(std::memory_order_acquire);
+    if (tail == head) {
+        return false;
+    }
+
+    // Everything below comes from the producer; check it before use
+    auto used = head - tail;
+    auto offset = tail & (capacity - 1);
+    auto to_end = capacity - offset;
+    if (used > capacity || offset % 8 != 0 || used < kLengthSize) {
+        corrupt_ = true;
+        return false;
+    }
+    uint32_t length = 0;
+    std::memcpy(&length, data_ + offset, kLengthSize);
+    if (length == kWrapMarker) {
+        if (offset == 0 || to_end + kLengthSize > used) {
+            corrupt_ = true;
+            return false;
+        }
+        tail += to_end;
+        used -= to_end;
+        offset = 0;
+        to_end = capacity;
+        std::memcpy(&length, data_, kLengthSize);
+    }
+    if (length > max_message_size()) {
+        corrupt_ = true;
+        return false;
+    }
+    auto record = align8(kLengthSize + length);
+    if (record > used || record > to_end) {
+        corrupt_ = true;
+        return false;
+    }
+    out.assign(data_ + offset + kLengthSize, length);
+    header_->tail.store(tail + record, std::memory_order_release);
+    return true;
+}
+
+auto ShmRing::empty() const -> bool {
+    return header_->tail.load(std::memory_order_acquire) ==
+           header_->head.load(std::memory_order_acquire);
+}
+
+} // namespace openclaw::plugins
@@ -0,0 +1,154 @@
+#include "openclaw/plugins/watcher.hpp"
+#include "openclaw/core/logger.hpp"
+
+#include <array>
+#include <cstring>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace openclaw::plugins {
+
+namespace fs = std::filesystem;
+namespace net = boost::asio;
+
+PluginWatcher::PluginWatcher(net::io_context& ioc, PluginLoader& loader,
+                             fs::path dir, std::chrono::milliseconds debounce)
+    : ioc_(ioc)
+    , loader_(loader)
+    , dir_(std::move(dir))
+    , debounce_(debounce)
+    , stream_(ioc)
+    , timer_(ioc, net::steady_timer::time_point::max()) {}
+
+PluginWatcher::~PluginWatcher() {
+    stop();
+}
+
+auto PluginWatcher::start() -> Result<void> {
+#ifdef __linux__
+    if (running_) {
+        return {};
+    }
+    int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        return std::unexpected(make_error(
+            ErrorCode::IoError, "inotify_init1 failed", std::strerror(errno)));
+    }
+    // IN_CLOSE_WRITE rather than IN_MODIFY: only react once a writer is done
+    constexpr uint32_t kMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE |
+                               IN_MOVED_FROM | IN_ONLYDIR;
+    if (::inotify_add_watch(fd, dir_.c_str(), kMask) < 0) {
+        auto err = std::string(std::strerror(errno));
+        ::close(fd);
+        return std::unexpected(make_error(
+            ErrorCode::IoError, "Cannot watch plugin directory",
+            dir_.string() + ": " + err));
+    }
+    stream_.assign(fd);
+    running_ = true;
+
+    net::co_spawn(ioc_, read_loop(), net::detached);
+    net::co_spawn(ioc_, debounce_loop(), net::detached);
+    LOG_INFO("Watching {} for plugin changes", dir_.string());
+    return {};
+#else
+    return std::unexpected(make_error(
+        ErrorCode::PluginError, "Plugin watching requires inotify (Linux)",
+        dir_.string()));
+#endif
+}
+
+void PluginWatcher::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    boost::system::error_code ec;
+    stream_.close(ec);
+    timer_.cancel();
+}
+
+auto PluginWatcher::read_loop() -> net::awaitable<void> {
+#ifdef __linux__
+    alignas(inotify_event) std::array<char, 4096> buffer;
+    while (running_) {
+        boost::system::error_code ec;
+        auto n = co_await stream_.async_read_some(
+            net::buffer(buffer), net::redirect_error(net::use_awaitable, ec));
+        if (ec) {
+            if (running_) {
+                LOG_ERROR("Plugin watcher read failed: {}", ec.message());
+            }
+            co_return;
+        }
+
+        for (size_t offset = 0; offset < n;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+            offset += sizeof(inotify_event) + event->len;
+            if (event->len == 0) {
+                continue;
+            }
+            auto path = dir_ / event->name;
+            if (!is_plugin_library(path)) {
+                continue;
+            }
+            pending_[path] = (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                                 ? Change::Removed
+                                 : Change::Written;
+        }
+        if (!pending_.empty()) {
+            // Re-arming cancels the pending wait, restarting the quiet period
+            timer_.expires_after(debounce_);
+        }
+    }
+#endif
+    co_return;
+}
+
+auto PluginWatcher::debounce_loop() -> net::awaitable<void> {
+    while (running_) {
+        boost::system::error_code ec;
+        co_await timer_.async_wait(net::redirect_error(net::use_awaitable, ec));
+        if (!running_) {
+            co_return;
+        }
+        if (ec == net::error::operation_aborted) {
+            continue;
+        }
+        timer_.expires_at(net::steady_timer::time_point::max());
+        apply_pending();
+    }
+}
+
+void PluginWatcher::apply_pending() {
+    auto changes = std::move(pending_);
+    pending_.clear();
+
+    auto plugins = loader_.snapshot();
+    for (const auto& [path, change] : changes) {
+        if (change == Change::Written) {
+            auto loaded = loader_.load(path);
+            if (!loaded) {
+                LOG_ERROR("Plugin reload from {} failed: {}",
+                          path.filename().string(), loaded.error().what());
+            }
+            continue;
+        }
+        for (const auto& [name, plugin] : *plugins) {
+            if (plugin->path == path) {
+                LOG_INFO("Plugin library {} removed", path.filename().string());
+                (void)loader_.unload(name);
+            }
+        }
+    }
+}
+
+} // namespace openclaw::plugins
@@ -0,0 +1,481 @@
+#include "openclaw/providers/usage_ledger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include "openclaw/core/logger.hpp"
+
+namespace openclaw::providers {
+
+namespace {
+
+constexpr std::array<std::string_view, 6> kDimensions = {
+    "provider", "model", "session", "agent", "channel", "caller",
+};
+
+auto unix_seconds(Timestamp at) -> int64_t {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        at.time_since_epoch()).count();
+}
+
+auto to_micros(double usd) -> int64_t {
+    return std::llround(usd * 1e6);
+}
+
+} // anonymous namespace
+
+void UsageTotals::add(const UsageTotals& other) {
+    runs += other.runs;
+    input_tokens += other.input_tokens;
+    output_tokens += other.output_tokens;
+    cost_micros += other.cost_micros;
+}
+
+auto UsageLedger::RollupKeyHash::operator()(const RollupKey& key) const noexcept
+    -> size_t {
+    size_t seed = std::hash<int64_t>{}(key.bucket);
+    auto mix = [&seed](const std::string& s) {
+        seed ^= std::hash<std::string>{}(s) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    };
+    mix(key.labels.provider);
+    mix(key.labels.model);
+    mix(key.labels.session);
+    mix(key.labels.agent);
+    mix(key.labels.channel);
+    mix(key.labels.caller);
+    return seed;
+}
+
+UsageLedger::UsageLedger(const UsageConfig& config, const std::string& db_path)
+    : config_(config)
+    , prices_(config.prices)
+    , db_(std::make_unique<SQLite::Database>(
+          db_path, SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE)) {
+    config_.bucket_seconds = std::max(config_.bucket_seconds, 1);
+    std::stable_sort(prices_.begin(), prices_.end(),
+        [](const ModelPriceConfig& a, const ModelPriceConfig& b) {
+            return a.model.size() > b.model.size();
+        });
+
+    for (const auto& bc : config.budgets) {
+        if (!is_dimension(bc.dimension) || bc.key.empty()) {
+            LOG_WARN("Ignoring usage budget '{}:{}': unknown dimension or empty key",
+                     bc.dimension, bc.key);
+            continue;
+        }
+        if (bc.soft_usd <= 0.0 && bc.hard_usd <= 0.0) {
+            continue;
+        }
+        Budget budget;
+        budget.config = bc;
+        if (bc.period != "day" && bc.period != "month") {
+            LOG_WARN("Usage budget '{}:{}' has unknown period '{}', using 'day'",
+                     bc.dimension, bc.key, bc.period);
+            budget.config.period = "day";
+        }
+        budget.soft_micros = to_micros(bc.soft_usd);
+        budget.hard_micros = to_micros(bc.hard_usd);
+        budgets_.push_back(std::move(budget));
+    }
+
+    init_schema();
+    seed_budgets();
+    LOG_INFO("Usage ledger opened at {} ({} prices, {} budgets)",
+             db_path, prices_.size(), budgets_.size());
+}
+
+UsageLedger::~UsageLedger() {
+    db_thread_.join();
+    try {
+        if (auto flushed = flush(); !flushed) {
+            LOG_ERROR("Final usage flush failed: {}", flushed.error().what());
+        }
+    } catch (...) {
+        // Never throw from the destructor
+    }
+}
+
+void UsageLedger::init_schema() {
+    // One row per bucket and label combination. Empty labels are stored
+    // as '' so they take part in the primary key.
+    db_->exec(R"SQL(
+        CREATE TABLE IF NOT EXISTS usage_rollup (
+            bucket INTEGER NOT NULL,
+            provider TEXT NOT NULL,
+            model TEXT NOT NULL,
+            session TEXT NOT NULL,
+            agent TEXT NOT NULL,
+            channel TEXT NOT NULL,
+            caller TEXT NOT NULL,
+            runs INTEGER NOT NULL,
+            input_tokens INTEGER NOT NULL,
+            output_tokens INTEGER NOT NULL,
+            cost_micros INTEGER NOT NULL,
+            PRIMARY KEY (bucket, provider, model, session, agent, channel, caller)
+        ) WITHOUT ROWID
+    )SQL");
+    migrate_schema();
+}
+
+void UsageLedger::migrate_schema() {
+    // Tables from before the caller dimension: it is part of the primary
+    // key, so the table is rebuilt rather than altered
+    {
+        SQLite::Statement columns(*db_,
+            "SELECT COUNT(*) FROM pragma_table_info('usage_rollup') WHERE name = 'caller'");
+        if (!columns.executeStep() || columns.getColumn(0).getInt() != 0) {
+            return;
+        }
+    }  // Finalized before the table is dropped
+    SQLite::Transaction txn(*db_);
+    db_->exec(R"SQL(
+        CREATE TABLE usage_rollup_v2 (
+            bucket INTEGER NOT NULL,
+            provider TEXT NOT NULL,
+            model TEXT NOT NULL,
+            session TEXT NOT NULL,
+            agent TEXT NOT NULL,
+            channel TEXT NOT NULL,
+            caller TEXT NOT NULL,
+            runs INTEGER NOT NULL,
+            input_tokens INTEGER NOT NULL,
+            output_tokens INTEGER NOT NULL,
+            cost_micros INTEGER NOT NULL,
+            PRIMARY KEY (bucket, provider, model, session, agent, channel, caller)
+        ) WITHOUT ROWID;
+        INSERT INTO usage_rollup_v2
+            SELECT bucket, provider, model, session, agent, channel, '',
+                   runs, input_tokens, output_tokens, cost_micros
+            FROM usage_rollup;
+        DROP TABLE usage_rollup;
+        ALTER TABLE usage_rollup_v2 RENAME TO usage_rollup;
+    )SQL");
+    txn.commit();
+    LOG_INFO("Usage ledger: added the caller dimension to usage_rollup");
+}
+
+void UsageLedger::seed_budgets() {
+    auto now = Clock::now();
+    for (auto& budget : budgets_) {
+        budget.period_start = period_start(budget.config, now);
+        // The dimension was checked against kDimensions
+        SQLite::Statement stmt(*db_,
+            "SELECT COALESCE(SUM(cost_micros), 0) FROM usage_rollup WHERE " +
+            budget.config.dimension + " = ? AND bucket >= ?");
+        stmt.bind(1, budget.config.key);
+        stmt.bind(2, budget.period_start);
+        if (stmt.executeStep()) {
+            budget.spent_micros = stmt.getColumn(0).getInt64();
+        }
+    }
+}
+
+auto UsageLedger::is_dimension(std::string_view name) -> bool {
+    return std::ranges::find(kDimensions, name) != kDimensions.end();
+}
+
+auto UsageLedger::label(const UsageLabels& labels, std::string_view dimension)
+    -> const std::string& {
+    if (dimension == "provider") return labels.provider;
+    if (dimension == "model")    return labels.model;
+    if (dimension == "session")  return labels.session;
+    if (dimension == "agent")    return labels.agent;
+    if (dimension == "channel")  return labels.channel;
+    return labels.caller;
+}
+
+auto UsageLedger::bucket_of(Timestamp at) const -> int64_t {
+    auto seconds = unix_seconds(at);
+    auto width = static_cast<int64_t>(config_.bucket_seconds);
+    return seconds - ((seconds % width) + width) % width;
+}
+
+auto UsageLedger::period_start(const UsageBudgetConfig& budget, Timestamp at)
+    -> int64_t {
+    auto day = std::chrono::floor<std::chrono::days>(at);
+    if (budget.period == "month") {
+        std::chrono::year_month_day ymd{day};
+        day = std::chrono::sys_days{ymd.year() / ymd.month() / 1};
+    }
+    return unix_seconds(Timestamp{day});
+}
+
+auto UsageLedger::cost_micros(std::string_view model, int64_t input_tokens,
+                              int64_t output_tokens) const -> int64_t {
+    // USD per million tokens is micro-USD per token
+    for (const auto& price : prices_) {
+        if (model.starts_with(price.model)) {
+            return std::llround(static_cast<double>(input_tokens) * price.input_per_mtok +
+                                static_cast<double>(output_tokens) * price.output_per_mtok);
+        }
+    }
+    return 0;
+}
+
+void UsageLedger::roll(Budget& budget, Timestamp now) {
+    auto start = period_start(budget.config, now);
+    if (start > budget.period_start) {
+        budget.period_start = start;
+        budget.spent_micros = 0;
+        budget.warned = false;
+    }
+}
+
+auto UsageLedger::status_of(const Budget& budget) const -> BudgetStatus {
+    BudgetStatus status;
+    status.tenant = budget.config.dimension + ":" + budget.config.key;
+    status.spent_usd = static_cast<double>(budget.spent_micros) / 1e6;
+    if (budget.hard_micros > 0 && budget.spent_micros >= budget.hard_micros) {
+        status.state = BudgetState::Hard;
+        status.limit_usd = budget.config.hard_usd;
+    } else if (budget.soft_micros > 0 && budget.spent_micros >= budget.soft_micros) {
+        status.state = BudgetState::Soft;
+        status.limit_usd = budget.config.soft_usd;
+    } else {
+        status.limit_usd = budget.hard_micros > 0 ? budget.config.hard_usd
+                                                  : budget.config.soft_usd;
+    }
+    return status;
+}
+
+void UsageLedger::record(const UsageEvent& event) {
+    UsageTotals totals{
+        .runs = 1,
+        .input_tokens = event.input_tokens,
+        .output_tokens = event.output_tokens,
+        .cost_micros = cost_micros(event.labels.model, event.input_tokens,
+                                   event.output_tokens),
+    };
+    RollupKey key{.bucket = bucket_of(event.at), .labels = event.labels};
+
+    std::lock_guard lock(mutex_);
+    pending_[std::move(key)].add(totals);
+
+    for (auto& budget : budgets_) {
+        if (label(event.labels, budget.config.dimension) != budget.config.key) {
+            continue;
+        }
+        roll(budget, event.at);
+        if (period_start(budget.config, event.at) != budget.period_start) {
+            continue;  // Late event from an earlier period
+        }
+        budget.spent_micros += totals.cost_micros;
+        if (!budget.warned && budget.soft_micros > 0 &&
+            budget.spent_micros >= budget.soft_micros) {
+            budget.warned = true;
+            LOG_WARN("Usage budget {}:{} passed its soft limit: ${:.2f} of ${:.2f} this {}",
+                     budget.config.dimension, budget.config.key,
+                     static_cast<double>(budget.spent_micros) / 1e6,
+                     budget.config.soft_usd, budget.config.period);
+        }
+    }
+}
+
+auto UsageLedger::check_budget(const UsageLabels& labels, Timestamp now)
+    -> BudgetStatus {
+    BudgetStatus worst;
+    std::lock_guard lock(mutex_);
+    for (auto& budget : budgets_) {
+        if (label(labels, budget.config.dimension) != budget.config.key) {
+            continue;
+        }
+        roll(budget, now);
+        auto status = status_of(budget);
+        if (worst.tenant.empty() || status.state > worst.state) {
+            worst = std::move(status);
+        }
+    }
+    return worst;
+}
+
+auto UsageLedger::budgets(Timestamp now) -> json {
+    json result = json::array();
+    std::lock_guard lock(mutex_);
+    for (auto& budget : budgets_) {
+        roll(budget, now);
+        auto status = status_of(budget);
+        result.push_back(json{
+            {"dimension", budget.config.dimension},
+            {"key", budget.config.key},
+            {"period", budget.config.period},
+            {"spent_usd", status.spent_usd},
+            {"soft_usd", budget.config.soft_usd},
+            {"hard_usd", budget.config.hard_usd},
+            {"state", status.state == BudgetState::Hard ? "hard"
+                    : status.state == BudgetState::Soft ? "soft" : "ok"},
+        });
+    }
+    return result;
+}
+
+auto UsageLedger::write(const Pending& rows) -> size_t {
+    SQLite::Transaction txn(*db_);
+    SQLite::Statement stmt(*db_,
+        "INSERT INTO usage_rollup (bucket, provider, model, session, agent, channel, "
+        "caller, runs, input_tokens, output_tokens, cost_micros) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?) "
+        "ON CONFLICT (bucket, provider, model, session, agent, channel, caller) DO UPDATE SET "
+        "runs = runs + excluded.runs, "
+        "input_tokens = input_tokens + excluded.input_tokens, "
+        "output_tokens = output_tokens + excluded.output_tokens, "
+        "cost_micros = cost_micros + excluded.cost_micros");
+    for (const auto& [key, totals] : rows) {
+        stmt.bind(1, key.bucket);
+        stmt.bind(2, key.labels.provider);
+        stmt.bind(3, key.labels.model);
+        stmt.bind(4, key.labels.session);
+        stmt.bind(5, key.labels.agent);
+        stmt.bind(6, key.labels.channel);
+        stmt.bind(7, key.labels.caller);
+        stmt.bind(8, totals.runs);
+        stmt.bind(9, totals.input_tokens);
+        stmt.bind(10, totals.output_tokens);
+        stmt.bind(11, totals.cost_micros);
+        stmt.exec();
+        stmt.reset();
+    }
+    txn.commit();
+    return rows.size();
+}
+
+auto UsageLedger::flush() -> Result<size_t> {
+    std::lock_guard db_lock(db_mutex_);
+    Pending rows;
+    {
+        std::lock_guard lock(mutex_);
+        rows.swap(pending_);
+    }
+    if (rows.empty()) {
+        return 0;
+    }
+    try {
+        return write(rows);
+    } catch (const SQLite::Exception& e) {
+        // Put the totals back so the next flush retries them
+        std::lock_guard lock(mutex_);
+        for (auto& [key, totals] : rows) {
+            pending_[key].add(totals);
+        }
+        return std::unexpected(
+            make_error(ErrorCode::DatabaseError, "Failed to flush usage", e.what()));
+    }
+}
+
+auto UsageLedger::query(const UsageQuery& query) -> Result<std::vector<UsageRow>> {
+    for (const auto& name : query.group_by) {
+        if (name != "bucket" && !is_dimension(name)) {
+            return std::unexpected(
+                make_error(ErrorCode::InvalidArgument, "Unknown usage dimension", name));
+        }
+    }
+    for (const auto& [name, _] : query.where) {
+        if (!is_dimension(name)) {
+            return std::unexpected(
+                make_error(ErrorCode::InvalidArgument, "Unknown usage dimension", name));
+        }
+    }
+
+    if (auto flushed = flush(); !flushed) {
+        return std::unexpected(flushed.error());
+    }
+
+    // Column names come from kDimensions only, values are bound
+    std::string columns;
+    for (const auto& name : query.group_by) {
+        if (!columns.empty()) columns += ", ";
+        columns += name;
+    }
+    std::string sql = "SELECT ";
+    if (!columns.empty()) sql += columns + ", ";
+    sql += "SUM(runs), SUM(input_tokens), SUM(output_tokens), SUM(cost_micros) "
+           "FROM usage_rollup WHERE bucket >= ? AND bucket < ?";
+    for (const auto& [name, _] : query.where) {
+        sql += " AND " + name + " = ?";
+    }
+    if (!columns.empty()) {
+        sql += " GROUP BY " + columns +
+               " ORDER BY SUM(cost_micros) DESC, SUM(input_tokens + output_tokens) DESC";
+    }
+    sql += " LIMIT ?";
+
+    try {
+        std::lock_guard db_lock(db_mutex_);
+        SQLite::Statement stmt(*db_, sql);
+        int index = 1;
+        stmt.bind(index++, query.from ? bucket_of(*query.from)
+                                      : std::numeric_limits<int64_t>::min());
+        stmt.bind(index++, query.to ? unix_seconds(*query.to)
+                                    : std::numeric_limits<int64_t>::max());
+        for (const auto& [_, value] : query.where) {
+            stmt.bind(index++, value);
+        }
+        stmt.bind(index, static_cast<int64_t>(query.limit));
+
+        std::vector<UsageRow> rows;
+        while (stmt.executeStep()) {
+            UsageRow row;
+            int col = 0;
+            for (const auto& name : query.group_by) {
+                if (name == "bucket") {
+                    row.keys[name] = stmt.getColumn(col++).getInt64() * 1000;
+                } else {
+                    row.keys[name] = stmt.getColumn(col++).getString();
+                }
+            }
+            row.totals.runs = stmt.getColumn(col++).getInt64();
+            row.totals.input_tokens = stmt.getColumn(col++).getInt64();
+            row.totals.output_tokens = stmt.getColumn(col++).getInt64();
+            row.totals.cost_micros = stmt.getColumn(col).getInt64();
+            rows.push_back(std::move(row));
+        }
+        return rows;
+    } catch (const SQLite::Exception& e) {
+        return std::unexpected(
+            make_error(ErrorCode::DatabaseError, "Failed to query usage", e.what()));
+    }
+}
+
+auto UsageLedger::async_query(UsageQuery query)
+    -> boost::asio::awaitable<Result<std::vector<UsageRow>>> {
+    co_return co_await boost::asio::co_spawn(db_thread_,
+        [this, query = std::move(query)]() -> boost::asio::awaitable<Result<std::vector<UsageRow>>> {
+            co_return this->query(query);
+        },
+        boost::asio::use_awaitable);
+}
+
+auto UsageLedger::flush_loop() -> boost::asio::awaitable<void> {
+    auto executor = co_await boost::asio::this_coro::executor;
+    boost::asio::steady_timer timer(executor);
+    auto interval = std::chrono::seconds(std::max(config_.flush_interval_seconds, 1));
+    while (!stopped_) {
+        timer.expires_after(interval);
+        boost::system::error_code ec;
+        co_await timer.async_wait(
+            boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        if (ec || stopped_) {
+            break;
+        }
+        auto flushed = co_await boost::asio::co_spawn(db_thread_,
+            [this]() -> boost::asio::awaitable<Result<size_t>> { co_return flush(); },
+            boost::asio::use_awaitable);
+        if (!flushed) {
+            LOG_WARN("Usage flush failed, will retry: {}", flushed.error().what());
+        }
+    }
+}
+
+void UsageLedger::stop() {
+    stopped_ = true;
+}
+
+} // namespace openclaw::providers
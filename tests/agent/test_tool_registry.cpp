@@ -136,6 +136,45 @@ TEST_CASE("ToolRegistry clear", "[agent][tool_registry]") {
     CHECK(reg.list().empty());
 }
 
+TEST_CASE("ToolRegistry replace publishes a set at once", "[agent][tool_registry]") {
+    ToolRegistry reg;
+    reg.register_tool(std::make_unique<StubTool>("keep", "Unrelated"));
+    reg.register_tool(std::make_unique<StubTool>("old_a", "Old A"));
+    reg.register_tool(std::make_unique<StubTool>("old_b", "Old B"));
+
+    auto before = reg.snapshot();
+    reg.replace({"old_a", "old_b"},
+                {std::make_shared<StubTool>("new_a", "New A")});
+
+    CHECK(reg.size() == 2);
+    CHECK(reg.contains("keep"));
+    CHECK(reg.contains("new_a"));
+    CHECK_FALSE(reg.contains("old_a"));
+
+    // Earlier snapshots are unaffected by later publications
+    CHECK(before->size() == 3);
+    CHECK(before->contains("old_b"));
+}
+
+TEST_CASE("ToolRegistry find keeps a removed tool alive", "[agent][tool_registry]") {
+    ToolRegistry reg;
+    reg.register_tool(std::make_unique<StubTool>("plugin_tool", "Version 1"));
+
+    auto held = reg.find("plugin_tool");
+    REQUIRE(held != nullptr);
+    std::weak_ptr<Tool> watch = held;
+
+    reg.register_tool(std::make_unique<StubTool>("plugin_tool", "Version 2"));
+    CHECK(reg.get("plugin_tool")->definition().description == "Version 2");
+
+    // The caller still holds version 1, as a call in flight would
+    REQUIRE_FALSE(watch.expired());
+    CHECK(held->definition().description == "Version 1");
+
+    held.reset();
+    CHECK(watch.expired());
+}
+
 TEST_CASE("ToolDefinition parameter metadata", "[agent][tool_registry]") {
     StubTool tool("test_tool", "A test");
     auto def = tool.definition();
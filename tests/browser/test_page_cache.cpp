@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include "openclaw/browser/page_cache.hpp"
+
+using namespace openclaw::browser;
+
+namespace {
+
+auto page(std::string content, std::string etag = {}) -> CachedPage {
+    CachedPage p;
+    p.final_url = "https://docs.example/page";
+    p.title = "Docs";
+    p.content = std::move(content);
+    p.etag = std::move(etag);
+    return p;
+}
+
+} // namespace
+
+TEST_CASE("normalize_url canonicalizes cache keys", "[browser][page_cache]") {
+    CHECK(normalize_url("HTTPS://Docs.Example.com:443/Guide?b=2#intro") ==
+          "https://docs.example.com/Guide?b=2");
+    CHECK(normalize_url("http://example.com") == "http://example.com/");
+    CHECK(normalize_url("http://example.com:8080/x") == "http://example.com:8080/x");
+    CHECK(normalize_url("https://example.com/a?utm_source=x&id=7&fbclid=abc") ==
+          "https://example.com/a?id=7");
+    CHECK(normalize_url("https://example.com/a?utm_medium=y") == "https://example.com/a");
+    CHECK(PageCache::key("https://example.com/#top", "text") ==
+          PageCache::key("https://EXAMPLE.com/", "text"));
+    CHECK(PageCache::key("https://example.com/", "text") !=
+          PageCache::key("https://example.com/", "html"));
+}
+
+TEST_CASE("parse_cache_control reads the directives that matter", "[browser][page_cache]") {
+    auto c = parse_cache_control("public, max-age=300, s-maxage=\"60\"");
+    REQUIRE(c.max_age.has_value());
+    CHECK(*c.max_age == 60);  // s-maxage wins for a shared cache
+    CHECK_FALSE(c.no_store);
+
+    CHECK(parse_cache_control("No-Store").no_store);
+    CHECK(parse_cache_control("private, max-age=10").is_private);
+    CHECK(parse_cache_control("no-cache").no_cache);
+    CHECK_FALSE(parse_cache_control("max-age=abc").max_age.has_value());
+    CHECK_FALSE(parse_cache_control("").max_age.has_value());
+}
+
+TEST_CASE("PageCache freshness follows Cache-Control", "[browser][page_cache]") {
+    PageCache cache(1 << 20, 1000);
+    CacheControl one_minute;
+    one_minute.max_age = 60;
+
+    REQUIRE(cache.store("k", page("hello", "\"v1\""), one_minute, 0));
+
+    auto fresh = cache.lookup("k", 59'000);
+    REQUIRE(fresh.has_value());
+    CHECK(fresh->fresh);
+    CHECK(fresh->page.content == "hello");
+
+    SECTION("Stale entries with validators are kept for revalidation") {
+        auto stale = cache.lookup("k", 61'000);
+        REQUIRE(stale.has_value());
+        CHECK_FALSE(stale->fresh);
+
+        cache.refresh("k", one_minute, 61'000);
+        CHECK(cache.lookup("k", 100'000)->fresh);
+        CHECK(cache.stats().revalidated == 1);
+    }
+
+    SECTION("Stale entries without validators are dropped") {
+        REQUIRE(cache.store("plain", page("text"), {}, 0));  // default TTL 1s
+        CHECK(cache.lookup("plain", 500).has_value());
+        CHECK_FALSE(cache.lookup("plain", 1500).has_value());
+        CHECK(cache.stats().entries == 1);
+    }
+
+    SECTION("no-cache entries are never fresh") {
+        CacheControl no_cache;
+        no_cache.no_cache = true;
+        REQUIRE(cache.store("nc", page("x", "\"e\""), no_cache, 0));
+        CHECK_FALSE(cache.lookup("nc", 1)->fresh);
+    }
+
+    SECTION("no-store and private responses are not stored") {
+        CacheControl no_store;
+        no_store.no_store = true;
+        CHECK_FALSE(cache.store("ns", page("x"), no_store, 0));
+        CacheControl is_private;
+        is_private.is_private = true;
+        CHECK_FALSE(cache.store("p", page("x"), is_private, 0));
+    }
+}
+
+TEST_CASE("PageCache evicts least recently used entries over budget",
+          "[browser][page_cache]") {
+    auto size = page(std::string(1000, 'a')).bytes();
+    PageCache cache(size * 2, 60'000);
+
+    cache.store("a", page(std::string(1000, 'a')), {}, 0);
+    cache.store("b", page(std::string(1000, 'b')), {}, 0);
+    CHECK(cache.lookup("a", 1).has_value());  // a is now most recent
+
+    cache.store("c", page(std::string(1000, 'c')), {}, 0);
+    CHECK(cache.lookup("a", 2).has_value());
+    CHECK_FALSE(cache.lookup("b", 2).has_value());
+    CHECK(cache.lookup("c", 2).has_value());
+
+    auto stats = cache.stats();
+    CHECK(stats.entries == 2);
+    CHECK(stats.evictions == 1);
+    CHECK(stats.bytes <= stats.max_bytes);
+
+    CHECK_FALSE(cache.store("huge", page(std::string(size * 3, 'x')), {}, 0));
+}
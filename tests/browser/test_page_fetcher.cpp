@@ -0,0 +1,162 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "openclaw/browser/page_fetcher.hpp"
+
+using namespace openclaw;
+using namespace openclaw::browser;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Serves every URL from a timer instead of Chrome: loading takes
+/// `delay`, or the URL's entry in `delays`.
+class FakeFetcher : public PageFetcher {
+public:
+    using PageFetcher::PageFetcher;
+
+    std::chrono::milliseconds delay = 20ms;
+    std::map<std::string, std::chrono::milliseconds> delays;
+    size_t acquired = 0;
+    size_t loading = 0;
+    size_t peak_loading = 0;
+
+protected:
+    auto acquire_session() -> awaitable<Result<std::shared_ptr<BrowserSession>>> override {
+        auto session = std::make_shared<BrowserSession>();
+        session->id = "fake-" + std::to_string(++acquired);
+        co_return session;
+    }
+
+    auto load_and_extract(BrowserSession& /*session*/, const std::string& url,
+                          const FetchManyOptions& /*options*/, PageFetchResult& result,
+                          DocumentResponse& /*document*/) -> awaitable<Result<void>> override {
+        peak_loading = std::max(peak_loading, ++loading);
+        auto it = delays.find(url);
+        boost::asio::steady_timer timer(co_await boost::asio::this_coro::executor,
+                                        it == delays.end() ? delay : it->second);
+        boost::system::error_code ec;
+        co_await timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        --loading;
+        result.final_url = url;
+        result.title = "Title";
+        result.content = "Text of " + url;
+        co_return ok_result();
+    }
+};
+
+auto browser_config(bool allow_private) -> BrowserConfig {
+    BrowserConfig config;
+    config.pool_size = 2;
+    config.contexts_per_browser = 4;
+    config.ssrf_policy.dangerously_allow_private_network = allow_private;
+    return config;
+}
+
+auto fetch(boost::asio::io_context& ioc, PageFetcher& fetcher,
+           std::vector<std::string> urls, FetchManyOptions options,
+           std::vector<size_t>* order = nullptr) -> std::vector<PageFetchResult> {
+    PageFetcher::ResultCallback on_result;
+    if (order) {
+        on_result = [order](const PageFetchResult& r) { order->push_back(r.index); };
+    }
+    std::optional<std::vector<PageFetchResult>> results;
+    boost::asio::co_spawn(ioc, fetcher.fetch_many(std::move(urls), std::move(options),
+                                                  std::move(on_result)),
+        [&results](std::exception_ptr e, std::vector<PageFetchResult> r) {
+            if (e) std::rethrow_exception(e);
+            results = std::move(r);
+        });
+    ioc.run();
+    return std::move(results.value());
+}
+
+auto numbered_urls(size_t count) -> std::vector<std::string> {
+    std::vector<std::string> urls;
+    for (size_t i = 0; i < count; ++i) {
+        urls.push_back("http://pages.test/" + std::to_string(i));
+    }
+    return urls;
+}
+
+} // anonymous namespace
+
+TEST_CASE("fetch_many loads at most `concurrency` pages at once", "[browser][page_fetcher]") {
+    boost::asio::io_context ioc;
+    BrowserPool pool(ioc, browser_config(true));
+    FakeFetcher fetcher(pool);
+
+    std::vector<size_t> order;
+    auto results = fetch(ioc, fetcher, numbered_urls(10),
+                         {.concurrency = 3, .timeout_ms = 1000}, &order);
+
+    REQUIRE(results.size() == 10);
+    for (size_t i = 0; i < results.size(); ++i) {
+        CHECK(results[i].ok());
+        CHECK(results[i].index == i);
+        CHECK(results[i].content == "Text of http://pages.test/" + std::to_string(i));
+    }
+    CHECK(fetcher.acquired == 10);
+    CHECK(fetcher.peak_loading == 3);
+    CHECK(order.size() == 10);
+}
+
+TEST_CASE("fetch_many caps concurrency at the pool's capacity", "[browser][page_fetcher]") {
+    boost::asio::io_context ioc;
+    BrowserPool pool(ioc, browser_config(true));  // 2 processes x 4 contexts
+    FakeFetcher fetcher(pool);
+
+    auto results = fetch(ioc, fetcher, numbered_urls(20),
+                         {.concurrency = 50, .timeout_ms = 1000});
+    CHECK(results.size() == 20);
+    CHECK(fetcher.peak_loading == 8);
+}
+
+TEST_CASE("fetch_many times out each URL on its own", "[browser][page_fetcher]") {
+    boost::asio::io_context ioc;
+    BrowserPool pool(ioc, browser_config(true));
+    FakeFetcher fetcher(pool);
+    fetcher.delays["http://pages.test/slow"] = 2s;
+
+    auto results = fetch(ioc, fetcher,
+                         {"http://pages.test/0", "http://pages.test/slow", "http://pages.test/1"},
+                         {.concurrency = 3, .timeout_ms = 200});
+
+    REQUIRE(results.size() == 3);
+    CHECK(results[0].ok());
+    CHECK(results[2].ok());
+    CHECK_FALSE(results[1].ok());
+    CHECK(results[1].error == "Timed out after 200ms");
+    CHECK(results[1].content.empty());
+}
+
+TEST_CASE("fetch_many rejects URLs the FetchGuard blocks before loading them",
+          "[browser][page_fetcher]") {
+    boost::asio::io_context ioc;
+    BrowserPool pool(ioc, browser_config(false));
+    FakeFetcher fetcher(pool);
+
+    auto results = fetch(ioc, fetcher,
+                         {"http://127.0.0.1:8080/admin", "http://93.184.216.34/",
+                          "http://10.1.2.3/", "not a url"},
+                         {.concurrency = 2, .timeout_ms = 1000});
+
+    REQUIRE(results.size() == 4);
+    CHECK_FALSE(results[0].ok());
+    CHECK(results[0].error.find("SSRF blocked") != std::string::npos);
+    CHECK(results[1].ok());
+    CHECK_FALSE(results[2].ok());
+    CHECK(results[2].error.find("SSRF blocked") != std::string::npos);
+    CHECK_FALSE(results[3].ok());
+    CHECK(fetcher.acquired == 1);  // No session spent on a rejected URL
+}
@@ -0,0 +1,103 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "openclaw/browser/request_interceptor.hpp"
+
+using namespace openclaw::browser;
+
+TEST_CASE("Named network profiles", "[browser][network]") {
+    auto full = NetworkProfile::named("full");
+    REQUIRE(full.has_value());
+    CHECK(full->is_passthrough());
+
+    auto text = NetworkProfile::named("text");
+    REQUIRE(text.has_value());
+    CHECK_FALSE(text->is_passthrough());
+    CHECK(text->block_images);
+    CHECK(text->block_media);
+    CHECK(text->block_fonts);
+    CHECK(text->block_trackers);
+
+    CHECK_FALSE(NetworkProfile::named("turbo").has_value());
+
+    SECTION("A size cap or extra domain disables passthrough") {
+        auto capped = *full;
+        capped.max_response_bytes = 1 << 20;
+        CHECK_FALSE(capped.is_passthrough());
+        auto blocked = *full;
+        blocked.blocked_domains = {"ads.example"};
+        CHECK_FALSE(blocked.is_passthrough());
+    }
+}
+
+TEST_CASE("url_host extracts the lower-cased host", "[browser][network]") {
+    CHECK(url_host("https://WWW.Example.com/path?q=1") == "www.example.com");
+    CHECK(url_host("http://user:pw@host.test:8080/") == "host.test");
+    CHECK(url_host("http://[::1]:9222/json") == "::1");
+    CHECK(url_host("https://example.com") == "example.com");
+    CHECK(url_host("data:image/png;base64,AAAA").empty());
+    CHECK(url_host("about:blank").empty());
+}
+
+TEST_CASE("is_local_scheme accepts only data: and blob:", "[browser][network]") {
+    CHECK(is_local_scheme("data:image/png;base64,AAAA"));
+    CHECK(is_local_scheme("blob:https://example.com/1b2c"));
+    CHECK(is_local_scheme("DATA:text/plain,hi"));
+    CHECK_FALSE(is_local_scheme("file:///etc/passwd"));
+    CHECK_FALSE(is_local_scheme("about:blank"));
+    CHECK_FALSE(is_local_scheme("https://example.com/data:x"));
+    CHECK_FALSE(is_local_scheme("no scheme"));
+}
+
+TEST_CASE("Tracker host matching includes subdomains only", "[browser][network]") {
+    CHECK(is_tracker_host("www.google-analytics.com"));
+    CHECK(is_tracker_host("doubleclick.net"));
+    CHECK(is_tracker_host("stats.g.doubleclick.net"));
+    CHECK_FALSE(is_tracker_host("notdoubleclick.net"));
+    CHECK_FALSE(is_tracker_host("example.com"));
+    CHECK(is_tracker_host("pixel.ads.example", {"ads.example"}));
+}
+
+TEST_CASE("classify_request applies the profile", "[browser][network]") {
+    auto text = *NetworkProfile::named("text");
+    auto full = *NetworkProfile::named("full");
+
+    SECTION("Heavy resource types") {
+        CHECK(classify_request(text, "Image", "https://cdn.test/a.png") ==
+              BlockReason::ResourceType);
+        CHECK(classify_request(text, "Media", "https://cdn.test/v.mp4") ==
+              BlockReason::ResourceType);
+        CHECK(classify_request(text, "Font", "https://cdn.test/f.woff2") ==
+              BlockReason::ResourceType);
+        CHECK(classify_request(full, "Image", "https://cdn.test/a.png") ==
+              BlockReason::None);
+    }
+
+    SECTION("Stylesheets and scripts still load") {
+        CHECK(classify_request(text, "Stylesheet", "https://cdn.test/s.css") ==
+              BlockReason::None);
+        CHECK(classify_request(text, "Script", "https://cdn.test/app.js") ==
+              BlockReason::None);
+    }
+
+    SECTION("Trackers") {
+        CHECK(classify_request(text, "Script",
+                               "https://www.googletagmanager.com/gtm.js") ==
+              BlockReason::Tracker);
+        CHECK(classify_request(full, "Script",
+                               "https://www.googletagmanager.com/gtm.js") ==
+              BlockReason::None);
+    }
+
+    SECTION("Documents are never blocked as trackers") {
+        CHECK(classify_request(text, "Document", "https://doubleclick.net/") ==
+              BlockReason::None);
+    }
+
+    SECTION("Configured domains apply to every profile") {
+        full.blocked_domains = {"ads.example"};
+        CHECK(classify_request(full, "XHR", "https://x.ads.example/bid") ==
+              BlockReason::Tracker);
+        CHECK(classify_request(full, "XHR", "https://example.com/api") ==
+              BlockReason::None);
+    }
+}
@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "openclaw/browser/screenshot.hpp"
+
+using namespace openclaw::browser;
+
+TEST_CASE("ImageBudget reads ImageConfig with defaults", "[browser][screenshot]") {
+    auto defaults = ImageBudget::from_config({});
+    CHECK(defaults.max_dimension_px == 1200);
+    CHECK(defaults.max_bytes == 5 * 1024 * 1024);
+
+    auto custom = ImageBudget::from_config({800, 100000});
+    CHECK(custom.max_dimension_px == 800);
+    CHECK(custom.max_bytes == 100000);
+}
+
+TEST_CASE("plan_capture scales the clip to the longest side", "[browser][screenshot]") {
+    ImageBudget budget;
+
+    SECTION("Viewport at device scale 2 is rendered at half scale") {
+        auto plan = plan_capture({0, 0, 1200, 800}, 2.0, "auto", 80, budget);
+        CHECK(plan.format == "webp");
+        CHECK(plan.scale == 0.5);
+        CHECK(plan.output_width() == 1200);
+        CHECK(plan.output_height() == 800);
+
+        auto params = plan.to_params();
+        CHECK(params["format"] == "webp");
+        CHECK(params["quality"] == 80);
+        CHECK(params["clip"]["scale"] == 0.5);
+    }
+
+    SECTION("Small regions are never upscaled") {
+        auto plan = plan_capture({10, 20, 300, 200}, 1.0, "png", 80, budget);
+        CHECK(plan.scale == 1.0);
+        CHECK(plan.output_width() == 300);
+        CHECK_FALSE(plan.to_params().contains("quality"));
+    }
+
+    SECTION("Tall full-page captures fit by height") {
+        auto plan = plan_capture({0, 0, 1000, 6000}, 1.0, "jpeg", 80, budget);
+        CHECK(plan.output_height() == 1200);
+        CHECK(plan.output_width() == 200);
+    }
+}
+
+TEST_CASE("refine_capture trades quality, then size", "[browser][screenshot]") {
+    ImageBudget budget{1200, 100000};
+    auto plan = plan_capture({0, 0, 1200, 800}, 1.0, "webp", 80, budget);
+
+    CHECK_FALSE(refine_capture(plan, 90000, budget).has_value());
+
+    auto lower = refine_capture(plan, 200000, budget);
+    REQUIRE(lower.has_value());
+    CHECK(lower->quality == 40);
+    CHECK(lower->scale == plan.scale);
+
+    auto floor = refine_capture(*lower, 400000, budget);
+    REQUIRE(floor.has_value());
+    CHECK(floor->quality == kMinScreenshotQuality);
+
+    auto smaller = refine_capture(*floor, 400000, budget);
+    REQUIRE(smaller.has_value());
+    CHECK(smaller->quality == kMinScreenshotQuality);
+    CHECK(smaller->output_width() == 540);  // sqrt(1/4) * 0.9 of 1200
+
+    SECTION("PNG can only shrink") {
+        auto png = plan_capture({0, 0, 1200, 800}, 1.0, "png", 80, budget);
+        auto next = refine_capture(png, 400000, budget);
+        REQUIRE(next.has_value());
+        CHECK(next->output_width() == 540);
+    }
+
+    SECTION("Gives up below the minimum dimension") {
+        CHECK_FALSE(refine_capture(*floor, 100000000, budget).has_value());
+    }
+}
+
+TEST_CASE("base64_decoded_size accounts for padding", "[browser][screenshot]") {
+    CHECK(base64_decoded_size("") == 0);
+    CHECK(base64_decoded_size("QQ==") == 1);
+    CHECK(base64_decoded_size("QUI=") == 2);
+    CHECK(base64_decoded_size("QUJD") == 3);
+}
@@ -0,0 +1,194 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+#include "openclaw/browser/snapshot_diff.hpp"
+
+using namespace openclaw::browser;
+using json = nlohmann::json;
+
+namespace {
+
+struct Node {
+    int backend_id;
+    int parent;  // Index into the node list
+    int type;
+    std::string name;
+    std::string value;
+    std::vector<std::string> attrs;  // name, value, name, value, ...
+};
+
+/// Encodes nodes as a DOMSnapshot.captureSnapshot result, every node rendered.
+auto encode(const std::vector<Node>& nodes) -> json {
+    json strings = json::array();
+    auto intern = [&](const std::string& s) {
+        strings.push_back(s);
+        return static_cast<int>(strings.size()) - 1;
+    };
+    json parent = json::array(), type = json::array(), name = json::array(),
+         value = json::array(), attrs = json::array(), backend = json::array(),
+         layout_index = json::array(), bounds = json::array();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const auto& n = nodes[i];
+        parent.push_back(n.parent);
+        type.push_back(n.type);
+        name.push_back(intern(n.name));
+        value.push_back(n.value.empty() ? -1 : intern(n.value));
+        json a = json::array();
+        for (const auto& s : n.attrs) a.push_back(intern(s));
+        attrs.push_back(a);
+        backend.push_back(n.backend_id);
+        if (n.type != 9) {
+            layout_index.push_back(i);
+            bounds.push_back({0, 0, 10, 10});
+        }
+    }
+    return {
+        {"strings", strings},
+        {"documents", json::array({{
+            {"nodes", {
+                {"parentIndex", parent},
+                {"nodeType", type},
+                {"nodeName", name},
+                {"nodeValue", value},
+                {"attributes", attrs},
+                {"backendNodeId", backend},
+            }},
+            {"layout", {{"nodeIndex", layout_index}, {"bounds", bounds}}},
+        }})},
+    };
+}
+
+auto digest(const std::vector<Node>& nodes) -> PageDigest {
+    auto flat = FlatDomSnapshot::decode(encode(nodes));
+    REQUIRE(flat.has_value());
+    return PageDigest::from_dom(*flat);
+}
+
+/// #document > HTML > BODY > [H1 "Inbox", UL > LI "first", BUTTON "Send"]
+auto base_page() -> std::vector<Node> {
+    return {
+        {1, -1, 9, "#document", "", {}},
+        {2, 0, 1, "HTML", "", {}},
+        {3, 1, 1, "BODY", "", {}},
+        {4, 2, 1, "H1", "", {}},
+        {5, 3, 3, "#text", "Inbox", {}},
+        {6, 2, 1, "UL", "", {}},
+        {7, 5, 1, "LI", "", {}},
+        {8, 6, 3, "#text", "first", {}},
+        {9, 2, 1, "BUTTON", "", {"type", "submit", "class", "btn"}},
+        {10, 8, 3, "#text", "Send", {}},
+    };
+}
+
+} // namespace
+
+TEST_CASE("PageDigest keys content nodes by backendNodeId", "[browser][snapshot_diff]") {
+    auto d = digest(base_page());
+    CHECK(d.size() == 10);
+
+    const auto* button = d.find(9);
+    REQUIRE(button != nullptr);
+    CHECK(button->label == "BUTTON");
+    CHECK(button->attrs == "type=submit");  // class is not semantic
+    CHECK(button->parent == 3);
+    CHECK(d.subtree_text(6) == "first");
+    CHECK(d.subtree_text(3) == "Inbox first Send");
+}
+
+TEST_CASE("Identical digests have an empty diff", "[browser][snapshot_diff]") {
+    auto diff = diff_digests(digest(base_page()), digest(base_page()));
+    CHECK(diff.empty());
+    CHECK(diff.added.empty());
+    CHECK(diff.removed.empty());
+    CHECK(diff.changed.empty());
+}
+
+TEST_CASE("Added subtrees are reported once at their root", "[browser][snapshot_diff]") {
+    auto after = base_page();
+    after.push_back({11, 5, 1, "LI", "", {}});
+    after.push_back({12, 10, 3, "#text", "second  message", {}});
+
+    auto diff = diff_digests(digest(base_page()), digest(after));
+    CHECK(diff.touched == 2);
+    REQUIRE(diff.added.size() == 1);
+    CHECK(diff.added[0]["id"] == 11);
+    CHECK(diff.added[0]["parent"] == 6);
+    CHECK(diff.added[0]["node"] == "LI");
+    CHECK(diff.added[0]["text"] == "second message");
+    CHECK(diff.removed.empty());
+    CHECK(diff.changed.empty());
+}
+
+TEST_CASE("Removed subtrees are reported once at their root", "[browser][snapshot_diff]") {
+    auto after = base_page();
+    after.resize(5);  // drop UL and BUTTON subtrees
+
+    auto diff = diff_digests(digest(base_page()), digest(after));
+    CHECK(diff.touched == 5);
+    REQUIRE(diff.removed.size() == 2);
+    CHECK(diff.removed[0]["id"] == 6);
+    CHECK(diff.removed[0]["text"] == "first");
+    CHECK(diff.removed[1]["id"] == 9);
+    CHECK(diff.added.empty());
+}
+
+TEST_CASE("Text and attribute edits are reported as changes", "[browser][snapshot_diff]") {
+    auto after = base_page();
+    after[4].value = "Inbox (3)";
+    after[8].attrs = {"type", "submit", "disabled", ""};
+
+    auto diff = diff_digests(digest(base_page()), digest(after));
+    CHECK(diff.touched == 2);
+    REQUIRE(diff.changed.size() == 2);
+    CHECK(diff.changed[0]["id"] == 5);
+    CHECK(diff.changed[0]["text"] == "Inbox (3)");
+    CHECK(diff.changed[1]["id"] == 9);
+    CHECK(diff.changed[1]["attrs"] == "type=submit; disabled=");
+
+    SECTION("Non-semantic attribute churn is ignored") {
+        auto styled = base_page();
+        styled[8].attrs = {"type", "submit", "class", "btn btn-active"};
+        CHECK(diff_digests(digest(base_page()), digest(styled)).empty());
+    }
+}
+
+TEST_CASE("Hidden content stays out of the digest", "[browser][snapshot_diff]") {
+    auto after = base_page();
+    after.push_back({11, 2, 1, "DIV", "", {"aria-hidden", "true"}});
+    after.push_back({12, 10, 3, "#text", "secret", {}});
+    after.push_back({13, 2, 1, "SCRIPT", "", {}});
+
+    CHECK(diff_digests(digest(base_page()), digest(after)).empty());
+}
+
+TEST_CASE("PageDigest reads accessibility trees", "[browser][snapshot_diff]") {
+    json tree = {{"nodes", json::array({
+        {{"nodeId", "1"}, {"role", {{"value", "RootWebArea"}}},
+         {"name", {{"value", "Inbox"}}}, {"childIds", {"2", "3"}}},
+        {{"nodeId", "2"}, {"ignored", true}, {"childIds", {"4"}}},
+        {{"nodeId", "3"}, {"role", {{"value", "button"}}},
+         {"name", {{"value", "Send"}}},
+         {"properties", json::array({
+             {{"name", "disabled"}, {"value", {{"value", true}}}},
+             {{"name", "focusable"}, {"value", {{"value", true}}}},
+         })}},
+        {{"nodeId", "4"}, {"role", {{"value", "heading"}}},
+         {"name", {{"value", "Messages"}}}},
+    })}};
+
+    auto d = PageDigest::from_accessibility(tree);
+    REQUIRE(d.size() == 3);
+    CHECK(d.nodes()[0].label == "[RootWebArea]");
+    // The ignored node's child is lifted to the root, before the button
+    CHECK(d.nodes()[1].id == 4);
+    CHECK(d.nodes()[1].parent == 1);
+    CHECK(d.nodes()[1].depth == 1);
+    CHECK(d.find(3)->attrs == "disabled=true");
+    CHECK(d.find(2) == nullptr);
+    CHECK(d.render() ==
+          "[RootWebArea] \"Inbox\"\n"
+          "  [heading] \"Messages\"\n"
+          "  [button] \"Send\" (disabled=true)\n");
+}
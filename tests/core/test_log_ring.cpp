@@ -0,0 +1,130 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "openclaw/core/log_ring.hpp"
+
+using namespace openclaw;
+
+namespace {
+
+auto push_text(LogRing& ring, const std::string& text) -> bool {
+    return ring.push([&](LogRecord& record) {
+        std::memcpy(record.message, text.data(), text.size());
+        record.length = static_cast<uint16_t>(text.size());
+    });
+}
+
+} // anonymous namespace
+
+TEST_CASE("LogRing delivers records in order", "[core][log_ring]") {
+    LogRing ring(16);
+    LogRecord record;
+    CHECK_FALSE(ring.pop(record));
+
+    REQUIRE(push_text(ring, "one"));
+    REQUIRE(push_text(ring, "two"));
+    REQUIRE(ring.pop(record));
+    CHECK(record.text() == "one");
+    REQUIRE(ring.pop(record));
+    CHECK(record.text() == "two");
+    CHECK_FALSE(ring.pop(record));
+}
+
+TEST_CASE("LogRing drops new records when full", "[core][log_ring]") {
+    LogRing ring(16, LogOverflow::Drop);
+    for (int i = 0; i < 16; ++i) {
+        REQUIRE(push_text(ring, std::to_string(i)));
+    }
+    CHECK_FALSE(push_text(ring, "16"));
+    CHECK(ring.dropped() == 1);
+
+    LogRecord record;
+    REQUIRE(ring.pop(record));
+    CHECK(record.text() == "0");
+    CHECK(push_text(ring, "17"));
+}
+
+TEST_CASE("LogRing overwrite mode skips what the sink missed", "[core][log_ring]") {
+    LogRing ring(16, LogOverflow::Overwrite);
+    for (int i = 0; i < 20; ++i) {
+        REQUIRE(push_text(ring, std::to_string(i)));
+    }
+
+    LogRecord record;
+    REQUIRE(ring.pop(record));
+    CHECK(record.text() == "4");
+    CHECK(ring.lost() == 4);
+}
+
+TEST_CASE("LogRing history survives consumption", "[core][log_ring]") {
+    LogRing ring(16);
+    for (int i = 0; i < 5; ++i) {
+        push_text(ring, std::to_string(i));
+    }
+    LogRecord record;
+    while (ring.pop(record)) {}
+
+    std::vector<LogRecord> out;
+    auto next = ring.read(ring.head() - 3, 10, out);
+    REQUIRE(out.size() == 3);
+    CHECK(out.front().text() == "2");
+    CHECK(out.back().text() == "4");
+    CHECK(next == 5);
+
+    push_text(ring, "5");
+    out.clear();
+    CHECK(ring.read(next, 10, out) == 6);
+    REQUIRE(out.size() == 1);
+    CHECK(out[0].text() == "5");
+}
+
+TEST_CASE("LogRing keeps per-producer order across threads", "[core][log_ring]") {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 20000;
+    LogRing ring(256, LogOverflow::Block);
+    ring.set_sink_running(true);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                push_text(ring, std::to_string(p) + ":" + std::to_string(i));
+            }
+        });
+    }
+
+    std::vector<int> next(kProducers, 0);
+    bool in_order = true;
+    int received = 0;
+    LogRecord record;
+    while (received < kProducers * kPerProducer) {
+        if (!ring.pop(record)) {
+            std::this_thread::yield();
+            continue;
+        }
+        auto text = std::string(record.text());
+        auto colon = text.find(':');
+        auto producer = std::stoi(text.substr(0, colon));
+        auto seq = std::stoi(text.substr(colon + 1));
+        in_order = in_order && seq == next[producer];
+        next[producer] = seq + 1;
+        ++received;
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    CHECK(in_order);
+    CHECK(ring.dropped() == 0);
+}
+
+TEST_CASE("log_category uses the module directory", "[core][log_ring]") {
+    CHECK(log_category("/home/u/mylobsterpp/src/browser/browser_pool.cpp") == "browser");
+    CHECK(log_category("include/openclaw/core/logger.hpp") == "core");
+    CHECK(log_category("/srv/src/openclaw/src/gateway/server.cpp") == "gateway");
+    CHECK(log_category("src/main.cpp").empty());
+    CHECK(log_category("test.cpp").empty());
+}
@@ -2,9 +2,11 @@
 
 #include "openclaw/core/secrets.hpp"
 
+#include <chrono>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <thread>
 
 #ifndef _WIN32
 #include <sys/stat.h>
@@ -99,6 +101,12 @@ TEST_CASE("SecretResolver: exec resolution", "[core][secrets]") {
         CHECK(*result == "hello");
     }
 
+    SECTION("arguments are passed without a shell") {
+        auto result = resolver.resolve_exec("echo", {"$HOME; true"});
+        REQUIRE(result.has_value());
+        CHECK(*result == "$HOME; true");
+    }
+
     SECTION("empty command rejected") {
         auto result = resolver.resolve_exec("", {});
         REQUIRE_FALSE(result.has_value());
@@ -106,6 +114,48 @@ TEST_CASE("SecretResolver: exec resolution", "[core][secrets]") {
     }
 }
 
+TEST_CASE("split_command_line splits words without a shell", "[core][secrets]") {
+    using Words = std::vector<std::string>;
+    CHECK(split_command_line("pass show api/key") == Words{"pass", "show", "api/key"});
+    CHECK(split_command_line("  op  read\t'op://vault/item name'  ") ==
+          Words{"op", "read", "op://vault/item name"});
+    CHECK(split_command_line(R"(echo "a \"quoted\" \\ word" it\'s)") ==
+          Words{"echo", R"(a "quoted" \ word)", "it's"});
+    CHECK(split_command_line("echo $HOME;ls *") == Words{"echo", "$HOME;ls", "*"});
+    CHECK(split_command_line("echo ''") == Words{"echo", ""});
+    CHECK(split_command_line("")->empty());
+
+    CHECK_FALSE(split_command_line("echo 'open").has_value());
+    CHECK_FALSE(split_command_line("echo \"open").has_value());
+    CHECK_FALSE(split_command_line("echo \\").has_value());
+}
+
+TEST_CASE("SecretResolver: exec refs carry their own arguments", "[core][secrets]") {
+    SecretsConfig config;
+    SecretResolver resolver(config);
+
+    SECTION("inline arguments") {
+        auto result = resolver.resolve(SecretRef{"exec", "", "echo api 'key value'"});
+        REQUIRE(result.has_value());
+        CHECK(*result == "api key value");
+    }
+
+    SECTION("config args follow the inline ones") {
+        SecretsConfig with_args;
+        with_args.exec = SecretsExecProvider{.command = "", .args = {"tail"}};
+        SecretResolver appended(with_args);
+        auto result = appended.resolve(SecretRef{"exec", "", "echo head"});
+        REQUIRE(result.has_value());
+        CHECK(*result == "head tail");
+    }
+
+    SECTION("unterminated quote") {
+        auto result = resolver.resolve(SecretRef{"exec", "", "echo 'oops"});
+        REQUIRE_FALSE(result.has_value());
+        CHECK(result.error().code() == ErrorCode::InvalidArgument);
+    }
+}
+
 TEST_CASE("SecretResolver: resolve dispatches by source", "[core][secrets]") {
     SecretsConfig config;
     SecretResolver resolver(config);
@@ -123,3 +173,89 @@ TEST_CASE("SecretResolver: resolve dispatches by source", "[core][secrets]") {
         CHECK(result.error().code() == ErrorCode::InvalidArgument);
     }
 }
+
+TEST_CASE("SecretResolver: exec timeout", "[core][secrets]") {
+    SecretsConfig config;
+    config.exec = SecretsExecProvider{.command = "", .args = {}, .timeout_ms = 100};
+    SecretResolver resolver(config);
+
+    auto start = std::chrono::steady_clock::now();
+    auto result = resolver.resolve_exec("sleep", {"5"});
+    REQUIRE_FALSE(result.has_value());
+    CHECK(result.error().code() == ErrorCode::Timeout);
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+
+    // Closing stdout early does not let the command outlive the timeout
+    start = std::chrono::steady_clock::now();
+    result = resolver.resolve_exec("sh", {"-c", "exec >&-; sleep 5"});
+    REQUIRE_FALSE(result.has_value());
+    CHECK(result.error().code() == ErrorCode::Timeout);
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+}
+
+TEST_CASE("SecretResolver: cache", "[core][secrets]") {
+    namespace fs = std::filesystem;
+
+    auto tmp_dir = fs::temp_directory_path() / ("test_secrets_cache_" + std::to_string(::getpid()));
+    fs::create_directories(tmp_dir);
+    auto secret_file = tmp_dir / "token.txt";
+    std::ofstream(secret_file) << "first\n";
+#ifndef _WIN32
+    ::chmod(secret_file.c_str(), 0600);
+#endif
+
+    SECTION("serves cached values until invalidated") {
+        SecretResolver resolver;
+        SecretRef ref{"file", "", secret_file.string()};
+        REQUIRE(resolver.resolve(ref) == "first");
+
+        std::ofstream(secret_file) << "second\n";
+        CHECK(resolver.resolve(ref) == "first");
+        CHECK(resolver.stats().hits == 1);
+
+        resolver.invalidate(ref);
+        CHECK(resolver.resolve(ref) == "second");
+        CHECK(resolver.stats().misses == 2);
+    }
+
+    SECTION("keeps the last good value when a refresh fails") {
+        SecretResolver resolver;
+        SecretRef ref{"file", "", secret_file.string(), 1};
+        REQUIRE(resolver.resolve(ref) == "first");
+
+        fs::remove(secret_file);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        CHECK(resolver.resolve(ref) == "first");
+
+        for (int i = 0; i < 200 && resolver.stats().refresh_failures == 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        auto stats = resolver.stats();
+        CHECK(stats.stale_served >= 1);
+        CHECK(stats.refresh_failures >= 1);
+        CHECK(resolver.resolve(ref) == "first");
+    }
+
+    SECTION("concurrent resolutions share one fetch") {
+        SecretsConfig config;
+        config.exec = SecretsExecProvider{.command = "", .args = {"-c", "sleep 0.2; echo $$"}};
+        SecretResolver resolver(config);
+        SecretRef ref{"exec", "", "sh"};
+
+        Result<std::string> first = std::string{};
+        std::thread other([&] { first = resolver.resolve(ref); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        auto second = resolver.resolve(ref);
+        other.join();
+
+        REQUIRE(first.has_value());
+        REQUIRE(second.has_value());
+        CHECK(*first == *second);
+        auto stats = resolver.stats();
+        CHECK(stats.misses == 1);
+        CHECK(stats.coalesced == 1);
+    }
+
+    std::error_code ec;
+    fs::remove_all(tmp_dir, ec);
+}
@@ -85,6 +85,22 @@ TEST_CASE("Authenticator configured with token auth", "[auth]") {
     CHECK(auth.active_method() == AuthMethod::Token);
 }
 
+TEST_CASE("Authenticator JWT auth fails closed on bad secrets", "[auth]") {
+    openclaw::AuthConfig config;
+    config.method = "jwt";
+    config.jwt_secrets = {"${OPENCLAW_TEST_UNSET_JWT_KEY}"};
+
+    Authenticator auth(config);
+
+    CHECK_FALSE(auth.is_open());
+    CHECK(auth.active_method() == AuthMethod::Jwt);
+    CHECK_FALSE(auth.set_jwt_secrets({""}).has_value());
+    CHECK(auth.set_jwt_secrets({"rotated_secret"}).has_value());
+
+    Authenticator none;
+    CHECK_FALSE(none.set_jwt_secrets({"secret"}).has_value());
+}
+
 TEST_CASE("AuthMethod enum values", "[auth]") {
     CHECK(AuthMethod::None != AuthMethod::Token);
     CHECK(AuthMethod::None != AuthMethod::Tailscale);
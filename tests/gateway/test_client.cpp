@@ -0,0 +1,278 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <exception>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/asio/experimental/awaitable_operators.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/websocket.hpp>
+
+#include "openclaw/gateway/client.hpp"
+
+using namespace openclaw;
+using namespace openclaw::gateway;
+using namespace boost::asio::experimental::awaitable_operators;
+using namespace std::chrono_literals;
+
+namespace {
+
+using PeerStream = websocket::stream<beast::tcp_stream>;
+
+/// A WebSocket server on a loopback port that accepts one client and
+/// hands it to a script, standing in for a GatewayServer.
+struct StubPeer {
+    explicit StubPeer(net::io_context& ioc)
+        : acceptor(ioc, {net::ip::make_address("127.0.0.1"), 0}) {}
+
+    [[nodiscard]] auto port() const -> std::string {
+        return std::to_string(acceptor.local_endpoint().port());
+    }
+
+    template <typename Script>
+    void serve(Script script) {
+        net::co_spawn(acceptor.get_executor(),
+            [this, script]() -> awaitable<void> {
+                PeerStream ws(co_await acceptor.async_accept(net::use_awaitable));
+                co_await ws.async_accept(net::use_awaitable);
+                co_await script(ws);
+            },
+            [](std::exception_ptr e) { if (e) std::rethrow_exception(e); });
+    }
+
+    tcp::acceptor acceptor;
+};
+
+auto read_request(PeerStream& ws) -> awaitable<RequestFrame> {
+    beast::flat_buffer buffer;
+    co_await ws.async_read(buffer, net::use_awaitable);
+    auto frame = parse_frame(beast::buffers_to_string(buffer.data()));
+    co_return std::get<RequestFrame>(*frame);
+}
+
+auto reply(PeerStream& ws, const RequestFrame& request, json result) -> awaitable<void> {
+    ws.text(true);
+    co_await ws.async_write(
+        net::buffer(serialize_frame(make_response(request.id, std::move(result)))),
+        net::use_awaitable);
+}
+
+/// Reads until the client goes away; a close frame is answered by beast.
+auto drain(PeerStream& ws) -> awaitable<void> {
+    beast::flat_buffer buffer;
+    try {
+        for (;;) {
+            co_await ws.async_read(buffer, net::use_awaitable);
+            buffer.consume(buffer.size());
+        }
+    } catch (const boost::system::system_error&) {
+    }
+}
+
+/// Starts `call` on its own and stores its result when it finishes.
+void start(net::io_context& ioc, awaitable<Result<json>> call,
+           std::optional<Result<json>>& out) {
+    net::co_spawn(ioc, std::move(call),
+        [&out](std::exception_ptr e, Result<json> result) {
+            if (e) std::rethrow_exception(e);
+            out = std::move(result);
+        });
+}
+
+template <typename Test>
+void run(net::io_context& ioc, Test test) {
+    net::co_spawn(ioc, std::move(test),
+        [](std::exception_ptr e) { if (e) std::rethrow_exception(e); });
+    ioc.run();
+}
+
+} // anonymous namespace
+
+TEST_CASE("GatewayClient matches pipelined responses by id", "[gateway][client]") {
+    net::io_context ioc;
+    StubPeer peer(ioc);
+    peer.serve([](PeerStream& ws) -> awaitable<void> {
+        std::vector<RequestFrame> requests;
+        for (int i = 0; i < 3; ++i) {
+            requests.push_back(co_await read_request(ws));
+        }
+        for (auto it = requests.rbegin(); it != requests.rend(); ++it) {
+            auto echo = json::object();
+            echo["method"] = it->method;
+            co_await reply(ws, *it, std::move(echo));
+        }
+        co_await ws.async_close(websocket::close_code::normal, net::use_awaitable);
+    });
+
+    GatewayClient client(ioc);
+    std::vector<std::optional<Result<json>>> results(3);
+    run(ioc, [&]() -> awaitable<void> {
+        auto connected = co_await client.connect("127.0.0.1", peer.port());
+        REQUIRE(connected.has_value());
+        for (size_t i = 0; i < results.size(); ++i) {
+            start(ioc, client.call(std::string(1, static_cast<char>('a' + i)), json::object()),
+                  results[i]);
+        }
+    });
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        REQUIRE(results[i].has_value());
+        REQUIRE(results[i]->has_value());
+        CHECK((**results[i])["method"] == std::string(1, static_cast<char>('a' + i)));
+    }
+    CHECK(client.pending_calls() == 0);
+}
+
+TEST_CASE("GatewayClient call times out at its deadline", "[gateway][client]") {
+    net::io_context ioc;
+    StubPeer peer(ioc);
+    peer.serve([](PeerStream& ws) -> awaitable<void> {
+        co_await read_request(ws);  // Never answered
+        co_await drain(ws);
+    });
+
+    GatewayClient client(ioc);
+    std::optional<Result<json>> result;
+    run(ioc, [&]() -> awaitable<void> {
+        auto connected = co_await client.connect("127.0.0.1", peer.port());
+        REQUIRE(connected.has_value());
+        result = co_await client.call("slow", json::object(), 50);
+        CHECK(client.pending_calls() == 0);
+        co_await client.disconnect();
+    });
+
+    REQUIRE(result.has_value());
+    REQUIRE_FALSE(result->has_value());
+    CHECK(result->error().code() == ErrorCode::Timeout);
+}
+
+TEST_CASE("GatewayClient drops the late response of a cancelled call", "[gateway][client]") {
+    net::io_context ioc;
+    StubPeer peer(ioc);
+    peer.serve([&ioc](PeerStream& ws) -> awaitable<void> {
+        auto slow = co_await read_request(ws);
+        net::steady_timer delay(ioc, 100ms);
+        co_await delay.async_wait(net::use_awaitable);
+        auto late = json::object();
+        late["late"] = true;
+        co_await reply(ws, slow, late);
+        auto next = co_await read_request(ws);
+        late["late"] = false;
+        co_await reply(ws, next, late);
+        co_await drain(ws);
+    });
+
+    GatewayClient client(ioc);
+    std::optional<Result<json>> next;
+    size_t winner = 0;
+    run(ioc, [&]() -> awaitable<void> {
+        auto connected = co_await client.connect("127.0.0.1", peer.port());
+        REQUIRE(connected.has_value());
+        net::steady_timer cancel(ioc, 20ms);
+        auto raced = co_await (
+            client.call("slow", json::object()) ||
+            cancel.async_wait(net::use_awaitable));
+        winner = raced.index();
+        CHECK(client.pending_calls() == 0);
+        next = co_await client.call("next", json::object());
+        co_await client.disconnect();
+    });
+
+    CHECK(winner == 1);
+    REQUIRE(next.has_value());
+    REQUIRE(next->has_value());
+    CHECK((**next)["late"] == false);
+}
+
+TEST_CASE("GatewayClient fails queued calls when a write fails", "[gateway][client]") {
+    net::io_context ioc;
+    StubPeer peer(ioc);
+    peer.serve([&ioc](PeerStream& ws) -> awaitable<void> {
+        // Read nothing so the client's first write stalls, then reset
+        net::steady_timer delay(ioc, 100ms);
+        co_await delay.async_wait(net::use_awaitable);
+        auto& socket = beast::get_lowest_layer(ws).socket();
+        socket.set_option(tcp::socket::linger(true, 0));
+        socket.close();
+    });
+
+    GatewayClient client(ioc);
+    std::vector<std::optional<Result<json>>> results(3);
+    // Larger than the loopback socket buffers on both ends
+    json big = {{"blob", std::string(32 * 1024 * 1024, 'x')}};
+    run(ioc, [&]() -> awaitable<void> {
+        auto connected = co_await client.connect("127.0.0.1", peer.port());
+        REQUIRE(connected.has_value());
+        start(ioc, client.call("a", std::move(big), 5000), results[0]);
+        start(ioc, client.call("b", json::object(), 5000), results[1]);
+        start(ioc, client.call("c", json::object(), 5000), results[2]);
+    });
+
+    for (const auto& result : results) {
+        REQUIRE(result.has_value());
+        REQUIRE_FALSE(result->has_value());
+        CHECK(result->error().code() != ErrorCode::Timeout);
+    }
+    CHECK(client.pending_calls() == 0);
+    CHECK_FALSE(client.is_connected());
+}
+
+TEST_CASE("GatewayClient fails pending calls when the server closes", "[gateway][client]") {
+    net::io_context ioc;
+    StubPeer peer(ioc);
+    peer.serve([](PeerStream& ws) -> awaitable<void> {
+        co_await read_request(ws);
+        co_await ws.async_close(websocket::close_code::going_away, net::use_awaitable);
+    });
+
+    GatewayClient client(ioc);
+    std::optional<Result<json>> result;
+    run(ioc, [&]() -> awaitable<void> {
+        auto connected = co_await client.connect("127.0.0.1", peer.port());
+        REQUIRE(connected.has_value());
+        result = co_await client.call("pending", json::object(), 5000);
+        CHECK(client.pending_calls() == 0);
+    });
+
+    REQUIRE(result.has_value());
+    REQUIRE_FALSE(result->has_value());
+    CHECK(result->error().code() == ErrorCode::ConnectionClosed);
+    CHECK_FALSE(client.is_connected());
+}
+
+TEST_CASE("GatewayClient disconnect closes after queued writes", "[gateway][client]") {
+    net::io_context ioc;
+    StubPeer peer(ioc);
+    std::string received;
+    bool saw_close = false;
+    peer.serve([&](PeerStream& ws) -> awaitable<void> {
+        received = (co_await read_request(ws)).method;
+        beast::flat_buffer buffer;
+        try {
+            co_await ws.async_read(buffer, net::use_awaitable);
+        } catch (const boost::system::system_error& e) {
+            saw_close = e.code() == websocket::error::closed;
+        }
+    });
+
+    GatewayClient client(ioc);
+    std::optional<Result<json>> result;
+    run(ioc, [&]() -> awaitable<void> {
+        auto connected = co_await client.connect("127.0.0.1", peer.port());
+        REQUIRE(connected.has_value());
+        start(ioc, client.call("pending", json::object(), 5000), result);
+        co_await net::post(ioc, net::use_awaitable);  // Let the call queue its write
+        co_await client.disconnect();
+    });
+
+    CHECK(received == "pending");
+    CHECK(saw_close);
+    REQUIRE(result.has_value());
+    REQUIRE_FALSE(result->has_value());
+    CHECK(result->error().code() == ErrorCode::ConnectionClosed);
+    CHECK(client.pending_calls() == 0);
+    CHECK_FALSE(client.is_connected());
+}
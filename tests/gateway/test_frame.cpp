@@ -326,3 +326,28 @@ TEST_CASE("serialize_frame round-trips", "[frame]") {
         CHECK(restored.data["n"] == 42);
     }
 }
+
+TEST_CASE("Binary payloads are detached from responses", "[frame]") {
+    json payload = {
+        {"ok", true},
+        {"data", json::binary({0x89, 'P', 'N', 'G'})},
+        {"pages", json::array({json::binary({1, 2}), "text"})},
+    };
+
+    auto detached = detach_binary(payload);
+    REQUIRE(detached.size() == 2);
+    CHECK(detached[0].size() == 4);
+    CHECK(payload["data"]["$binary"]["index"] == 0);
+    CHECK(payload["data"]["$binary"]["size"] == 4);
+    CHECK(payload["pages"][0]["$binary"]["index"] == 1);
+    CHECK(payload["pages"][1] == "text");
+    CHECK(detach_binary(payload).empty());
+
+    auto frame = make_binary_frame("req-9", 1, detached[1]);
+    auto newline = frame.find('\n');
+    REQUIRE(newline != std::string::npos);
+    auto header = json::parse(frame.substr(0, newline));
+    CHECK(header["id"] == "req-9");
+    CHECK(header["index"] == 1);
+    CHECK(frame.substr(newline + 1) == std::string("\x01\x02", 2));
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <string>
+
+#include "openclaw/gateway/log_tail.hpp"
+
+using namespace openclaw;
+using namespace openclaw::gateway;
+
+namespace {
+
+auto make_record(spdlog::level::level_enum level, const char* category, std::string text)
+    -> LogRecord {
+    LogRecord record;
+    record.level = static_cast<uint8_t>(level);
+    std::strncpy(record.category, category, sizeof(record.category) - 1);
+    std::memcpy(record.message, text.data(), text.size());
+    record.length = static_cast<uint16_t>(text.size());
+    return record;
+}
+
+} // anonymous namespace
+
+TEST_CASE("LogFilter matches level, category and text", "[gateway][log_tail]") {
+    auto filter = LogFilter::parse(json{
+        {"level", "warn"},
+        {"category", json::array({"browser", "gateway"})},
+        {"session", "s-42"},
+        {"pattern", "time*out"},
+    });
+    REQUIRE(filter);
+
+    CHECK(filter->matches(make_record(spdlog::level::warn, "browser",
+                                      "session s-42 timed out")));
+    CHECK(filter->matches(make_record(spdlog::level::err, "gateway",
+                                      "s-42: timeout")));
+    CHECK_FALSE(filter->matches(make_record(spdlog::level::info, "browser",
+                                            "session s-42 timed out")));
+    CHECK_FALSE(filter->matches(make_record(spdlog::level::warn, "agent",
+                                            "session s-42 timed out")));
+    CHECK_FALSE(filter->matches(make_record(spdlog::level::warn, "browser",
+                                            "session s-7 timed out")));
+    CHECK_FALSE(filter->matches(make_record(spdlog::level::warn, "browser",
+                                            "session s-42 closed")));
+}
+
+TEST_CASE("LogFilter defaults to everything", "[gateway][log_tail]") {
+    auto filter = LogFilter::parse(json::object());
+    REQUIRE(filter);
+    CHECK(filter->sample_every == 1);
+    CHECK(filter->matches(make_record(spdlog::level::trace, "", "anything")));
+}
+
+TEST_CASE("LogFilter patterns are globs searched in the message", "[gateway][log_tail]") {
+    auto matches = [](const char* pattern, const std::string& message) {
+        auto filter = LogFilter::parse(json{{"pattern", pattern}});
+        return filter && filter->matches(make_record(spdlog::level::info, "", message));
+    };
+    CHECK(matches("conn?ction", "lost connection to peer"));
+    CHECK(matches("lost*peer", "lost connection to peer"));
+    CHECK(matches("*", ""));
+    CHECK(matches("a*b*c", "xxaxxbxxbxxc"));
+    CHECK_FALSE(matches("a*b*c", "xxcxxbxxa"));
+    CHECK_FALSE(matches("peer?", "lost connection to peer"));
+
+    // Patterns that make backtracking matchers explode stay cheap
+    std::string many_stars;
+    for (int i = 0; i < 60; ++i) {
+        many_stars += "a*";
+    }
+    many_stars += "b";
+    CHECK_FALSE(matches(many_stars.c_str(), std::string(900, 'a')));
+}
+
+TEST_CASE("LogFilter rejects bad parameters", "[gateway][log_tail]") {
+    CHECK_FALSE(LogFilter::parse(json{{"level", "loud"}}));
+    CHECK_FALSE(LogFilter::parse(json{{"regex", "a+"}}));
+    CHECK_FALSE(LogFilter::parse(json{{"pattern", 3}}));
+    CHECK_FALSE(LogFilter::parse(json{{"pattern", std::string(257, 'a')}}));
+    CHECK_FALSE(LogFilter::parse(json{{"sample", 0}}));
+    CHECK_FALSE(LogFilter::parse(json{{"sample", 1.5}}));
+    CHECK_FALSE(LogFilter::parse(json{{"category", 3}}));
+    CHECK_FALSE(LogFilter::parse(json{{"contains", ""}}));
+
+    auto sampled = LogFilter::parse(json{{"sample", 0.25}});
+    REQUIRE(sampled);
+    CHECK(sampled->sample_every == 4);
+}
@@ -0,0 +1,186 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <exception>
+#include <optional>
+#include <string>
+
+#include <boost/asio.hpp>
+
+#include "openclaw/gateway/outbox.hpp"
+
+using namespace openclaw;
+using namespace openclaw::gateway;
+using namespace std::chrono_literals;
+
+namespace {
+
+auto delta(std::string run_id, std::string text, std::string stream = "text") -> EventFrame {
+    auto data = json::object();
+    data["runId"] = std::move(run_id);
+    data["stream"] = std::move(stream);
+    data["text"] = std::move(text);
+    return EventFrame{.event = "chat.delta", .data = std::move(data)};
+}
+
+auto final_item(const std::string& run_id) -> Outbox::Item {
+    auto data = json::object();
+    data["runId"] = run_id;
+    auto text = serialize_frame(Frame{EventFrame{.event = "chat.final", .data = data}});
+    auto bytes = text.size();
+    return Outbox::Item{.data = std::move(text), .bytes = bytes, .run_id = run_id};
+}
+
+/// Starts push_delta() on its own; `out` is set once it returns.
+void start(boost::asio::io_context& ioc, Outbox& outbox, EventFrame event,
+           std::optional<bool>& out) {
+    boost::asio::co_spawn(ioc, outbox.push_delta(std::move(event)),
+        [&out](std::exception_ptr e, bool queued) {
+            if (e) std::rethrow_exception(e);
+            out = queued;
+        });
+}
+
+auto push(boost::asio::io_context& ioc, Outbox& outbox, EventFrame event) -> bool {
+    std::optional<bool> queued;
+    start(ioc, outbox, std::move(event), queued);
+    ioc.restart();
+    ioc.run();
+    return queued.value();
+}
+
+/// Writes the next frame the way Connection's writer does.
+auto write_one(Outbox& outbox) -> Outbox::Item {
+    auto item = outbox.pop();
+    outbox.done(item);
+    return item;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Outbox coalesces a run's deltas into its queued delta", "[gateway][outbox]") {
+    boost::asio::io_context ioc;
+    Outbox outbox(ioc.get_executor());
+
+    CHECK(push(ioc, outbox, delta("r1", "Hel")));
+    CHECK(push(ioc, outbox, delta("r1", "lo")));
+    CHECK(push(ioc, outbox, delta("r2", "other")));
+    CHECK(push(ioc, outbox, delta("r1", " world")));
+    CHECK(push(ioc, outbox, delta("r1", "hmm", "thinking")));  // Another stream
+    outbox.push(final_item("r2"));
+    CHECK(push(ioc, outbox, delta("r2", " run")));  // Not past r2's final
+
+    auto stats = outbox.stats();
+    CHECK(stats["queued_frames"] == 5);
+    CHECK(stats["coalesced"] == 2);
+    CHECK(stats["dropped"] == 0);
+
+    auto first = write_one(outbox);
+    REQUIRE(first.delta.has_value());
+    CHECK(first.delta->data["text"] == "Hello world");
+    CHECK(write_one(outbox).delta->data["text"] == "other");
+    CHECK(write_one(outbox).delta->data["text"] == "hmm");
+    CHECK_FALSE(write_one(outbox).delta.has_value());
+    CHECK(write_one(outbox).delta->data["text"] == " run");
+    CHECK(outbox.empty());
+    CHECK(outbox.bytes() == 0);
+}
+
+TEST_CASE("Outbox drops deltas over the limit but not other frames", "[gateway][outbox]") {
+    boost::asio::io_context ioc;
+    Outbox outbox(ioc.get_executor());
+    outbox.set_policy(StreamPolicy::Drop, 300);
+
+    CHECK(push(ioc, outbox, delta("r1", "a")));
+    CHECK(push(ioc, outbox, delta("r1", "b")));  // Drop never merges
+    CHECK(push(ioc, outbox, delta("r1", "c")));  // Queue is at the limit now
+    CHECK_FALSE(push(ioc, outbox, delta("r1", "d")));
+    outbox.push(Outbox::Item{.data = "tool", .bytes = 4, .run_id = "r1"});
+    outbox.push(final_item("r1"));
+
+    auto stats = outbox.stats();
+    CHECK(stats["policy"] == "drop");
+    CHECK(stats["queued_frames"] == 5);
+    CHECK(stats["dropped"] == 1);
+    CHECK(stats["coalesced"] == 0);
+    CHECK(outbox.bytes() > 300);
+
+    // Room again once the writer drains
+    while (!outbox.empty()) write_one(outbox);
+    CHECK(push(ioc, outbox, delta("r1", "e")));
+    CHECK(outbox.stats()["peak_bytes"].get<size_t>() > 300);
+}
+
+TEST_CASE("Outbox drops coalesced deltas once full", "[gateway][outbox]") {
+    boost::asio::io_context ioc;
+    Outbox outbox(ioc.get_executor());
+    outbox.set_policy(StreamPolicy::Coalesce, 200);
+
+    CHECK(push(ioc, outbox, delta("r1", "a")));
+    CHECK(push(ioc, outbox, delta("r1", std::string(100, 'b'))));
+    CHECK_FALSE(push(ioc, outbox, delta("r1", "c")));
+    CHECK(outbox.stats()["coalesced"] == 1);
+    CHECK(outbox.stats()["dropped"] == 1);
+}
+
+TEST_CASE("Outbox pauses a run until the writer drains", "[gateway][outbox]") {
+    boost::asio::io_context ioc;
+    Outbox outbox(ioc.get_executor());
+    outbox.set_policy(StreamPolicy::Pause, 256);
+    outbox.push(Outbox::Item{.data = std::string(300, 'x'), .bytes = 300});
+
+    std::optional<bool> queued;
+    start(ioc, outbox, delta("r1", "held"), queued);
+    ioc.poll();
+    CHECK_FALSE(queued.has_value());
+    CHECK(outbox.stats()["paused_runs"] == 1);
+    CHECK(outbox.stats()["pauses"] == 1);
+
+    // Still over the limit while the frame is being written
+    auto item = outbox.pop();
+    ioc.poll();
+    CHECK_FALSE(queued.has_value());
+
+    outbox.done(item);
+    ioc.poll();
+    REQUIRE(queued.has_value());
+    CHECK(*queued);
+    CHECK(outbox.stats()["paused_runs"] == 0);
+    CHECK(outbox.stats()["dropped"] == 0);
+    CHECK(write_one(outbox).delta->data["text"] == "held");
+}
+
+TEST_CASE("Outbox drops a paused delta at the pause limit", "[gateway][outbox]") {
+    boost::asio::io_context ioc;
+    Outbox outbox(ioc.get_executor());
+    outbox.set_policy(StreamPolicy::Pause, 256, 100ms);
+    outbox.push(Outbox::Item{.data = std::string(300, 'x'), .bytes = 300});
+
+    auto started = std::chrono::steady_clock::now();
+    CHECK_FALSE(push(ioc, outbox, delta("r1", "late")));
+    CHECK(std::chrono::steady_clock::now() - started >= 100ms);
+
+    auto stats = outbox.stats();
+    CHECK(stats["pauses"] == 1);
+    CHECK(stats["dropped"] == 1);
+    CHECK(stats["paused_runs"] == 0);
+    CHECK(stats["queued_frames"] == 1);
+}
+
+TEST_CASE("Outbox close releases paused runs", "[gateway][outbox]") {
+    boost::asio::io_context ioc;
+    Outbox outbox(ioc.get_executor());
+    outbox.set_policy(StreamPolicy::Pause, 256);
+    outbox.push(Outbox::Item{.data = std::string(300, 'x'), .bytes = 300});
+
+    std::optional<bool> queued;
+    start(ioc, outbox, delta("r1", "held"), queued);
+    ioc.poll();
+    CHECK_FALSE(queued.has_value());
+
+    outbox.close();
+    ioc.poll();
+    REQUIRE(queued.has_value());
+    CHECK_FALSE(*queued);
+    CHECK_FALSE(push(ioc, outbox, delta("r1", "after")));
+}
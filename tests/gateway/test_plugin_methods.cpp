@@ -0,0 +1,81 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include "openclaw/gateway/plugin_handler.hpp"
+
+using namespace openclaw;
+using namespace openclaw::gateway;
+
+namespace {
+
+auto builtin(json) -> boost::asio::awaitable<json> {
+    co_return json{{"from", "builtin"}};
+}
+
+auto from_plugin(json) -> boost::asio::awaitable<json> {
+    co_return json{{"from", "plugin"}};
+}
+
+// A plugin instance without a library, declaring `names`
+auto make_plugin(std::initializer_list<const char*> names)
+    -> std::shared_ptr<plugins::LoadedPlugin> {
+    auto loaded = std::make_shared<plugins::LoadedPlugin>();
+    loaded->name = "demo";
+    for (const auto* name : names) {
+        loaded->methods.push_back({.name = name, .description = "", .handler = from_plugin});
+    }
+    return loaded;
+}
+
+auto group_of(const Protocol& protocol, const std::string& name) -> std::optional<std::string> {
+    for (const auto& info : protocol.methods()) {
+        if (info.name == name) {
+            return info.group;
+        }
+    }
+    return std::nullopt;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Plugin methods never displace built-ins across reloads", "[gateway][plugin]") {
+    Protocol protocol;
+    protocol.register_method("config.get", builtin, "Built-in", "config");
+
+    auto first = make_plugin({"config.get", "demo.ping"});
+    swap_plugin_methods(protocol, nullptr, first);
+    CHECK(first->published_methods == std::vector<std::string>{"demo.ping"});
+    CHECK(group_of(protocol, "config.get") == "config");
+    CHECK(group_of(protocol, "demo.ping") == "plugin");
+
+    // Reload: the refused name is not the plugin's to take over
+    auto second = make_plugin({"config.get", "demo.ping"});
+    swap_plugin_methods(protocol, first, second);
+    CHECK(second->published_methods == std::vector<std::string>{"demo.ping"});
+    CHECK(group_of(protocol, "config.get") == "config");
+    CHECK(group_of(protocol, "demo.ping") == "plugin");
+
+    // Unload: only what the plugin published goes
+    swap_plugin_methods(protocol, second, nullptr);
+    CHECK(group_of(protocol, "config.get") == "config");
+    CHECK_FALSE(protocol.has_method("demo.ping"));
+}
+
+TEST_CASE("A reloaded plugin keeps and drops its own methods", "[gateway][plugin]") {
+    Protocol protocol;
+
+    auto first = make_plugin({"demo.ping", "demo.old"});
+    swap_plugin_methods(protocol, nullptr, first);
+
+    auto second = make_plugin({"demo.ping", "demo.new"});
+    swap_plugin_methods(protocol, first, second);
+    CHECK(protocol.has_method("demo.ping"));
+    CHECK(protocol.has_method("demo.new"));
+    CHECK_FALSE(protocol.has_method("demo.old"));
+}
@@ -1,5 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+
 #include "openclaw/gateway/protocol.hpp"
 
 TEST_CASE("Protocol registers and looks up methods", "[protocol]") {
@@ -113,3 +116,45 @@ TEST_CASE("Protocol method info preserves metadata", "[protocol]") {
     CHECK(all[0].description == "Send a chat message");
     CHECK(all[0].group == "chat");
 }
+
+TEST_CASE("Protocol replace_methods swaps a method set", "[protocol]") {
+    openclaw::gateway::Protocol proto;
+    auto handler = [](openclaw::gateway::json) -> boost::asio::awaitable<openclaw::gateway::json> {
+        co_return openclaw::gateway::json{};
+    };
+
+    proto.register_method("core.method", handler, "Core", "core");
+    proto.register_method("ext.old", handler, "Old", "plugin");
+
+    std::vector<std::pair<openclaw::gateway::MethodInfo, openclaw::gateway::MethodHandler>> add;
+    add.emplace_back(openclaw::gateway::MethodInfo{"ext.new", "New", "plugin"}, handler);
+    proto.replace_methods({"ext.old"}, std::move(add));
+
+    CHECK(proto.has_method("core.method"));
+    CHECK(proto.has_method("ext.new"));
+    CHECK_FALSE(proto.has_method("ext.old"));
+
+    auto plugin_methods = proto.methods_in_group("plugin");
+    REQUIRE(plugin_methods.size() == 1);
+    CHECK(plugin_methods[0].description == "New");
+}
+
+TEST_CASE("Protocol dispatch passes the request context", "[protocol]") {
+    openclaw::gateway::Protocol proto;
+    proto.register_method("test.whoami",
+        [](openclaw::gateway::json, openclaw::gateway::RequestContext context)
+            -> boost::asio::awaitable<openclaw::gateway::json> {
+            co_return openclaw::gateway::json(context.connection_id);
+        });
+
+    boost::asio::io_context ioc;
+    std::string caller;
+    boost::asio::co_spawn(ioc,
+        proto.dispatch({"1", "test.whoami", {}}, {"conn-7"}),
+        [&](std::exception_ptr, openclaw::Result<openclaw::gateway::json> result) {
+            REQUIRE(result);
+            caller = result->get<std::string>();
+        });
+    ioc.run();
+    CHECK(caller == "conn-7");
+}
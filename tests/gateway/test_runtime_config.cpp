@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "openclaw/gateway/config_handler.hpp"
+
+using namespace openclaw;
+using namespace openclaw::gateway;
+
+namespace {
+
+struct TempDir {
+    TempDir() : path(std::filesystem::temp_directory_path() /
+                     ("runtime-config-" + std::to_string(::getpid()))) {
+        std::filesystem::create_directories(path);
+    }
+    ~TempDir() { std::filesystem::remove_all(path); }
+    std::filesystem::path path;
+};
+
+auto read_file(const std::filesystem::path& path) -> json {
+    std::ifstream in(path);
+    return json::parse(in);
+}
+
+} // anonymous namespace
+
+TEST_CASE("RuntimeConfig publishes immutable versions", "[gateway][runtime_config]") {
+    RuntimeConfig config(Config{});
+    auto before = config.snapshot();
+    auto port = config.get("gateway.port");
+    REQUIRE(port);
+
+    config.set("gateway.port", 9000);
+    auto after = config.snapshot();
+
+    CHECK(after->version == before->version + 1);
+    CHECK(after->hash != before->hash);
+    CHECK(config.hash() == after->hash);
+    CHECK(*port == 18789);  // Still reads the version it was taken from
+    CHECK(*config.get("gateway.port") == 9000);
+    CHECK_FALSE(config.get("gateway.missing"));
+}
+
+TEST_CASE("RuntimeConfig notifies change handlers", "[gateway][runtime_config]") {
+    RuntimeConfig config(Config{});
+    std::vector<json> seen;
+    config.on_change([&](const ConfigSnapshot& snapshot) {
+        seen.push_back(*snapshot.find("gateway.port"));
+    });
+
+    config.set("gateway.port", 9000);
+    config.set("gateway.port", 9001);
+
+    REQUIRE(seen.size() == 2);
+    CHECK(seen[0] == 9000);
+    CHECK(seen[1] == 9001);
+}
+
+TEST_CASE("RuntimeConfig patch checks the base hash", "[gateway][runtime_config]") {
+    RuntimeConfig config(Config{});
+    auto base = config.hash();
+
+    CHECK(config.patch({{"log_level", "debug"}, {"cron.enabled", true}}, base));
+    auto version = config.snapshot()->version;
+    CHECK_FALSE(config.patch({{"log_level", "warn"}}, base));
+    CHECK(config.snapshot()->version == version);
+    CHECK(*config.get("log_level") == "debug");
+}
+
+TEST_CASE("RuntimeConfig coalesces writes into one atomic file write", "[gateway][runtime_config]") {
+    TempDir dir;
+    auto path = dir.path / "config.json";
+    RuntimeConfig config(Config{});
+    config.set_persist_path(path, std::chrono::milliseconds(50));
+
+    for (int port = 9000; port < 9010; ++port) {
+        config.set("gateway.port", port);
+    }
+    config.flush();
+
+    CHECK(read_file(path)["gateway"]["port"] == 9009);
+    CHECK_FALSE(std::filesystem::exists(dir.path / "config.json.tmp"));
+}
+
+TEST_CASE("RuntimeConfig reload adopts external edits only", "[gateway][runtime_config]") {
+    TempDir dir;
+    auto path = dir.path / "config.json";
+    RuntimeConfig config(Config{});
+    config.set_persist_path(path, std::chrono::milliseconds(0));
+
+    config.set("log_level", "warn");
+    config.flush();
+    auto own = config.reload(path);
+    REQUIRE(own);
+    CHECK_FALSE(*own);
+
+    auto edited = read_file(path);
+    edited["log_level"] = "error";
+    std::ofstream(path) << edited.dump();
+    auto external = config.reload(path);
+    REQUIRE(external);
+    CHECK(*external);
+    CHECK(*config.get("log_level") == "error");
+
+    std::ofstream(path) << "{ not json";
+    CHECK_FALSE(config.reload(path));
+    CHECK(*config.get("log_level") == "error");
+}
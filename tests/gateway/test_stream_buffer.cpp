@@ -0,0 +1,145 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include <boost/asio.hpp>
+
+#include "openclaw/gateway/stream_buffer.hpp"
+
+using namespace openclaw;
+using namespace openclaw::gateway;
+using namespace std::chrono_literals;
+
+namespace {
+
+auto text_chunk(std::string text) -> providers::CompletionChunk {
+    return providers::CompletionChunk{.type = "text", .text = std::move(text)};
+}
+
+/// Pushes `text` in chunks of `size`, then clears `generating`.
+auto generate(providers::StreamCallback on_chunk, const std::string& text, size_t size,
+              std::atomic<bool>& generating)
+    -> boost::asio::awaitable<Result<providers::CompletionResponse>> {
+    for (size_t i = 0; i < text.size(); i += size) {
+        on_chunk(text_chunk(text.substr(i, size)));
+    }
+    generating = false;
+    co_return providers::CompletionResponse{.model = "stub"};
+}
+
+} // anonymous namespace
+
+TEST_CASE("Stream policies parse by name", "[gateway][stream]") {
+    CHECK(parse_stream_policy("pause") == StreamPolicy::Pause);
+    CHECK(parse_stream_policy("coalesce") == StreamPolicy::Coalesce);
+    CHECK(parse_stream_policy("drop") == StreamPolicy::Drop);
+    CHECK_FALSE(parse_stream_policy("buffer").has_value());
+    CHECK(stream_policy_name(StreamPolicy::Drop) == "drop");
+}
+
+TEST_CASE("RunStreamBuffer merges deltas the consumer has not taken", "[gateway][stream]") {
+    RunStreamBuffer buffer(64 * 1024);
+    CHECK(buffer.push(text_chunk("Hel")));
+    CHECK(buffer.push(text_chunk("lo")));
+    CHECK(buffer.push(providers::CompletionChunk{.type = "tool_use", .tool_name = "search"}));
+    CHECK(buffer.push(text_chunk(" world")));
+
+    auto batch = buffer.take();
+    REQUIRE(batch.size() == 3);
+    CHECK(batch[0].text == "Hello");
+    CHECK(batch[1].type == "tool_use");
+    CHECK(batch[2].text == " world");
+    CHECK(buffer.bytes() == 0);
+
+    // Taken chunks are not merged into
+    CHECK(buffer.push(text_chunk("!")));
+    REQUIRE(buffer.take().size() == 1);
+}
+
+TEST_CASE("RunStreamBuffer holds the producer while full", "[gateway][stream]") {
+    RunStreamBuffer buffer(100);
+    REQUIRE(buffer.push(text_chunk(std::string(100, 'a'))));
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&] {
+        buffer.push(text_chunk("b"));
+        pushed = true;
+    });
+
+    std::this_thread::sleep_for(50ms);
+    CHECK_FALSE(pushed);
+    CHECK(run_buffer_metrics().paused_producers.load() >= 1);
+
+    auto first = buffer.take();
+    producer.join();
+    CHECK(pushed);
+    REQUIRE(first.size() == 1);
+    REQUIRE(buffer.take().front().text == "b");
+}
+
+TEST_CASE("RunStreamBuffer drops after close or the pause limit", "[gateway][stream]") {
+    RunStreamBuffer buffer(10, 20ms);
+    REQUIRE(buffer.push(text_chunk(std::string(10, 'a'))));
+    CHECK_FALSE(buffer.push(providers::CompletionChunk{.type = "tool_use"}));  // Times out
+
+    bool late = true;
+    std::thread producer([&] { late = buffer.push(text_chunk("late")); });
+    buffer.close();
+    producer.join();
+    CHECK_FALSE(late);
+
+    CHECK(buffer.closed());
+    CHECK(buffer.take().front().text == std::string(10, 'a'));
+}
+
+TEST_CASE("stream_run delivers chunks while the run is generating", "[gateway][stream]") {
+    boost::asio::io_context ioc;
+    boost::asio::thread_pool provider_thread(1);
+    constexpr size_t kCapacity = 4 * 1024;
+    constexpr int kChunks = 200;  // 50 KiB in all
+    std::atomic<bool> generating{true};
+    std::string expected;
+    for (int i = 0; i < kChunks; ++i) {
+        expected += std::string(256, static_cast<char>('a' + i % 26));
+    }
+
+    // Like a provider, the chunks arrive from a thread of their own
+    auto produce = [&](providers::StreamCallback on_chunk) {
+        return boost::asio::co_spawn(provider_thread,
+            generate(std::move(on_chunk), expected, 256, generating),
+            boost::asio::use_awaitable);
+    };
+
+    std::string delivered;
+    int delivered_while_generating = 0;
+    auto sink = [&](const providers::CompletionChunk& chunk) -> boost::asio::awaitable<void> {
+        if (generating) {
+            ++delivered_while_generating;
+        }
+        delivered += chunk.text;
+        co_return;
+    };
+
+    auto dropped = run_buffer_metrics().dropped.load();
+    auto started = std::chrono::steady_clock::now();
+    std::optional<Result<providers::CompletionResponse>> result;
+    boost::asio::co_spawn(ioc, stream_run(kCapacity, produce, sink, 200ms),
+        [&](std::exception_ptr e, Result<providers::CompletionResponse> r) {
+            if (e) std::rethrow_exception(e);
+            result = std::move(r);
+        });
+    ioc.run();
+
+    REQUIRE(result.has_value());
+    REQUIRE(result->has_value());
+    CHECK((*result)->model == "stub");
+    CHECK(delivered == expected);  // Nothing dropped at the pause limit
+    CHECK(delivered_while_generating > 0);
+    CHECK(run_buffer_metrics().dropped.load() == dropped);
+    CHECK(std::chrono::steady_clock::now() - started < 2s);
+}
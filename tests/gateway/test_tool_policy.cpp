@@ -87,3 +87,42 @@ TEST_CASE("ToolPolicy allow/deny overrides", "[gateway][tool_policy]") {
         CHECK_FALSE(policy.is_allowed("shell", "user"));
     }
 }
+
+TEST_CASE("ToolPolicy decision table tracks changes", "[gateway][tool_policy]") {
+    ToolPolicy policy;
+    policy.set_owner("owner");
+
+    SECTION("Unknown tools are denied") {
+        CHECK_FALSE(policy.tool_id("no_such_tool").has_value());
+        CHECK_FALSE(policy.is_allowed("no_such_tool", "owner"));
+    }
+
+    SECTION("Ids stay valid across reconfiguration") {
+        auto id = policy.tool_id("shell");
+        REQUIRE(id.has_value());
+        CHECK(policy.is_allowed(*id, "user"));
+
+        policy.set_profile(ToolProfile::Minimal);
+        CHECK(policy.tool_id("shell") == id);
+        CHECK_FALSE(policy.is_allowed(*id, "user"));
+
+        policy.configure(json{{"tools.allow", {"shell"}}});
+        CHECK(policy.is_allowed(*id, "user"));
+
+        policy.deny("shell");
+        CHECK_FALSE(policy.is_allowed(*id, "user"));
+    }
+
+    SECTION("Owner-only decisions depend on the caller") {
+        auto id = policy.tool_id("whatsapp_login");
+        REQUIRE(id.has_value());
+        CHECK(policy.is_allowed(*id, "owner"));
+        CHECK_FALSE(policy.is_allowed(*id, "user"));
+    }
+
+    SECTION("Newly allowed custom tools get an id") {
+        policy.allow("custom_tool");
+        CHECK(policy.tool_id("custom_tool").has_value());
+        CHECK(policy.is_allowed("custom_tool", "user"));
+    }
+}
@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "openclaw/infra/html_sanitizer.hpp"
+
+#include <string>
+
+using namespace openclaw::infra;
+
+namespace {
+
+auto to_text(std::string_view html, size_t max_bytes = 0) -> std::string {
+    return HtmlSanitizer::sanitize(html, {.output = HtmlSanitizer::Output::Text,
+                                          .max_bytes = max_bytes});
+}
+
+auto to_html(std::string_view html) -> std::string {
+    return HtmlSanitizer::sanitize(html, {.output = HtmlSanitizer::Output::Html});
+}
+
+/// Feeds `html` one byte at a time.
+auto to_text_bytewise(std::string_view html) -> std::string {
+    HtmlSanitizer sanitizer;
+    for (char c : html) {
+        sanitizer.feed(std::string_view(&c, 1));
+    }
+    return sanitizer.finish();
+}
+
+} // anonymous namespace
+
+TEST_CASE("HtmlSanitizer extracts readable text", "[infra][sanitizer]") {
+    SECTION("Tags removed and whitespace collapsed") {
+        CHECK(to_text("<p>Hello   <b>big</b>\n\t world</p>") == "Hello big world");
+    }
+
+    SECTION("Block elements become line breaks") {
+        CHECK(to_text("<h1>Title</h1><p>One</p><p>Two<br>Three</p>") ==
+              "Title\n\nOne\n\nTwo\nThree");
+    }
+
+    SECTION("Scripts, styles and comments are dropped") {
+        CHECK(to_text("<script>if (a < b) { x = '</div>'; }</script>"
+                      "<style>p { color: red }</style>"
+                      "<!-- ignore <p>this</p> -->Text") == "Text");
+    }
+
+    SECTION("Entities are decoded") {
+        CHECK(to_text("Fish &amp; chips &lt;3 &#8364;5 &#x1F600; &nbsp;ok &bogus; &") ==
+              "Fish & chips <3 \xE2\x82\xAC" "5 \xF0\x9F\x98\x80 ok &bogus; &");
+    }
+
+    SECTION("A lone '<' is text") {
+        CHECK(to_text("1 < 2 and 3 <= 4") == "1 < 2 and 3 <= 4");
+    }
+}
+
+TEST_CASE("HtmlSanitizer drops hidden elements", "[infra][sanitizer]") {
+    SECTION("Nested elements of the same name") {
+        CHECK(to_text("<div>A</div><div hidden><div>B</div>C</div><div>D</div>") == "A\nD");
+    }
+
+    SECTION("Style variants") {
+        CHECK(to_text("<span style=\"display: NONE\">x</span>"
+                      "<span style='opacity:0.0'>x</span>"
+                      "<span style=\"font-size:0px\">x</span>"
+                      "<span style=\"opacity:0.5\">shown</span>") == "shown");
+    }
+
+    SECTION("Hidden markup in HTML output") {
+        CHECK(to_html("<p>Keep</p><div class=\"a sr-only\"><p>Drop</p></div>"
+                      "<!-- note --><p>Too</p>") == "<p>Keep</p><p>Too</p>");
+    }
+
+    SECTION("Hidden elements whose end tag is left out") {
+        CHECK(to_text("<ul><li hidden>a<li>b</ul>after") == "b\n\nafter");
+        CHECK(to_text("<p style=\"display:none\">x<p>y") == "y");
+        CHECK(to_text("<div><p hidden>x</div>y") == "y");
+        CHECK(to_text("<table><tr hidden><td>a<tr><td>b</table>") == "b");
+    }
+
+    SECTION("Nested lists stay inside a hidden item") {
+        CHECK(to_text("<ul><li hidden>a<ul><li>b</ul>c<li>d</ul>") == "d");
+    }
+
+    SECTION("Stray end tags do not end a hidden element") {
+        CHECK(to_text("<div hidden>a</span></p>b</div>c") == "c");
+    }
+
+    SECTION("Quoted '>' does not end a tag") {
+        CHECK(to_text("<a title=\"a > b\" aria-hidden=\"true\">hidden</a>ok") == "ok");
+    }
+}
+
+TEST_CASE("HtmlSanitizer streams", "[infra][sanitizer]") {
+    std::string html = "<html><head><title>T &amp; U</title><script>var s = \"</scr\" + \"ipt>\";"
+                       "</script></head><body><p>Caf&eacute; &copy; 2024</p>"
+                       "<div style=\"display:none\">secret</div><ul><li>one</li><li>two</li></ul>"
+                       "</body></html>";
+
+    SECTION("Chunk boundaries do not change the output") {
+        CHECK(to_text_bytewise(html) == to_text(html));
+    }
+
+    SECTION("Output cap stops on a UTF-8 boundary") {
+        HtmlSanitizer sanitizer({.output = HtmlSanitizer::Output::Text, .max_bytes = 6});
+        CHECK_FALSE(sanitizer.feed("<p>abcd\xE2\x82\xAC tail</p>"));
+        CHECK(sanitizer.truncated());
+        CHECK(sanitizer.finish() == "abcd");
+    }
+
+    SECTION("Output can be taken incrementally") {
+        HtmlSanitizer sanitizer;
+        sanitizer.feed("<p>first</p>");
+        auto head = sanitizer.take();
+        sanitizer.feed("<p>second</p>");
+        CHECK(head + sanitizer.finish() == "first\n\nsecond");
+    }
+}
@@ -112,3 +112,84 @@ TEST_CASE("JWT create_token with integer claims", "[infra][jwt]") {
     auto& payload = *result;
     CHECK(payload.contains("tier_level"));
 }
+
+TEST_CASE("JwtVerifier caches validated tokens", "[infra][jwt]") {
+    openclaw::infra::JwtVerifier verifier({TEST_SECRET});
+    auto token = openclaw::infra::create_token({{"sub", "user1"}}, TEST_SECRET);
+
+    REQUIRE(verifier.verify(token).has_value());
+    auto result = verifier.verify(token);
+    REQUIRE(result.has_value());
+    CHECK((*result)["sub"] == "user1");
+
+    auto stats = verifier.stats();
+    CHECK(stats.misses == 1);
+    CHECK(stats.hits == 1);
+    CHECK(stats.cached == 1);
+
+    SECTION("failures are not cached") {
+        auto forged = openclaw::infra::create_token({{"sub", "user1"}}, "other");
+        REQUIRE_FALSE(verifier.verify(forged).has_value());
+        REQUIRE_FALSE(verifier.verify(forged).has_value());
+        CHECK(verifier.stats().rejected == 2);
+        CHECK(verifier.stats().cached == 1);
+    }
+
+    SECTION("revoke refuses a cached token") {
+        verifier.revoke(token);
+        auto revoked = verifier.verify(token);
+        REQUIRE_FALSE(revoked.has_value());
+        CHECK(revoked.error().code() == openclaw::ErrorCode::Unauthorized);
+        CHECK(verifier.stats().cached == 0);
+    }
+
+    SECTION("revocation hook sees cached tokens") {
+        verifier.set_revocation_hook([](const json& claims) {
+            return claims.value("sub", "") == "user1";
+        });
+        REQUIRE_FALSE(verifier.verify(token).has_value());
+        verifier.set_revocation_hook(nullptr);
+        CHECK(verifier.verify(token).has_value());
+    }
+}
+
+TEST_CASE("JwtVerifier key rotation", "[infra][jwt]") {
+    openclaw::infra::JwtVerifier verifier({"new_secret", TEST_SECRET});
+    auto old_token = openclaw::infra::create_token({{"sub", "old"}}, TEST_SECRET);
+    auto new_token = openclaw::infra::create_token({{"sub", "new"}}, "new_secret");
+
+    CHECK(verifier.verify(old_token).has_value());
+    CHECK(verifier.verify(new_token).has_value());
+
+    // Retiring the old secret also drops its cached tokens
+    REQUIRE(verifier.set_keys({"new_secret"}).has_value());
+    CHECK(verifier.stats().cached == 0);
+    CHECK_FALSE(verifier.verify(old_token).has_value());
+    CHECK(verifier.verify(new_token).has_value());
+}
+
+TEST_CASE("JwtVerifier refuses empty and unresolved keys", "[infra][jwt]") {
+    openclaw::infra::JwtVerifier verifier({TEST_SECRET});
+    auto token = openclaw::infra::create_token({{"sub", "user1"}}, TEST_SECRET);
+
+    CHECK_FALSE(verifier.set_keys({}).has_value());
+    CHECK_FALSE(verifier.set_keys({""}).has_value());
+    CHECK_FALSE(verifier.set_keys({TEST_SECRET, "${JWT_KEY_OLD}"}).has_value());
+    CHECK(verifier.verify(token).has_value());  // Current keys stay
+
+    // A token signed with the literal placeholder must not get in
+    openclaw::infra::JwtVerifier unresolved({"${JWT_KEY_OLD}"});
+    auto forged = openclaw::infra::create_token({{"sub", "x"}}, "${JWT_KEY_OLD}");
+    CHECK_FALSE(unresolved.verify(forged).has_value());
+    openclaw::infra::JwtVerifier empty({""});
+    CHECK_FALSE(empty.verify(openclaw::infra::create_token({{"sub", "x"}}, "")).has_value());
+}
+
+TEST_CASE("JwtVerifier evicts when full", "[infra][jwt]") {
+    openclaw::infra::JwtVerifier verifier({TEST_SECRET}, {.max_entries = 2});
+    for (int i = 0; i < 5; ++i) {
+        auto token = openclaw::infra::create_token({{"n", i}}, TEST_SECRET);
+        REQUIRE(verifier.verify(token).has_value());
+    }
+    CHECK(verifier.stats().cached == 2);
+}
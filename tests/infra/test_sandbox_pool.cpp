@@ -0,0 +1,214 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "openclaw/infra/sandbox_pool.hpp"
+
+using namespace openclaw;
+using namespace openclaw::infra;
+
+namespace {
+
+// /bin/sh running the shell job loop stands in for a real interpreter
+auto stub_config() -> CodeSandboxConfig {
+    CodeSandboxConfig config;
+    config.runtimes = {{.name = "stub", .command = {"/bin/sh"}, .runner = "shell", .workers = 1}};
+    config.network_mode = "bridge";
+    config.timeout_seconds = 2;
+    config.max_open_files = 64;
+    return config;
+}
+
+struct TmpDir {
+    std::filesystem::path path;
+    explicit TmpDir(const char* name)
+        : path(std::filesystem::temp_directory_path() / name) {
+        std::filesystem::remove_all(path);
+    }
+    ~TmpDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+};
+
+auto run(boost::asio::io_context& ioc, SandboxPool& pool, std::string code)
+    -> Result<CodeRunResult> {
+    std::optional<Result<CodeRunResult>> result;
+    boost::asio::co_spawn(ioc, pool.run("stub", std::move(code)),
+        [&](std::exception_ptr, Result<CodeRunResult> r) { result = std::move(r); });
+    ioc.restart();
+    ioc.run();
+    return std::move(*result);
+}
+
+/// Waits up to a second for `pid` to be gone or a zombie.
+auto exits(pid_t pid) -> bool {
+    for (int i = 0; i < 100; ++i) {
+        std::ifstream file("/proc/" + std::to_string(pid) + "/stat");
+        std::string stat;
+        if (!std::getline(file, stat)) return true;
+        auto name_end = stat.rfind(')');
+        if (name_end + 2 < stat.size() && stat[name_end + 2] == 'Z') return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+TEST_CASE("SandboxPool rejects unsafe or unknown settings", "[infra][sandbox_pool]") {
+    boost::asio::io_context ioc;
+    TmpDir dir("test_sandbox_pool_config");
+
+    auto host = stub_config();
+    host.network_mode = "host";
+    auto rejected = std::make_shared<SandboxPool>(ioc, host, dir.path)->start();
+    REQUIRE_FALSE(rejected.has_value());
+    CHECK(rejected.error().code() == ErrorCode::Forbidden);
+
+    auto unknown = stub_config();
+    unknown.runtimes[0].runner = "ruby";
+    CHECK_FALSE(std::make_shared<SandboxPool>(ioc, unknown, dir.path)->start().has_value());
+
+    auto missing = stub_config();
+    missing.runtimes[0].command = {"/nonexistent/interpreter"};
+    CHECK_FALSE(std::make_shared<SandboxPool>(ioc, missing, dir.path)->start().has_value());
+}
+
+TEST_CASE("SandboxPool reuses a worker and resets it between jobs", "[infra][sandbox_pool]") {
+    boost::asio::io_context ioc;
+    TmpDir dir("test_sandbox_pool_reuse");
+    auto config = stub_config();
+    config.max_jobs_per_worker = 3;
+    auto pool = std::make_shared<SandboxPool>(ioc, config, dir.path);
+    REQUIRE(pool->start().has_value());
+
+    auto first = run(ioc, *pool, "echo hello; echo oops >&2; touch left-behind; exit 3");
+    REQUIRE(first.has_value());
+    CHECK(first->out == "hello\n");
+    CHECK(first->err == "oops\n");
+    CHECK(first->exit_code == 3);
+    CHECK_FALSE(first->reused);
+
+    auto second = run(ioc, *pool, "test -e left-behind && echo stale; ulimit -n");
+    REQUIRE(second.has_value());
+    CHECK(second->out == "64\n");  // Directory emptied, limits applied
+    CHECK(second->reused);
+
+    REQUIRE(run(ioc, *pool, "true").has_value());
+    auto stats = pool->stats()["stub"];
+    CHECK(stats["jobs"] == 3);
+    CHECK(stats["recycled"] == 1);  // After max_jobs_per_worker
+    CHECK(stats["spawned"] == 2);
+
+    auto fresh = run(ioc, *pool, "echo again");
+    REQUIRE(fresh.has_value());
+    CHECK_FALSE(fresh->reused);
+}
+
+TEST_CASE("SandboxPool kills processes a job leaves running", "[infra][sandbox_pool]") {
+    boost::asio::io_context ioc;
+    TmpDir dir("test_sandbox_pool_stray");
+    auto pool = std::make_shared<SandboxPool>(ioc, stub_config(), dir.path);
+    REQUIRE(pool->start().has_value());
+
+    auto first = run(ioc, *pool, "sleep 30 & echo $!");
+    REQUIRE(first.has_value());
+    auto pid = static_cast<pid_t>(std::stol(first->out));
+    CHECK(exits(pid));
+
+    auto second = run(ioc, *pool, "echo next");
+    REQUIRE(second.has_value());
+    CHECK(second->out == "next\n");
+    CHECK_FALSE(second->reused);  // Recycled after the stray process
+    CHECK(pool->stats()["stub"]["recycled"] == 1);
+
+    // Leaving the session does not hide a process from the reaper
+    auto escaped = run(ioc, *pool, "command -v setsid >/dev/null || exit 7; setsid sleep 30 & echo $!");
+    REQUIRE(escaped.has_value());
+    if (escaped->exit_code == 7) {
+        WARN("setsid not installed");
+        return;
+    }
+    CHECK(exits(static_cast<pid_t>(std::stol(escaped->out))));
+    auto third = run(ioc, *pool, "true");
+    REQUIRE(third.has_value());
+    CHECK_FALSE(third->reused);
+    CHECK(pool->stats()["stub"]["recycled"] == 2);
+}
+
+TEST_CASE("SandboxPool replaces timed out and overflowing workers", "[infra][sandbox_pool]") {
+    boost::asio::io_context ioc;
+    TmpDir dir("test_sandbox_pool_recycle");
+    auto config = stub_config();
+    config.timeout_seconds = 1;
+    config.max_output_bytes = 16;
+    auto pool = std::make_shared<SandboxPool>(ioc, config, dir.path);
+    REQUIRE(pool->start().has_value());
+
+    auto slow = run(ioc, *pool, "sleep 30");
+    REQUIRE_FALSE(slow.has_value());
+    CHECK(slow.error().code() == ErrorCode::Timeout);
+
+    auto loud = run(ioc, *pool, "printf '%0100d' 0");
+    REQUIRE(loud.has_value());
+    CHECK(loud->truncated);
+    CHECK(loud->out == std::string(16, '0'));
+
+    auto after = run(ioc, *pool, "echo ok");
+    REQUIRE(after.has_value());
+    CHECK(after->out == "ok\n");
+
+    auto stats = pool->stats()["stub"];
+    CHECK(stats["timeouts"] == 1);
+    CHECK(stats["recycled"] == 2);
+}
+
+TEST_CASE("SandboxPool queues jobs while every worker is busy", "[infra][sandbox_pool]") {
+    boost::asio::io_context ioc;
+    TmpDir dir("test_sandbox_pool_queue");
+    auto config = stub_config();
+    config.runtimes[0].workers = 2;
+    auto pool = std::make_shared<SandboxPool>(ioc, config, dir.path);
+    REQUIRE(pool->start().has_value());
+
+    std::vector<Result<CodeRunResult>> results;
+    for (int i = 0; i < 3; ++i) {
+        boost::asio::co_spawn(ioc, pool->run("stub", "sleep 0.2; echo " + std::to_string(i)),
+            [&](std::exception_ptr, Result<CodeRunResult> r) { results.push_back(std::move(r)); });
+    }
+    ioc.run();
+
+    REQUIRE(results.size() == 3);
+    for (const auto& result : results) {
+        CHECK(result.has_value());
+    }
+    CHECK(pool->stats()["stub"]["jobs"] == 3);
+    CHECK(pool->stats()["stub"]["spawned"] == 2);
+}
+
+TEST_CASE("SandboxPool workers have no network with mode none", "[infra][sandbox_pool]") {
+    boost::asio::io_context ioc;
+    TmpDir dir("test_sandbox_pool_network");
+    auto config = stub_config();
+    config.network_mode = "none";
+    auto pool = std::make_shared<SandboxPool>(ioc, config, dir.path);
+    auto started = pool->start();
+    if (!started) {
+        // No namespaces here; the pool must refuse rather than run open
+        CHECK(started.error().code() == ErrorCode::Forbidden);
+        return;
+    }
+
+    auto result = run(ioc, *pool, "tail -n +3 /proc/net/dev | cut -d: -f1 | tr -d ' '");
+    REQUIRE(result.has_value());
+    CHECK(result->out == "lo\n");
+}
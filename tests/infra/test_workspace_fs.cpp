@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "openclaw/infra/workspace_fs.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+using namespace openclaw;
+using namespace openclaw::infra;
+
+namespace {
+struct TmpDir {
+    fs::path path;
+    TmpDir() {
+        path = fs::temp_directory_path() / ("test_workspace_fs_" + std::to_string(::getpid()));
+        fs::create_directories(path / "ws");
+    }
+    ~TmpDir() {
+        std::error_code ec;
+        fs::remove_all(path, ec);
+    }
+};
+
+auto read_all(int fd) -> std::string {
+    std::string out(64, '\0');
+    auto n = ::pread(fd, out.data(), out.size(), 0);
+    out.resize(n > 0 ? static_cast<size_t>(n) : 0);
+    return out;
+}
+} // namespace
+
+TEST_CASE("WorkspaceFs opens files inside the workspace", "[infra][security]") {
+    TmpDir tmp;
+    auto ws = tmp.path / "ws";
+    fs::create_directories(ws / "sub");
+    std::ofstream(ws / "sub" / "a.txt") << "hello";
+    WorkspaceFs files({ws});
+
+    SECTION("Absolute path") {
+        auto fd = files.open(ws / "sub" / "a.txt");
+        REQUIRE(fd.has_value());
+        CHECK(read_all(fd->get()) == "hello");
+    }
+
+    SECTION("Relative path resolves against the first root") {
+        auto fd = files.open("sub/a.txt");
+        REQUIRE(fd.has_value());
+        CHECK(read_all(fd->get()) == "hello");
+    }
+
+    SECTION("Relative symlink inside the workspace") {
+        fs::create_symlink("sub/a.txt", ws / "link.txt");
+        auto fd = files.open(ws / "link.txt");
+        REQUIRE(fd.has_value());
+        CHECK(read_all(fd->get()) == "hello");
+    }
+
+    SECTION("Absolute symlink inside the workspace is walked beneath the root") {
+        fs::create_symlink(ws / "sub" / "a.txt", ws / "abs.txt");
+        auto fd = files.open(ws / "abs.txt");
+        REQUIRE(fd.has_value());
+        CHECK(read_all(fd->get()) == "hello");
+    }
+
+    SECTION("Absolute symlinked directory, then dot-dot") {
+        fs::create_directory_symlink(ws / "sub", ws / "absdir");
+        auto fd = files.open("absdir/../sub/a.txt");
+        REQUIRE(fd.has_value());
+        CHECK(read_all(fd->get()) == "hello");
+    }
+
+    SECTION("Writes through an absolute symlink inside the workspace") {
+        fs::create_symlink(ws / "sub" / "new.txt", ws / "abs-new.txt");
+        auto fd = files.open("abs-new.txt", O_WRONLY | O_CREAT | O_TRUNC);
+        REQUIRE(fd.has_value());
+        CHECK(fs::exists(ws / "sub" / "new.txt"));
+    }
+
+    SECTION("Missing file") {
+        auto fd = files.open("missing.txt");
+        REQUIRE_FALSE(fd.has_value());
+        CHECK(fd.error().code() == ErrorCode::NotFound);
+    }
+}
+
+TEST_CASE("WorkspaceFs rejects escapes", "[infra][security]") {
+    TmpDir tmp;
+    auto ws = tmp.path / "ws";
+    std::ofstream(tmp.path / "secret.txt") << "secret";
+    WorkspaceFs files({ws});
+
+    SECTION("Dot-dot") {
+        auto fd = files.open("../secret.txt");
+        REQUIRE_FALSE(fd.has_value());
+        CHECK(fd.error().code() == ErrorCode::Forbidden);
+    }
+
+    SECTION("Encoded dot-dot") {
+        auto fd = files.open("%2e%2e/secret.txt");
+        REQUIRE_FALSE(fd.has_value());
+        CHECK(fd.error().code() == ErrorCode::Forbidden);
+    }
+
+    SECTION("Absolute path outside every root") {
+        auto fd = files.open(tmp.path / "secret.txt");
+        REQUIRE_FALSE(fd.has_value());
+        CHECK(fd.error().code() == ErrorCode::Forbidden);
+    }
+
+    SECTION("Symlinked directory pointing outside") {
+        fs::create_directory_symlink(tmp.path, ws / "out");
+        auto fd = files.open(ws / "out" / "secret.txt");
+        REQUIRE_FALSE(fd.has_value());
+        CHECK(fd.error().code() == ErrorCode::Forbidden);
+    }
+
+    SECTION("Absolute symlink pointing outside") {
+        fs::create_symlink(tmp.path / "secret.txt", ws / "abs.txt");
+        for (int flags : {O_RDONLY, O_WRONLY | O_TRUNC, O_WRONLY | O_CREAT}) {
+            auto fd = files.open("abs.txt", flags);
+            REQUIRE_FALSE(fd.has_value());
+            CHECK(fd.error().code() == ErrorCode::Forbidden);
+        }
+        CHECK(fs::file_size(tmp.path / "secret.txt") == 6);
+    }
+
+    SECTION("Dangling absolute symlink pointing outside is not created") {
+        fs::create_symlink(tmp.path / "planted.txt", ws / "plant.txt");
+        auto fd = files.open("plant.txt", O_WRONLY | O_CREAT);
+        REQUIRE_FALSE(fd.has_value());
+        CHECK(fd.error().code() == ErrorCode::Forbidden);
+        CHECK_FALSE(fs::exists(tmp.path / "planted.txt"));
+    }
+
+    SECTION("Relative symlink climbing out through an absolute one") {
+        fs::create_directories(ws / "sub");
+        fs::create_directory_symlink(ws / "sub", ws / "absdir");
+        fs::create_symlink("../../secret.txt", ws / "sub" / "up.txt");
+        auto fd = files.open("absdir/up.txt");
+        REQUIRE_FALSE(fd.has_value());
+        CHECK(fd.error().code() == ErrorCode::Forbidden);
+    }
+
+    SECTION("Hardlinked file") {
+        fs::create_hard_link(tmp.path / "secret.txt", ws / "hard.txt");
+        auto fd = files.open(ws / "hard.txt", O_WRONLY | O_TRUNC);
+        REQUIRE_FALSE(fd.has_value());
+        CHECK(fd.error().code() == ErrorCode::Forbidden);
+        // O_TRUNC must not have been applied before the check
+        CHECK(fs::file_size(tmp.path / "secret.txt") == 6);
+    }
+}
@@ -0,0 +1,140 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <functional>
+#include <optional>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include "openclaw/plugins/plugin_host.hpp"
+
+using namespace openclaw;
+using namespace openclaw::plugins;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Stand-in host process: writes "ready" with one tool straight into the
+// response ring, then never answers. In "corrupt" mode it answers the
+// first call with a record longer than the ring.
+constexpr const char* kFakeHost = R"(
+import json, mmap, os, select, struct, sys, time
+mode = sys.argv[1]
+opts = dict(zip(sys.argv[2::2], sys.argv[3::2]))
+cap = max(64, 1 << (int(opts['--ring-bytes']) - 1).bit_length())
+region = 192 + cap
+mem = mmap.mmap(int(opts['--memfd']), 2 * region)
+base = region
+def publish(length, payload):
+    head = struct.unpack_from('<Q', mem, base)[0]
+    off = base + 192 + (head & (cap - 1))
+    struct.pack_into('<I', mem, off, length)
+    mem[off + 4:off + 4 + len(payload)] = payload
+    struct.pack_into('<Q', mem, base, head + ((4 + len(payload) + 7) & ~7))
+    os.write(int(opts['--response-fd']), struct.pack('<Q', 1))
+ready = {'op': 'ready', 'name': 'fake', 'version': '1',
+         'tools': [{'name': 'wait', 'description': '', 'parameters': []}]}
+publish(len(json.dumps(ready)), json.dumps(ready).encode())
+if mode == 'corrupt':
+    select.select([int(opts['--request-fd'])], [], [])
+    publish(0x7fffffff, b'')
+time.sleep(3600)
+)";
+
+auto fake_host(const char* mode) -> std::optional<PluginHostOptions> {
+    if (!std::filesystem::exists("/usr/bin/python3")) {
+        return std::nullopt;
+    }
+    PluginHostOptions options;
+    options.library = "fake.so";
+    options.command = {"/usr/bin/python3", "-c", kFakeHost, mode};
+    options.ring_bytes = 4096;
+    options.call_timeout = 10s;
+    options.restart_delay = 200ms;
+    return options;
+}
+
+auto run_until(boost::asio::io_context& ioc, const std::function<bool()>& done) -> bool {
+    auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (!done() && std::chrono::steady_clock::now() < deadline) {
+        ioc.restart();
+        ioc.run_for(10ms);
+    }
+    return done();
+}
+
+// Starts a call to the fake tool; the result lands in `result`.
+void start_call(boost::asio::io_context& ioc, PluginHost& host,
+                std::optional<Result<json>>& result) {
+    boost::asio::co_spawn(ioc, host.call("wait", json::object()),
+        [&result](std::exception_ptr, Result<json> r) { result = std::move(r); });
+    ioc.restart();
+    ioc.run_for(50ms);  // Request pushed and waiting
+}
+
+} // anonymous namespace
+
+TEST_CASE("PluginHost fails calls of a killed host and restarts it with backoff",
+          "[plugins][plugin_host]") {
+    auto options = fake_host("hang");
+    if (!options) {
+        WARN("python3 not available; skipping");
+        return;
+    }
+    boost::asio::io_context ioc;
+    auto host = std::make_shared<PluginHost>(ioc, *options);
+    REQUIRE(host->start().has_value());
+    REQUIRE(run_until(ioc, [&] { return host->ready(); }));
+
+    std::optional<Result<json>> result;
+    start_call(ioc, *host, result);
+    REQUIRE_FALSE(result.has_value());
+
+    auto first = host->pid();
+    auto killed = std::chrono::steady_clock::now();
+    ::kill(first, SIGKILL);
+    REQUIRE(run_until(ioc, [&] { return result.has_value(); }));
+    REQUIRE_FALSE(result->has_value());
+    CHECK(result->error().code() == ErrorCode::PluginError);
+
+    REQUIRE(run_until(ioc, [&] { return host->ready() && host->pid() != first; }));
+    CHECK(host->restarts() == 1);
+    CHECK(std::chrono::steady_clock::now() - killed >= 200ms);
+
+    // A second crash soon after waits twice as long
+    auto second = host->pid();
+    killed = std::chrono::steady_clock::now();
+    ::kill(second, SIGKILL);
+    REQUIRE(run_until(ioc, [&] { return host->ready() && host->pid() != second; }));
+    CHECK(host->restarts() == 2);
+    CHECK(std::chrono::steady_clock::now() - killed >= 400ms);
+
+    host->stop();
+}
+
+TEST_CASE("PluginHost kills and restarts a host that corrupts its ring",
+          "[plugins][plugin_host]") {
+    auto options = fake_host("corrupt");
+    if (!options) {
+        WARN("python3 not available; skipping");
+        return;
+    }
+    boost::asio::io_context ioc;
+    auto host = std::make_shared<PluginHost>(ioc, *options);
+    REQUIRE(host->start().has_value());
+    REQUIRE(run_until(ioc, [&] { return host->ready(); }));
+    auto first = host->pid();
+
+    std::optional<Result<json>> result;
+    start_call(ioc, *host, result);
+    REQUIRE(run_until(ioc, [&] { return result.has_value(); }));
+    REQUIRE_FALSE(result->has_value());
+    CHECK(result->error().code() == ErrorCode::PluginError);
+
+    REQUIRE(run_until(ioc, [&] { return host->ready() && host->pid() != first; }));
+    CHECK(host->restarts() == 1);
+    host->stop();
+}
@@ -0,0 +1,168 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "openclaw/plugins/shm_ring.hpp"
+
+using namespace openclaw::plugins;
+
+namespace {
+
+/// Heap stand-in for a shared mapping, aligned like one.
+struct Region {
+    explicit Region(size_t capacity)
+        : bytes(ShmRing::region_size(capacity) / 64 + 1) {}
+    auto data() -> void* { return bytes.data(); }
+
+    struct alignas(64) Line { char b[64]; };
+    std::vector<Line> bytes;
+};
+
+} // anonymous namespace
+
+TEST_CASE("ShmRing passes messages in order", "[plugins][shm_ring]") {
+    Region region(256);
+    auto producer = ShmRing::create(region.data(), 256);
+    auto consumer = ShmRing::attach(region.data(), 256);
+
+    CHECK(consumer.empty());
+    REQUIRE(producer.try_push("first"));
+    REQUIRE(producer.try_push(""));
+    REQUIRE(producer.try_push("third message"));
+
+    std::string out;
+    REQUIRE(consumer.try_pop(out));
+    CHECK(out == "first");
+    REQUIRE(consumer.try_pop(out));
+    CHECK(out.empty());
+    REQUIRE(consumer.try_pop(out));
+    CHECK(out == "third message");
+    CHECK_FALSE(consumer.try_pop(out));
+    CHECK(consumer.empty());
+}
+
+TEST_CASE("ShmRing rejects pushes until the consumer frees room", "[plugins][shm_ring]") {
+    Region region(64);
+    auto ring = ShmRing::create(region.data(), 64);
+    REQUIRE(ring.capacity() == 64);
+
+    std::string message(20, 'x');  // 4 + 20 -> 24-byte records
+    REQUIRE(ring.try_push(message));
+    REQUIRE(ring.try_push(message));
+    CHECK_FALSE(ring.try_push(message));
+
+    std::string out;
+    REQUIRE(ring.try_pop(out));
+    CHECK(ring.try_push(message));
+}
+
+TEST_CASE("ShmRing wraps records that would cross the end", "[plugins][shm_ring]") {
+    Region region(64);
+    auto ring = ShmRing::create(region.data(), 64);
+    std::string out;
+
+    // Walk the write position around the buffer several times with
+    // records that do not divide it evenly
+    for (int i = 0; i < 20; ++i) {
+        auto message = std::string(static_cast<size_t>(i % 3) * 9 + 5,
+                                   static_cast<char>('a' + i));
+        REQUIRE(ring.try_push(message));
+        REQUIRE(ring.try_pop(out));
+        CHECK(out == message);
+    }
+    CHECK(ring.empty());
+}
+
+TEST_CASE("ShmRing refuses oversized messages", "[plugins][shm_ring]") {
+    Region region(64);
+    auto ring = ShmRing::create(region.data(), 64);
+    CHECK(ring.try_push(std::string(ring.max_message_size(), 'x')));
+    std::string out;
+    REQUIRE(ring.try_pop(out));
+    CHECK_FALSE(ring.try_push(std::string(ring.max_message_size() + 1, 'x')));
+}
+
+TEST_CASE("ShmRing hands over messages between threads", "[plugins][shm_ring]") {
+    Region region(1024);
+    auto producer = ShmRing::create(region.data(), 1024);
+    auto consumer = ShmRing::attach(region.data(), 1024);
+    constexpr int kCount = 20000;
+
+    std::thread writer([&] {
+        for (int i = 0; i < kCount; ++i) {
+            auto message = std::to_string(i);
+            while (!producer.try_push(message)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    bool in_order = true;
+    std::string out;
+    while (expected < kCount) {
+        if (consumer.try_pop(out)) {
+            in_order = in_order && out == std::to_string(expected);
+            ++expected;
+        }
+    }
+    writer.join();
+    CHECK(in_order);
+    CHECK(consumer.empty());
+}
+
+TEST_CASE("ShmRing refuses records the producer could not have written", "[plugins][shm_ring]") {
+    Region region(64);
+    auto producer = ShmRing::create(region.data(), 64);
+    auto consumer = ShmRing::attach(region.data(), 64);
+    auto* header = static_cast<ShmRing::Header*>(region.data());
+    auto* data = static_cast<char*>(region.data()) + sizeof(ShmRing::Header);
+    std::string out;
+
+    SECTION("capacity in the header is ignored") {
+        header->capacity = uint64_t{1} << 40;
+        CHECK(consumer.capacity() == 64);
+        CHECK(consumer.max_message_size() == 28);
+    }
+
+    SECTION("length past the largest message") {
+        REQUIRE(producer.try_push("ok"));
+        uint32_t length = 1000;
+        std::memcpy(data, &length, sizeof(length));
+        CHECK_FALSE(consumer.try_pop(out));
+        CHECK(consumer.corrupt());
+    }
+
+    SECTION("record longer than what was published") {
+        REQUIRE(producer.try_push("ok"));
+        uint32_t length = 20;
+        std::memcpy(data, &length, sizeof(length));
+        CHECK_FALSE(consumer.try_pop(out));
+        CHECK(consumer.corrupt());
+    }
+
+    SECTION("head further ahead than the ring holds") {
+        header->head.store(4096);
+        CHECK_FALSE(consumer.try_pop(out));
+        CHECK(consumer.corrupt());
+    }
+
+    SECTION("wrap marker at the start of the buffer") {
+        REQUIRE(producer.try_push("ok"));
+        uint32_t marker = 0xFFFFFFFFu;
+        std::memcpy(data, &marker, sizeof(marker));
+        CHECK_FALSE(consumer.try_pop(out));
+        CHECK(consumer.corrupt());
+    }
+
+    SECTION("good records are still refused once corrupt") {
+        header->head.store(4096);
+        CHECK_FALSE(consumer.try_pop(out));
+        header->head.store(0);
+        REQUIRE(producer.try_push("ok"));
+        CHECK_FALSE(consumer.try_pop(out));
+    }
+}
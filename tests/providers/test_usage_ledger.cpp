@@ -0,0 +1,204 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include "openclaw/providers/usage_ledger.hpp"
+
+using namespace openclaw::providers;
+
+namespace {
+
+auto priced_config() -> openclaw::UsageConfig {
+    openclaw::UsageConfig config;
+    config.prices = {
+        {.model = "claude-sonnet-4", .input_per_mtok = 3.0, .output_per_mtok = 15.0},
+        {.model = "claude-sonnet-4-5", .input_per_mtok = 4.0, .output_per_mtok = 20.0},
+    };
+    return config;
+}
+
+auto event(std::string model, std::string agent, int64_t in, int64_t out) -> UsageEvent {
+    return UsageEvent{
+        .labels = {.provider = "anthropic", .model = std::move(model),
+                   .session = "s1", .agent = std::move(agent), .channel = "telegram"},
+        .input_tokens = in,
+        .output_tokens = out,
+    };
+}
+
+// RAII helper: removes the file on destruction, ignoring errors.
+struct TmpDbFile {
+    std::filesystem::path path;
+    explicit TmpDbFile(const char* name)
+        : path(std::filesystem::temp_directory_path() / name) {
+        std::filesystem::remove(path);
+    }
+    ~TmpDbFile() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+    auto str() const -> std::string { return path.string(); }
+};
+
+} // namespace
+
+TEST_CASE("UsageLedger prices by the longest matching model", "[providers][usage]") {
+    UsageLedger ledger(priced_config(), ":memory:");
+
+    CHECK(ledger.cost_micros("claude-sonnet-4-20250514", 1000, 100) == 3000 + 1500);
+    CHECK(ledger.cost_micros("claude-sonnet-4-5-20250929", 1000, 100) == 4000 + 2000);
+    CHECK(ledger.cost_micros("gpt-4o", 1000, 100) == 0);
+}
+
+TEST_CASE("UsageLedger aggregates runs into rollups", "[providers][usage]") {
+    UsageLedger ledger(priced_config(), ":memory:");
+    ledger.record(event("claude-sonnet-4-20250514", "main", 1000, 100));
+    ledger.record(event("claude-sonnet-4-20250514", "main", 2000, 200));
+    ledger.record(event("claude-sonnet-4-5-20250929", "cron", 1000, 100));
+
+    auto total = ledger.query({});
+    REQUIRE(total.has_value());
+    REQUIRE(total->size() == 1);
+    CHECK(total->front().totals.runs == 3);
+    CHECK(total->front().totals.input_tokens == 4000);
+    CHECK(total->front().totals.output_tokens == 400);
+    CHECK(total->front().totals.cost_micros == 4500 + 9000 + 6000);
+
+    // Everything recorded so far shares one bucket and two label sets
+    auto flushed = ledger.flush();
+    REQUIRE(flushed.has_value());
+    CHECK(*flushed == 0);  // query() already flushed
+
+    auto by_agent = ledger.query({.group_by = {"agent"}});
+    REQUIRE(by_agent.has_value());
+    REQUIRE(by_agent->size() == 2);
+    CHECK(by_agent->at(0).keys["agent"] == "main");  // Most expensive first
+    CHECK(by_agent->at(0).totals.runs == 2);
+    CHECK(by_agent->at(1).keys["agent"] == "cron");
+
+    auto cron_only = ledger.query({.where = {{"agent", "cron"}}});
+    REQUIRE(cron_only.has_value());
+    CHECK(cron_only->front().totals.runs == 1);
+
+    auto later = ledger.query({.from = openclaw::Clock::now() + std::chrono::hours(2)});
+    REQUIRE(later.has_value());
+    CHECK(later->front().totals.runs == 0);
+
+    CHECK_FALSE(ledger.query({.group_by = {"cost; DROP TABLE usage_rollup"}}).has_value());
+    CHECK_FALSE(ledger.query({.where = {{"tenant", "x"}}}).has_value());
+}
+
+TEST_CASE("UsageLedger enforces soft and hard budgets", "[providers][usage]") {
+    auto config = priced_config();
+    config.budgets = {
+        {.dimension = "agent", .key = "main", .soft_usd = 0.01, .hard_usd = 0.02},
+    };
+    TmpDbFile db("test_usage_ledger_budgets.db");
+
+    {
+        UsageLedger ledger(config, db.str());
+        CHECK(ledger.check_budget(event("", "main", 0, 0).labels).state == BudgetState::Ok);
+
+        ledger.record(event("claude-sonnet-4", "main", 2000, 400));  // $0.012
+        auto soft = ledger.check_budget(event("", "main", 0, 0).labels);
+        CHECK(soft.state == BudgetState::Soft);
+        CHECK(soft.tenant == "agent:main");
+
+        ledger.record(event("claude-sonnet-4", "main", 2000, 400));  // $0.024
+        CHECK(ledger.check_budget(event("", "main", 0, 0).labels).state == BudgetState::Hard);
+        CHECK(ledger.check_budget(event("", "other", 0, 0).labels).state == BudgetState::Ok);
+
+        auto budgets = ledger.budgets();
+        REQUIRE(budgets.size() == 1);
+        CHECK(budgets[0]["state"] == "hard");
+    }
+
+    // The destructor flushed; a new ledger picks the spend up from the table
+    UsageLedger reopened(config, db.str());
+    CHECK(reopened.check_budget(event("", "main", 0, 0).labels).state == BudgetState::Hard);
+
+    // The next period starts from zero
+    auto tomorrow = openclaw::Clock::now() + std::chrono::hours(24);
+    CHECK(reopened.check_budget(event("", "main", 0, 0).labels, tomorrow).state ==
+          BudgetState::Ok);
+}
+
+TEST_CASE("UsageLedger caller budgets ignore the labels a request picks", "[providers][usage]") {
+    auto config = priced_config();
+    config.budgets = {
+        {.dimension = "caller", .key = "alice", .hard_usd = 0.01},
+    };
+    UsageLedger ledger(config, ":memory:");
+
+    auto run = event("claude-sonnet-4", "main", 2000, 400);  // $0.012
+    run.labels.caller = "alice";
+    ledger.record(run);
+
+    // Same caller under another session, agent and channel
+    auto dodge = event("", "other", 0, 0).labels;
+    dodge.session = "fresh";
+    dodge.channel = "";
+    dodge.caller = "alice";
+    auto status = ledger.check_budget(dodge);
+    CHECK(status.state == BudgetState::Hard);
+    CHECK(status.tenant == "caller:alice");
+
+    auto by_caller = ledger.query({.group_by = {"caller"}});
+    REQUIRE(by_caller.has_value());
+    REQUIRE(by_caller->size() == 1);
+    CHECK(by_caller->front().keys["caller"] == "alice");
+}
+
+TEST_CASE("UsageLedger adds the caller column to an older table", "[providers][usage]") {
+    TmpDbFile db("test_usage_ledger_migrate.db");
+    {
+        SQLite::Database old(db.str(), SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+        old.exec(R"SQL(
+            CREATE TABLE usage_rollup (
+                bucket INTEGER NOT NULL, provider TEXT NOT NULL, model TEXT NOT NULL,
+                session TEXT NOT NULL, agent TEXT NOT NULL, channel TEXT NOT NULL,
+                runs INTEGER NOT NULL, input_tokens INTEGER NOT NULL,
+                output_tokens INTEGER NOT NULL, cost_micros INTEGER NOT NULL,
+                PRIMARY KEY (bucket, provider, model, session, agent, channel)
+            ) WITHOUT ROWID;
+            INSERT INTO usage_rollup VALUES (0, 'anthropic', 'm', 's1', 'main', 'telegram',
+                                             2, 100, 10, 500);
+        )SQL");
+    }
+
+    UsageLedger ledger(priced_config(), db.str());
+    ledger.record(event("claude-sonnet-4", "main", 1000, 100));
+    auto by_caller = ledger.query({.group_by = {"caller"}});
+    REQUIRE(by_caller.has_value());
+    REQUIRE(by_caller->size() == 1);
+    CHECK(by_caller->front().keys["caller"] == "");
+    CHECK(by_caller->front().totals.runs == 3);
+}
+
+TEST_CASE("UsageLedger async_query resumes on the caller's executor", "[providers][usage]") {
+    UsageLedger ledger(priced_config(), ":memory:");
+    ledger.record(event("claude-sonnet-4", "main", 1000, 100));
+
+    boost::asio::io_context ioc;
+    std::optional<openclaw::Result<std::vector<UsageRow>>> result;
+    bool on_io_thread = false;
+    boost::asio::co_spawn(ioc,
+        [&]() -> boost::asio::awaitable<void> {
+            result = co_await ledger.async_query({});
+            on_io_thread = ioc.get_executor().running_in_this_thread();
+        },
+        boost::asio::detached);
+    ioc.run();
+
+    REQUIRE(result.has_value());
+    REQUIRE(result->has_value());
+    CHECK((*result)->front().totals.runs == 1);
+    CHECK(on_io_thread);
+}